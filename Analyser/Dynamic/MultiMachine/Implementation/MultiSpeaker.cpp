@@ -43,6 +43,12 @@ void MultiSpeaker::set_computed_output_rate(float cycles_per_second, int buffer_
 	}
 }
 
+void MultiSpeaker::set_skips_output(bool skips_output) {
+	for(const auto &speaker: speakers_) {
+		speaker->set_skips_output(skips_output);
+	}
+}
+
 void MultiSpeaker::set_delegate(Outputs::Speaker::Speaker::Delegate *delegate) {
 	delegate_ = delegate;
 }
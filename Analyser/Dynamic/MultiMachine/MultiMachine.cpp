@@ -64,6 +64,15 @@ MouseMachine::Machine *MultiMachine::mouse_machine() {
 	return nullptr;
 }
 
+SnapshotMachine::Machine *MultiMachine::snapshot_machine() {
+	if(has_picked_) {
+		return machines_.front()->snapshot_machine();
+	} else {
+		// Snapshots can't be meaningfully applied across a set of potential machines.
+		return nullptr;
+	}
+}
+
 Configurable::Device *MultiMachine::configurable_device() {
 	if(has_picked_) {
 		return machines_.front()->configurable_device();
@@ -57,6 +57,7 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiCRTMachine::De
 		MouseMachine::Machine *mouse_machine() final;
 		KeyboardMachine::Machine *keyboard_machine() final;
 		MediaTarget::Machine *media_target() final;
+		SnapshotMachine::Machine *snapshot_machine() final;
 		void *raw_pointer() final;
 
 	private:
@@ -0,0 +1,177 @@
+//
+//  Profiler.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Profiler.hpp"
+
+#include "../Static/Disassembler/6502.hpp"
+#include "../Static/Disassembler/AddressMapper.hpp"
+#include "../Static/Disassembler/Z80.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace Analyser::Dynamic;
+
+namespace {
+
+/// @returns @c addresses as 16-bit entry points for a disassembler.
+std::vector<uint16_t> entry_points(const std::vector<uint32_t> &addresses) {
+	std::vector<uint16_t> result;
+	result.reserve(addresses.size());
+	for(const auto address: addresses) {
+		result.push_back(uint16_t(address));
+	}
+	return result;
+}
+
+/// @returns The result of applying @c format to each instruction of @c disassembly found at one of @c addresses.
+template <typename DisassemblyT, typename InstructionT>
+std::map<uint32_t, std::string> descriptions(const DisassemblyT &disassembly, const std::vector<uint32_t> &addresses, std::string (*format)(const InstructionT &)) {
+	std::map<uint32_t, std::string> result;
+	for(const auto address: addresses) {
+		const auto instruction = disassembly.instructions_by_address.find(uint16_t(address));
+		if(instruction != disassembly.instructions_by_address.end()) {
+			result[address] = format(instruction->second);
+		}
+	}
+	return result;
+}
+
+}
+
+Profiler::Profiler(CPU::TraceRing::Source source) : source_(source) {}
+
+void Profiler::sample(const CPU::TraceRing &ring) {
+	const uint64_t end = ring.count();
+	const auto records = ring.records(next_index_);
+
+	// If any records have been lost since the last sample, the previous instruction's duration is unknown.
+	if(end - records.size() != next_index_) {
+		has_previous_ = false;
+	}
+	next_index_ = end;
+
+	for(const auto &record: records) {
+		if(record.source != source_) continue;
+
+		if(has_previous_) {
+			auto &entry = entries_[previous_.program_counter];
+			const uint64_t cycles = record.time - previous_.time;
+			entry.address = previous_.program_counter;
+			entry.opcode = previous_.opcode;
+			entry.cycles += cycles;
+			++entry.instructions;
+			total_cycles_ += cycles;
+		}
+		previous_ = record;
+		has_previous_ = true;
+	}
+}
+
+void Profiler::clear() {
+	entries_.clear();
+	total_cycles_ = 0;
+	has_previous_ = false;
+}
+
+void Profiler::add_symbol(const std::string &name, uint32_t start, uint32_t end) {
+	symbols_.push_back(Symbol{name, start, end});
+}
+
+const Profiler::Symbol *Profiler::symbol_for(uint32_t address) const {
+	// The most recently added of any overlapping symbols wins.
+	for(auto symbol = symbols_.rbegin(); symbol != symbols_.rend(); ++symbol) {
+		if(address >= symbol->start && address < symbol->end) return &*symbol;
+	}
+	return nullptr;
+}
+
+std::vector<Profiler::Entry> Profiler::entries() const {
+	std::vector<Entry> result;
+	result.reserve(entries_.size());
+	for(const auto &entry: entries_) {
+		result.push_back(entry.second);
+	}
+	std::sort(result.begin(), result.end(), [] (const Entry &lhs, const Entry &rhs) {
+		return (lhs.cycles != rhs.cycles) ? lhs.cycles > rhs.cycles : lhs.address < rhs.address;
+	});
+	return result;
+}
+
+void Profiler::print(std::ostream &stream, const Disassembler &disassembler, std::size_t limit) const {
+	const auto sorted_entries = entries();
+	const double total = double(std::max(total_cycles_, uint64_t(1)));
+	char line[128];
+
+	std::snprintf(line, sizeof(line), "%llu cycles sampled over %zu addresses\n", static_cast<unsigned long long>(total_cycles_), sorted_entries.size());
+	stream << line;
+	stream << "     %       cycles  instructions  address  opcode  symbol\n";
+
+	std::map<uint32_t, std::string> disassembly;
+	if(disassembler) {
+		std::vector<uint32_t> addresses;
+		for(std::size_t index = 0; index < std::min(limit, sorted_entries.size()); ++index) {
+			addresses.push_back(sorted_entries[index].address);
+		}
+		disassembly = disassembler(addresses);
+	}
+
+	std::map<const Symbol *, uint64_t> symbol_cycles;
+	for(std::size_t index = 0; index < sorted_entries.size(); ++index) {
+		const auto &entry = sorted_entries[index];
+		const Symbol *const symbol = symbol_for(entry.address);
+		symbol_cycles[symbol] += entry.cycles;
+		if(index >= limit) continue;
+
+		std::snprintf(line, sizeof(line), "%6.2f %12llu  %12llu  %07X  %04X    ",
+			100.0 * double(entry.cycles) / total,
+			static_cast<unsigned long long>(entry.cycles),
+			static_cast<unsigned long long>(entry.instructions),
+			entry.address,
+			entry.opcode);
+		stream << line;
+
+		if(symbol) {
+			std::snprintf(line, sizeof(line), "%s+%X", symbol->name.c_str(), entry.address - symbol->start);
+			stream << line;
+		}
+		const auto description = disassembly.find(entry.address);
+		if(description != disassembly.end()) {
+			stream << (symbol ? "\t" : "") << description->second;
+		}
+		stream << "\n";
+	}
+
+	if(symbols_.empty()) return;
+	stream << "\n     %       cycles  symbol\n";
+	std::vector<std::pair<const Symbol *, uint64_t>> sorted_symbols(symbol_cycles.begin(), symbol_cycles.end());
+	std::sort(sorted_symbols.begin(), sorted_symbols.end(), [] (const auto &lhs, const auto &rhs) {
+		return lhs.second > rhs.second;
+	});
+	for(const auto &symbol: sorted_symbols) {
+		std::snprintf(line, sizeof(line), "%6.2f %12llu  %s\n",
+			100.0 * double(symbol.second) / total,
+			static_cast<unsigned long long>(symbol.second),
+			symbol.first ? symbol.first->name.c_str() : "(other)");
+		stream << line;
+	}
+}
+
+Profiler::Disassembler Profiler::MOS6502Disassembler(const std::vector<uint8_t> &memory) {
+	return [memory] (const std::vector<uint32_t> &addresses) {
+		const auto disassembly = Analyser::Static::MOS6502::Disassemble(memory, Analyser::Static::Disassembler::OffsetMapper<uint16_t>(0), entry_points(addresses));
+		return descriptions(disassembly, addresses, Analyser::Static::MOS6502::Format);
+	};
+}
+
+Profiler::Disassembler Profiler::Z80Disassembler(const std::vector<uint8_t> &memory) {
+	return [memory] (const std::vector<uint32_t> &addresses) {
+		const auto disassembly = Analyser::Static::Z80::Disassemble(memory, Analyser::Static::Disassembler::OffsetMapper<uint16_t>(0), entry_points(addresses));
+		return descriptions(disassembly, addresses, Analyser::Static::Z80::Format);
+	};
+}
@@ -0,0 +1,97 @@
+//
+//  Profiler.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Profiler_hpp
+#define Profiler_hpp
+
+#include "../../Processors/TraceRing.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Analyser {
+namespace Dynamic {
+
+/*!
+	Accumulates the cycles spent executing each guest instruction address, by sampling the
+	records that processors add to a CPU::TraceRing, and produces a flat profile from them.
+
+	Each instruction is charged the time between its record and the next; so records must come
+	from only a single processor. If the ring has wrapped between samples, the records lost are
+	simply not counted.
+*/
+class Profiler {
+	public:
+		/// Creates a profiler that considers only records from processors of type @c source.
+		Profiler(CPU::TraceRing::Source source);
+
+		/*!
+			Adds all records that have been added to @c ring since the previous sample, and
+			which are still retained, to the profile.
+		*/
+		void sample(const CPU::TraceRing &ring);
+
+		/// Discards the profile so far.
+		void clear();
+
+		/// Names the range of addresses [@c start, @c end) as @c name, for the purposes of reporting.
+		void add_symbol(const std::string &name, uint32_t start, uint32_t end);
+
+		struct Entry {
+			uint32_t address = 0;
+			uint64_t cycles = 0;
+			uint64_t instructions = 0;
+			uint16_t opcode = 0;
+		};
+
+		/// @returns All addresses sampled, in descending order of cycles spent.
+		std::vector<Entry> entries() const;
+
+		/// Provides textual descriptions, e.g. disassemblies, of the instructions at each of a set of addresses.
+		using Disassembler = std::function<std::map<uint32_t, std::string>(const std::vector<uint32_t> &addresses)>;
+
+		/*!
+			Writes a flat profile of the @c limit most expensive addresses to @c stream, annotated
+			with the symbols that contain them and, if supplied, the output of @c disassembler, which
+			is called once for all addresses printed; then the total cycles spent in each symbol.
+		*/
+		void print(std::ostream &stream, const Disassembler &disassembler = nullptr, std::size_t limit = 50) const;
+
+		/// @returns A Disassembler for 6502 code, based on the contents of @c memory, which is a copy of the 6502's address space.
+		static Disassembler MOS6502Disassembler(const std::vector<uint8_t> &memory);
+
+		/// @returns A Disassembler for Z80 code, based on the contents of @c memory, which is a copy of the Z80's address space.
+		static Disassembler Z80Disassembler(const std::vector<uint8_t> &memory);
+
+	private:
+		const CPU::TraceRing::Source source_;
+
+		std::unordered_map<uint32_t, Entry> entries_;
+		uint64_t total_cycles_ = 0;
+
+		uint64_t next_index_ = 0;
+		bool has_previous_ = false;
+		CPU::TraceRing::Record previous_;
+
+		struct Symbol {
+			std::string name;
+			uint32_t start, end;
+		};
+		std::vector<Symbol> symbols_;
+		const Symbol *symbol_for(uint32_t address) const;
+};
+
+}
+}
+
+#endif /* Profiler_hpp */
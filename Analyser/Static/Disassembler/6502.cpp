@@ -10,6 +10,8 @@
 
 #include "Kernel.hpp"
 
+#include <cstdio>
+
 using namespace Analyser::Static::MOS6502;
 namespace  {
 
@@ -318,3 +320,51 @@ Disassembly Analyser::Static::MOS6502::Disassemble(
 	std::vector<uint16_t> entry_points) {
 	return Analyser::Static::Disassembly::Disassemble<Disassembly, uint16_t, MOS6502Disassembler>(memory, address_mapper, entry_points);
 }
+
+std::string Analyser::Static::MOS6502::Format(const Instruction &instruction) {
+	// These are in the same order as Instruction's operations.
+	static constexpr const char *mnemonics[] = {
+		"BRK", "JSR", "RTI", "RTS", "JMP",
+		"CLC", "SEC", "CLD", "SED", "CLI", "SEI", "CLV",
+		"NOP",
+
+		"SLO", "RLA", "SRE", "RRA", "ALR", "ARR",
+		"SAX", "LAX", "DCP", "ISC",
+		"ANC", "XAA", "AXS",
+		"AND", "EOR", "ORA", "BIT",
+		"ADC", "SBC",
+		"AHX", "SHY", "SHX", "TAS", "LAS",
+
+		"LDA", "STA", "LDX", "STX", "LDY", "STY",
+
+		"BPL", "BMI", "BVC", "BVS", "BCC", "BCS", "BNE", "BEQ",
+
+		"CMP", "CPX", "CPY",
+		"INC", "DEC", "DEX", "DEY", "INX", "INY",
+		"ASL", "ROL", "LSR", "ROR",
+		"TAX", "TXA", "TAY", "TYA", "TSX", "TXS",
+		"PLA", "PHA", "PLP", "PHP",
+
+		"KIL"
+	};
+
+	char operand[16] = "";
+	switch(instruction.addressing_mode) {
+		case Instruction::Implied:											break;
+		case Instruction::Absolute:			std::snprintf(operand, sizeof(operand), " $%04X", instruction.operand);		break;
+		case Instruction::AbsoluteX:		std::snprintf(operand, sizeof(operand), " $%04X,X", instruction.operand);	break;
+		case Instruction::AbsoluteY:		std::snprintf(operand, sizeof(operand), " $%04X,Y", instruction.operand);	break;
+		case Instruction::Immediate:		std::snprintf(operand, sizeof(operand), " #$%02X", instruction.operand);		break;
+		case Instruction::ZeroPage:			std::snprintf(operand, sizeof(operand), " $%02X", instruction.operand);		break;
+		case Instruction::ZeroPageX:		std::snprintf(operand, sizeof(operand), " $%02X,X", instruction.operand);	break;
+		case Instruction::ZeroPageY:		std::snprintf(operand, sizeof(operand), " $%02X,Y", instruction.operand);	break;
+		case Instruction::Indirect:			std::snprintf(operand, sizeof(operand), " ($%04X)", instruction.operand);	break;
+		case Instruction::IndexedIndirectX:	std::snprintf(operand, sizeof(operand), " ($%02X,X)", instruction.operand);	break;
+		case Instruction::IndirectIndexedY:	std::snprintf(operand, sizeof(operand), " ($%02X),Y", instruction.operand);	break;
+		case Instruction::Relative:
+			std::snprintf(operand, sizeof(operand), " $%04X", uint16_t(instruction.address + 2 + int8_t(instruction.operand)));
+		break;
+	}
+
+	return std::string(mnemonics[instruction.operation]) + operand;
+}
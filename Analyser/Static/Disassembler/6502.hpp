@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
 namespace Analyser {
@@ -94,6 +95,11 @@ Disassembly Disassemble(
 	const std::function<std::size_t(uint16_t)> &address_mapper,
 	std::vector<uint16_t> entry_points);
 
+/*!
+	@returns @c instruction in conventional assembler syntax, e.g. "LDA ($12),Y".
+*/
+std::string Format(const Instruction &instruction);
+
 }
 }
 }
@@ -10,6 +10,8 @@
 
 #include "Kernel.hpp"
 
+#include <cstdio>
+
 using namespace Analyser::Static::Z80;
 namespace  {
 
@@ -162,7 +164,7 @@ void DisassembleEDPage(Accessor &accessor, Instruction &instruction, bool needs_
 				instruction.operation = Instruction::Operation::Invalid;
 			}
 		break;
-		case 3:
+		case 1:
 			switch(z(operation)) {
 				case 0:
 					instruction.operation = Instruction::Operation::IN;
@@ -617,3 +619,130 @@ Disassembly Analyser::Static::Z80::Disassemble(
 	std::vector<uint16_t> entry_points) {
 	return Analyser::Static::Disassembly::Disassemble<Disassembly, uint16_t, Z80Disassembler>(memory, address_mapper, entry_points);
 }
+
+namespace {
+
+std::string hex(int value, int digits) {
+	char buffer[8];
+	std::snprintf(buffer, sizeof(buffer), "$%0*X", digits, value & ((1 << (digits * 4)) - 1));
+	return buffer;
+}
+
+std::string offset(const char *index, int offset) {
+	char buffer[16];
+	std::snprintf(buffer, sizeof(buffer), "(%s%c$%02X)", index, (offset < 0) ? '-' : '+', (offset < 0) ? -offset : offset);
+	return buffer;
+}
+
+// Both indirect offsets and relative displacements are stored biased by -128.
+std::string location(const Instruction &instruction, Instruction::Location location) {
+	using Location = Instruction::Location;
+	switch(location) {
+		case Location::B:					return "B";
+		case Location::C:					return "C";
+		case Location::D:					return "D";
+		case Location::E:					return "E";
+		case Location::H:					return "H";
+		case Location::L:					return "L";
+		case Location::HL_Indirect:			return "(HL)";
+		case Location::A:					return "A";
+		case Location::I:					return "I";
+		case Location::R:					return "R";
+		case Location::BC:					return "BC";
+		case Location::DE:					return "DE";
+		case Location::HL:					return "HL";
+		case Location::SP:					return "SP";
+		case Location::AF:					return "AF";
+		case Location::Operand:				return hex(instruction.operand, (instruction.operand > 0xff) ? 4 : 2);
+		case Location::IX_Indirect_Offset:	return offset("IX", int8_t(instruction.offset + 128));
+		case Location::IY_Indirect_Offset:	return offset("IY", int8_t(instruction.offset + 128));
+		case Location::IXh:					return "IXh";
+		case Location::IXl:					return "IXl";
+		case Location::IYh:					return "IYh";
+		case Location::IYl:					return "IYl";
+		case Location::Operand_Indirect:	return "(" + hex(instruction.operand, (instruction.operand > 0xff) ? 4 : 2) + ")";
+		case Location::BC_Indirect:			return "(BC)";
+		case Location::DE_Indirect:			return "(DE)";
+		case Location::SP_Indirect:			return "(SP)";
+		default:							return "";
+	}
+}
+
+}
+
+std::string Analyser::Static::Z80::Format(const Instruction &instruction) {
+	// These are in the same order as Instruction::Operation and Instruction::Condition.
+	static constexpr const char *mnemonics[] = {
+		"NOP",
+		"EX AF, AF'", "EXX", "EX",
+		"LD", "HALT",
+		"ADD", "ADC", "SUB", "SBC", "AND", "XOR", "OR", "CP",
+		"INC", "DEC",
+		"RLCA", "RRCA", "RLA", "RRA", "DAA", "CPL", "SCF", "CCF",
+		"RLD", "RRD",
+		"DJNZ", "JR", "JP", "CALL", "RST", "RET", "RETI", "RETN",
+		"PUSH", "POP",
+		"IN", "OUT",
+		"EI", "DI",
+		"RLC", "RRC", "RL", "RR", "SLA", "SRA", "SLL", "SRL",
+		"BIT", "RES", "SET",
+		"LDI", "CPI", "INI", "OUTI",
+		"LDD", "CPD", "IND", "OUTD",
+		"LDIR", "CPIR", "INIR", "OTIR",
+		"LDDR", "CPDR", "INDR", "OTDR",
+		"NEG",
+		"IM",
+		"???"
+	};
+	static constexpr const char *conditions[] = {
+		"", "NZ", "Z", "NC", "C", "PO", "PE", "P", "M"
+	};
+
+	std::vector<std::string> operands;
+	if(instruction.condition != Instruction::Condition::None) {
+		operands.push_back(conditions[int(instruction.condition)]);
+	}
+
+	switch(instruction.operation) {
+		case Instruction::Operation::JR:
+		case Instruction::Operation::DJNZ:
+			operands.push_back(hex(instruction.address + 2 + int8_t(instruction.operand + 128), 4));
+		break;
+
+		case Instruction::Operation::JP:
+		case Instruction::Operation::CALL:
+			operands.push_back(
+				(instruction.source == Instruction::Location::HL) ? "(HL)" : hex(instruction.operand, 4)
+			);
+		break;
+
+		case Instruction::Operation::BIT:
+		case Instruction::Operation::RES:
+		case Instruction::Operation::SET:
+		case Instruction::Operation::IM:
+			operands.push_back(std::to_string(instruction.operand));
+			if(instruction.destination != Instruction::Location::None) {
+				operands.push_back(location(instruction, instruction.destination));
+			}
+		break;
+
+		default:
+			if(instruction.destination != Instruction::Location::None) {
+				operands.push_back(location(instruction, instruction.destination));
+			}
+			// Operations such as INC and RLC name their single operand as both source and destination.
+			if(
+				instruction.source != Instruction::Location::None &&
+				(instruction.source != instruction.destination || instruction.operation == Instruction::Operation::LD)
+			) {
+				operands.push_back(location(instruction, instruction.source));
+			}
+		break;
+	}
+
+	std::string result = mnemonics[int(instruction.operation)];
+	for(std::size_t c = 0; c < operands.size(); ++c) {
+		result += (c ? ", " : " ") + operands[c];
+	}
+	return result;
+}
@@ -13,6 +13,7 @@
 #include <functional>
 #include <map>
 #include <set>
+#include <string>
 #include <vector>
 
 namespace Analyser {
@@ -83,6 +84,11 @@ Disassembly Disassemble(
 	const std::function<std::size_t(uint16_t)> &address_mapper,
 	std::vector<uint16_t> entry_points);
 
+/*!
+	@returns @c instruction in conventional assembler syntax, e.g. "LD (IX+5), A".
+*/
+std::string Format(const Instruction &instruction);
+
 }
 }
 }
@@ -9,13 +9,21 @@
 #ifndef DeferredQueue_h
 #define DeferredQueue_h
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <vector>
 
+#include "../Concurrency/Task.hpp"
+
 /*!
 	A DeferredQueue maintains a list of ordered actions and the times at which
 	they should happen, and divides a total execution period up into the portions
 	that occur between those actions, triggering each action when it is reached.
+
+	Pending actions are kept in a min-heap ordered by the time at which they fall due,
+	and stored as Concurrency::Tasks, so neither scheduling nor performing an action
+	allocates once the queue has reached its working size.
 */
 template <typename TimeUnit> class DeferredQueue {
 	public:
@@ -25,11 +33,12 @@ template <typename TimeUnit> class DeferredQueue {
 		/*!
 			Schedules @c action to occur in @c delay units of time.
 
-			Actions must be scheduled in the order they will occur. It is undefined behaviour
-			to schedule them out of order.
+			Actions scheduled for the same time will occur in the order they were scheduled.
 		*/
-		void defer(TimeUnit delay, const std::function<void(void)> &action) {
-			pending_actions_.emplace_back(delay, action);
+		void defer(TimeUnit delay, Concurrency::Task action) {
+			pending_actions_.emplace_back(time_ + delay, next_sequence_number_, std::move(action));
+			++next_sequence_number_;
+			std::push_heap(pending_actions_.begin(), pending_actions_.end(), &DeferredAction::is_later);
 		}
 
 		/*!
@@ -48,33 +57,53 @@ template <typename TimeUnit> class DeferredQueue {
 
 			// Divide the time to run according to the pending actions.
 			while(length > TimeUnit(0)) {
-				TimeUnit next_period = pending_actions_.empty() ? length : std::min(length, pending_actions_[0].delay);
+				if(pending_actions_.empty()) {
+					target_(length);
+					break;
+				}
+
+				const TimeUnit next_period = std::min(length, pending_actions_.front().time - time_);
 				target_(next_period);
 				length -= next_period;
+				time_ += next_period;
 
-				off_t performances = 0;
-				for(auto &action: pending_actions_) {
-					action.delay -= next_period;
-					if(!action.delay) {
-						action.action();
-						++performances;
-					}
-				}
-				if(performances) {
-					pending_actions_.erase(pending_actions_.begin(), pending_actions_.begin() + performances);
+				// Perform everything that is now due. Each action is removed from the heap before
+				// being performed, in case it schedules further actions.
+				while(!pending_actions_.empty() && pending_actions_.front().time == time_) {
+					std::pop_heap(pending_actions_.begin(), pending_actions_.end(), &DeferredAction::is_later);
+					Concurrency::Task action = std::move(pending_actions_.back().action);
+					pending_actions_.pop_back();
+					action();
 				}
 			}
+
+			// Times are relative to the moment the queue last became empty, so as not to grow without bound.
+			if(pending_actions_.empty()) {
+				time_ = TimeUnit(0);
+				next_sequence_number_ = 0;
+			}
 		}
 
 	private:
 		std::function<void(TimeUnit)> target_;
 
-		// The list of deferred actions.
+		// The current time, relative to the last time at which there were no pending actions.
+		TimeUnit time_ = TimeUnit(0);
+		uint64_t next_sequence_number_ = 0;
+
+		// The heap of deferred actions.
 		struct DeferredAction {
-			TimeUnit delay;
-			std::function<void(void)> action;
+			TimeUnit time;
+			uint64_t sequence_number;
+			Concurrency::Task action;
 
-			DeferredAction(TimeUnit delay, const std::function<void(void)> &action) : delay(delay), action(std::move(action)) {}
+			DeferredAction(TimeUnit time, uint64_t sequence_number, Concurrency::Task &&action) :
+				time(time), sequence_number(sequence_number), action(std::move(action)) {}
+
+			static bool is_later(const DeferredAction &lhs, const DeferredAction &rhs) {
+				if(lhs.time != rhs.time) return lhs.time > rhs.time;
+				return lhs.sequence_number > rhs.sequence_number;
+			}
 		};
 		std::vector<DeferredAction> pending_actions_;
 };
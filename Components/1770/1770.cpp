@@ -20,6 +20,7 @@ WD1770::WD1770(Personality p) :
 		personality_(p),
 		interesting_event_mask_(int(Event1770::Command)) {
 	set_is_double_density(false);
+	set_needs_flux_events(false);
 	posit_event(int(Event1770::Command));
 }
 
@@ -813,7 +814,11 @@ void WD1770::update_status(std::function<void(Status &)> updater) {
 		if(did_change) delegate_->wd1770_did_change_output(this);
 	} else updater(status_);
 
-	if(status_.busy != old_status.busy) update_clocking_observer();
+	if(status_.busy != old_status.busy) {
+		// The bit stream is of interest only while a command is being performed.
+		set_needs_flux_events(status_.busy);
+		update_clocking_observer();
+	}
 }
 
 void WD1770::set_head_load_request(bool head_load) {}
@@ -832,3 +837,37 @@ ClockingHint::Preference WD1770::preferred_clocking() {
 	if(status_.busy) return ClockingHint::Preference::RealTime;
 	return Storage::Disk::MFMController::preferred_clocking();
 }
+
+// MARK: - Snapshots
+
+void WD1770::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("1770", 1);
+	MFMController::save_state(writer);
+	writer.put(
+		status_, track_, sector_, data_, command_,
+		index_hole_count_, index_hole_count_target_, distance_into_section_, step_direction_,
+		interesting_event_mask_, resume_point_, delay_time_,
+		header_, head_is_loaded_
+	);
+	writer.end();
+}
+
+bool WD1770::restore_state(Storage::Snapshot::Reader &reader) {
+	if(
+		!reader.begin("1770", 1) ||
+		!MFMController::restore_state(reader) ||
+		!reader.get(
+			status_, track_, sector_, data_, command_,
+			index_hole_count_, index_hole_count_target_, distance_into_section_, step_direction_,
+			interesting_event_mask_, resume_point_, delay_time_,
+			header_, head_is_loaded_
+		)
+	) {
+		return false;
+	}
+
+	if(delegate_) delegate_->wd1770_did_change_output(this);
+	set_needs_flux_events(status_.busy);
+	update_clocking_observer();
+	return reader.end();
+}
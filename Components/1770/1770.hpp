@@ -75,6 +75,15 @@ class WD1770: public Storage::Disk::MFMController {
 
 		ClockingHint::Preference preferred_clocking() final;
 
+		/*!
+			Appends the controller's state to @c writer. Attached drives are not included;
+			they should be saved by their owner.
+		*/
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	protected:
 		virtual void set_head_load_request(bool head_load);
 		virtual void set_motor_on(bool motor_on);
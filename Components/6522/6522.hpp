@@ -16,6 +16,7 @@
 #include "Implementation/6522Storage.hpp"
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Storage/Snapshot.hpp"
 
 namespace MOS {
 namespace MOS6522 {
@@ -114,9 +115,23 @@ template <class T> class MOS6522: public MOS6522Storage {
 		/// @returns @c true if the IRQ line is currently active; @c false otherwise.
 		bool get_interrupt_line();
 
+		/*!
+			@returns The number of half cycles until a timer next expires, which may change the IRQ line and PB7,
+			if there are no interceding calls to @c write, @c read or @c set_control_line_input; or a negative
+			value if neither timer is running. Returns zero if the shift register is enabled or either port is
+			in pulse output mode, as timing of those isn't predicted.
+		*/
+		HalfCycles get_next_sequence_point() const;
+
 		/// Updates the port handler to the current time and then requests that it flush.
 		void flush();
 
+		/// Appends the 6522's state to @c writer.
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/// Restores state captured by @c save_state; @returns @c true on success, @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	private:
 		void do_phase1();
 		void do_phase2();
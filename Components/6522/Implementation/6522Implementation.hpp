@@ -388,6 +388,37 @@ template <typename T> bool MOS6522<T>::get_interrupt_line() {
 	return !!interrupt_status;
 }
 
+template <typename T> HalfCycles MOS6522<T>::get_next_sequence_point() const {
+	if(
+		shift_mode() != ShiftMode::Disabled ||
+		handshake_modes_[0] == HandshakeMode::Pulse ||
+		handshake_modes_[1] == HandshakeMode::Pulse
+	) return HalfCycles(0);
+
+	HalfCycles result(-1);
+	for(int timer = 0; timer < 2; ++timer) {
+		if(!timer_is_running_[timer]) continue;
+
+		// A timer that underflowed upon the last phase 2 expires upon the next phase 1.
+		if(!is_phase2_ && registers_.timer[timer] == 0xffff && !registers_.last_timer[timer]) {
+			return HalfCycles(1);
+		}
+
+		// Otherwise count the phase 2s until the timer underflows, allowing for any reload or
+		// write that will apply at the next; it then expires upon the phase 1 that follows.
+		int phase2s = registers_.timer[timer] + 1;
+		if(registers_.next_timer[timer] >= 0) {
+			phase2s = registers_.next_timer[timer] + 2;
+		} else if(!timer && registers_.timer_needs_reload) {
+			phase2s = registers_.timer_latch[0] + 2;
+		}
+
+		const HalfCycles time(phase2s * 2 + (is_phase2_ ? 0 : 1));
+		if(result < HalfCycles(0) || time < result) result = time;
+	}
+	return result;
+}
+
 template <typename T> void MOS6522<T>::evaluate_cb2_output() {
 	// CB2 is a special case, being both the line the shift register can output to,
 	// and one that can be used as an input or handshaking output according to the
@@ -452,5 +483,33 @@ template <typename T> void MOS6522<T>::shift_out() {
 	}
 }
 
+// MARK: - Snapshots
+
+template <typename T> void MOS6522<T>::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("6522", 1);
+	writer.put(is_phase2_, time_since_bus_handler_call_);
+	writer.put(
+		registers_.output, registers_.input, registers_.data_direction,
+		registers_.timer, registers_.timer_latch, registers_.last_timer, registers_.next_timer,
+		registers_.shift, registers_.auxiliary_control, registers_.peripheral_control,
+		registers_.interrupt_flags, registers_.interrupt_enable, registers_.timer_needs_reload);
+	writer.put(control_inputs_, control_outputs_, handshake_modes_);
+	writer.put(timer_is_running_, last_posted_interrupt_status_, shift_bits_remaining_);
+	writer.end();
+}
+
+template <typename T> bool MOS6522<T>::restore_state(Storage::Snapshot::Reader &reader) {
+	if(!reader.begin("6522", 1)) return false;
+	reader.get(is_phase2_, time_since_bus_handler_call_);
+	reader.get(
+		registers_.output, registers_.input, registers_.data_direction,
+		registers_.timer, registers_.timer_latch, registers_.last_timer, registers_.next_timer,
+		registers_.shift, registers_.auxiliary_control, registers_.peripheral_control,
+		registers_.interrupt_flags, registers_.interrupt_enable, registers_.timer_needs_reload);
+	reader.get(control_inputs_, control_outputs_, handshake_modes_);
+	reader.get(timer_is_running_, last_posted_interrupt_status_, shift_bits_remaining_);
+	return reader.end();
+}
+
 }
 }
@@ -13,6 +13,7 @@
 #include <cstdio>
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Numeric/Random.hpp"
 
 namespace MOS {
 
@@ -122,7 +123,7 @@ template <class T> class MOS6532 {
 		}
 
 		MOS6532() {
-			timer_.value = static_cast<unsigned int>((rand() & 0xff) << 10);
+			timer_.value = static_cast<unsigned int>((Numeric::random() & 0xff) << 10);
 		}
 
 		inline void set_port_did_change(int port) {
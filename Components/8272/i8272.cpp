@@ -79,6 +79,7 @@ namespace {
 i8272::i8272(BusHandler &bus_handler, Cycles clock_rate) :
 	Storage::Disk::MFMController(clock_rate),
 	bus_handler_(bus_handler) {
+	set_needs_flux_events(false);
 	posit_event(static_cast<int>(Event8272::CommandByte));
 }
 
@@ -339,6 +340,7 @@ void i8272::posit_event(int event_type) {
 				// Establishes the drive and head being addressed, and whether in double density mode; populates the internal
 				// cylinder, head, sector and size registers from the command stream.
 				is_executing_ = true;
+				set_needs_flux_events(true);
 				if(!dma_mode_) SetNonDMAExecution();
 				SET_DRIVE_HEAD_MFM();
 				LOAD_HEAD();
@@ -861,6 +863,7 @@ void i8272::posit_event(int event_type) {
 
 			// Set ready to send data to the processor, no longer in non-DMA execution phase.
 			is_executing_ = false;
+			set_needs_flux_events(false);
 			ResetNonDMAExecution();
 			SetDataRequest();
 			SetDataDirectionToProcessor();
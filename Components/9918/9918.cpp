@@ -11,6 +11,7 @@
 #include <cassert>
 #include <cstring>
 #include <cstdlib>
+#include "../../Numeric/Random.hpp"
 #include "../../Outputs/Log.hpp"
 
 using namespace TI::TMS;
@@ -79,8 +80,8 @@ Base::Base(Personality p) :
 
 	// Establish that output is delayed after reading by `output_lag` cycles; start
 	// at a random position.
-	read_pointer_.row = rand() % 262;
-	read_pointer_.column = rand() % (342 - output_lag);
+	read_pointer_.row = Numeric::random() % 262;
+	read_pointer_.column = Numeric::random() % (342 - output_lag);
 	write_pointer_.row = read_pointer_.row;
 	write_pointer_.column = read_pointer_.column + output_lag;
 }
@@ -1042,3 +1043,61 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 		}
 	}
 }
+
+// MARK: - Snapshots
+
+void TMS9918::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("9918", 1);
+
+	writer.put_vector(ram_);
+	writer.put(tv_standard_, ram_pointer_, read_ahead_buffer_, queued_access_, cycles_until_access_, minimum_access_column_);
+	writer.put(status_, write_phase_, low_write_);
+	writer.put(mode1_enable_, mode2_enable_, mode3_enable_, blank_display_, sprites_16x16_, sprites_magnified_, generate_interrupts_, sprite_height_);
+	writer.put(pattern_name_address_, colour_table_address_, pattern_generator_table_address_, sprite_attribute_table_address_, sprite_generator_table_address_);
+	writer.put(text_colour_, background_colour_, cycles_error_, latched_column_);
+	writer.put(mode_timing_, line_interrupt_target, line_interrupt_counter, enable_line_interrupts_, line_interrupt_pending_);
+	writer.put(screen_mode_, read_pointer_, write_pointer_, master_system_);
+	writer.put_vector(upcoming_cram_dots_);
+
+	// Only those line buffers between the output position and the line for which sprites
+	// are being collected are in use.
+	const int total_lines = mode_timing_.total_lines;
+	const int line_count = (write_pointer_.row + 1 - read_pointer_.row + total_lines) % total_lines + 1;
+	writer.put(line_count);
+	for(int c = 0; c < line_count; ++c) {
+		writer.put(line_buffers_[(read_pointer_.row + c) % total_lines]);
+	}
+
+	writer.end();
+}
+
+bool TMS9918::restore_state(Storage::Snapshot::Reader &reader) {
+	if(!reader.begin("9918", 1)) return false;
+
+	const std::size_t ram_size = ram_.size();
+	if(!reader.get_vector(ram_, ram_size) || ram_.size() != ram_size) return false;
+	reader.get(tv_standard_, ram_pointer_, read_ahead_buffer_, queued_access_, cycles_until_access_, minimum_access_column_);
+	reader.get(status_, write_phase_, low_write_);
+	reader.get(mode1_enable_, mode2_enable_, mode3_enable_, blank_display_, sprites_16x16_, sprites_magnified_, generate_interrupts_, sprite_height_);
+	reader.get(pattern_name_address_, colour_table_address_, pattern_generator_table_address_, sprite_attribute_table_address_, sprite_generator_table_address_);
+	reader.get(text_colour_, background_colour_, cycles_error_, latched_column_);
+	reader.get(mode_timing_, line_interrupt_target, line_interrupt_counter, enable_line_interrupts_, line_interrupt_pending_);
+	reader.get(screen_mode_, read_pointer_, write_pointer_, master_system_);
+	reader.get_vector(upcoming_cram_dots_);
+
+	const int total_lines = mode_timing_.total_lines;
+	int line_count;
+	if(
+		!reader.get(line_count) ||
+		total_lines <= 0 || total_lines > int(std::size(line_buffers_)) ||
+		line_count < 0 || line_count > total_lines ||
+		read_pointer_.row < 0 || read_pointer_.row >= total_lines
+	) {
+		return false;
+	}
+	for(int c = 0; c < line_count; ++c) {
+		reader.get(line_buffers_[(read_pointer_.row + c) % total_lines]);
+	}
+
+	return reader.end();
+}
@@ -11,6 +11,7 @@
 
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Storage/Snapshot.hpp"
 
 #include "Implementation/9918Base.hpp"
 
@@ -94,6 +95,12 @@ class TMS9918: public Base {
 			@returns @c true if the interrupt line is currently active; @c false otherwise.
 		*/
 		bool get_interrupt_line();
+
+		/// Appends the VDP's state, including its RAM, to @c writer.
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/// Restores state captured by @c save_state; @returns @c true on success, @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader);
 };
 
 }
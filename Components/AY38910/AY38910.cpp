@@ -355,3 +355,28 @@ void AY38910::update_bus() {
 		case Read:			data_output_ = get_register_value();	break;
 	}
 }
+
+// MARK: - Snapshots
+
+void AY38910::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("AY38", 1);
+	writer.put(selected_register_, registers_, output_registers_, master_divider_);
+	writer.put(tone_periods_, tone_counters_, tone_outputs_);
+	writer.put(noise_period_, noise_counter_, noise_shift_register_, noise_output_);
+	writer.put(envelope_period_, envelope_divider_, envelope_position_);
+	writer.put(control_state_, data_input_, data_output_);
+	writer.end();
+}
+
+bool AY38910::restore_state(Storage::Snapshot::Reader &reader) {
+	if(!reader.begin("AY38", 1)) return false;
+	reader.get(selected_register_, registers_, output_registers_, master_divider_);
+	reader.get(tone_periods_, tone_counters_, tone_outputs_);
+	reader.get(noise_period_, noise_counter_, noise_shift_register_, noise_output_);
+	reader.get(envelope_period_, envelope_divider_, envelope_position_);
+	reader.get(control_state_, data_input_, data_output_);
+
+	// Output volume depends on the volume range, which is a property of the host rather than of the AY.
+	evaluate_output_volume();
+	return reader.end();
+}
@@ -11,6 +11,7 @@
 
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../Storage/Snapshot.hpp"
 
 namespace GI {
 namespace AY38910 {
@@ -96,6 +97,18 @@ class AY38910: public ::Outputs::Speaker::SampleSource {
 		bool is_zero_level();
 		void set_sample_volume_range(std::int16_t range);
 
+		/*!
+			Appends the AY's state to @c writer. As some of that state belongs to the audio thread,
+			the caller should ensure that the task queue has been flushed.
+		*/
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/*!
+			Restores state captured by @c save_state, subject to the same caveat.
+			@returns @c true if state was restored; @c false otherwise.
+		*/
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	private:
 		Concurrency::DeferringAsyncTaskQueue &task_queue_;
 
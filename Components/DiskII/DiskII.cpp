@@ -65,12 +65,12 @@ void DiskII::set_control(Control control, bool on) {
 void DiskII::select_drive(int drive) {
 	if((drive&1) == active_drive_) return;
 
-	drives_[active_drive_].set_event_delegate(this);
-	drives_[active_drive_^1].set_event_delegate(nullptr);
-
 	drives_[active_drive_].set_motor_on(false);
 	active_drive_ = drive & 1;
 	drives_[active_drive_].set_motor_on(motor_is_enabled_);
+
+	drives_[active_drive_].set_event_delegate(this);
+	drives_[active_drive_^1].set_event_delegate(nullptr);
 }
 
 // The read pulse is controlled by a special IC that outputs a 1us pulse for every field reversal on the disk.
@@ -282,3 +282,40 @@ void DiskII::set_activity_observer(Activity::Observer *observer) {
 Storage::Disk::Drive &DiskII::get_drive(int index) {
 	return drives_[index];
 }
+
+// MARK: - Snapshots
+
+void DiskII::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("DSK2", 1);
+	writer.put(
+		state_, inputs_, shift_register_,
+		stepper_mask_, stepper_position_, motor_off_time_,
+		active_drive_, motor_is_enabled_,
+		data_input_, flux_duration_
+	);
+	drives_[0].save_state(writer);
+	drives_[1].save_state(writer);
+	writer.end();
+}
+
+bool DiskII::restore_state(Storage::Snapshot::Reader &reader) {
+	if(
+		!reader.begin("DSK2", 1) ||
+		!reader.get(
+			state_, inputs_, shift_register_,
+			stepper_mask_, stepper_position_, motor_off_time_,
+			active_drive_, motor_is_enabled_,
+			data_input_, flux_duration_
+		) ||
+		(active_drive_ & ~1) || (stepper_mask_ & ~0xf) || (stepper_position_ & ~7) ||
+		!drives_[0].restore_state(reader) ||
+		!drives_[1].restore_state(reader)
+	) {
+		return false;
+	}
+
+	drives_[active_drive_].set_event_delegate(this);
+	drives_[active_drive_^1].set_event_delegate(nullptr);
+	set_component_prefers_clocking(nullptr, ClockingHint::Preference::None);
+	return reader.end();
+}
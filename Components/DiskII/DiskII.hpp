@@ -85,6 +85,15 @@ class DiskII :
 		// *NOT FOR HARDWARE EMULATION USAGE*.
 		Storage::Disk::Drive &get_drive(int index);
 
+		/*!
+			Appends the controller's state and the mechanical state of both drives to @c writer.
+			The state machine ROM and the disks are not captured.
+		*/
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	private:
 		enum class Control {
 			P0, P1, P2, P3,
@@ -159,3 +159,20 @@ void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 
 	master_divider_ &= (master_divider_period_ - 1);
 }
+
+// MARK: - Snapshots
+
+void SN76489::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("7648", 1);
+	writer.put(master_divider_, channels_, noise_mode_, noise_shifter_, active_register_, shifter_is_16bit_);
+	writer.end();
+}
+
+bool SN76489::restore_state(Storage::Snapshot::Reader &reader) {
+	if(!reader.begin("7648", 1)) return false;
+	reader.get(master_divider_, channels_, noise_mode_, noise_shifter_, active_register_, shifter_is_16bit_);
+
+	// Output volume depends on the volume range, which is a property of the host rather than of the SN76489.
+	evaluate_output_volume();
+	return reader.end() && master_divider_ >= 0 && master_divider_ < master_divider_period_;
+}
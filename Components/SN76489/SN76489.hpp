@@ -11,6 +11,7 @@
 
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../Storage/Snapshot.hpp"
 
 namespace TI {
 
@@ -33,6 +34,18 @@ class SN76489: public Outputs::Speaker::SampleSource {
 		bool is_zero_level();
 		void set_sample_volume_range(std::int16_t range);
 
+		/*!
+			Appends the SN76489's state to @c writer. As that state belongs to the audio thread,
+			the caller should ensure that the task queue has been flushed.
+		*/
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/*!
+			Restores state captured by @c save_state, subject to the same caveat.
+			@returns @c true if state was restored; @c false otherwise.
+		*/
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	private:
 		int master_divider_ = 0;
 		int master_divider_period_ = 16;
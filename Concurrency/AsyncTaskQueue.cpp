@@ -8,38 +8,13 @@
 
 #include "AsyncTaskQueue.hpp"
 
+#include <thread>
+
 using namespace Concurrency;
 
-AsyncTaskQueue::AsyncTaskQueue()
-#ifndef __APPLE__
-	: should_destruct_(false)
-#endif
-{
+AsyncTaskQueue::AsyncTaskQueue() {
 #ifdef __APPLE__
 	serial_dispatch_queue_ = dispatch_queue_create("com.thomasharte.clocksignal.asyntaskqueue", DISPATCH_QUEUE_SERIAL);
-#else
-	thread_ = std::make_unique<std::thread>([this]() {
-		while(!should_destruct_) {
-			std::function<void(void)> next_function;
-
-			// Take lock, check for a new task
-			std::unique_lock<std::mutex> lock(queue_mutex_);
-			if(!pending_tasks_.empty()) {
-				next_function = pending_tasks_.front();
-				pending_tasks_.pop_front();
-			}
-
-			if(next_function) {
-				// If there is a task, release lock and perform it
-				lock.unlock();
-				next_function();
-			} else {
-				// If there isn't a task, atomically block on the processing condition and release the lock
-				// until there's something pending (and then release it again via scope)
-				processing_condition_.wait(lock);
-			}
-		}
-	});
 #endif
 }
 
@@ -49,20 +24,37 @@ AsyncTaskQueue::~AsyncTaskQueue() {
 	dispatch_release(serial_dispatch_queue_);
 	serial_dispatch_queue_ = nullptr;
 #else
-	should_destruct_ = true;
-	enqueue([](){});
-	thread_->join();
-	thread_.reset();
+	flush();
+
+	// If a flush performed the final tasks then the pool may still hold a submission of
+	// this queue, which it will discard; wait for that to happen.
+	while(outstanding_submissions_.load(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
 #endif
 }
 
-void AsyncTaskQueue::enqueue(std::function<void(void)> function) {
+void AsyncTaskQueue::enqueue(Task function) {
 #ifdef __APPLE__
-	dispatch_async(serial_dispatch_queue_, ^{function();});
+	dispatch_async_f(serial_dispatch_queue_, new Task(std::move(function)), [](void *context) {
+		Task *const task = static_cast<Task *>(context);
+		(*task)();
+		delete task;
+	});
 #else
-	std::lock_guard<std::mutex> lock(queue_mutex_);
-	pending_tasks_.push_back(function);
-	processing_condition_.notify_all();
+	bool should_submit = false;
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex_);
+		pending_tasks_.push_back(std::move(function));
+		++enqueued_tasks_;
+
+		if(state_ == State::Idle) {
+			state_ = State::Scheduled;
+			outstanding_submissions_.fetch_add(1, std::memory_order_relaxed);
+			should_submit = true;
+		}
+	}
+	if(should_submit) WorkerPool::shared().submit(this);
 #endif
 }
 
@@ -70,36 +62,112 @@ void AsyncTaskQueue::flush() {
 #ifdef __APPLE__
 	dispatch_sync(serial_dispatch_queue_, ^{});
 #else
-	auto flush_mutex = std::make_shared<std::mutex>();
-	auto flush_condition = std::make_shared<std::condition_variable>();
-	std::unique_lock<std::mutex> lock(*flush_mutex);
-	enqueue([=] () {
-		std::unique_lock<std::mutex> inner_lock(*flush_mutex);
-		flush_condition->notify_all();
-	});
-	flush_condition->wait(lock);
+	std::unique_lock<std::mutex> lock(queue_mutex_);
+	const uint64_t target = enqueued_tasks_;
+
+	while(true) {
+		switch(state_) {
+			case State::Idle:
+			return;
+
+			// If the queue isn't currently being acted upon by a worker, claim it and perform
+			// its tasks here; a worker that later finds the queue will discard it.
+			case State::Scheduled:
+				state_ = State::Running;
+				lock.unlock();
+				perform_tasks(target);
+			return;
+
+			// Otherwise wait for the worker to complete everything enqueued so far, but
+			// check periodically whether it has returned the queue to the pool.
+			case State::Running:
+				lock.unlock();
+				for(int spin = 0; spin < 1024; ++spin) {
+					if(completed_tasks_.load(std::memory_order_acquire) >= target) return;
+					if(spin >= 64) std::this_thread::yield();
+				}
+				lock.lock();
+			break;
+		}
+	}
 #endif
 }
 
-DeferringAsyncTaskQueue::~DeferringAsyncTaskQueue() {
-	perform();
-	flush();
+#ifndef __APPLE__
+
+void AsyncTaskQueue::run() {
+	bool should_perform = false;
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex_);
+		if(state_ == State::Scheduled) {
+			state_ = State::Running;
+			should_perform = true;
+		}
+	}
+
+	if(should_perform) perform_tasks(0);
+	outstanding_submissions_.fetch_sub(1, std::memory_order_release);
 }
 
-void DeferringAsyncTaskQueue::defer(std::function<void(void)> function) {
-	if(!deferred_tasks_) {
-		deferred_tasks_ = std::make_shared<std::list<std::function<void(void)>>>();
+void AsyncTaskQueue::perform_tasks(uint64_t target) {
+	// Perform batches of tasks until at least the target has been completed; then either
+	// return the queue to idle or, to be fair to other queues, resubmit it.
+	while(true) {
+		{
+			std::lock_guard<std::mutex> lock(queue_mutex_);
+			std::swap(pending_tasks_, performing_tasks_);
+		}
+
+		for(auto &task: performing_tasks_) {
+			task();
+			completed_tasks_.fetch_add(1, std::memory_order_release);
+		}
+		performing_tasks_.clear();
+
+		std::lock_guard<std::mutex> lock(queue_mutex_);
+		if(pending_tasks_.empty()) {
+			state_ = State::Idle;
+			return;
+		}
+
+		if(completed_tasks_.load(std::memory_order_relaxed) >= target) {
+			state_ = State::Scheduled;
+			outstanding_submissions_.fetch_add(1, std::memory_order_relaxed);
+			WorkerPool::shared().submit(this);
+			return;
+		}
 	}
-	deferred_tasks_->push_back(function);
+}
+
+#endif
+
+DeferringAsyncTaskQueue::~DeferringAsyncTaskQueue() {
+	perform();
+	flush();
 }
 
 void DeferringAsyncTaskQueue::perform() {
-	if(!deferred_tasks_) return;
-	std::shared_ptr<std::list<std::function<void(void)>>> deferred_tasks = deferred_tasks_;
-	deferred_tasks_.reset();
-	enqueue([deferred_tasks] {
-		for(const auto &function : *deferred_tasks) {
-			function();
+	if(deferred_tasks_.empty()) return;
+
+	enqueue([this, tasks = std::move(deferred_tasks_)] () mutable {
+		for(auto &task: tasks) {
+			task();
+		}
+		tasks.clear();
+
+		// Return the batch for reuse if there's space; otherwise it'll just be destroyed.
+		const uint32_t position = spare_batch_ring_.write_position();
+		if(spare_batch_ring_.advance()) {
+			spare_batches_[position] = std::move(tasks);
+			spare_batch_ring_.submit();
 		}
 	});
+
+	// Obtain a spare batch, if one is available.
+	deferred_tasks_.clear();
+	const uint32_t position = spare_batch_ring_.read_position();
+	if(position != spare_batch_ring_.submitted_position()) {
+		deferred_tasks_ = std::move(spare_batches_[position]);
+		spare_batch_ring_.set_read_position(position + 1);
+	}
 }
@@ -9,15 +9,22 @@
 #ifndef AsyncTaskQueue_hpp
 #define AsyncTaskQueue_hpp
 
+#include <array>
 #include <atomic>
-#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <memory>
-#include <thread>
+#include <mutex>
+#include <vector>
+
+#include "SPSCRing.hpp"
+#include "Task.hpp"
 
 #ifdef __APPLE__
 #include <dispatch/dispatch.h>
+#else
+#include "WorkerPool.hpp"
 #endif
 
 namespace Concurrency {
@@ -26,8 +33,17 @@ namespace Concurrency {
 	An async task queue allows a caller to enqueue void(void) functions. Those functions are guaranteed
 	to be performed serially and asynchronously from the caller. A caller may also request to flush,
 	causing it to block until all previously-enqueued functions are complete.
+
+	On Apple platforms each queue is a serial dispatch queue. Elsewhere, queues share the threads
+	of WorkerPool::shared(): a queue with pending functions submits itself to the pool, and whichever
+	worker picks it up performs every function pending at that time before resubmitting the queue if
+	more have since arrived. So no queue owns a thread, and at most one thread acts on a queue at once.
 */
-class AsyncTaskQueue {
+class AsyncTaskQueue
+#ifndef __APPLE__
+	: private WorkerPool::Job
+#endif
+{
 	public:
 		AsyncTaskQueue();
 		virtual ~AsyncTaskQueue();
@@ -36,13 +52,17 @@ class AsyncTaskQueue {
 			Adds @c function to the queue.
 
 			@discussion Functions will be performed serially and asynchronously. This method is safe to
-			call from multiple threads.
+			call from multiple threads. Other than on Apple platforms, functions small enough to be stored
+			inline by Task are enqueued without allocation once the queue has reached its working size.
 			@parameter function The function to enqueue.
 		*/
-		void enqueue(std::function<void(void)> function);
+		void enqueue(Task function);
 
 		/*!
 			Blocks the caller until all previously-enqueud functions have completed.
+
+			Other than on Apple platforms, if no thread is yet acting on this queue then the caller
+			will perform the pending functions itself; otherwise it will wait for the worker to catch up.
 		*/
 		void flush();
 
@@ -50,12 +70,26 @@ class AsyncTaskQueue {
 #ifdef __APPLE__
 		dispatch_queue_t serial_dispatch_queue_;
 #else
-		std::unique_ptr<std::thread> thread_;
+		void run() final;
+		void perform_tasks(uint64_t target);
 
 		std::mutex queue_mutex_;
-		std::list<std::function<void(void)>> pending_tasks_;
-		std::condition_variable processing_condition_;
-		std::atomic_bool should_destruct_;
+		std::vector<Task> pending_tasks_;
+		enum class State {
+			/// No functions are pending.
+			Idle,
+			/// Functions are pending and the queue has been submitted to the worker pool.
+			Scheduled,
+			/// A thread is currently performing functions.
+			Running
+		} state_ = State::Idle;
+		uint64_t enqueued_tasks_ = 0;
+
+		// These are accessed only by whichever thread has moved the queue into the Running state.
+		std::vector<Task> performing_tasks_;
+
+		std::atomic<uint64_t> completed_tasks_{0};
+		std::atomic<int> outstanding_submissions_{0};
 #endif
 };
 
@@ -66,6 +100,10 @@ class AsyncTaskQueue {
 
 	It therefore offers similar semantics to an asynchronous task queue, but allows for management of
 	synchronisation costs, since neither defer nor perform make any effort to be thread safe.
+
+	Deferred functions are stored as Tasks in batches that are returned for reuse once performed,
+	so once the queue has reached its working size neither defer nor perform allocates, other than
+	within libdispatch on Apple platforms.
 */
 class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 	public:
@@ -76,7 +114,9 @@ class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 
 			This is not thread safe; it should be serialised with other calls to itself and to perform.
 		*/
-		void defer(std::function<void(void)> function);
+		void defer(Task function) {
+			deferred_tasks_.push_back(std::move(function));
+		}
 
 		/*!
 			Enqueues a function that will perform all currently deferred functions, in the
@@ -87,9 +127,13 @@ class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 		void perform();
 
 	private:
-		// TODO: this is a shared_ptr because of the issues capturing moveables in C++11;
-		// switch to a unique_ptr if/when adapting to C++14
-		std::shared_ptr<std::list<std::function<void(void)>>> deferred_tasks_;
+		std::vector<Task> deferred_tasks_;
+
+		// Performed batches are returned here for reuse; the producer is whichever thread is
+		// currently acting on the queue, and the consumer is the caller of perform.
+		static constexpr uint32_t SpareBatches = 16;
+		std::array<std::vector<Task>, SpareBatches> spare_batches_;
+		SPSCRing<SpareBatches> spare_batch_ring_;
 };
 
 }
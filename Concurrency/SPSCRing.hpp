@@ -0,0 +1,207 @@
+//
+//  SPSCRing.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef SPSCRing_hpp
+#define SPSCRing_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Concurrency {
+
+/*!
+	Describes the back-pressure experienced by an SPSCRing.
+*/
+struct RingStatistics {
+	/// The total number of positions in the ring.
+	size_t capacity = 0;
+
+	/// The number of times that writing was refused because the producer would
+	/// otherwise have overtaken the consumer. Repeated attempts to make the same
+	/// write, with no successful write in between, count as a single overflow.
+	size_t overflows = 0;
+
+	/// The greatest number of positions that have been submitted
+	/// but not yet released by the consumer.
+	size_t high_water_mark = 0;
+};
+
+/*!
+	Manages the positions within a single-producer, single-consumer ring buffer of @c Size
+	positions; the owner supplies storage for whatever those positions identify.
+
+	The producer maintains a private write position, which it may advance tentatively and
+	then either @c submit, making everything prior to it available to the consumer, or
+	@c rollback, discarding everything since the previous submission.
+
+	The consumer obtains the most recent submission via @c submitted_position and announces
+	that it is finished with everything prior to a position via @c set_read_position.
+
+	The producer will not advance the write position into space that the consumer has yet to
+	release; a ring is considered full when one position remains, so that a full ring can be
+	distinguished from an empty one.
+
+	Each side writes only its own atomic, so the two never contend for a lock. Where a single
+	owner uses several rings to describe related data, it should use a SubmissionSequence
+	so that the consumer obtains all submitted positions as a single snapshot.
+*/
+template <uint32_t Size> class SPSCRing {
+	public:
+		static_assert(Size > 1, "A ring requires at least two positions");
+
+		/// @returns @c position reduced to the range [0, Size).
+		static constexpr uint32_t wrap(uint32_t position) {
+			return position % Size;
+		}
+
+		/// @returns The number of positions from @c begin forward to @c end.
+		static constexpr uint32_t distance(uint32_t begin, uint32_t end) {
+			return (end + Size - begin) % Size;
+		}
+
+		// MARK: - Producer interface.
+
+		/// @returns The current write position.
+		uint32_t write_position() const {
+			return write_;
+		}
+
+		/*!
+			Moves the write position to @c position without checking for available space;
+			this is intended for use after a successful call to @c can_write_to.
+		*/
+		void set_write_position(uint32_t position) {
+			write_ = wrap(position);
+		}
+
+		/*!
+			Determines whether the producer may advance its write position to @c position
+			without overtaking the consumer. A request that would move the write position
+			backwards relative to the consumer is refused, and recorded as an overflow.
+
+			@returns @c true if the write position may be advanced to @c position; @c false otherwise.
+		*/
+		bool can_write_to(uint32_t position) {
+			const uint32_t read = read_.load(std::memory_order_acquire);
+			if(distance(read, wrap(position)) < distance(read, write_)) {
+				if(!is_overflowing_) {
+					overflows_.fetch_add(1, std::memory_order_relaxed);
+					is_overflowing_ = true;
+				}
+				return false;
+			}
+			is_overflowing_ = false;
+			return true;
+		}
+
+		/*!
+			Advances the write position by @c count if there is space to do so.
+
+			@returns @c true if the write position was advanced; @c false otherwise.
+		*/
+		bool advance(uint32_t count = 1) {
+			if(!can_write_to(write_ + count)) return false;
+			write_ = wrap(write_ + count);
+			return true;
+		}
+
+		/// Publishes everything up to the current write position to the consumer.
+		void submit() {
+			const uint32_t occupancy = distance(read_.load(std::memory_order_relaxed), write_);
+			if(occupancy > high_water_mark_.load(std::memory_order_relaxed)) {
+				high_water_mark_.store(occupancy, std::memory_order_relaxed);
+			}
+			submit_.store(write_, std::memory_order_release);
+		}
+
+		/// Returns the write position to that at the most recent @c submit.
+		void rollback() {
+			write_ = submit_.load(std::memory_order_relaxed);
+		}
+
+		// MARK: - Consumer interface.
+
+		/// @returns The write position as of the most recent @c submit.
+		uint32_t submitted_position() const {
+			return submit_.load(std::memory_order_acquire);
+		}
+
+		/// @returns The current read position.
+		uint32_t read_position() const {
+			return read_.load(std::memory_order_relaxed);
+		}
+
+		/// Releases all positions prior to @c position back to the producer.
+		void set_read_position(uint32_t position) {
+			read_.store(wrap(position), std::memory_order_release);
+		}
+
+		// MARK: - Statistics; these may be requested from any thread.
+
+		RingStatistics statistics() const {
+			RingStatistics statistics;
+			statistics.capacity = Size;
+			statistics.overflows = overflows_.load(std::memory_order_relaxed);
+			statistics.high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+			return statistics;
+		}
+
+	private:
+		// The write position is private to the producer; the submit position is
+		// written only by the producer and the read position only by the consumer.
+		// The two atomics are kept apart to avoid false sharing.
+		uint32_t write_ = 0;
+		bool is_overflowing_ = false;
+		alignas(64) std::atomic<uint32_t> submit_{0};
+		alignas(64) std::atomic<uint32_t> read_{0};
+
+		std::atomic<size_t> overflows_{0};
+		std::atomic<uint32_t> high_water_mark_{0};
+};
+
+/*!
+	Allows the consumer of several related SPSCRings to obtain their submitted positions
+	as a single snapshot, even though each ring publishes its position independently.
+
+	The producer performs all of its submissions within a call to @c submit; the consumer
+	reads all submitted positions within a call to @c read, which repeats the read until it
+	has not overlapped with a submission. This is a sequence lock: the producer never waits,
+	and the consumer waits only while a submission is in progress.
+*/
+class SubmissionSequence {
+	public:
+		/// Calls @c submit, which should submit every related ring.
+		template <typename Function> void submit(const Function &submit) {
+			const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+			sequence_.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			submit();
+			sequence_.store(sequence + 2, std::memory_order_release);
+		}
+
+		/// Calls @c read, which should obtain the submitted position of every related ring, until it
+		/// has done so without any intervening submission.
+		template <typename Function> void read(const Function &read) const {
+			while(true) {
+				const uint32_t sequence = sequence_.load(std::memory_order_acquire);
+				if(sequence & 1) continue;
+
+				read();
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if(sequence_.load(std::memory_order_relaxed) == sequence) return;
+			}
+		}
+
+	private:
+		std::atomic<uint32_t> sequence_{0};
+};
+
+}
+
+#endif /* SPSCRing_hpp */
@@ -0,0 +1,129 @@
+//
+//  Task.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Task_hpp
+#define Task_hpp
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Concurrency {
+
+/*!
+	A move-only, type-erased void(void) callable.
+
+	Unlike std::function, callables of up to @c InlineSize bytes are always stored within the
+	Task itself, whether or not they are trivially copyable, so constructing, moving and
+	destroying such Tasks never touches the heap. Larger callables are stored on the heap.
+*/
+class Task {
+	public:
+		/// The largest callable that will be stored without allocation.
+		static constexpr std::size_t InlineSize = 64;
+
+		Task() noexcept = default;
+
+		template <
+			typename Function,
+			typename = std::enable_if_t<!std::is_same<std::decay_t<Function>, Task>::value>
+		> Task(Function &&function) {
+			using Callable = std::decay_t<Function>;
+			if constexpr (is_inline<Callable>()) {
+				new (&storage_) Callable(std::forward<Function>(function));
+				perform_ = [](Storage &storage) {
+					(*std::launder(reinterpret_cast<Callable *>(&storage)))();
+				};
+				manage_ = [](Storage &source, Storage *destination) {
+					Callable *const callable = std::launder(reinterpret_cast<Callable *>(&source));
+					if(destination) new (destination) Callable(std::move(*callable));
+					callable->~Callable();
+				};
+			} else {
+				*reinterpret_cast<Callable **>(&storage_) = new Callable(std::forward<Function>(function));
+				perform_ = [](Storage &storage) {
+					(**reinterpret_cast<Callable **>(&storage))();
+				};
+				manage_ = [](Storage &source, Storage *destination) {
+					Callable *&callable = *reinterpret_cast<Callable **>(&source);
+					if(destination) {
+						*reinterpret_cast<Callable **>(destination) = callable;
+					} else {
+						delete callable;
+					}
+					callable = nullptr;
+				};
+			}
+		}
+
+		Task(Task &&rhs) noexcept {
+			*this = std::move(rhs);
+		}
+
+		Task &operator =(Task &&rhs) noexcept {
+			if(this != &rhs) {
+				reset();
+				if(rhs.manage_) {
+					rhs.manage_(rhs.storage_, &storage_);
+					perform_ = rhs.perform_;
+					manage_ = rhs.manage_;
+					rhs.perform_ = nullptr;
+					rhs.manage_ = nullptr;
+				}
+			}
+			return *this;
+		}
+
+		Task(const Task &) = delete;
+		Task &operator =(const Task &) = delete;
+
+		~Task() {
+			reset();
+		}
+
+		/// Performs the stored callable, which must exist.
+		void operator()() {
+			perform_(storage_);
+		}
+
+		/// @returns @c true if this Task holds a callable; @c false otherwise.
+		explicit operator bool() const {
+			return perform_;
+		}
+
+		/// Destroys the stored callable, if any.
+		void reset() {
+			if(manage_) {
+				manage_(storage_, nullptr);
+				perform_ = nullptr;
+				manage_ = nullptr;
+			}
+		}
+
+		/// @returns @c true if a callable of type @c Callable would be stored without allocation.
+		template <typename Callable> static constexpr bool is_inline() {
+			return
+				sizeof(Callable) <= InlineSize &&
+				alignof(std::max_align_t) % alignof(Callable) == 0 &&
+				std::is_nothrow_move_constructible<Callable>::value;
+		}
+
+	private:
+		using Storage = std::aligned_storage_t<InlineSize, alignof(std::max_align_t)>;
+		Storage storage_;
+
+		void (*perform_)(Storage &) = nullptr;
+
+		// Moves the callable from the source to the destination, or destroys it if there is no destination.
+		void (*manage_)(Storage &source, Storage *destination) = nullptr;
+};
+
+}
+
+#endif /* Task_hpp */
@@ -0,0 +1,150 @@
+//
+//  WorkerPool.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+using namespace Concurrency;
+
+namespace {
+
+// Identifies the pool and worker index, if any, of the current thread.
+thread_local const WorkerPool *current_pool = nullptr;
+thread_local std::size_t current_worker = 0;
+
+}
+
+// MARK: - JobList.
+
+void WorkerPool::JobList::push(Job *job) {
+	if(count_ == jobs_.size()) {
+		std::rotate(jobs_.begin(), jobs_.begin() + std::ptrdiff_t(head_), jobs_.end());
+		head_ = 0;
+		jobs_.resize(jobs_.size() * 2);
+	}
+	jobs_[(head_ + count_) % jobs_.size()] = job;
+	++count_;
+}
+
+WorkerPool::Job *WorkerPool::JobList::pop_front() {
+	if(!count_) return nullptr;
+	Job *const job = jobs_[head_];
+	head_ = (head_ + 1) % jobs_.size();
+	--count_;
+	return job;
+}
+
+WorkerPool::Job *WorkerPool::JobList::pop_back() {
+	if(!count_) return nullptr;
+	--count_;
+	return jobs_[(head_ + count_) % jobs_.size()];
+}
+
+// MARK: - WorkerPool.
+
+WorkerPool::WorkerPool(std::size_t threads) {
+	if(!threads) {
+		threads = std::max(std::thread::hardware_concurrency(), 2u);
+	}
+
+	for(std::size_t c = 0; c < threads; ++c) {
+		workers_.push_back(std::make_unique<Worker>());
+	}
+	for(std::size_t c = 0; c < threads; ++c) {
+		workers_[c]->thread = std::thread([this, c] {
+			run_worker(c);
+		});
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
+		should_stop_ = true;
+	}
+	sleep_condition_.notify_all();
+
+	for(auto &worker: workers_) {
+		worker->thread.join();
+	}
+}
+
+WorkerPool &WorkerPool::shared() {
+	// This is deliberately leaked, so that queues that outlive static destruction
+	// may continue to use it.
+	static WorkerPool *const pool = new WorkerPool();
+	return *pool;
+}
+
+bool WorkerPool::is_worker_thread() const {
+	return current_pool == this;
+}
+
+void WorkerPool::submit(Job *job) {
+	const std::size_t index =
+		is_worker_thread() ?
+			current_worker :
+			next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+	{
+		std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+		workers_[index]->jobs.push(job);
+	}
+
+	// Both this increment and the corresponding one in run are sequentially consistent,
+	// so either a worker that is about to sleep will see this job, or this thread will
+	// see that worker and wake it.
+	pending_jobs_.fetch_add(1);
+	if(sleeping_workers_.load()) {
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
+		sleep_condition_.notify_one();
+	}
+}
+
+WorkerPool::Job *WorkerPool::next_job(std::size_t index) {
+	// Take from the front of this worker's own list first.
+	{
+		std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+		if(Job *const job = workers_[index]->jobs.pop_front()) {
+			return job;
+		}
+	}
+
+	// Otherwise attempt to steal from the back of any other worker's list.
+	for(std::size_t offset = 1; offset < workers_.size(); ++offset) {
+		Worker &victim = *workers_[(index + offset) % workers_.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if(Job *const job = victim.jobs.pop_back()) {
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void WorkerPool::run_worker(std::size_t index) {
+	current_pool = this;
+	current_worker = index;
+
+	while(true) {
+		if(Job *const job = next_job(index)) {
+			pending_jobs_.fetch_sub(1);
+			job->run();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleep_mutex_);
+		sleeping_workers_.fetch_add(1);
+		sleep_condition_.wait(lock, [this] {
+			return should_stop_ || pending_jobs_.load();
+		});
+		sleeping_workers_.fetch_sub(1);
+		if(should_stop_) return;
+	}
+}
@@ -0,0 +1,102 @@
+//
+//  WorkerPool.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef WorkerPool_hpp
+#define WorkerPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Concurrency {
+
+/*!
+	A worker pool owns a fixed set of threads, each of which performs Jobs submitted to
+	the pool. Each thread has its own list of pending Jobs; a thread with nothing to do will
+	take work from another's list.
+
+	Jobs submitted from within a worker are added to that worker's list; those submitted
+	from elsewhere are distributed across the workers in turn.
+
+	The pool does not own Jobs, nor does it impose any order upon them; an owner that needs
+	ordering, such as AsyncTaskQueue, should submit a single Job at a time and resubmit it
+	as required.
+*/
+class WorkerPool {
+	public:
+		struct Job {
+			virtual ~Job() = default;
+
+			/// Performs this job; this is called on one of the pool's threads.
+			virtual void run() = 0;
+		};
+
+		/// Creates a pool with @c threads threads, or as many as there are processors if @c threads is 0.
+		WorkerPool(std::size_t threads = 0);
+		~WorkerPool();
+
+		/// @returns The process-wide pool, which is created upon first request and never destroyed.
+		static WorkerPool &shared();
+
+		/*!
+			Schedules @c job to be performed once. The job must not be destroyed until
+			it has been performed.
+
+			This method is safe to call from any thread, and does not allocate in steady state.
+		*/
+		void submit(Job *job);
+
+		/// @returns The number of threads in this pool.
+		std::size_t size() const {
+			return workers_.size();
+		}
+
+		/// @returns @c true if the calling thread belongs to this pool; @c false otherwise.
+		bool is_worker_thread() const;
+
+	private:
+		// A growable FIFO of job pointers, which allocates only when full.
+		class JobList {
+			public:
+				void push(Job *);
+				Job *pop_front();
+				Job *pop_back();
+
+			private:
+				std::vector<Job *> jobs_ = std::vector<Job *>(16);
+				std::size_t head_ = 0, count_ = 0;
+		};
+
+		struct Worker {
+			std::mutex mutex;
+			JobList jobs;
+			std::thread thread;
+		};
+		std::vector<std::unique_ptr<Worker>> workers_;
+
+		// The total number of submitted jobs not yet taken by a worker.
+		std::atomic<std::size_t> pending_jobs_{0};
+		std::atomic<std::size_t> next_worker_{0};
+
+		// Idle workers sleep on this condition.
+		std::mutex sleep_mutex_;
+		std::condition_variable sleep_condition_;
+		std::atomic<std::size_t> sleeping_workers_{0};
+		bool should_stop_ = false;
+
+		void run_worker(std::size_t index);
+		Job *next_job(std::size_t index);
+};
+
+}
+
+#endif /* WorkerPool_hpp */
@@ -70,7 +70,7 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 				uint8_t *ram_, *aux_ram_;
 		};
 
-		CPU::MOS6502::Processor<(model == Analyser::Static::AppleII::Target::Model::EnhancedIIe) ? CPU::MOS6502::Personality::PSynertek65C02 : CPU::MOS6502::Personality::P6502, ConcreteMachine, false> m6502_;
+		CPU::MOS6502::Processor<(model == Analyser::Static::AppleII::Target::Model::EnhancedIIe) ? CPU::MOS6502::Personality::PSynertek65C02 : CPU::MOS6502::Personality::P6502, ConcreteMachine, false, true> m6502_;
 		VideoBusHandler video_bus_handler_;
 		Apple::II::Video::Video<VideoBusHandler, is_iie()> video_;
 		int cycles_into_current_line_ = 0;
@@ -304,17 +304,24 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 		// they will discharge.
 		//
 		// This emulator models that with analogue_charge_ being essentially the amount of time,
-		// in charge threshold units, since 0xc070 was last strobed. But if any of the analogue
-		// inputs were already partially charged then they gain a bias in analogue_biases_.
+		// in cycles, since 0xc070 was last strobed; AnalogueChargeCycles cycles make up one charge
+		// threshold unit. But if any of the analogue inputs were already partially charged then
+		// they gain a bias, in charge threshold units, in analogue_biases_.
 		//
 		// It's a little indirect, but it means only having to increment the one value in the
-		// main loop.
-		float analogue_charge_ = 0.0f;
+		// main loop. That value is an integer so that any number of cycles can be added at once.
+		static constexpr int AnalogueChargeCycles = 2820;
+		static constexpr int MaximumAnalogueCharge = AnalogueChargeCycles * 11 / 10;
+		int analogue_charge_ = 0;
 		float analogue_biases_[4] = {0.0f, 0.0f, 0.0f, 0.0f};
 
+		float analogue_charge() const {
+			return float(analogue_charge_) / float(AnalogueChargeCycles);
+		}
+
 		std::vector<std::unique_ptr<Inputs::Joystick>> joysticks_;
 		bool analogue_channel_is_discharged(size_t channel) {
-			return (1.0f - static_cast<Joystick *>(joysticks_[channel >> 1].get())->axes[channel & 1]) < analogue_charge_ + analogue_biases_[channel];
+			return (1.0f - static_cast<Joystick *>(joysticks_[channel >> 1].get())->axes[channel & 1]) < analogue_charge() + analogue_biases_[channel];
 		}
 
 		// The IIe has three keys that are wired directly to the same input as the joystick buttons.
@@ -626,10 +633,10 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 							if(analogue_channel_is_discharged(c)) {
 								analogue_biases_[c] = 0.0f;
 							} else {
-								analogue_biases_[c] += analogue_charge_;
+								analogue_biases_[c] += analogue_charge();
 							}
 						}
-						analogue_charge_ = 0.0f;
+						analogue_charge_ = 0;
 					} break;
 
 					/* Switches triggered by reading or writing. */
@@ -791,11 +798,41 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 			}
 
 			// Update analogue charge level.
-			analogue_charge_ = std::min(analogue_charge_ + 1.0f / 2820.0f, 1.1f);
+			analogue_charge_ = std::min(analogue_charge_ + 1, MaximumAnalogueCharge);
 
 			return Cycles(1);
 		}
 
+		// MARK: - Direct pages.
+
+		// The 6502 may access RAM and ROM directly, other than the I/O and expansion ROM area, and other
+		// than RAM that the video might be displaying, as long as no card needs to see every cycle.
+		static constexpr bool has_direct_pages = true;
+
+		forceinline uint8_t *direct_read_page(int page) {
+			if(!every_cycle_cards_.empty() || card_lists_are_dirty_ || (page & 0xf0) == 0xc0) return nullptr;
+			return read_pages_[page];
+		}
+
+		forceinline uint8_t *direct_write_page(int page) {
+			if(page >= 0x02 && page < 0x60) return nullptr;
+			return direct_read_page(page) ? write_pages_[page] : nullptr;
+		}
+
+		forceinline void advance(Cycles cycles) {
+			cycles_since_video_update_ += cycles;
+			cycles_since_card_update_ += cycles;
+			cycles_since_audio_update_ += cycles * Cycles(7);
+
+			// Account for stretched cycles as per perform_bus_operation.
+			const int stretched_cycles = (cycles_into_current_line_ + cycles.as<int>()) / 65;
+			cycles_into_current_line_ = (cycles_into_current_line_ + cycles.as<int>()) % 65;
+			cycles_since_audio_update_ += Cycles(stretched_cycles);
+			stretched_cycles_since_card_update_ += stretched_cycles;
+
+			analogue_charge_ = std::min(analogue_charge_ + cycles.as<int>(), MaximumAnalogueCharge);
+		}
+
 		void flush() {
 			update_video();
 			update_audio();
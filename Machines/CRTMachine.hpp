@@ -63,6 +63,9 @@ class Machine {
 			Sets a speed multiplier to apply to this machine; e.g. a multiplier of 1.5 will cause the
 			emulated machine to run 50% faster than a real machine. This speed-up is an emulation
 			fiction: it will apply across the system, including to the CRT.
+
+			To run as quickly as possible without the full cost of video and audio output, instead
+			output via an Outputs::Display::FieldSkippingScanTarget and set the speaker to skip output.
 		*/
 		virtual void set_speed_multiplier(double multiplier) {
 			speed_multiplier_ = multiplier;
@@ -16,6 +16,7 @@
 
 #include "../CRTMachine.hpp"
 #include "../JoystickMachine.hpp"
+#include "../SnapshotMachine.hpp"
 
 #include "../../Configurable/StandardOptions.hpp"
 #include "../../ClockReceiver/ForceInline.hpp"
@@ -116,7 +117,8 @@ class ConcreteMachine:
 	public CPU::Z80::BusHandler,
 	public CRTMachine::Machine,
 	public Configurable::Device,
-	public JoystickMachine::Machine {
+	public JoystickMachine::Machine,
+	public SnapshotMachine::Machine {
 
 	public:
 		ConcreteMachine(const Analyser::Static::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
@@ -238,6 +240,7 @@ class ConcreteMachine:
 						} else if(address >= 0x8000 && address <= cartridge_address_limit_) {
 							if(is_megacart_ && address >= 0xffc0) {
 								page_megacart(address);
+								z80_.prevent_idle_skip();
 							}
 							*cycle.value = cartridge_pages_[(address >> 14)&1][address&0x3fff];
 						} else {
@@ -261,6 +264,10 @@ class ConcreteMachine:
 						switch((address >> 5) & 7) {
 							case 5:
 								*cycle.value = vdp_->read(address);
+
+								// Data reads advance the VDP's address, but a loop of status reads can be skipped up
+								// to the next interrupt. Sprite flags raised during a skip are then seen by the first read after it.
+								if(!(address & 1)) z80_.prevent_idle_skip();
 								z80_.set_non_maskable_interrupt_line(vdp_->get_interrupt_line());
 								time_until_interrupt_ = vdp_->get_time_until_interrupt();
 							break;
@@ -289,6 +296,7 @@ class ConcreteMachine:
 										ay_.set_control_lines(GI::AY38910::ControlLines(GI::AY38910::BC2 | GI::AY38910::BC1));
 										*cycle.value = ay_.get_data_output();
 										ay_.set_control_lines(GI::AY38910::ControlLines(0));
+										z80_.prevent_idle_skip();
 									break;
 								}
 							break;
@@ -356,6 +364,21 @@ class ConcreteMachine:
 			return penalty;
 		}
 
+		// Idle loops may be skipped. Reads of VDP data, the AY and the megacart paging addresses prevent skipping;
+		// all other reads are either free of side effects or, as for VDP status, repeat until the VDP's interrupt, and
+		// the joysticks change only between calls to run_for, so the only event that an idle loop can await is that interrupt.
+		static constexpr bool skips_idle_loops = true;
+
+		HalfCycles get_time_until_event() {
+			return time_until_interrupt_ > HalfCycles(0) ? time_until_interrupt_ : HalfCycles(-1);
+		}
+
+		void skip_idle_time(HalfCycles duration) {
+			vdp_ += duration;
+			time_since_sn76489_update_ += duration;
+			if(time_until_interrupt_ > HalfCycles(0)) time_until_interrupt_ -= duration;
+		}
+
 		void flush() {
 			vdp_.flush();
 			update_audio();
@@ -391,6 +414,46 @@ class ConcreteMachine:
 			return selection_set;
 		}
 
+		// MARK: - SnapshotMachine::Machine.
+		void save_state(Storage::Snapshot::Writer &writer) final {
+			flush();
+			audio_queue_.flush();
+
+			writer.begin("COLV", 1);
+			z80_.save_state(writer);
+			vdp_.last_valid()->save_state(writer);
+			sn76489_.save_state(writer);
+			ay_.save_state(writer);
+
+			writer.put(ram_, super_game_module_.replace_bios, super_game_module_.replace_ram, super_game_module_.ram);
+			writer.put(is_megacart_ ? uint32_t(cartridge_pages_[1] - cartridge_.data()) : uint32_t(0));
+			writer.put(joysticks_in_keypad_mode_, time_since_sn76489_update_, time_until_interrupt_);
+			writer.end();
+		}
+
+		bool restore_state(Storage::Snapshot::Reader &reader) final {
+			flush();
+			audio_queue_.flush();
+
+			uint32_t megacart_page;
+			if(
+				!reader.begin("COLV", 1) ||
+				!z80_.restore_state(reader) ||
+				!vdp_.last_valid()->restore_state(reader) ||
+				!sn76489_.restore_state(reader) ||
+				!ay_.restore_state(reader) ||
+				!reader.get(ram_, super_game_module_.replace_bios, super_game_module_.replace_ram, super_game_module_.ram) ||
+				!reader.get(megacart_page) ||
+				!reader.get(joysticks_in_keypad_mode_, time_since_sn76489_update_, time_until_interrupt_) ||
+				(is_megacart_ && ((megacart_page & 16383) || megacart_page >= cartridge_.size()))
+			) {
+				return false;
+			}
+
+			if(is_megacart_) cartridge_pages_[1] = &cartridge_[megacart_page];
+			return reader.end();
+		}
+
 	private:
 		inline void page_megacart(uint16_t address) {
 			const std::size_t selected_start = (static_cast<std::size_t>(address&63) << 14) % cartridge_.size();
@@ -501,6 +501,7 @@ class ConcreteMachine:
 			if(isReadOperation(operation)) {
 				uint8_t result = processor_read_memory_map_[address >> 10] ? processor_read_memory_map_[address >> 10][address & 0x3ff] : 0xff;
 				if((address&0xfc00) == 0x9000) {
+					m6502_.prevent_idle_skip();
 					if(!(address&0x100)) {
 						update_video();
 						result &= mos6560_.read(address);
@@ -613,6 +614,26 @@ class ConcreteMachine:
 			return Cycles(1);
 		}
 
+		// Idle loops may be skipped. Reads from the VIC and the VIAs prevent skipping, and the tape and the C1540 may
+		// signal a VIA at any time; so if neither is active, the only events that an idle loop can await are the VIAs' timers.
+		static constexpr bool skips_idle_loops = true;
+
+		Cycles get_time_until_event() {
+			if(c1540_ || (!tape_is_sleeping_ && !hold_tape_)) return Cycles(0);
+
+			const HalfCycles user_port_event = user_port_via_.get_next_sequence_point();
+			const HalfCycles keyboard_event = keyboard_via_.get_next_sequence_point();
+			if(user_port_event < HalfCycles(0)) return keyboard_event < HalfCycles(0) ? Cycles(-1) : keyboard_event.cycles();
+			if(keyboard_event < HalfCycles(0)) return user_port_event.cycles();
+			return std::min(user_port_event, keyboard_event).cycles();
+		}
+
+		void skip_idle_time(Cycles cycles) {
+			cycles_since_mos6560_update_ += cycles;
+			user_port_via_.run_for(cycles);
+			keyboard_via_.run_for(cycles);
+		}
+
 		void flush() {
 			update_video();
 			mos6560_.flush();
@@ -701,7 +722,7 @@ class ConcreteMachine:
 		void update_video() {
 			mos6560_.run_for(cycles_since_mos6560_update_.flush<Cycles>());
 		}
-		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, ConcreteMachine, false> m6502_;
+		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, ConcreteMachine, false, true> m6502_;
 
 		std::vector<uint8_t>  character_rom_;
 		std::vector<uint8_t>  basic_rom_;
@@ -17,6 +17,7 @@
 #include "KeyboardMachine.hpp"
 #include "MediaTarget.hpp"
 #include "MouseMachine.hpp"
+#include "SnapshotMachine.hpp"
 
 #include "Utility/Typer.hpp"
 
@@ -36,6 +37,7 @@ struct DynamicMachine {
 	virtual KeyboardMachine::Machine *keyboard_machine() = 0;
 	virtual MouseMachine::Machine *mouse_machine() = 0;
 	virtual MediaTarget::Machine *media_target() = 0;
+	virtual SnapshotMachine::Machine *snapshot_machine() = 0;
 
 	/*!
 		Provides a raw pointer to the underlying machine if and only if this dynamic machine really is
@@ -144,3 +144,18 @@ void BD500::set_head_loaded(bool loaded) {
 		observer_->set_led_status("BD-500", loaded);
 	}
 }
+
+void BD500::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("BD50", 1);
+	DiskController::save_state(writer);
+	writer.put(is_loading_head_);
+	writer.end();
+}
+
+bool BD500::restore_state(Storage::Snapshot::Reader &reader) {
+	return
+		reader.begin("BD50", 1) &&
+		DiskController::restore_state(reader) &&
+		reader.get(is_loading_head_) &&
+		reader.end();
+}
@@ -29,6 +29,9 @@ class BD500: public DiskController {
 
 		void set_activity_observer(Activity::Observer *observer);
 
+		void save_state(Storage::Snapshot::Writer &writer) const;
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	private:
 		void set_head_load_request(bool head_load) final;
 		bool is_loading_head_ = false;
@@ -43,6 +43,40 @@ class DiskController: public WD::WD1770 {
 			return paged_item_;
 		}
 
+		/// Appends the state of the WD1770, the paging outputs and all attached drives to @c writer.
+		void save_state(Storage::Snapshot::Writer &writer) const {
+			WD1770::save_state(writer);
+			writer.put(selected_drive_, enable_overlay_ram_, disable_basic_rom_, paged_item_);
+			for(const auto &drive: drives_) {
+				writer.put(bool(drive));
+				if(drive) drive->save_state(writer);
+			}
+		}
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader) {
+			size_t selected_drive;
+			PagedItem paged_item;
+			if(
+				!WD1770::restore_state(reader) ||
+				!reader.get(selected_drive, enable_overlay_ram_, disable_basic_rom_, paged_item) ||
+				selected_drive >= drives_.size()
+			) {
+				return false;
+			}
+
+			for(auto &drive: drives_) {
+				// Drives are created upon media insertion, so the same drives should be present now as then.
+				bool has_drive;
+				if(!reader.get(has_drive) || has_drive != bool(drive)) return false;
+				if(drive && !drive->restore_state(reader)) return false;
+			}
+
+			select_drive(selected_drive);
+			set_paged_item(paged_item);
+			return true;
+		}
+
 	protected:
 		std::array<std::shared_ptr<Storage::Disk::Drive>, 4> drives_;
 		size_t selected_drive_ = 0;
@@ -68,3 +68,18 @@ void Jasmin::set_activity_observer(Activity::Observer *observer) {
 		observer_->set_led_status("Jasmin", motor_on_);
 	}
 }
+
+void Jasmin::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("JSMN", 1);
+	DiskController::save_state(writer);
+	writer.put(motor_on_);
+	writer.end();
+}
+
+bool Jasmin::restore_state(Storage::Snapshot::Reader &reader) {
+	return
+		reader.begin("JSMN", 1) &&
+		DiskController::restore_state(reader) &&
+		reader.get(motor_on_) &&
+		reader.end();
+}
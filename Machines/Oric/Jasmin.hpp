@@ -23,6 +23,9 @@ class Jasmin: public DiskController {
 
 		void set_activity_observer(Activity::Observer *observer);
 
+		void save_state(Storage::Snapshot::Writer &writer) const;
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	private:
 		void set_motor_on(bool on) final;
 		bool motor_on_ = false;
@@ -119,3 +119,18 @@ void Microdisc::set_activity_observer(Activity::Observer *observer) {
 		observer_->set_led_status("Microdisc", head_load_request_);
 	}
 }
+
+void Microdisc::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("MDSC", 1);
+	DiskController::save_state(writer);
+	writer.put(last_control_, irq_enable_, head_load_request_counter_, head_load_request_);
+	writer.end();
+}
+
+bool Microdisc::restore_state(Storage::Snapshot::Reader &reader) {
+	return
+		reader.begin("MDSC", 1) &&
+		DiskController::restore_state(reader) &&
+		reader.get(last_control_, irq_enable_, head_load_request_counter_, head_load_request_) &&
+		reader.end();
+}
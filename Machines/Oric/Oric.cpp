@@ -18,6 +18,7 @@
 #include "../MediaTarget.hpp"
 #include "../CRTMachine.hpp"
 #include "../KeyboardMachine.hpp"
+#include "../SnapshotMachine.hpp"
 
 #include "../Utility/MemoryFuzzer.hpp"
 #include "../Utility/StringSerialiser.hpp"
@@ -105,6 +106,11 @@ class Keyboard {
 			row_ = row & 7;
 		}
 
+		/// @returns The active row.
+		uint8_t get_active_row() const {
+			return row_;
+		}
+
 		/// Queries the keys on the active row specified by @c mask.
 		bool query_column(uint8_t column_mask) {
 			return !!(rows_[row_] & column_mask);
@@ -136,6 +142,17 @@ class TapePlayer: public Storage::Tape::BinaryTapePlayer {
 			return static_cast<uint8_t>(parser_.get_next_byte(get_tape(), use_fast_encoding));
 		}
 
+		/// Appends the state of the tape player and of the fast-loading parser to @c writer.
+		void save_state(Storage::Snapshot::Writer &writer) const {
+			BinaryTapePlayer::save_state(writer);
+			parser_.save_state(writer);
+		}
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader) {
+			return BinaryTapePlayer::restore_state(reader) && parser_.restore_state(reader);
+		}
+
 	private:
 		Storage::Tape::Oric::Parser parser_;
 };
@@ -200,6 +217,16 @@ class VIAPortHandler: public MOS::MOS6522::IRQDelegatePortHandler {
 			audio_queue_.perform();
 		}
 
+		/// Appends the state of the AY's control lines to @c writer; this handler should have been flushed.
+		void save_state(Storage::Snapshot::Writer &writer) const {
+			writer.put(ay_bdir_, ay_bc1_);
+		}
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader) {
+			return reader.get(ay_bdir_, ay_bc1_);
+		}
+
 	private:
 		void update_ay() {
 			speaker_.run_for(audio_queue_, cycles_since_ay_update_.flush<Cycles>());
@@ -227,6 +254,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 	public DiskController::Delegate,
 	public ClockingHint::Observer,
 	public Activity::Source,
+	public SnapshotMachine::Machine,
 	public Machine,
 	public Keyboard::SpecialKeyHandler {
 
@@ -669,11 +697,75 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 			diskii_clocking_preference_ = diskii_.preferred_clocking();
 		}
 
+		// MARK: - SnapshotMachine::Machine.
+		void save_state(Storage::Snapshot::Writer &writer) final {
+			flush();
+			audio_queue_.flush();
+
+			writer.begin("ORIC", 1);
+			m6502_.save_state(writer);
+			via_.save_state(writer);
+			via_port_handler_.save_state(writer);
+			ay8910_.save_state(writer);
+			video_output_.save_state(writer);
+
+			writer.put(ram_, keyboard_.get_active_row());
+			writer.put(ram_top_, paged_rom_ != rom_.data(), pravetz_rom_base_pointer_, jasmin_reset_counter_);
+
+			switch(disk_interface) {
+				default: break;
+				case DiskInterface::BD500:		bd500_.save_state(writer);		break;
+				case DiskInterface::Jasmin:		jasmin_.save_state(writer);		break;
+				case DiskInterface::Microdisc:	microdisc_.save_state(writer);	break;
+				case DiskInterface::Pravetz:	diskii_.save_state(writer);		break;
+			}
+			tape_player_.save_state(writer);
+			writer.end();
+		}
+
+		bool restore_state(Storage::Snapshot::Reader &reader) final {
+			flush();
+			audio_queue_.flush();
+
+			uint8_t keyboard_row;
+			bool is_disk_rom_paged;
+			if(
+				!reader.begin("ORIC", 1) ||
+				!m6502_.restore_state(reader) ||
+				!via_.restore_state(reader) ||
+				!via_port_handler_.restore_state(reader) ||
+				!ay8910_.restore_state(reader) ||
+				!video_output_.restore_state(reader) ||
+				!reader.get(ram_, keyboard_row) ||
+				!reader.get(ram_top_, is_disk_rom_paged, pravetz_rom_base_pointer_, jasmin_reset_counter_) ||
+				pravetz_rom_base_pointer_ > 0x100 ||
+				(is_disk_rom_paged && disk_rom_.empty())
+			) {
+				return false;
+			}
+
+			keyboard_.set_active_row(keyboard_row);
+			paged_rom_ = is_disk_rom_paged ? disk_rom_.data() : rom_.data();
+
+			bool disk_interface_was_restored = true;
+			switch(disk_interface) {
+				default: break;
+				case DiskInterface::BD500:		disk_interface_was_restored = bd500_.restore_state(reader);		break;
+				case DiskInterface::Jasmin:		disk_interface_was_restored = jasmin_.restore_state(reader);	break;
+				case DiskInterface::Microdisc:	disk_interface_was_restored = microdisc_.restore_state(reader);	break;
+				case DiskInterface::Pravetz:	disk_interface_was_restored = diskii_.restore_state(reader);	break;
+			}
+			if(!disk_interface_was_restored || !tape_player_.restore_state(reader)) return false;
+
+			set_interrupt_line();
+			return reader.end();
+		}
+
 	private:
 		const uint16_t basic_invisible_ram_top_ = 0xffff;
 		const uint16_t basic_visible_ram_top_ = 0xbfff;
 
-		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, ConcreteMachine, false> m6502_;
+		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, ConcreteMachine, false, true> m6502_;
 
 		// RAM and ROM
 		std::vector<uint8_t> rom_, disk_rom_;
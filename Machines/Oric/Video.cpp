@@ -276,3 +276,47 @@ void VideoOutput::set_character_set_base_address() {
 	if(is_graphics_mode_) character_set_base_address_ = use_alternative_character_set_ ? 0x9c00 : 0x9800;
 	else character_set_base_address_ = use_alternative_character_set_ ? 0xb800 : 0xb400;
 }
+
+// MARK: - Snapshots
+
+void VideoOutput::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("ORVD", 1);
+	writer.put(crt_is_60Hz_, counter_, frame_counter_, v_sync_start_position_, v_sync_end_position_, counter_period_);
+	writer.put(ink_, paper_, is_graphics_mode_, next_frame_is_sixty_hertz_);
+	writer.put(use_alternative_character_set_, use_double_height_characters_, blink_text_);
+	writer.end();
+}
+
+bool VideoOutput::restore_state(Storage::Snapshot::Reader &reader) {
+	const bool was_60Hz = crt_is_60Hz_;
+	if(
+		!reader.begin("ORVD", 1) ||
+		!reader.get(crt_is_60Hz_, counter_, frame_counter_, v_sync_start_position_, v_sync_end_position_, counter_period_) ||
+		!reader.get(ink_, paper_, is_graphics_mode_, next_frame_is_sixty_hertz_) ||
+		!reader.get(use_alternative_character_set_, use_double_height_characters_, blink_text_) ||
+		(counter_period_ != int(PAL50Period) && counter_period_ != int(PAL60Period)) ||
+		counter_ < 0 || counter_ >= counter_period_
+	) {
+		return false;
+	}
+
+	if(was_60Hz != crt_is_60Hz_) update_crt_frequency();
+	set_character_set_base_address();
+
+	// If restoring to the middle of a pixel line, resume output into a fresh buffer;
+	// the portion of that line prior to the snapshot will be lost.
+	rgb_pixel_target_ = nullptr;
+	composite_pixel_target_ = nullptr;
+	const int h_counter = counter_ & 63;
+	if(counter_ < 224*64 && h_counter && h_counter < 40) {
+		if(data_type_ == Outputs::Display::InputDataType::Red1Green1Blue1) {
+			rgb_pixel_target_ = reinterpret_cast<uint8_t *>(crt_.begin_data(240));
+			if(rgb_pixel_target_) rgb_pixel_target_ += h_counter * 6;
+		} else {
+			composite_pixel_target_ = reinterpret_cast<uint32_t *>(crt_.begin_data(240));
+			if(composite_pixel_target_) composite_pixel_target_ += h_counter * 6;
+		}
+	}
+
+	return reader.end();
+}
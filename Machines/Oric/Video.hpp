@@ -11,6 +11,7 @@
 
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Storage/Snapshot.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -31,6 +32,12 @@ class VideoOutput {
 
 		void register_crt_frequency_mismatch();
 
+		/// Appends the video counters and registers to @c writer; video memory is the responsibility of the owner.
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	private:
 		uint8_t *ram_;
 		Outputs::CRT::CRT crt_;
@@ -44,8 +51,8 @@ class VideoOutput {
 		int v_sync_start_position_, v_sync_end_position_, counter_period_;
 
 		// Output target and device.
-		uint8_t *rgb_pixel_target_;
-		uint32_t *composite_pixel_target_;
+		uint8_t *rgb_pixel_target_ = nullptr;
+		uint32_t *composite_pixel_target_ = nullptr;
 		uint32_t colour_forms_[8];
 		Outputs::Display::InputDataType data_type_;
 
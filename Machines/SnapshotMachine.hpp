@@ -0,0 +1,60 @@
+//
+//  SnapshotMachine.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef SnapshotMachine_hpp
+#define SnapshotMachine_hpp
+
+#include "../Storage/Snapshot.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace SnapshotMachine {
+
+/*!
+	A SnapshotMachine::Machine is anything that can capture its complete emulated state — processor,
+	chips, RAM and the mechanical state of any media drives — and later restore it.
+
+	Media contents are not captured; a snapshot should be restored to a machine that was
+	constructed from the same target and that has the same media inserted.
+
+	At present only the Oric, with any of its disk interfaces, and the ColecoVision implement
+	this interface; for all other machines DynamicMachine::snapshot_machine returns @c nullptr.
+*/
+class Machine {
+	public:
+		/// Appends this machine's complete state to @c writer.
+		virtual void save_state(Storage::Snapshot::Writer &writer) = 0;
+
+		/*!
+			Replaces this machine's state with that next in @c reader.
+
+			@returns @c true if the state was restored; @c false if the snapshot was not one
+				produced by this type of machine, or was produced by a later version of it.
+				If restoration fails then the machine's state is undefined, and it should be
+				discarded or reset.
+		*/
+		virtual bool restore_state(Storage::Snapshot::Reader &reader) = 0;
+
+		/// @returns A complete snapshot of this machine's state.
+		std::vector<uint8_t> snapshot() {
+			Storage::Snapshot::Writer writer;
+			save_state(writer);
+			return writer.take();
+		}
+
+		/// Restores the state captured in @c snapshot; @returns @c true on success, @c false otherwise.
+		bool restore(const std::vector<uint8_t> &snapshot) {
+			Storage::Snapshot::Reader reader(snapshot);
+			return restore_state(reader);
+		}
+};
+
+}
+
+#endif /* SnapshotMachine_hpp */
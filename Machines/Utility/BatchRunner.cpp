@@ -0,0 +1,215 @@
+//
+//  BatchRunner.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "BatchRunner.hpp"
+
+#include "../../Numeric/Random.hpp"
+#include "../../Outputs/Software/ScanTarget.hpp"
+
+#include <algorithm>
+
+using namespace Machine;
+
+/*!
+	Holds a single live machine, its outputs and the captured results, and
+	runs one slice of emulated time whenever performed by the worker pool.
+*/
+class BatchRunner::Instance:
+	public Concurrency::WorkerPool::Job,
+	public Outputs::Display::Software::ScanTarget::Delegate,
+	public Outputs::Speaker::Speaker::Delegate {
+	public:
+		Instance(BatchRunner &runner, std::size_t index, BatchRunner::Job &&job) :
+			index(index),
+			runner_(runner),
+			job_(std::move(job)),
+			remaining_(job_.duration),
+			random_source_(job_.seed) {}
+
+		/// Constructs the machine for this instance's job; @returns @c true on success.
+		bool start() {
+			const Numeric::RandomSource::Scope random_scope(random_source_);
+			machine_.reset(MachineForTargets(job_.targets, [this] (const std::vector<::ROMMachine::ROM> &roms) {
+				return runner_.fetch_roms(roms);
+			}, result.error));
+			if(!machine_) return false;
+
+			CRTMachine::Machine *const crt_machine = machine_->crt_machine();
+			if(!crt_machine) {
+				machine_.reset();
+				result.error = Error::UnknownError;
+				return false;
+			}
+
+			if(job_.frame_interval) {
+				frame_.resize(size_t(job_.frame_width * job_.frame_height * 4));
+				scan_target_.set_target_buffer(frame_.data(), job_.frame_width, job_.frame_height);
+			}
+			scan_target_.set_delegate(this);
+			if(job_.turbo_field_interval > 1) {
+				field_skipping_scan_target_.set_target(&scan_target_);
+				field_skipping_scan_target_.set_field_interval(job_.turbo_field_interval);
+				crt_machine->set_scan_target(&field_skipping_scan_target_);
+			} else {
+				crt_machine->set_scan_target(&scan_target_);
+			}
+
+			Outputs::Speaker::Speaker *const speaker = crt_machine->get_speaker();
+			if(speaker && job_.turbo_field_interval > 1) {
+				speaker->set_skips_output(true);
+			} else if(speaker && job_.audio_sample_rate > 0.0f) {
+				speaker->set_output_rate(job_.audio_sample_rate, 512);
+				speaker->set_delegate(this);
+			}
+			return true;
+		}
+
+		/// @returns @c true if this instance has run for the entire duration of its job.
+		bool is_finished() const {
+			return remaining_ <= 0.0;
+		}
+
+		/// Destroys the machine, ensuring that all output is complete.
+		void finish() {
+			// Destroying the machine flushes its audio queue, so all audio will have been delivered.
+			machine_.reset();
+			result.fields = scan_target_.completed_fields();
+		}
+
+		const std::size_t index;
+		Result result;
+
+	private:
+		BatchRunner &runner_;
+		BatchRunner::Job job_;
+		Time::Seconds remaining_;
+		Time::Seconds slice_ = 0.0;
+
+		// Supplies all random numbers used by the machine, whichever thread it runs on.
+		Numeric::RandomSource random_source_;
+
+		std::vector<uint8_t> frame_;
+		Outputs::Display::Software::ScanTarget scan_target_;
+		Outputs::Display::FieldSkippingScanTarget field_skipping_scan_target_;
+
+		// The machine is declared last so that it is destroyed first.
+		std::unique_ptr<DynamicMachine> machine_;
+
+		friend class BatchRunner;
+
+		// WorkerPool::Job.
+		void run() final {
+			const Numeric::RandomSource::Scope random_scope(random_source_);
+			machine_->crt_machine()->run_for(slice_);
+			remaining_ -= slice_;
+			runner_.instance_did_complete_slice();
+		}
+
+		// Software::ScanTarget::Delegate.
+		void scan_target_did_complete_field(Outputs::Display::Software::ScanTarget *scan_target) final {
+			if(job_.frame_interval && !(scan_target->completed_fields() % job_.frame_interval)) {
+				result.frames.push_back(frame_);
+			}
+		}
+
+		// Speaker::Delegate; this is called serially from the machine's audio queue.
+		void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+			result.audio.insert(result.audio.end(), buffer.begin(), buffer.end());
+		}
+};
+
+BatchRunner::BatchRunner(const ::ROMMachine::ROMFetcher &rom_fetcher, Concurrency::WorkerPool &pool) :
+	pool_(pool), rom_fetcher_(rom_fetcher) {}
+
+std::size_t BatchRunner::add(Job &&job) {
+	jobs_.push_back(std::move(job));
+	return jobs_.size() - 1;
+}
+
+std::vector<std::unique_ptr<std::vector<uint8_t>>> BatchRunner::fetch_roms(const std::vector<::ROMMachine::ROM> &roms) {
+	// Machines are constructed only on the thread that calls run, so no locking is required here.
+	std::vector<::ROMMachine::ROM> missing_roms;
+	for(const auto &rom: roms) {
+		if(roms_.find(rom.machine_name + "/" + rom.file_name) == roms_.end()) {
+			missing_roms.push_back(rom);
+		}
+	}
+
+	if(!missing_roms.empty()) {
+		auto fetched_roms = rom_fetcher_(missing_roms);
+		for(std::size_t c = 0; c < missing_roms.size(); ++c) {
+			roms_[missing_roms[c].machine_name + "/" + missing_roms[c].file_name] =
+				c < fetched_roms.size() ? std::move(fetched_roms[c]) : nullptr;
+		}
+	}
+
+	std::vector<std::unique_ptr<std::vector<uint8_t>>> results;
+	for(const auto &rom: roms) {
+		const auto &cached_rom = roms_[rom.machine_name + "/" + rom.file_name];
+		results.push_back(cached_rom ? std::make_unique<std::vector<uint8_t>>(*cached_rom) : nullptr);
+	}
+	return results;
+}
+
+void BatchRunner::instance_did_complete_slice() {
+	std::lock_guard<std::mutex> lock(slice_mutex_);
+	--outstanding_instances_;
+	if(!outstanding_instances_) {
+		slice_condition_.notify_all();
+	}
+}
+
+std::vector<BatchRunner::Result> BatchRunner::run(Time::Seconds slice, std::size_t max_machines) {
+	if(!max_machines) max_machines = pool_.size() * 2;
+
+	std::vector<Result> results(jobs_.size());
+	std::vector<std::unique_ptr<Instance>> instances;
+	std::size_t next_job = 0;
+
+	while(next_job < jobs_.size() || !instances.empty()) {
+		// Top up the set of live machines.
+		while(instances.size() < max_machines && next_job < jobs_.size()) {
+			auto instance = std::make_unique<Instance>(*this, next_job, std::move(jobs_[next_job]));
+			++next_job;
+
+			if(instance->start()) {
+				instances.push_back(std::move(instance));
+			} else {
+				results[instance->index] = std::move(instance->result);
+			}
+		}
+		if(instances.empty()) break;
+
+		// Run a slice of every machine, and wait for all to finish.
+		{
+			std::lock_guard<std::mutex> lock(slice_mutex_);
+			outstanding_instances_ = instances.size();
+		}
+		for(auto &instance: instances) {
+			instance->slice_ = std::min(slice, instance->remaining_);
+			pool_.submit(instance.get());
+		}
+		{
+			std::unique_lock<std::mutex> lock(slice_mutex_);
+			slice_condition_.wait(lock, [this] { return !outstanding_instances_; });
+		}
+
+		// Retire any machines that are finished.
+		auto retired = std::stable_partition(instances.begin(), instances.end(), [] (const std::unique_ptr<Instance> &instance) {
+			return !instance->is_finished();
+		});
+		for(auto instance = retired; instance != instances.end(); ++instance) {
+			(*instance)->finish();
+			results[(*instance)->index] = std::move((*instance)->result);
+		}
+		instances.erase(retired, instances.end());
+	}
+
+	jobs_.clear();
+	return results;
+}
@@ -0,0 +1,122 @@
+//
+//  BatchRunner.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef BatchRunner_hpp
+#define BatchRunner_hpp
+
+#include "MachineForTarget.hpp"
+
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Concurrency/WorkerPool.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	A batch runner runs a list of jobs, each of which is a machine and a period of emulated time,
+	within a single process, capturing video and audio output to memory.
+
+	Up to a nominated number of machines are alive at once. They are advanced in lock-step slices
+	of emulated time, each slice being performed for all machines in parallel on a WorkerPool,
+	and as machines complete they are replaced by those for further jobs.
+
+	Results are deterministic: a job produces the same output regardless of which other jobs
+	it is run alongside, or the number of threads available. To that end, machines are constructed
+	on the thread that calls @c run, one at a time, and each machine has its own Numeric::RandomSource,
+	seeded from its job, which is nominated for the thread on which it is constructed or run.
+
+	ROMs are fetched only once per batch runner, and retained for use by any later machine that
+	requests the same images.
+*/
+class BatchRunner {
+	public:
+		struct Job {
+			/// The targets from which to build a machine, as returned by Analyser::Static::GetTargets.
+			Analyser::Static::TargetList targets;
+
+			/// The amount of emulated time for which to run the machine.
+			Time::Seconds duration = 10.0;
+
+			/// The seed for the source of all random numbers used by the machine.
+			unsigned int seed = 0;
+
+			/// Every @c frame_interval th field will be captured; 0 indicates that no fields should be captured.
+			int frame_interval = 0;
+
+			/// The dimensions of captured fields.
+			int frame_width = 640, frame_height = 480;
+
+			/// The rate at which to capture audio; 0 indicates that audio should not be captured.
+			float audio_sample_rate = 0.0f;
+
+			/// If greater than 1, the machine is run in turbo mode: only every @c turbo_field_interval th
+			/// field is output, and audio is neither filtered nor captured. Fields that are not output
+			/// are neither captured nor counted.
+			int turbo_field_interval = 0;
+		};
+
+		struct Result {
+			/// Indicates whether the machine could be constructed.
+			Error error = Error::None;
+
+			/// The total number of fields output.
+			int fields = 0;
+
+			/// All captured fields, in RGBA order at the dimensions specified by the job.
+			std::vector<std::vector<uint8_t>> frames;
+
+			/// All captured audio, at the rate specified by the job.
+			std::vector<int16_t> audio;
+		};
+
+		/*!
+			Creates a batch runner that will obtain ROMs via @c rom_fetcher and will perform work on @c pool.
+		*/
+		BatchRunner(const ::ROMMachine::ROMFetcher &rom_fetcher, Concurrency::WorkerPool &pool = Concurrency::WorkerPool::shared());
+
+		/// Adds @c job to the batch. @returns The index of its result in the vector returned by @c run.
+		std::size_t add(Job &&job);
+
+		/*!
+			Runs all jobs added since the previous call to @c run to completion, blocking until done.
+			This should not be called from a thread that belongs to the worker pool.
+
+			@param slice The amount of emulated time for which each machine is run between synchronisation points.
+			@param max_machines The maximum number of machines to keep alive at once; if this is 0 then
+				twice the number of threads in the worker pool is used.
+			@returns The results of all jobs, in the order in which they were added.
+		*/
+		std::vector<Result> run(Time::Seconds slice = 0.02, std::size_t max_machines = 0);
+
+	private:
+		Concurrency::WorkerPool &pool_;
+		std::vector<Job> jobs_;
+
+		// ROM caching.
+		::ROMMachine::ROMFetcher rom_fetcher_;
+		std::map<std::string, std::unique_ptr<std::vector<uint8_t>>> roms_;
+		std::vector<std::unique_ptr<std::vector<uint8_t>>> fetch_roms(const std::vector<::ROMMachine::ROM> &roms);
+
+		// Synchronisation for the end of each slice.
+		class Instance;
+		std::mutex slice_mutex_;
+		std::condition_variable slice_condition_;
+		std::size_t outstanding_instances_ = 0;
+		void instance_did_complete_slice();
+};
+
+}
+
+#endif /* BatchRunner_hpp */
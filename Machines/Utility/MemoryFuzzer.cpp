@@ -8,6 +8,8 @@
 
 #include "MemoryFuzzer.hpp"
 
+#include "../../Numeric/Random.hpp"
+
 #include <cstdlib>
 
 void Memory::Fuzz(uint8_t *buffer, std::size_t size) {
@@ -19,7 +21,7 @@ void Memory::Fuzz(uint8_t *buffer, std::size_t size) {
 	}
 
 	for(std::size_t c = 0; c < size; c++) {
-		buffer[c] = static_cast<uint8_t>(std::rand() >> shift);
+		buffer[c] = static_cast<uint8_t>(Numeric::random() >> shift);
 	}
 }
 
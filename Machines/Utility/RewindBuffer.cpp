@@ -0,0 +1,207 @@
+//
+//  RewindBuffer.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "RewindBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Machine;
+
+namespace {
+
+/// The granularity at which unchanged state is detected by comparison, before any byte-by-byte work.
+constexpr std::size_t PageSize = 4096;
+
+/// The shortest run of unchanged bytes that will end a run of changed bytes; shorter runs are
+/// cheaper to store inline than to encode as a new run.
+constexpr std::size_t MinimumUnchangedRun = 4;
+
+void put_length(std::vector<uint8_t> &target, std::size_t length) {
+	while(length >= 0x80) {
+		target.push_back(uint8_t(length | 0x80));
+		length >>= 7;
+	}
+	target.push_back(uint8_t(length));
+}
+
+bool get_length(const uint8_t *&source, const uint8_t *end, std::size_t &length) {
+	length = 0;
+	int shift = 0;
+	while(source < end && shift < 64) {
+		const uint8_t next = *source;
+		++source;
+		length |= std::size_t(next & 0x7f) << shift;
+		if(!(next & 0x80)) return true;
+		shift += 7;
+	}
+	return false;
+}
+
+}
+
+RewindBuffer::RewindBuffer(CRTMachine::Machine &crt_machine, SnapshotMachine::Machine &snapshot_machine, Time::Seconds duration, int keyframe_interval) :
+	crt_machine_(crt_machine),
+	snapshot_machine_(snapshot_machine),
+	duration_(duration),
+	keyframe_interval_(std::max(keyframe_interval, 1)) {}
+
+void RewindBuffer::run_for(Time::Seconds duration) {
+	// Each period run ends at a vertical sync so may overrun the time requested; any
+	// overrun is deducted from the next call.
+	time_owed_ += duration;
+	while(time_owed_ > 0.0) {
+		const Time::Seconds ran = crt_machine_.run_until(0.0, CRTMachine::Machine::MachineEvent::VerticalSync);
+		time_owed_ -= ran;
+		time_ += ran;
+		capture();
+	}
+}
+
+void RewindBuffer::capture() {
+	std::vector<uint8_t> state = snapshot_machine_.snapshot();
+
+	Frame frame;
+	frame.time = time_;
+
+	++frames_since_keyframe_;
+	if(!frames_.empty() && state.size() == latest_.size()) {
+		encode_delta(latest_, state, delta_buffer_);
+		frame.delta.assign(delta_buffer_.begin(), delta_buffer_.end());
+		frame.has_delta = true;
+	}
+	if(!frame.has_delta || frames_since_keyframe_ >= keyframe_interval_) {
+		frame.keyframe = state;
+		frames_since_keyframe_ = 0;
+	}
+
+	memory_usage_ += frame.delta.size() + frame.keyframe.size();
+	frames_.push_back(std::move(frame));
+	latest_ = std::move(state);
+
+	// Discard history that has aged out. The oldest remaining frame never needs its delta.
+	while(frames_.size() > 1 && frames_.front().time < time_ - duration_) {
+		memory_usage_ -= frames_.front().delta.size() + frames_.front().keyframe.size();
+		frames_.pop_front();
+	}
+	memory_usage_ -= frames_.front().delta.size();
+	frames_.front().delta = std::vector<uint8_t>();
+	frames_.front().has_delta = false;
+}
+
+std::size_t RewindBuffer::size() const {
+	return frames_.size();
+}
+
+bool RewindBuffer::rewind(std::size_t frames) {
+	if(frames >= frames_.size()) return false;
+	const std::size_t target = frames_.size() - 1 - frames;
+
+	// Find the nearest keyframe at or after the target, if any, then walk backwards from there.
+	std::size_t source = target;
+	while(source < frames_.size() - 1 && frames_[source].keyframe.empty()) ++source;
+	std::vector<uint8_t> state = (source == frames_.size() - 1) ? latest_ : frames_[source].keyframe;
+
+	for(std::size_t index = source; index > target; --index) {
+		if(!frames_[index].has_delta || !apply_delta(state, frames_[index].delta)) return false;
+	}
+
+	if(!snapshot_machine_.restore(state)) return false;
+
+	// Discard everything after the target.
+	for(auto frame = frames_.begin() + std::ptrdiff_t(target) + 1; frame != frames_.end(); ++frame) {
+		memory_usage_ -= frame->delta.size() + frame->keyframe.size();
+	}
+	frames_.erase(frames_.begin() + std::ptrdiff_t(target) + 1, frames_.end());
+	latest_ = std::move(state);
+	time_ = frames_.back().time;
+	time_owed_ = 0.0;
+
+	frames_since_keyframe_ = 0;
+	for(auto frame = frames_.rbegin(); frame != frames_.rend() && frame->keyframe.empty(); ++frame) {
+		++frames_since_keyframe_;
+	}
+	return true;
+}
+
+void RewindBuffer::clear() {
+	frames_.clear();
+	latest_ = std::vector<uint8_t>();
+	frames_since_keyframe_ = 0;
+	memory_usage_ = 0;
+}
+
+std::size_t RewindBuffer::memory_usage() const {
+	return memory_usage_ + latest_.size();
+}
+
+// MARK: - Delta encoding.
+
+/*
+	A delta is a sequence of pairs of lengths, each followed by a run of bytes: the first length is the
+	number of bytes that are unchanged, the second is the number of bytes that follow, each of which is
+	the exclusive OR of the old and new values. Anything beyond the final run is unchanged.
+*/
+void RewindBuffer::encode_delta(const std::vector<uint8_t> &from, const std::vector<uint8_t> &to, std::vector<uint8_t> &delta) {
+	delta.clear();
+
+	std::size_t unchanged = 0;
+	std::size_t position = 0;
+	while(position < to.size()) {
+		const std::size_t page_end = std::min(position + PageSize, to.size());
+
+		// Skip entire pages cheaply.
+		if(!memcmp(&from[position], &to[position], page_end - position)) {
+			unchanged += page_end - position;
+			position = page_end;
+			continue;
+		}
+
+		while(position < page_end) {
+			if(from[position] == to[position]) {
+				++unchanged;
+				++position;
+				continue;
+			}
+
+			// Find the end of this run of changes, tolerating short runs of unchanged bytes.
+			std::size_t last_change = position;
+			for(std::size_t end = position + 1; end < page_end && end - last_change <= MinimumUnchangedRun; ++end) {
+				if(from[end] != to[end]) last_change = end;
+			}
+
+			put_length(delta, unchanged);
+			put_length(delta, last_change + 1 - position);
+			for(; position <= last_change; ++position) {
+				delta.push_back(from[position] ^ to[position]);
+			}
+			unchanged = 0;
+		}
+	}
+}
+
+bool RewindBuffer::apply_delta(std::vector<uint8_t> &state, const std::vector<uint8_t> &delta) {
+	const uint8_t *source = delta.data();
+	const uint8_t *const end = source + delta.size();
+
+	std::size_t position = 0;
+	while(source < end) {
+		std::size_t unchanged, length;
+		if(!get_length(source, end, unchanged) || !get_length(source, end, length)) return false;
+
+		position += unchanged;
+		if(position > state.size() || length > state.size() - position || length > std::size_t(end - source)) return false;
+
+		for(std::size_t c = 0; c < length; ++c) {
+			state[position + c] ^= source[c];
+		}
+		source += length;
+		position += length;
+	}
+	return true;
+}
@@ -0,0 +1,112 @@
+//
+//  RewindBuffer.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef RewindBuffer_hpp
+#define RewindBuffer_hpp
+
+#include "../CRTMachine.hpp"
+#include "../SnapshotMachine.hpp"
+
+#include "../../ClockReceiver/TimeTypes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	A rewind buffer runs a machine and captures its state at every vertical sync, retaining
+	a nominated period of history to which the machine can subsequently be returned.
+
+	Every @c keyframe_interval th capture is stored in full; all others are stored as
+	the exclusive OR of consecutive snapshots, page by page, with runs of unchanged bytes
+	— including whole unchanged pages — run-length encoded. Memory use between keyframes
+	is therefore proportional to the amount of state that changes from frame to frame
+	rather than to the total size of the machine's memory.
+
+	As an exclusive OR delta can be applied in either direction, returning to a frame
+	involves walking backwards from the nearest subsequent keyframe, or from the most
+	recent frame.
+*/
+class RewindBuffer {
+	public:
+		/*!
+			Creates a rewind buffer for a machine; both references should be to the same machine.
+
+			@param duration The period of emulated time for which history should be retained.
+			@param keyframe_interval The number of frames between each full snapshot.
+		*/
+		RewindBuffer(CRTMachine::Machine &crt_machine, SnapshotMachine::Machine &snapshot_machine, Time::Seconds duration = 10.0, int keyframe_interval = 60);
+
+		/*!
+			Runs the machine for @c duration seconds, capturing state whenever a vertical
+			sync occurs. This should be used in place of the machine's own @c run_for.
+
+			The machine is always run up to a vertical sync, so may run for slightly longer than
+			requested; any excess is deducted from the duration of the next call.
+		*/
+		void run_for(Time::Seconds duration);
+
+		/// @returns The number of frames currently available to return to, including the most recent.
+		std::size_t size() const;
+
+		/*!
+			Returns the machine to the state it was in @c frames captures ago, discarding all
+			subsequent history; a value of 0 returns the machine to the most recent capture.
+
+			@returns @c true if the machine was returned to that state; @c false if insufficient
+				history is available, in which case neither the machine nor the buffer is modified,
+				or if the machine declined to restore the state, in which case the buffer is unmodified
+				but the machine's state is undefined as per SnapshotMachine::Machine::restore_state.
+		*/
+		bool rewind(std::size_t frames);
+
+		/// Discards all history.
+		void clear();
+
+		/// @returns The number of bytes currently occupied by stored history.
+		std::size_t memory_usage() const;
+
+	private:
+		CRTMachine::Machine &crt_machine_;
+		SnapshotMachine::Machine &snapshot_machine_;
+		const Time::Seconds duration_;
+		const int keyframe_interval_;
+
+		struct Frame {
+			/// The emulated time at which this frame was captured.
+			Time::Seconds time = 0.0;
+
+			/// The complete state at this frame, if this is a keyframe; otherwise empty.
+			std::vector<uint8_t> keyframe;
+
+			/// The delta from the previous frame's state to this one, if @c has_delta is @c true. There is no
+			/// delta if there is no previous frame or the states are of different sizes, in which case this
+			/// frame will be a keyframe.
+			std::vector<uint8_t> delta;
+			bool has_delta = false;
+		};
+		std::deque<Frame> frames_;
+		std::vector<uint8_t> latest_;
+		Time::Seconds time_ = 0.0;
+		int frames_since_keyframe_ = 0;
+		Time::Seconds time_owed_ = 0.0;
+		std::size_t memory_usage_ = 0;
+		std::vector<uint8_t> delta_buffer_;
+
+		void capture();
+
+		static void encode_delta(const std::vector<uint8_t> &from, const std::vector<uint8_t> &to, std::vector<uint8_t> &delta);
+		static bool apply_delta(std::vector<uint8_t> &state, const std::vector<uint8_t> &delta);
+};
+
+}
+
+#endif /* RewindBuffer_hpp */
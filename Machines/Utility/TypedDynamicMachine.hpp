@@ -49,6 +49,10 @@ template<typename T> class TypedDynamicMachine: public ::Machine::DynamicMachine
 			return get<MouseMachine::Machine>();
 		}
 
+		SnapshotMachine::Machine *snapshot_machine() final {
+			return get<SnapshotMachine::Machine>();
+		}
+
 		Configurable::Device *configurable_device() final {
 			return get<Configurable::Device>();
 		}
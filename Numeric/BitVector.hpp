@@ -0,0 +1,347 @@
+//
+//  BitVector.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef BitVector_hpp
+#define BitVector_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace Numeric {
+
+/*!
+	A growable sequence of bits, packed most-significant bit first into 64-bit words so that it
+	can be searched, copied and serialised a word at a time.
+
+	Its interface is largely a subset of that of std::vector<bool>, with the addition of word-oriented
+	operations. Bits beyond the end of the vector but within its final word are always zero.
+*/
+class BitVector {
+	public:
+		BitVector() = default;
+
+		BitVector(std::size_t size, bool value = false) {
+			resize(size, value);
+		}
+
+		BitVector(std::initializer_list<bool> bits) {
+			reserve(bits.size());
+			for(const auto bit: bits) push_back(bit);
+		}
+
+		/// @returns The number of bits in this vector.
+		std::size_t size() const {
+			return size_;
+		}
+
+		/// @returns @c true if this vector contains no bits; @c false otherwise.
+		bool empty() const {
+			return !size_;
+		}
+
+		/// Removes all bits.
+		void clear() {
+			words_.clear();
+			size_ = 0;
+		}
+
+		/// Allocates storage for at least @c size bits.
+		void reserve(std::size_t size) {
+			words_.reserve(word_count(size));
+		}
+
+		/// Truncates this vector to @c size bits, or extends it with bits of value @c value.
+		void resize(std::size_t size, bool value = false) {
+			const std::size_t original_size = size_;
+			words_.resize(word_count(size), 0);
+			size_ = size;
+
+			if(size > original_size) {
+				if(value) fill(original_size, size, true);
+			} else if(size & 63) {
+				words_.back() &= ~(all_ones >> (size & 63));
+			}
+		}
+
+		/// Appends @c value.
+		void push_back(bool value) {
+			if(!(size_ & 63)) words_.push_back(0);
+			if(value) words_.back() |= top_bit >> (size_ & 63);
+			++size_;
+		}
+
+		/// @returns The value of the bit at @c index.
+		bool operator[](std::size_t index) const {
+			return (words_[index >> 6] << (index & 63)) >> 63;
+		}
+
+		/// Acts as a reference to a single bit.
+		class reference {
+			public:
+				operator bool() const {
+					return *word_ & mask_;
+				}
+
+				reference &operator =(bool value) {
+					if(value) *word_ |= mask_;
+					else *word_ &= ~mask_;
+					return *this;
+				}
+
+				reference &operator =(const reference &rhs) {
+					return *this = bool(rhs);
+				}
+
+			private:
+				reference(uint64_t *word, uint64_t mask) : word_(word), mask_(mask) {}
+				uint64_t *const word_;
+				const uint64_t mask_;
+				friend class BitVector;
+		};
+
+		/// @returns A reference to the bit at @c index.
+		reference operator[](std::size_t index) {
+			return reference(&words_[index >> 6], top_bit >> (index & 63));
+		}
+
+		/// Provides iteration through all bits, in order, allowing them to be modified.
+		class iterator {
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = bool;
+				using difference_type = std::ptrdiff_t;
+				using pointer = void;
+				using reference = BitVector::reference;
+
+				reference operator *() const {
+					return (*vector_)[index_];
+				}
+
+				iterator &operator ++() {
+					++index_;
+					return *this;
+				}
+
+				iterator operator ++(int) {
+					const iterator result = *this;
+					++index_;
+					return result;
+				}
+
+				bool operator ==(const iterator &rhs) const {
+					return index_ == rhs.index_;
+				}
+
+				bool operator !=(const iterator &rhs) const {
+					return index_ != rhs.index_;
+				}
+
+			private:
+				iterator(BitVector *vector, std::size_t index) : vector_(vector), index_(index) {}
+				BitVector *vector_;
+				std::size_t index_;
+				friend class BitVector;
+		};
+
+		/// Provides iteration through the values of all bits, in order.
+		class const_iterator {
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = bool;
+				using difference_type = std::ptrdiff_t;
+				using pointer = void;
+				using reference = bool;
+
+				bool operator *() const {
+					return (*vector_)[index_];
+				}
+
+				const_iterator &operator ++() {
+					++index_;
+					return *this;
+				}
+
+				const_iterator operator ++(int) {
+					const const_iterator result = *this;
+					++index_;
+					return result;
+				}
+
+				bool operator ==(const const_iterator &rhs) const {
+					return index_ == rhs.index_;
+				}
+
+				bool operator !=(const const_iterator &rhs) const {
+					return index_ != rhs.index_;
+				}
+
+			private:
+				const_iterator(const BitVector *vector, std::size_t index) : vector_(vector), index_(index) {}
+				const BitVector *vector_;
+				std::size_t index_;
+				friend class BitVector;
+		};
+
+		iterator begin() {
+			return iterator(this, 0);
+		}
+
+		iterator end() {
+			return iterator(this, size_);
+		}
+
+		const_iterator begin() const {
+			return const_iterator(this, 0);
+		}
+
+		const_iterator end() const {
+			return const_iterator(this, size_);
+		}
+
+		const_iterator cbegin() const {
+			return begin();
+		}
+
+		const_iterator cend() const {
+			return end();
+		}
+
+		bool operator ==(const BitVector &rhs) const {
+			return size_ == rhs.size_ && words_ == rhs.words_;
+		}
+
+		bool operator !=(const BitVector &rhs) const {
+			return !(*this == rhs);
+		}
+
+		// MARK: - Word-oriented operations.
+
+		/// @returns The words in which bits are stored; bit @c n is found in bit 63 - (n & 63) of word n >> 6.
+		const std::vector<uint64_t> &words() const {
+			return words_;
+		}
+
+		/*!
+			@returns The 64 bits beginning at @c index, with that at @c index in the most-significant position.
+			Bits beyond the end of the vector are returned as zero.
+		*/
+		uint64_t word_at(std::size_t index) const {
+			const std::size_t word = index >> 6;
+			const int offset = int(index & 63);
+			if(word >= words_.size()) return 0;
+
+			uint64_t result = words_[word] << offset;
+			if(offset && word + 1 < words_.size()) result |= words_[word + 1] >> (64 - offset);
+			return result;
+		}
+
+		/*!
+			@returns The index of the first set bit at or after @c index, or size() if there is no such bit.
+		*/
+		std::size_t find_next_set(std::size_t index) const {
+			std::size_t word = index >> 6;
+			if(word >= words_.size()) return size_;
+
+			uint64_t bits = words_[word] & (all_ones >> (index & 63));
+			while(!bits) {
+				++word;
+				if(word == words_.size()) return size_;
+				bits = words_[word];
+			}
+			return (word << 6) + leading_zeros(bits);
+		}
+
+		/// Sets all bits from @c begin up to but not including @c end to @c value.
+		void fill(std::size_t begin, std::size_t end, bool value) {
+			while(begin < end) {
+				const int offset = int(begin & 63);
+				const std::size_t count = std::min(end - begin, std::size_t(64 - offset));
+				const uint64_t mask = (count == 64) ? all_ones : (((uint64_t(1) << count) - 1) << (64 - offset - count));
+
+				if(value) words_[begin >> 6] |= mask;
+				else words_[begin >> 6] &= ~mask;
+				begin += count;
+			}
+		}
+
+		/// Appends the @c count most-significant bits of @c bits, which may be at most 64.
+		void append_bits(uint64_t bits, std::size_t count) {
+			if(!count) return;
+			if(count < 64) bits &= ~(all_ones >> count);
+
+			const int offset = int(size_ & 63);
+			if(!offset) {
+				words_.push_back(bits);
+			} else {
+				words_.back() |= bits >> offset;
+				if(std::size_t(offset) + count > 64) words_.push_back(bits << (64 - offset));
+			}
+			size_ += count;
+		}
+
+		/// Appends the bits of @c source from @c begin up to but not including @c end.
+		void append(const BitVector &source, std::size_t begin, std::size_t end) {
+			reserve(size_ + end - begin);
+			while(begin < end) {
+				const std::size_t count = std::min(end - begin, std::size_t(64));
+				append_bits(source.word_at(begin), count);
+				begin += count;
+			}
+		}
+
+		/// Appends all bits of @c rhs.
+		BitVector &operator +=(const BitVector &rhs) {
+			append(rhs, 0, rhs.size_);
+			return *this;
+		}
+
+		/// Rotates all bits towards the end of the vector by @c length places, moving those that pass the end to the front.
+		void rotate_right(std::size_t length) {
+			if(!size_) return;
+			length %= size_;
+			if(!length) return;
+
+			BitVector result;
+			result.append(*this, size_ - length, size_);
+			result.append(*this, 0, size_ - length);
+			*this = std::move(result);
+		}
+
+	private:
+		std::vector<uint64_t> words_;
+		std::size_t size_ = 0;
+
+		static constexpr uint64_t all_ones = ~uint64_t(0);
+		static constexpr uint64_t top_bit = uint64_t(1) << 63;
+
+		static constexpr std::size_t word_count(std::size_t size) {
+			return (size + 63) >> 6;
+		}
+
+		/// @returns The number of leading zeros in @c bits, which must be non-zero.
+		static int leading_zeros(uint64_t bits) {
+#if defined(__GNUC__)
+			return __builtin_clzll(bits);
+#else
+			int result = 0;
+			while(!(bits & top_bit)) {
+				bits <<= 1;
+				++result;
+			}
+			return result;
+#endif
+		}
+};
+
+}
+
+#endif /* BitVector_hpp */
@@ -9,6 +9,8 @@
 #ifndef LFSR_h
 #define LFSR_h
 
+#include "Random.hpp"
+
 namespace Numeric {
 
 template <typename IntType> struct LSFRPolynomial {};
@@ -34,25 +36,26 @@ template <> struct LSFRPolynomial<uint8_t> {
 	Provides a linear-feedback shift register with a random initial state; if no polynomial is supplied
 	then one will be picked that is guaranteed to give the maximal number of LFSR states that can fit
 	in the specified int type.
+
+	The initial state is obtained from @c Numeric::random when the register is first advanced rather
+	than upon construction, so that it is drawn on the thread that uses the register.
 */
 template <typename IntType = uint64_t, IntType polynomial = LSFRPolynomial<IntType>::value> class LFSR {
 	public:
-		LFSR() {
+		/*!
+			Advances the LSFR, returning either an @c IntType of value @c 1 or @c 0,
+			determining the bit that was just shifted out.
+		*/
+		IntType next() {
 			// Randomise the value, ensuring it doesn't end up being 0.
 			while(!value_) {
 				uint8_t *value_byte = reinterpret_cast<uint8_t *>(&value_);
 				for(size_t c = 0; c < sizeof(IntType); ++c) {
-					*value_byte = uint8_t(uint64_t(rand()) * 255 / RAND_MAX);
+					*value_byte = uint8_t(uint64_t(random()) * 255 / RAND_MAX);
 					++value_byte;
 				}
 			}
-		}
 
-		/*!
-			Advances the LSFR, returning either an @c IntType of value @c 1 or @c 0,
-			determining the bit that was just shifted out.
-		*/
-		IntType next() {
 			const auto result = value_ & 1;
 			value_ = (value_ >> 1) ^ (result * polynomial);
 			return result;
@@ -0,0 +1,66 @@
+//
+//  Random.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Random_hpp
+#define Random_hpp
+
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
+namespace Numeric {
+
+/*!
+	A seedable source of pseudo-random numbers that can be nominated as the source for
+	@c Numeric::random on a particular thread, so that components that randomise their
+	state draw from it rather than from the process-wide @c std::rand.
+
+	This allows an owner of several machines to give each its own reproducible sequence,
+	regardless of which threads the machines happen to be run on.
+*/
+class RandomSource {
+	public:
+		explicit RandomSource(unsigned int seed) : generator_(seed) {}
+
+		/// @returns A number in the range [0, RAND_MAX].
+		int next() {
+			return int(uint64_t(generator_()) % (uint64_t(RAND_MAX) + 1));
+		}
+
+		/*!
+			Nominates a source as that used by @c Numeric::random on the calling thread for the lifetime
+			of this object, restoring the previous nomination upon destruction.
+		*/
+		class Scope {
+			public:
+				Scope(RandomSource &source) : previous_(current_) {
+					current_ = &source;
+				}
+				~Scope() {
+					current_ = previous_;
+				}
+
+			private:
+				RandomSource *const previous_;
+		};
+
+	private:
+		std::minstd_rand generator_;
+		static inline thread_local RandomSource *current_ = nullptr;
+
+		friend int random();
+};
+
+/// @returns A number in the range [0, RAND_MAX], from this thread's nominated RandomSource if there is one, or from @c std::rand otherwise.
+inline int random() {
+	return RandomSource::current_ ? RandomSource::current_->next() : std::rand();
+}
+
+}
+
+#endif /* Random_hpp */
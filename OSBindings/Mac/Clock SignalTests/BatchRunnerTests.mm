@@ -0,0 +1,102 @@
+//
+//  BatchRunnerTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Utility/BatchRunner.hpp"
+#include "../../../Analyser/Static/Atari2600/Target.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// @returns A target for an Atari 2600 running a program that continuously copies the RIOT timer,
+/// which has a random initial value, to the background colour.
+Analyser::Static::TargetList timer_display_target() {
+	std::vector<uint8_t> rom(4096, 0xea);
+	const uint8_t program[] = {
+		0xad, 0x84, 0x02,	// LDA INTIM
+		0x85, 0x09,			// STA COLUBK
+		0x85, 0x02,			// STA WSYNC
+		0x4c, 0x00, 0xf0,	// JMP $f000
+	};
+	std::copy(std::begin(program), std::end(program), rom.begin());
+	rom[0xffc] = 0x00;
+	rom[0xffd] = 0xf0;
+
+	auto target = std::make_unique<Analyser::Static::Atari2600::Target>();
+	target->machine = Analyser::Machine::Atari2600;
+	target->media.cartridges.push_back(std::make_shared<Storage::Cartridge::Cartridge>(
+		std::vector<Storage::Cartridge::Cartridge::Segment>{{0x1000, std::move(rom)}}
+	));
+
+	Analyser::Static::TargetList targets;
+	targets.push_back(std::move(target));
+	return targets;
+}
+
+/// Runs one job for each of @c seeds, at most @c max_machines at a time, while another thread calls
+/// @c std::rand continuously.
+std::vector<Machine::BatchRunner::Result> run_batch(const std::vector<unsigned int> &seeds, std::size_t max_machines) {
+	Machine::BatchRunner runner([] (const std::vector<::ROMMachine::ROM> &roms) {
+		return std::vector<std::unique_ptr<std::vector<uint8_t>>>(roms.size());
+	});
+	for(const auto seed: seeds) {
+		Machine::BatchRunner::Job job;
+		job.targets = timer_display_target();
+		job.duration = 0.5;
+		job.seed = seed;
+		job.frame_interval = 5;
+		job.frame_width = 80;
+		job.frame_height = 60;
+		runner.add(std::move(job));
+	}
+
+	std::atomic<bool> is_running(true);
+	std::thread interference([&is_running] {
+		while(is_running) std::rand();
+	});
+	auto results = runner.run(0.02, max_machines);
+	is_running = false;
+	interference.join();
+
+	return results;
+}
+
+}
+
+@interface BatchRunnerTests : XCTestCase
+@end
+
+@implementation BatchRunnerTests
+
+- (void)testRepeatedBatchesMatch {
+	const std::vector<unsigned int> seeds = {1, 2, 3, 1, 4, 5, 2, 6};
+	const auto first = run_batch(seeds, 0);
+	const auto second = run_batch(seeds, 3);
+
+	XCTAssertEqual(first.size(), seeds.size());
+	XCTAssertEqual(second.size(), seeds.size());
+	for(std::size_t c = 0; c < seeds.size(); ++c) {
+		XCTAssertEqual(first[c].error, Machine::Error::None);
+		XCTAssertGreaterThan(first[c].frames.size(), 0);
+		XCTAssertEqual(first[c].fields, second[c].fields, @"Field counts differ for job %zu", c);
+		XCTAssert(first[c].frames == second[c].frames, @"Frames differ for job %zu", c);
+	}
+
+	// Jobs with the same seed should match one another, and those with different seeds should not.
+	XCTAssert(first[0].frames == first[3].frames);
+	XCTAssert(first[1].frames == first[6].frames);
+	XCTAssert(first[0].frames != first[1].frames);
+}
+
+@end
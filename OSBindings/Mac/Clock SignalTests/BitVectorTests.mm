@@ -0,0 +1,169 @@
+//
+//  BitVectorTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Numeric/BitVector.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// @returns A pseudo-random pattern of @c size bits.
+std::vector<bool> pattern(std::size_t size, uint32_t seed) {
+	std::vector<bool> result;
+	for(std::size_t c = 0; c < size; ++c) {
+		seed = seed * 1664525 + 1013904223;
+		result.push_back(seed & 0x10000);
+	}
+	return result;
+}
+
+Numeric::BitVector bit_vector(const std::vector<bool> &bits) {
+	Numeric::BitVector result;
+	for(const auto bit: bits) result.push_back(bit);
+	return result;
+}
+
+bool equals(const Numeric::BitVector &lhs, const std::vector<bool> &rhs) {
+	return lhs.size() == rhs.size() && std::equal(rhs.begin(), rhs.end(), lhs.begin());
+}
+
+/// @returns @c true if all bits of @c vector's final word that lie beyond its end are zero.
+bool tail_is_clear(const Numeric::BitVector &vector) {
+	if(!(vector.size() & 63)) return true;
+	return !(vector.words().back() << (vector.size() & 63));
+}
+
+}
+
+@interface BitVectorTests : XCTestCase
+@end
+
+@implementation BitVectorTests
+
+- (void)testTailMasking {
+	// Shrinking should clear the bits that are removed, so that growing again exposes only zeroes.
+	Numeric::BitVector vector(130, true);
+	XCTAssert(tail_is_clear(vector));
+	XCTAssertEqual(vector.words().size(), 3);
+
+	vector.resize(70);
+	XCTAssert(tail_is_clear(vector));
+	XCTAssertEqual(vector.words().size(), 2);
+	XCTAssertEqual(vector.words()[1], 0xfc00'0000'0000'0000);
+
+	vector.resize(128);
+	for(std::size_t c = 0; c < 128; ++c) {
+		XCTAssertEqual(vector[c], c < 70);
+	}
+
+	// Reading a word that runs off the end should produce zeroes.
+	XCTAssertEqual(vector.word_at(64), 0xfc00'0000'0000'0000);
+	XCTAssertEqual(vector.word_at(66), 0xf000'0000'0000'0000);
+	XCTAssertEqual(vector.word_at(200), 0);
+
+	// Appending a partial word should not set anything beyond the appended bits.
+	Numeric::BitVector appended;
+	appended.append_bits(0xffff'ffff'ffff'ffff, 3);
+	XCTAssertEqual(appended.size(), 3);
+	XCTAssert(tail_is_clear(appended));
+	XCTAssertEqual(appended.words()[0], 0xe000'0000'0000'0000);
+}
+
+- (void)testFindNextSet {
+	for(const std::size_t size: {1, 63, 64, 65, 127, 128, 129, 300}) {
+		const auto bits = pattern(size, uint32_t(size));
+
+		// Sparse bits, including those either side of word boundaries.
+		std::vector<bool> sparse(size);
+		for(const std::size_t index: {0, 5, 63, 64, 127, 128, 190, 299}) {
+			if(index < size) sparse[index] = true;
+		}
+
+		for(const auto &reference: {bits, sparse, std::vector<bool>(size)}) {
+			const auto vector = bit_vector(reference);
+			for(std::size_t index = 0; index <= size + 64; ++index) {
+				std::size_t expected = index;
+				while(expected < size && !reference[expected]) ++expected;
+				expected = std::min(expected, size);
+				XCTAssertEqual(vector.find_next_set(index), expected, @"Size %zu, index %zu", size, index);
+			}
+		}
+	}
+}
+
+- (void)testResize {
+	const auto bits = pattern(200, 1);
+	for(const std::size_t initial: {0, 1, 64, 100, 200}) {
+		for(const std::size_t size: {0, 3, 64, 65, 150, 250}) {
+			for(const bool value: {false, true}) {
+				std::vector<bool> reference(bits.begin(), bits.begin() + initial);
+				auto vector = bit_vector(reference);
+
+				reference.resize(size, value);
+				vector.resize(size, value);
+				XCTAssert(equals(vector, reference), @"Resize from %zu to %zu with %d", initial, size, value);
+				XCTAssert(tail_is_clear(vector));
+			}
+		}
+	}
+}
+
+- (void)testAppend {
+	const auto source_bits = pattern(300, 2);
+	const auto source = bit_vector(source_bits);
+
+	for(const std::size_t initial: {0, 1, 63, 64, 65}) {
+		for(const std::size_t begin: {0, 1, 63, 64, 100}) {
+			for(const std::size_t end: {100, 127, 128, 129, 300}) {
+				std::vector<bool> reference = pattern(initial, 3);
+				auto vector = bit_vector(reference);
+
+				reference.insert(reference.end(), source_bits.begin() + begin, source_bits.begin() + end);
+				vector.append(source, begin, end);
+				XCTAssert(equals(vector, reference), @"Append [%zu, %zu) to %zu bits", begin, end, initial);
+				XCTAssert(tail_is_clear(vector));
+			}
+		}
+	}
+
+	// Also check concatenation and rotation, which are built upon append.
+	auto concatenated = bit_vector(pattern(70, 4));
+	concatenated += source;
+	auto reference = pattern(70, 4);
+	reference.insert(reference.end(), source_bits.begin(), source_bits.end());
+	XCTAssert(equals(concatenated, reference));
+
+	concatenated.rotate_right(75);
+	std::rotate(reference.begin(), reference.end() - 75, reference.end());
+	XCTAssert(equals(concatenated, reference));
+}
+
+- (void)testMutableIteration {
+	Numeric::BitVector vector(100);
+	std::fill(vector.begin(), vector.end(), true);
+	XCTAssertEqual(vector.find_next_set(0), 0);
+	XCTAssert(tail_is_clear(vector));
+	for(const auto bit: std::as_const(vector)) {
+		XCTAssert(bit);
+	}
+
+	std::size_t index = 0;
+	for(auto bit: vector) {
+		bit = (index % 3) == 0;
+		++index;
+	}
+	for(std::size_t c = 0; c < 100; ++c) {
+		XCTAssertEqual(vector[c], (c % 3) == 0);
+	}
+}
+
+@end
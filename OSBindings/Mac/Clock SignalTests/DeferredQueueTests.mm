@@ -0,0 +1,110 @@
+//
+//  DeferredQueueTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../ClockReceiver/DeferredQueue.hpp"
+#include "../../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <malloc/malloc.h>
+#include <vector>
+
+namespace {
+
+/// @returns The number of heap blocks currently in use by this process.
+size_t blocks_in_use() {
+	malloc_statistics_t statistics;
+	malloc_zone_statistics(nullptr, &statistics);
+	return statistics.blocks_in_use;
+}
+
+}
+
+@interface DeferredQueueTests : XCTestCase
+@end
+
+@implementation DeferredQueueTests
+
+- (void)testOrdering {
+	std::vector<int> events;
+	DeferredQueue<Cycles> queue([&events] (Cycles length) {
+		events.push_back(-int(length.as_integral()));
+	});
+
+	// Schedule out of order, and schedule one action from within another.
+	queue.defer(Cycles(5), [&events] { events.push_back(1); });
+	queue.defer(Cycles(5), [&events, &queue] {
+		events.push_back(2);
+		queue.defer(Cycles(0), [&events] { events.push_back(3); });
+	});
+	queue.defer(Cycles(2), [&events] { events.push_back(0); });
+
+	queue.run_for(Cycles(3));
+	queue.run_for(Cycles(10));
+
+	const std::vector<int> expected = {-2, 0, -1, -2, 1, 2, 3, -8};
+	XCTAssert(events == expected);
+}
+
+- (void)testDeferredQueueSteadyStateIsAllocationFree {
+	int performed = 0;
+	DeferredQueue<Cycles> queue([] (Cycles) {});
+
+	const auto run = [&] {
+		for(int c = 0; c < 100000; ++c) {
+			queue.defer(Cycles(2), [&performed] { ++performed; });
+			queue.defer(Cycles(3), [&performed] { ++performed; });
+			queue.run_for(Cycles(7));
+		}
+	};
+
+	run();
+	const size_t blocks = blocks_in_use();
+	run();
+	XCTAssertEqual(blocks, blocks_in_use());
+	XCTAssertEqual(performed, 400000);
+}
+
+- (void)testDeferringAsyncTaskQueueSteadyStateIsAllocationFree {
+	int performed = 0;
+	Concurrency::DeferringAsyncTaskQueue queue;
+
+	const auto run = [&] {
+		for(int c = 0; c < 1000; ++c) {
+			for(int t = 0; t < 100; ++t) {
+				queue.defer([&performed] { ++performed; });
+			}
+			queue.perform();
+			queue.flush();
+		}
+	};
+
+	run();
+	const size_t blocks = blocks_in_use();
+	run();
+
+	// Apple's AsyncTaskQueue is built upon libdispatch, which may hold on to
+	// allocations of its own; permit a little slack.
+	XCTAssertLessThanOrEqual(blocks_in_use(), blocks + 16);
+	XCTAssertEqual(performed, 200000);
+}
+
+- (void)testDeferredQueuePerformance {
+	[self measureBlock:^{
+		DeferredQueue<Cycles> queue([] (Cycles) {});
+		int performed = 0;
+
+		for(int c = 0; c < 1000000; ++c) {
+			queue.defer(Cycles(2), [&performed] { ++performed; });
+			queue.run_for(Cycles(5));
+		}
+	}];
+}
+
+@end
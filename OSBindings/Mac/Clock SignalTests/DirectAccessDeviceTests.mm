@@ -0,0 +1,175 @@
+//
+//  DirectAccessDeviceTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/MassStorage/SCSI/DirectAccessDevice.hpp"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// A mass storage device in which every byte of each block is the low byte of its address, and which records
+/// all writes, prefetches and flushes.
+struct TestDevice: public Storage::MassStorage::MassStorageDevice {
+	size_t get_block_size() final {
+		return 512;
+	}
+
+	size_t get_number_of_blocks() final {
+		return 1000;
+	}
+
+	std::vector<uint8_t> get_block(size_t address) final {
+		return std::vector<uint8_t>(512, uint8_t(address));
+	}
+
+	void set_block(size_t address, const std::vector<uint8_t> &contents) final {
+		writes[address] = contents;
+		is_flushed = false;
+	}
+
+	void prefetch(size_t address, size_t count) final {
+		prefetches.emplace_back(address, count);
+	}
+
+	bool flush() final {
+		is_flushed = flush_succeeds;
+		return flush_succeeds;
+	}
+
+	std::map<size_t, std::vector<uint8_t>> writes;
+	std::vector<std::pair<size_t, size_t>> prefetches;
+	bool is_flushed = true;
+	bool flush_succeeds = true;
+};
+
+/// Performs a single command, supplying any data requested from @c input and retaining any data sent, and the final status.
+struct TestResponder: public SCSI::Target::Responder {
+	TestResponder(const std::vector<uint8_t> &command, const std::vector<uint8_t> &input = {}) :
+		command(command), input(input) {}
+
+	void send_data(std::vector<uint8_t> &&data, continuation next) final {
+		output = std::move(data);
+		next(SCSI::Target::CommandState(command, received), *this);
+	}
+
+	void receive_data(size_t length, continuation next) final {
+		received.assign(input.begin(), input.begin() + ssize_t(length));
+		next(SCSI::Target::CommandState(command, received), *this);
+	}
+
+	void send_status(Status status, continuation next) final {
+		this->status = status;
+		next(SCSI::Target::CommandState(command, received), *this);
+	}
+
+	void send_message(Message, continuation next) final {
+		next(SCSI::Target::CommandState(command, received), *this);
+	}
+
+	void end_command() final {
+		did_end = true;
+	}
+
+	SCSI::Target::CommandState state() const {
+		return SCSI::Target::CommandState(command, received);
+	}
+
+	const std::vector<uint8_t> command, input;
+	std::vector<uint8_t> received, output;
+	Status status = Status::Busy;
+	bool did_end = false;
+};
+
+/// @returns A READ(6) command for @c count blocks from @c address.
+std::vector<uint8_t> read6(uint32_t address, uint8_t count) {
+	return {0x08, uint8_t(address >> 16), uint8_t(address >> 8), uint8_t(address), count, 0x00};
+}
+
+/// @returns A WRITE(6) command for @c count blocks from @c address.
+std::vector<uint8_t> write6(uint32_t address, uint8_t count) {
+	return {0x0a, uint8_t(address >> 16), uint8_t(address >> 8), uint8_t(address), count, 0x00};
+}
+
+}
+
+@interface DirectAccessDeviceTests : XCTestCase
+@end
+
+@implementation DirectAccessDeviceTests
+
+- (void)testReadAhead {
+	auto device = std::make_shared<TestDevice>();
+	SCSI::DirectAccessDevice executor;
+	executor.set_storage(device);
+
+	// A first read, from the start of the device, should return the blocks requested and should be taken to be sequential.
+	TestResponder first(read6(0, 4));
+	XCTAssertTrue(executor.read(first.state(), first));
+	XCTAssertTrue(first.did_end);
+	XCTAssertEqual(first.status, SCSI::Target::Responder::Status::Good);
+	XCTAssertEqual(first.output.size(), 4 * 512);
+	for(size_t c = 0; c < first.output.size(); ++c) {
+		XCTAssertEqual(first.output[c], c / 512);
+	}
+	XCTAssertEqual(device->prefetches, (std::vector<std::pair<size_t, size_t>>{{4, 4}}));
+
+	// A continuation should prompt a read-ahead of the same length.
+	TestResponder second(read6(4, 8));
+	XCTAssertTrue(executor.read(second.state(), second));
+	XCTAssertEqual(second.output.size(), 8 * 512);
+	XCTAssertEqual(second.output.front(), 4);
+	XCTAssertEqual(second.output.back(), 11);
+	XCTAssertEqual(device->prefetches.size(), 2);
+	XCTAssertEqual(device->prefetches.back(), (std::pair<size_t, size_t>{12, 8}));
+
+	// A read elsewhere should not.
+	TestResponder third(read6(100, 2));
+	XCTAssertTrue(executor.read(third.state(), third));
+	XCTAssertEqual(third.output.front(), 100);
+	XCTAssertEqual(device->prefetches.size(), 2);
+
+	// ... but one that follows on from it again should.
+	TestResponder fourth(read6(102, 3));
+	XCTAssertTrue(executor.read(fourth.state(), fourth));
+	XCTAssertEqual(device->prefetches.size(), 3);
+	XCTAssertEqual(device->prefetches.back(), (std::pair<size_t, size_t>{105, 3}));
+}
+
+- (void)testWriteFlushes {
+	auto device = std::make_shared<TestDevice>();
+	SCSI::DirectAccessDevice executor;
+	executor.set_storage(device);
+
+	std::vector<uint8_t> data(3 * 512);
+	for(size_t c = 0; c < data.size(); ++c) data[c] = uint8_t(c / 512 + 1);
+
+	// Each block should be written, then flushed before the command completes.
+	TestResponder write(write6(20, 3), data);
+	XCTAssertTrue(executor.write(write.state(), write));
+	XCTAssertTrue(write.did_end);
+	XCTAssertEqual(write.status, SCSI::Target::Responder::Status::Good);
+	XCTAssertTrue(device->is_flushed);
+	XCTAssertEqual(device->writes.size(), 3);
+	for(size_t c = 0; c < 3; ++c) {
+		XCTAssertEqual(device->writes[20 + c], std::vector<uint8_t>(512, uint8_t(c + 1)));
+	}
+
+	// A failure to flush should be reported.
+	device->flush_succeeds = false;
+	TestResponder failed(write6(30, 1), data);
+	XCTAssertTrue(executor.write(failed.state(), failed));
+	XCTAssertTrue(failed.did_end);
+	XCTAssertEqual(failed.status, SCSI::Target::Responder::Status::CheckCondition);
+}
+
+@end
@@ -0,0 +1,322 @@
+//
+//  DirectPageTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Processors/6502/6502.hpp"
+#include "../../../Processors/Z80/Z80.hpp"
+
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+/// Records a bus access that was observed by a test machine, and when.
+using Access = std::tuple<int, uint16_t, uint8_t, long>;
+
+/*!
+	Provides a Z80 with 64kb of RAM, of which the lower 32kb is a direct page area if @c direct is @c true,
+	a periodic IRQ that is acknowledged by output to any port, a periodic NMI and an input port that returns
+	the current time. All accesses above $8000, all input and output and all interrupt acknowledgements are
+	recorded, along with the time at which they occurred.
+*/
+template <bool direct> class Z80DirectMachine: public CPU::Z80::BusHandler {
+	public:
+		Z80DirectMachine() : z80(*this) {
+			constexpr uint8_t program[] = {
+				0x31, 0x00, 0x7f,	// LD SP, $7f00
+				0xed, 0x56,			// IM 1
+				0xfb,				// EI
+				0x21, 0x00, 0x10,	// LD HL, $1000
+				0x11, 0x00, 0x80,	// LD DE, $8000
+				0x06, 0x00,			// LD B, 0
+				0x7e,				// loop: LD A, (HL)
+				0x3c,				// INC A
+				0x77,				// LD (HL), A
+				0x12,				// LD (DE), A
+				0x1a,				// LD A, (DE)
+				0xdb, 0x10,			// IN A, ($10)
+				0x86,				// ADD A, (HL)
+				0x77,				// LD (HL), A
+				0x23,				// INC HL
+				0x7c,				// LD A, H
+				0xe6, 0x1f,			// AND $1f
+				0xf6, 0x10,			// OR $10
+				0x67,				// LD H, A
+				0x1c,				// INC E
+				0x7b,				// LD A, E
+				0xe6, 0x3f,			// AND $3f
+				0x5f,				// LD E, A
+				0x10, 0xe9,			// DJNZ loop
+				0x76,				// HALT
+				0x18, 0xe6,			// JR loop
+			};
+
+			// Acknowledge the interrupt and count it in device memory.
+			constexpr uint8_t irq_handler[] = {
+				0xf5,				// PUSH AF
+				0xd3, 0x00,			// OUT ($00), A
+				0x3a, 0x00, 0x81,	// LD A, ($8100)
+				0x3c,				// INC A
+				0x32, 0x00, 0x81,	// LD ($8100), A
+				0xf1,				// POP AF
+				0xfb,				// EI
+				0xc9,				// RET
+			};
+
+			// Count the NMI in device memory.
+			constexpr uint8_t nmi_handler[] = {
+				0xf5,				// PUSH AF
+				0x3a, 0x00, 0x82,	// LD A, ($8200)
+				0x3c,				// INC A
+				0x32, 0x00, 0x82,	// LD ($8200), A
+				0xf1,				// POP AF
+				0xed, 0x45,			// RETN
+			};
+
+			memset(ram, 0, sizeof(ram));
+			ram[0] = 0xc3;	ram[1] = 0x00;	ram[2] = 0x01;	// JP $0100
+			memcpy(&ram[0x38], irq_handler, sizeof(irq_handler));
+			memcpy(&ram[0x66], nmi_handler, sizeof(nmi_handler));
+			memcpy(&ram[0x100], program, sizeof(program));
+
+			// Registers power up with random values, so give them fixed ones.
+			for(const auto reg: {CPU::Z80::Register::AF, CPU::Z80::Register::BC, CPU::Z80::Register::DE, CPU::Z80::Register::HL}) {
+				z80.set_value_of_register(reg, 0);
+			}
+		}
+
+		HalfCycles perform_machine_cycle(const CPU::Z80::PartialMachineCycle &cycle) {
+			++calls;
+			switch(cycle.operation) {
+				case CPU::Z80::PartialMachineCycle::ReadOpcode:
+				case CPU::Z80::PartialMachineCycle::Read:
+					*cycle.value = ram[*cycle.address];
+					if(*cycle.address >= 0x8000) record(cycle);
+				break;
+				case CPU::Z80::PartialMachineCycle::Write:
+					ram[*cycle.address] = *cycle.value;
+					if(*cycle.address >= 0x8000) record(cycle);
+				break;
+				case CPU::Z80::PartialMachineCycle::Input:
+					*cycle.value = uint8_t(time.as_integral());
+					record(cycle);
+				break;
+				case CPU::Z80::PartialMachineCycle::Output:
+					z80.set_interrupt_line(false);
+					record(cycle);
+				break;
+				case CPU::Z80::PartialMachineCycle::Interrupt:
+					*cycle.value = 0xff;
+					record(cycle);
+				break;
+				default: break;
+			}
+			advance(cycle.length);
+			return HalfCycles(0);
+		}
+
+		static constexpr bool has_direct_pages = direct;
+		uint8_t *direct_read_page(int page) {
+			return page < 0x80 ? &ram[page << 8] : nullptr;
+		}
+		uint8_t *direct_write_page(int page) {
+			return page < 0x80 ? &ram[page << 8] : nullptr;
+		}
+		bool direct_internal_cycles() {
+			return true;
+		}
+
+		void advance(HalfCycles duration) {
+			time += duration;
+			if(time >= next_irq_) {
+				z80.set_interrupt_line(true);
+				next_irq_ += HalfCycles(5003);
+			}
+			if(time >= next_nmi_) {
+				z80.set_non_maskable_interrupt_line(true);
+				z80.set_non_maskable_interrupt_line(false);
+				next_nmi_ += HalfCycles(17011);
+			}
+		}
+
+		CPU::Z80::Processor<Z80DirectMachine, false, true> z80;
+		uint8_t ram[65536];
+		HalfCycles time;
+		std::vector<Access> accesses;
+		long calls = 0;
+
+	private:
+		HalfCycles next_irq_ = HalfCycles(5003);
+		HalfCycles next_nmi_ = HalfCycles(17011);
+
+		void record(const CPU::Z80::PartialMachineCycle &cycle) {
+			accesses.emplace_back(int(cycle.operation), cycle.address ? *cycle.address : 0, cycle.value ? *cycle.value : 0, long(time.as_integral()));
+		}
+};
+
+/*!
+	Provides a 6502 with 64kb of RAM, of which the lower 32kb is a direct page area if @c direct is @c true,
+	a periodic IRQ that is acknowledged by a write to $8002 and a location, $8001, that returns the current
+	time. All accesses above $8000 are recorded, along with the time at which they occurred.
+*/
+template <bool direct> class MOS6502DirectMachine: public CPU::MOS6502::BusHandler {
+	public:
+		MOS6502DirectMachine() : m6502(*this) {
+			constexpr uint8_t program[] = {
+				0xd8,				// CLD
+				0x58,				// CLI
+				0xa2, 0xff,			// LDX #$ff
+				0x9a,				// TXS
+				0xa0, 0x00,			// LDY #0
+				0xb9, 0x00, 0x10,	// loop: LDA $1000, Y
+				0x18,				// CLC
+				0x69, 0x01,			// ADC #1
+				0x99, 0x00, 0x10,	// STA $1000, Y
+				0x8d, 0x00, 0x80,	// STA $8000
+				0xad, 0x01, 0x80,	// LDA $8001
+				0x99, 0x00, 0x11,	// STA $1100, Y
+				0xc8,				// INY
+				0xd0, 0xeb,			// BNE loop
+				0xe6, 0x20,			// INC $20
+				0x4c, 0x07, 0x04,	// JMP loop
+			};
+
+			// Acknowledge the interrupt and count it.
+			constexpr uint8_t irq_handler[] = {
+				0x48,				// PHA
+				0x8d, 0x02, 0x80,	// STA $8002
+				0xe6, 0x21,			// INC $21
+				0x68,				// PLA
+				0x40,				// RTI
+			};
+
+			memset(ram, 0, sizeof(ram));
+			memcpy(&ram[0x400], program, sizeof(program));
+			memcpy(&ram[0x500], irq_handler, sizeof(irq_handler));
+			ram[0xfffc] = 0x00;	ram[0xfffd] = 0x04;
+			ram[0xfffe] = 0x00;	ram[0xffff] = 0x05;
+
+			// Registers power up with random values, so give them fixed ones.
+			for(const auto reg: {CPU::MOS6502::Register::ProgramCounter, CPU::MOS6502::Register::A, CPU::MOS6502::Register::X, CPU::MOS6502::Register::Y, CPU::MOS6502::Register::Flags, CPU::MOS6502::Register::StackPointer}) {
+				m6502.set_value_of_register(reg, 0);
+			}
+		}
+
+		Cycles perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			++calls;
+			if(operation == CPU::MOS6502::BusOperation::Read || operation == CPU::MOS6502::BusOperation::ReadOpcode || operation == CPU::MOS6502::BusOperation::Write) {
+				if(isReadOperation(operation)) {
+					*value = (address == 0x8001) ? uint8_t(time.as_integral()) : ram[address];
+				} else {
+					ram[address] = *value;
+					if(address == 0x8002) m6502.set_irq_line(false);
+				}
+				if(address >= 0x8000) {
+					accesses.emplace_back(int(operation), address, *value, long(time.as_integral()));
+				}
+			}
+			advance(Cycles(1));
+			return Cycles(1);
+		}
+
+		static constexpr bool has_direct_pages = direct;
+		uint8_t *direct_read_page(int page) {
+			return page < 0x80 ? &ram[page << 8] : nullptr;
+		}
+		uint8_t *direct_write_page(int page) {
+			return page < 0x80 ? &ram[page << 8] : nullptr;
+		}
+
+		void advance(Cycles duration) {
+			time += duration;
+			if(time >= next_irq_) {
+				m6502.set_irq_line(true);
+				next_irq_ += Cycles(1009);
+			}
+		}
+
+		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, MOS6502DirectMachine, false> m6502;
+		uint8_t ram[65536];
+		Cycles time;
+		std::vector<Access> accesses;
+		long calls = 0;
+
+	private:
+		Cycles next_irq_ = Cycles(1009);
+};
+
+}
+
+@interface DirectPageTests : XCTestCase
+@end
+
+@implementation DirectPageTests
+
+- (void)compareZ80WithWait:(BOOL)wait {
+	auto plain = std::make_unique<Z80DirectMachine<false>>();
+	auto direct = std::make_unique<Z80DirectMachine<true>>();
+
+	// Run in a mixture of long and very short steps, optionally holding the wait line for some of them.
+	for(int c = 0; c < 4000; ++c) {
+		const bool is_waiting = wait && (c % 5) == 3;
+		const HalfCycles length = HalfCycles((c & 1) ? 1 + (c % 13) : 400 + (c % 7) * 37);
+		plain->z80.set_wait_line(is_waiting);
+		direct->z80.set_wait_line(is_waiting);
+		plain->z80.run_for(length);
+		direct->z80.run_for(length);
+	}
+
+	// Most bus activity should have avoided the bus handler, without affecting the outcome.
+	XCTAssertLessThan(direct->calls * 2, plain->calls);
+	XCTAssertEqual(plain->time.as_integral(), direct->time.as_integral());
+	XCTAssert(plain->accesses == direct->accesses);
+	XCTAssertEqual(memcmp(plain->ram, direct->ram, sizeof(plain->ram)), 0);
+	for(const auto reg: {CPU::Z80::Register::AF, CPU::Z80::Register::BC, CPU::Z80::Register::DE, CPU::Z80::Register::HL, CPU::Z80::Register::StackPointer, CPU::Z80::Register::ProgramCounter, CPU::Z80::Register::R, CPU::Z80::Register::IFF1}) {
+		XCTAssertEqual(plain->z80.get_value_of_register(reg), direct->z80.get_value_of_register(reg));
+	}
+
+	// Check that interrupts and device accesses actually occurred.
+	XCTAssertGreaterThan(plain->ram[0x8100], 0);
+	XCTAssertGreaterThan(plain->ram[0x8200], 0);
+	XCTAssertGreaterThan(plain->accesses.size(), 1000);
+}
+
+- (void)testZ80 {
+	[self compareZ80WithWait:NO];
+}
+
+- (void)testZ80Wait {
+	[self compareZ80WithWait:YES];
+}
+
+- (void)test6502 {
+	auto plain = std::make_unique<MOS6502DirectMachine<false>>();
+	auto direct = std::make_unique<MOS6502DirectMachine<true>>();
+
+	for(int c = 0; c < 4000; ++c) {
+		const Cycles length = Cycles((c & 1) ? 1 + (c % 5) : 200 + (c % 7) * 19);
+		plain->m6502.run_for(length);
+		direct->m6502.run_for(length);
+	}
+
+	XCTAssertLessThan(direct->calls * 2, plain->calls);
+	XCTAssertEqual(plain->time.as_integral(), direct->time.as_integral());
+	XCTAssert(plain->accesses == direct->accesses);
+	XCTAssertEqual(memcmp(plain->ram, direct->ram, sizeof(plain->ram)), 0);
+	for(const auto reg: {CPU::MOS6502::Register::A, CPU::MOS6502::Register::X, CPU::MOS6502::Register::Y, CPU::MOS6502::Register::StackPointer, CPU::MOS6502::Register::ProgramCounter, CPU::MOS6502::Register::Flags}) {
+		XCTAssertEqual(plain->m6502.get_value_of_register(reg), direct->m6502.get_value_of_register(reg));
+	}
+
+	XCTAssertGreaterThan(plain->ram[0x21], 0);
+	XCTAssertGreaterThan(plain->accesses.size(), 1000);
+}
+
+@end
@@ -0,0 +1,237 @@
+//
+//  DiskControllerIdleTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/1770/1770.hpp"
+#include "../../../Components/8272/i8272.hpp"
+#include "../../../Storage/Disk/DiskImage/DiskImage.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Encoder.hpp"
+
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int ClockRate = 8000000;
+constexpr Cycles::IntType PollInterval = 8;
+
+/// @returns The expected value of byte @c index of sector @c sector.
+uint8_t sector_byte(int sector, std::size_t index) {
+	return uint8_t(sector * 17 + index * 3);
+}
+
+/// A single-sided, single-track disk image of nine 512-byte MFM sectors, each filled with @c sector_byte.
+class SectorDiskImage: public Storage::Disk::DiskImage {
+	public:
+		Storage::Disk::HeadPosition get_maximum_head_position() final {
+			return Storage::Disk::HeadPosition(1);
+		}
+
+		int get_head_count() final {
+			return 1;
+		}
+
+		std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address address) final {
+			std::vector<Storage::Encodings::MFM::Sector> sectors;
+			for(int c = 1; c <= 9; ++c) {
+				Storage::Encodings::MFM::Sector sector;
+				sector.address.sector = uint8_t(c);
+				sector.size = 2;
+				sector.samples.emplace_back(512);
+				for(std::size_t index = 0; index < 512; ++index) {
+					sector.samples.back()[index] = sector_byte(c, index);
+				}
+				sectors.push_back(std::move(sector));
+			}
+			return Storage::Encodings::MFM::GetMFMTrackWithSectors(sectors);
+		}
+};
+
+/// Always requests flux transitions, so that the drive never skips them, but forwards them to @c delegate only
+/// while it wants them; all other drive events are forwarded unconditionally.
+struct FluxForwarder: public Storage::Disk::Drive::EventDelegate {
+	FluxForwarder(Storage::Disk::Drive::EventDelegate &delegate) : delegate(delegate) {}
+
+	void process_event(const Storage::Disk::Drive::Event &event) final {
+		if(event.type == Storage::Disk::Track::Event::IndexHole || delegate.needs_flux_events()) {
+			delegate.process_event(event);
+		}
+	}
+	void process_write_completed() final								{	delegate.process_write_completed();	}
+	void advance(const Cycles cycles) final								{	delegate.advance(cycles);	}
+	bool needs_flux_events() final										{	return true;	}
+
+	Storage::Disk::Drive::EventDelegate &delegate;
+};
+
+/// The result of reading a sector: its contents and the number of cycles from command to completion.
+struct SectorRead {
+	std::vector<uint8_t> data;
+	Cycles::IntType duration = 0;
+};
+
+/// A WD1770 attached to a single drive, which either may or may not skip flux transitions while the controller is idle.
+class TestWD1770: public WD::WD1770 {
+	public:
+		TestWD1770(bool skips_flux) :
+			WD1770(P1770),
+			drive_(std::make_shared<Storage::Disk::Drive>(ClockRate, 300, 1)),
+			forwarder_(*this) {
+			drive_->set_disk(std::make_shared<Storage::Disk::DiskImageHolder<SectorDiskImage>>());
+			set_drive(drive_);
+			if(!skips_flux) drive_->set_event_delegate(&forwarder_);
+			set_is_double_density(true);
+		}
+
+		SectorRead read_sector(uint8_t sector) {
+			SectorRead reading;
+			write(1, 0);
+			write(2, sector);
+			write(0, 0x80);		// Read sector.
+
+			while(true) {
+				run_for(Cycles(PollInterval));
+				reading.duration += PollInterval;
+
+				const uint8_t status = read(0);
+				if(status & Flag::DataRequest) reading.data.push_back(read(3));
+				if(!(status & Flag::Busy)) break;
+			}
+			return reading;
+		}
+
+	private:
+		std::shared_ptr<Storage::Disk::Drive> drive_;
+		FluxForwarder forwarder_;
+
+		void set_motor_on(bool motor_on) final {
+			drive_->set_motor_on(motor_on);
+		}
+};
+
+/// An 8272 attached to a single drive, which either may or may not skip flux transitions while the controller is idle.
+class TestI8272: public Intel::i8272::i8272 {
+	public:
+		TestI8272(bool skips_flux) :
+			i8272(bus_handler_, Cycles(ClockRate)),
+			drive_(std::make_shared<Storage::Disk::Drive>(ClockRate, 300, 1)),
+			forwarder_(*this) {
+			drive_->set_disk(std::make_shared<Storage::Disk::DiskImageHolder<SectorDiskImage>>());
+			drive_->set_motor_on(true);
+			set_drive(drive_);
+			if(!skips_flux) drive_->set_event_delegate(&forwarder_);
+
+			// Allow the drive to become ready.
+			run_for(Cycles(ClockRate));
+		}
+
+		SectorRead read_sector(uint8_t sector) {
+			SectorRead reading;
+
+			// Read data, MFM, drive 0 head 0; cylinder 0, head 0, the sector requested, 512 bytes per sector,
+			// the same final sector, standard gap length and an unused data length.
+			const uint8_t command[] = {0x46, 0x00, 0x00, 0x00, sector, 0x02, sector, 0x2a, 0xff};
+			for(const auto byte: command) {
+				while((read(0) & 0xc0) != 0x80) step(reading);
+				write(1, byte);
+			}
+
+			// Collect data until the result phase begins, then discard the result.
+			while(true) {
+				step(reading);
+				const uint8_t status = read(0);
+				if((status & 0xe0) == 0xe0) {
+					reading.data.push_back(read(1));
+				} else if((status & 0xd0) == 0xd0) {
+					break;
+				}
+			}
+			while((read(0) & 0xd0) == 0xd0) read(1);
+			return reading;
+		}
+
+	private:
+		Intel::i8272::BusHandler bus_handler_;
+		std::shared_ptr<Storage::Disk::Drive> drive_;
+		FluxForwarder forwarder_;
+
+		void select_drive(int) final {}
+
+		void step(SectorRead &reading) {
+			run_for(Cycles(PollInterval));
+			reading.duration += PollInterval;
+		}
+};
+
+/// Each pair is a sector to read and the number of cycles to remain idle afterwards. Idle periods are chosen
+/// not to be multiples of the rotation period; the fourth is sufficiently long for a WD1770's motor to stop.
+const std::pair<uint8_t, Cycles::IntType> reads_and_idles[] = {
+	{3, 6'012'345},
+	{7, 1'234'567},
+	{1, 9'876'543},
+	{9, 20'000'003},
+	{5, 0},
+};
+
+/// Performs @c reads_and_idles with a controller of type @c ControllerT, both with and without flux skipping.
+/// @returns The pairs of results.
+template <typename ControllerT> std::vector<std::pair<SectorRead, SectorRead>> reads_after_idle() {
+	std::vector<std::pair<SectorRead, SectorRead>> results;
+	ControllerT skipping(true), walking(false);
+	for(const auto &read: reads_and_idles) {
+		results.emplace_back(skipping.read_sector(read.first), walking.read_sector(read.first));
+		skipping.run_for(Cycles(read.second));
+		walking.run_for(Cycles(read.second));
+	}
+	return results;
+}
+
+}
+
+@interface DiskControllerIdleTests : XCTestCase
+@end
+
+@implementation DiskControllerIdleTests
+
+/// Checks that sector contents and command durations are the same whether or not flux transitions were skipped.
+- (void)checkReads:(const std::vector<std::pair<SectorRead, SectorRead>> &)results {
+	XCTAssertEqual(results.size(), std::size(reads_and_idles));
+	for(std::size_t c = 0; c < results.size(); ++c) {
+		const int sector = reads_and_idles[c].first;
+		const SectorRead &skipped = results[c].first;
+		const SectorRead &walked = results[c].second;
+
+		XCTAssertEqual(skipped.data.size(), 512, @"Sector %d", sector);
+		XCTAssert(skipped.data == walked.data, @"Sector %d", sector);
+		for(std::size_t index = 0; index < skipped.data.size(); ++index) {
+			if(skipped.data[index] != sector_byte(sector, index)) {
+				XCTAssert(false, @"Sector %d differs at byte %zu", sector, index);
+				break;
+			}
+		}
+
+		// Allow the two to differ by a couple of polling intervals, in case the resumed bit stream and PLL
+		// come to land differently in one.
+		XCTAssertLessThanOrEqual(std::abs(skipped.duration - walked.duration), 2 * PollInterval,
+			@"Sector %d: %lld versus %lld cycles", sector, (long long)skipped.duration, (long long)walked.duration);
+	}
+}
+
+- (void)testWD1770ReadsAfterIdle {
+	[self checkReads:reads_after_idle<TestWD1770>()];
+}
+
+- (void)test8272ReadsAfterIdle {
+	[self checkReads:reads_after_idle<TestI8272>()];
+}
+
+@end
@@ -0,0 +1,64 @@
+//
+//  DiskImagePrefetchTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Disk/DiskImage/DiskImage.hpp"
+#include "../../../Storage/Disk/Track/PCMTrack.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace {
+
+/// A two-sided, forty-track disk image that is slow to decode; each track records its address in its data.
+class SlowDiskImage: public Storage::Disk::DiskImage {
+	public:
+		Storage::Disk::HeadPosition get_maximum_head_position() final {
+			return Storage::Disk::HeadPosition(40);
+		}
+
+		int get_head_count() final {
+			return 2;
+		}
+
+		std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address address) final {
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			Storage::Disk::PCMSegment segment(std::vector<uint8_t>{uint8_t(address.position.as_int()), uint8_t(address.head)});
+			return std::make_shared<Storage::Disk::PCMTrack>(segment);
+		}
+};
+
+}
+
+@interface DiskImagePrefetchTests : XCTestCase
+@end
+
+@implementation DiskImagePrefetchTests
+
+- (void)testSequentialSeeks {
+	auto disk = std::make_unique<Storage::Disk::DiskImageHolder<SlowDiskImage>>();
+
+	// Step across the disk, waiting between steps for the next track to be prefetched.
+	for(int c = 0; c < 40; ++c) {
+		XCTAssert(disk->get_track_at_position(Storage::Disk::Track::Address(0, Storage::Disk::HeadPosition(c))));
+		disk->flush_update_queue();
+	}
+
+	// Only the first track should have been decoded on demand.
+	XCTAssertEqual(disk->get_prefetch_statistics().misses, 1);
+	XCTAssertEqual(disk->get_prefetch_statistics().hits, 39);
+
+	// The other head should have been prefetched alongside, and a track once used should persist.
+	const auto track = disk->get_track_at_position(Storage::Disk::Track::Address(1, Storage::Disk::HeadPosition(39)));
+	XCTAssertEqual(disk->get_prefetch_statistics().hits, 40);
+	XCTAssertEqual(track, disk->get_track_at_position(Storage::Disk::Track::Address(1, Storage::Disk::HeadPosition(39))));
+}
+
+@end
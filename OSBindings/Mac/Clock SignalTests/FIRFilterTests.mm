@@ -0,0 +1,65 @@
+//
+//  FIRFilterTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../SignalProcessing/FIRFilter.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+@interface FIRFilterTests : XCTestCase
+@end
+
+@implementation FIRFilterTests {
+	std::vector<short> _source;
+}
+
+- (void)setUp {
+	srand(68);
+	_source.resize(16384);
+	for(auto &sample: _source) {
+		sample = short(rand());
+	}
+}
+
+- (void)testKernelsMatchReference {
+	using Kernel = SignalProcessing::FIRFilter::Kernel;
+
+	for(const std::size_t taps: {3, 7, 15, 17, 31, 33, 65, 255, 1023}) {
+		SignalProcessing::FIRFilter filter(taps, 1000000.0f, 0.0f, 22050.0f);
+
+		for(const auto kernel: {Kernel::SSE2, Kernel::AVX2, Kernel::NEON}) {
+			if(!SignalProcessing::FIRFilter::is_available(kernel)) continue;
+
+			for(std::size_t c = 0; c < 1024; ++c) {
+				const int reference = filter.dot_product(&_source[c], Kernel::Scalar);
+				const int result = filter.dot_product(&_source[c], kernel);
+				XCTAssertEqual(reference, result, @"Kernel %d differs from reference with %zu taps at offset %zu", int(kernel), taps, c);
+			}
+		}
+	}
+}
+
+- (void)testBatchesMatchSingleApplication {
+	for(const std::size_t taps: {3, 17, 255, 1023}) {
+		SignalProcessing::FIRFilter filter(taps, 1000000.0f, 0.0f, 22050.0f);
+
+		for(const std::size_t step: {1, 3, 22}) {
+			const std::size_t count = (_source.size() - taps) / step - 1;
+			std::vector<short> results(count);
+			filter.apply(_source.data(), results.data(), count, step);
+
+			for(std::size_t c = 0; c < count; ++c) {
+				XCTAssertEqual(results[c], filter.apply(&_source[c * step]), @"Batch result differs with %zu taps and step %zu at %zu", taps, step, c);
+			}
+		}
+	}
+}
+
+@end
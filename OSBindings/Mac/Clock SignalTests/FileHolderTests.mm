@@ -0,0 +1,82 @@
+//
+//  FileHolderTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/FileHolder.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string temporary_file(const std::vector<uint8_t> &contents) {
+	NSString *const path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	[[NSData dataWithBytes:contents.data() length:contents.size()] writeToFile:path atomically:NO];
+	return path.UTF8String;
+}
+
+}
+
+@interface FileHolderTests : XCTestCase
+@end
+
+@implementation FileHolderTests
+
+- (void)testMappedReadsMatchStdio {
+	std::vector<uint8_t> contents;
+	for(int c = 0; c < 1000; c++) contents.push_back(uint8_t(c * 7));
+	const auto name = temporary_file(contents);
+
+	Storage::FileHolder stdio(name, Storage::FileHolder::FileMode::Read);
+	Storage::FileHolder mapped(name, Storage::FileHolder::FileMode::MappedRead);
+	XCTAssertFalse(stdio.is_mapped());
+	XCTAssertTrue(mapped.is_mapped());
+
+	for(auto file: {&stdio, &mapped}) {
+		XCTAssertEqual(file->get32le(), 0x150e'0700);
+		XCTAssertEqual(file->get16be(), 0x1c23);
+		XCTAssertEqual(file->read_le<uint16_t>(2), (std::vector<uint16_t>{0x312a, 0x3f38}));
+		XCTAssertEqual(file->read_be<uint32_t>(1), (std::vector<uint32_t>{0x464d545b}));
+		XCTAssertEqual(file->tell(), 14);
+
+		// Reads that overrun the end of the file should be truncated and set the end-of-file indicator.
+		file->seek(-2, SEEK_END);
+		XCTAssertFalse(file->eof());
+		const auto span = file->span(4);
+		XCTAssertEqual(span.size(), 2);
+		XCTAssertEqual(span[1], contents.back());
+		XCTAssertTrue(file->eof());
+
+		file->seek(0, SEEK_SET);
+		XCTAssertFalse(file->eof());
+		XCTAssertEqual(file->read(1000), contents);
+	}
+}
+
+- (void)testCopyOnWrite {
+	const std::vector<uint8_t> contents(256, 0xaa);
+	const auto name = temporary_file(contents);
+
+	{
+		Storage::FileHolder mapped(name, Storage::FileHolder::FileMode::MappedCopyOnWrite);
+		XCTAssertFalse(mapped.get_is_known_read_only());
+
+		// Writes should be visible through the mapping but should not extend it.
+		mapped.seek(254, SEEK_SET);
+		XCTAssertEqual(mapped.write(std::vector<uint8_t>{1, 2, 3, 4}), 2);
+		mapped.seek(253, SEEK_SET);
+		XCTAssertEqual(mapped.read(4), (std::vector<uint8_t>{0xaa, 1, 2}));
+	}
+
+	// The file itself should be unmodified.
+	Storage::FileHolder stdio(name, Storage::FileHolder::FileMode::Read);
+	XCTAssertEqual(stdio.read(1000), contents);
+}
+
+@end
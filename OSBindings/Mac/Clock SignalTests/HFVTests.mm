@@ -0,0 +1,167 @@
+//
+//  HFVTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/MassStorage/Formats/HFV.hpp"
+
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+constexpr size_t NumberOfBlocks = 2000;
+constexpr size_t DriverBlocks = 0x60;
+
+/// @returns The original contents of block @c block of the test image.
+std::vector<uint8_t> original_block(size_t block) {
+	std::vector<uint8_t> contents(512);
+	for(size_t c = 0; c < contents.size(); ++c) {
+		contents[c] = uint8_t(block ^ (c * 3));
+	}
+	return contents;
+}
+
+/// @returns The name of a new file containing @c NumberOfBlocks blocks, as per @c original_block.
+std::string temporary_image() {
+	std::vector<uint8_t> contents;
+	for(size_t block = 0; block < NumberOfBlocks; ++block) {
+		const auto block_contents = original_block(block);
+		contents.insert(contents.end(), block_contents.begin(), block_contents.end());
+	}
+
+	NSString *const path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	[[NSData dataWithBytes:contents.data() length:contents.size()] writeToFile:path atomically:NO];
+	return path.UTF8String;
+}
+
+/// @returns The current contents of block @c block of the file @c name.
+std::vector<uint8_t> file_block(const std::string &name, size_t block) {
+	Storage::FileHolder file(name, Storage::FileHolder::FileMode::Read);
+	file.seek(long(block * 512), SEEK_SET);
+	return file.read(512);
+}
+
+std::vector<uint8_t> to_vector(Storage::MassStorage::MassStorageDevice::Span span) {
+	return std::vector<uint8_t>(span.begin(), span.end());
+}
+
+}
+
+@interface HFVTests : XCTestCase
+@end
+
+@implementation HFVTests
+
+- (void)testReadBlock {
+	Storage::MassStorage::HFV hfv(temporary_image());
+	Storage::MassStorage::MassStorageDevice &device = hfv;
+	static_cast<Storage::MassStorage::Encodings::Macintosh::Volume &>(hfv).set_drive_type(Storage::MassStorage::Encodings::Macintosh::DriveType::SCSI);
+	XCTAssertEqual(device.get_number_of_blocks(), NumberOfBlocks + DriverBlocks);
+
+	// Blocks from the image should be supplied unmodified, by either means.
+	for(const size_t block: {size_t(0), size_t(1), size_t(999), NumberOfBlocks - 1}) {
+		XCTAssertEqual(to_vector(device.read_block(block + DriverBlocks)), original_block(block));
+		XCTAssertEqual(device.get_block(block + DriverBlocks), original_block(block));
+	}
+
+	// Synthesised driver blocks should be consistent between the two, and stable.
+	for(size_t block = 0; block < DriverBlocks; ++block) {
+		const auto span = device.read_block(block);
+		XCTAssertEqual(span.size(), 512);
+		XCTAssertEqual(to_vector(span), device.get_block(block));
+		XCTAssertEqual(device.read_block(block).data(), span.data());
+	}
+
+	// The first is the driver descriptor.
+	const auto descriptor = device.read_block(0);
+	XCTAssertEqual(descriptor[0], 0x45);
+	XCTAssertEqual(descriptor[1], 0x52);
+}
+
+- (void)testWriteBack {
+	const auto name = temporary_image();
+	std::vector<uint8_t> written(512);
+	for(size_t c = 0; c < written.size(); ++c) written[c] = uint8_t(c * 5);
+
+	{
+		Storage::MassStorage::HFV hfv(name);
+		Storage::MassStorage::MassStorageDevice &device = hfv;
+		static_cast<Storage::MassStorage::Encodings::Macintosh::Volume &>(hfv).set_drive_type(Storage::MassStorage::Encodings::Macintosh::DriveType::SCSI);
+
+		// Writes should be visible immediately but should reach the file only upon a flush.
+		for(const size_t block: {10, 11, 12, 500}) {
+			device.set_block(block + DriverBlocks, written);
+			XCTAssertEqual(to_vector(device.read_block(block + DriverBlocks)), written);
+		}
+		XCTAssertEqual(file_block(name, 11), original_block(11));
+
+		XCTAssertTrue(device.flush());
+		for(const size_t block: {10, 11, 12, 500}) {
+			XCTAssertEqual(file_block(name, block), written);
+		}
+		XCTAssertEqual(file_block(name, 9), original_block(9));
+		XCTAssertEqual(file_block(name, 13), original_block(13));
+
+		// Anything still unwritten upon destruction should be flushed then.
+		device.set_block(1500 + DriverBlocks, written);
+	}
+	XCTAssertEqual(file_block(name, 1500), written);
+	XCTAssertEqual(file_block(name, 1501), original_block(1501));
+}
+
+- (void)testWriteFailure {
+	const auto name = temporary_image();
+	const std::vector<uint8_t> written(512, 0x5a);
+
+	Storage::MassStorage::HFV hfv(name);
+	Storage::MassStorage::MassStorageDevice &device = hfv;
+	static_cast<Storage::MassStorage::Encodings::Macintosh::Volume &>(hfv).set_drive_type(Storage::MassStorage::Encodings::Macintosh::DriveType::SCSI);
+
+	// Replace the file with a directory, which can't be opened for writing.
+	XCTAssertEqual(unlink(name.c_str()), 0);
+	XCTAssertEqual(mkdir(name.c_str(), 0700), 0);
+
+	// The failure should be reported, but the write should still be visible.
+	device.set_block(20 + DriverBlocks, written);
+	XCTAssertFalse(device.flush());
+	XCTAssertEqual(to_vector(device.read_block(20 + DriverBlocks)), written);
+
+	// Once the file can be written again, the block should still be pending.
+	XCTAssertEqual(rmdir(name.c_str()), 0);
+	{
+		Storage::FileHolder file(name, Storage::FileHolder::FileMode::Rewrite);
+	}
+	XCTAssertTrue(device.flush());
+	XCTAssertEqual(file_block(name, 20), written);
+}
+
+- (void)testReadOnlyWrite {
+	const auto name = temporary_image();
+	const std::vector<uint8_t> written(512, 0xa5);
+	XCTAssertEqual(chmod(name.c_str(), 0400), 0);
+
+	// Permissions don't apply to every user; there's nothing to test if the file can be written regardless.
+	if(!Storage::FileHolder(name, Storage::FileHolder::FileMode::ReadWrite).get_is_known_read_only()) return;
+
+	Storage::MassStorage::HFV hfv(name);
+	Storage::MassStorage::MassStorageDevice &device = hfv;
+	static_cast<Storage::MassStorage::Encodings::Macintosh::Volume &>(hfv).set_drive_type(Storage::MassStorage::Encodings::Macintosh::DriveType::SCSI);
+
+	// The write should be visible, but every flush should report that it hasn't reached the file.
+	XCTAssertTrue(device.flush());
+	device.set_block(20 + DriverBlocks, written);
+	XCTAssertEqual(to_vector(device.read_block(20 + DriverBlocks)), written);
+	XCTAssertFalse(device.flush());
+	XCTAssertFalse(device.flush());
+	XCTAssertEqual(file_block(name, 20), original_block(20));
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+//  MOS6502DispatchTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Processors/6502/AllRAM/6502AllRAM.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr CPU::MOS6502::Register registers[] = {
+	CPU::MOS6502::Register::LastOperationAddress,
+	CPU::MOS6502::Register::ProgramCounter,
+	CPU::MOS6502::Register::StackPointer,
+	CPU::MOS6502::Register::Flags,
+	CPU::MOS6502::Register::A,
+	CPU::MOS6502::Register::X,
+	CPU::MOS6502::Register::Y,
+};
+
+}
+
+/*!
+	Runs Klaus Dormann's functional tests on a switch-dispatched and a threaded-dispatch 6502 in lock step,
+	one cycle at a time, and requires that the two remain identical throughout.
+*/
+@interface MOS6502DispatchTests : XCTestCase
+@end
+
+@implementation MOS6502DispatchTests
+
+- (void)compareResource:(NSString *)resource personality:(CPU::MOS6502::Personality)personality successAddress:(uint16_t)success {
+	NSData *const test = [NSData dataWithContentsOfFile:[[NSBundle bundleForClass:[self class]] pathForResource:resource ofType:@"bin"]];
+	XCTAssertNotNil(test);
+	if(!test) return;
+
+	std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processors[] = {
+		std::unique_ptr<CPU::MOS6502::AllRAMProcessor>(CPU::MOS6502::AllRAMProcessor::Processor(personality, false)),
+		std::unique_ptr<CPU::MOS6502::AllRAMProcessor>(CPU::MOS6502::AllRAMProcessor::Processor(personality, true)),
+	};
+	// Registers power up with random values, so give both processors the same ones.
+	for(auto &processor: processors) {
+		for(const auto reg: {CPU::MOS6502::Register::StackPointer, CPU::MOS6502::Register::Flags, CPU::MOS6502::Register::A, CPU::MOS6502::Register::X, CPU::MOS6502::Register::Y}) {
+			processor->set_value_of_register(reg, 0xff);
+		}
+		processor->set_data_at_address(0, test.length, reinterpret_cast<const uint8_t *>(test.bytes));
+		processor->set_value_of_register(CPU::MOS6502::Register::ProgramCounter, 0x400);
+	}
+
+	std::vector<uint8_t> memories[2] = {std::vector<uint8_t>(65536), std::vector<uint8_t>(65536)};
+	uint16_t last_operation_address = 0;
+	int confirmation_cycle = 0;
+	for(int cycle = 1; ; ++cycle) {
+		for(auto &processor: processors) {
+			processor->run_for(Cycles(1));
+		}
+
+		// Compare all registers and the timestamp after every cycle, and all of memory periodically.
+		XCTAssertEqual(processors[0]->get_timestamp().as_integral(), processors[1]->get_timestamp().as_integral());
+		for(const auto reg: registers) {
+			const auto switched = processors[0]->get_value_of_register(reg);
+			const auto threaded = processors[1]->get_value_of_register(reg);
+			if(switched != threaded) {
+				XCTFail(@"Register %d differs after %d cycles: %04x versus %04x", int(reg), cycle, switched, threaded);
+				return;
+			}
+		}
+
+		if(!(cycle & 65535)) {
+			for(std::size_t c = 0; c < 2; ++c) {
+				processors[c]->get_data_at_address(0, 65536, memories[c].data());
+			}
+			if(memories[0] != memories[1]) {
+				XCTFail(@"Memory differs after %d cycles", cycle);
+				return;
+			}
+		}
+
+		// The tests end by jumping to self, upon success or failure; as per KlausDormannTests, look for
+		// an unchanged operation address after a thousand cycles and then again a few cycles later.
+		const uint16_t operation_address = processors[0]->get_value_of_register(CPU::MOS6502::Register::LastOperationAddress);
+		if(cycle == confirmation_cycle && operation_address == last_operation_address) break;
+		if(!(cycle % 1000)) {
+			if(operation_address == last_operation_address) confirmation_cycle = cycle + 7;
+			last_operation_address = operation_address;
+		}
+	}
+
+	XCTAssertEqual(last_operation_address, success);
+}
+
+- (void)test6502 {
+	[self compareResource:@"6502_functional_test" personality:CPU::MOS6502::Personality::P6502 successAddress:0x3399];
+}
+
+- (void)test65C02 {
+	[self compareResource:@"65C02_extended_opcodes_test" personality:CPU::MOS6502::Personality::PWDC65C02 successAddress:0x24f1];
+}
+
+@end
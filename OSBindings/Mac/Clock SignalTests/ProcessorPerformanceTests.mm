@@ -0,0 +1,200 @@
+//
+//  ProcessorPerformanceTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Processors/6502/AllRAM/6502AllRAM.hpp"
+#include "../../../Processors/68000/AllRAM/68000AllRAM.hpp"
+#include "../../../Processors/Z80/AllRAM/Z80AllRAM.hpp"
+
+#include <chrono>
+#include <memory>
+
+namespace {
+
+/// Counts opcode fetches, i.e. instructions executed, including prefixes.
+class Z80InstructionCounter: public CPU::Z80::AllRAMProcessor::MemoryAccessDelegate {
+	public:
+		void z80_all_ram_processor_did_perform_bus_operation(CPU::Z80::AllRAMProcessor &, CPU::Z80::PartialMachineCycle::Operation operation, uint16_t, uint8_t, HalfCycles) final {
+			if(operation == CPU::Z80::PartialMachineCycle::ReadOpcode) ++instructions;
+		}
+		long instructions = 0;
+};
+
+/// A loop that exercises the base, CB, DD and ED pages and both taken and untaken conditional calls.
+constexpr uint8_t z80_program[] = {
+	0x31, 0x00, 0xf0,			// LD SP, $f000
+	0x21, 0x00, 0x80,			// LD HL, $8000
+	0xdd, 0x21, 0x00, 0x90,		// LD IX, $9000
+
+	// loop:
+	0x7e,						// LD A, (HL)
+	0x3c,						// INC A
+	0x77,						// LD (HL), A
+	0xcb, 0x07,					// RLC A
+	0xdd, 0x77, 0x05,			// LD (IX+5), A
+	0xed, 0x44,					// NEG
+	0xc5,						// PUSH BC
+	0xc1,						// POP BC
+	0xcd, 0x20, 0x00,			// CALL $0020
+	0x23,						// INC HL
+	0xc4, 0x20, 0x00,			// CALL NZ, $0020
+	0x18, 0xeb,					// JR loop
+
+	0x00,
+
+	// $0020:
+	0xc9,						// RET
+};
+
+/// A loop of loads, stores, arithmetic, stack operations and subroutine calls; it assumes that the 6502 starts at $0200.
+constexpr uint8_t mos6502_program[] = {
+	0xa2, 0xff,			// LDX #$ff
+	0x9a,				// TXS
+	0xa2, 0x00,			// LDX #0
+	0xa0, 0x00,			// LDY #0
+	0x18,				// CLC
+	0xd8,				// CLD
+
+	// loop:
+	0xbd, 0x00, 0x30,	// LDA $3000, X
+	0x69, 0x03,			// ADC #3
+	0x9d, 0x00, 0x30,	// STA $3000, X
+	0x91, 0x10,			// STA ($10), Y
+	0x48,				// PHA
+	0x68,				// PLA
+	0x2a,				// ROL A
+	0x20, 0x40, 0x02,	// JSR $0240
+	0xe8,				// INX
+	0xd0, 0xec,			// BNE loop
+	0xc8,				// INY
+	0x4c, 0x09, 0x02,	// JMP loop
+};
+constexpr uint8_t mos6502_subroutine[] = {
+	0xe6, 0x20,			// INC $20
+	0x60,				// RTS
+};
+constexpr uint8_t mos6502_pointer[] = {0x00, 0x40};
+
+/// A loop of register arithmetic, memory reads and writes and a subroutine call, preceded by reset vectors.
+constexpr uint8_t mc68000_program[] = {
+	0x00, 0x00, 0xf0, 0x00,					// Initial stack pointer: $f000.
+	0x00, 0x00, 0x00, 0x08,					// Initial program counter: $0008.
+
+	// start:
+	0x41, 0xf9, 0x00, 0x00, 0x30, 0x00,		// LEA $3000, A0
+	0x70, 0x63,								// MOVEQ #99, D0
+
+	// loop:
+	0x32, 0x18,								// MOVE.W (A0)+, D1
+	0xd2, 0x41,								// ADD.W D1, D1
+	0x31, 0x41, 0x00, 0x10,					// MOVE.W D1, 16(A0)
+	0xe3, 0x49,								// LSL.W #1, D1
+	0xb3, 0x42,								// EOR.W D1, D2
+	0x4a, 0x42,								// TST.W D2
+	0x61, 0x00, 0x00, 0x0c,					// BSR sub
+	0x51, 0xc8, 0xff, 0xec,					// DBRA D0, loop
+	0x60, 0x00, 0xff, 0xe0,					// BRA start
+
+	0x00, 0x00,
+
+	// sub:
+	0x52, 0x83,								// ADDQ.L #1, D3
+	0x4e, 0x75,								// RTS
+};
+
+}
+
+@interface ProcessorPerformanceTests : XCTestCase
+@end
+
+@implementation ProcessorPerformanceTests
+
+- (void)testZ80Construction {
+	[self measureBlock:^{
+		for(int c = 0; c < 100; ++c) {
+			std::unique_ptr<CPU::Z80::AllRAMProcessor> processor(CPU::Z80::AllRAMProcessor::Processor());
+		}
+	}];
+}
+
+- (void)testZ80Throughput {
+	constexpr int cycles = 50'000'000;
+
+	// Count the instructions in a run, then time a second run without a delegate.
+	Z80InstructionCounter counter;
+	{
+		std::unique_ptr<CPU::Z80::AllRAMProcessor> processor(CPU::Z80::AllRAMProcessor::Processor());
+		processor->set_data_at_address(0, sizeof(z80_program), z80_program);
+		processor->set_memory_access_delegate(&counter);
+		processor->run_for(Cycles(cycles));
+	}
+
+	[self measureBlock:^{
+		std::unique_ptr<CPU::Z80::AllRAMProcessor> processor(CPU::Z80::AllRAMProcessor::Processor());
+		processor->set_data_at_address(0, sizeof(z80_program), z80_program);
+
+		const auto start = std::chrono::steady_clock::now();
+		processor->run_for(Cycles(cycles));
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		NSLog(@"Z80: %0.1f million instructions/second", double(counter.instructions) / duration.count() / 1e6);
+	}];
+}
+
+- (void)measureMOS6502:(CPU::MOS6502::Personality)personality threaded:(BOOL)threaded {
+	constexpr int cycles = 50'000'000;
+
+	[self measureBlock:^{
+		std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processor(CPU::MOS6502::AllRAMProcessor::Processor(personality, threaded));
+		processor->set_data_at_address(0x0200, sizeof(mos6502_program), mos6502_program);
+		processor->set_data_at_address(0x0240, sizeof(mos6502_subroutine), mos6502_subroutine);
+		processor->set_data_at_address(0x0010, sizeof(mos6502_pointer), mos6502_pointer);
+		processor->set_value_of_register(CPU::MOS6502::Register::Flags, 0);
+		processor->set_value_of_register(CPU::MOS6502::Register::ProgramCounter, 0x0200);
+
+		const auto start = std::chrono::steady_clock::now();
+		processor->run_for(Cycles(cycles));
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		NSLog(@"6502: %0.1f million cycles/second", double(cycles) / duration.count() / 1e6);
+	}];
+}
+
+- (void)test6502Throughput {
+	[self measureMOS6502:CPU::MOS6502::Personality::P6502 threaded:NO];
+}
+
+- (void)test6502ThreadedThroughput {
+	[self measureMOS6502:CPU::MOS6502::Personality::P6502 threaded:YES];
+}
+
+- (void)test65C02Throughput {
+	[self measureMOS6502:CPU::MOS6502::Personality::PWDC65C02 threaded:NO];
+}
+
+- (void)test65C02ThreadedThroughput {
+	[self measureMOS6502:CPU::MOS6502::Personality::PWDC65C02 threaded:YES];
+}
+
+- (void)test68000Throughput {
+	constexpr int cycles = 50'000'000;
+
+	[self measureBlock:^{
+		std::unique_ptr<CPU::MC68000::AllRAMProcessor> processor(CPU::MC68000::AllRAMProcessor::Processor());
+		processor->set_data_at_address(0, sizeof(mc68000_program), mc68000_program);
+
+		const auto start = std::chrono::steady_clock::now();
+		processor->run_for(Cycles(cycles));
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		NSLog(@"68000: %0.1f million instructions/second", double(processor->get_instruction_count()) / duration.count() / 1e6);
+	}];
+}
+
+@end
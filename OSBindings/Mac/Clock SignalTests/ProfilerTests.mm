@@ -0,0 +1,85 @@
+//
+//  ProfilerTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Analyser/Dynamic/Profiler.hpp"
+
+#include <sstream>
+
+@interface ProfilerTests : XCTestCase
+@end
+
+@implementation ProfilerTests
+
+- (void)testCyclesPerAddress {
+	CPU::TraceRing &ring = CPU::TraceRing::current();
+	ring.clear();
+
+	// Three passes through a two-instruction loop at $200, of 2 and 3 cycles.
+	uint64_t time = 0;
+	for(int c = 0; c < 6; ++c) {
+		auto &record = ring.begin_record();
+		record.time = time;
+		record.program_counter = (c & 1) ? 0x202 : 0x200;
+		record.opcode = (c & 1) ? 0xd0 : 0xe8;
+		record.source = CPU::TraceRing::Source::MOS6502;
+		record.register_count = 0;
+		ring.end_record();
+		time += (c & 1) ? 3 : 2;
+	}
+
+	Analyser::Dynamic::Profiler profiler(CPU::TraceRing::Source::MOS6502);
+	profiler.sample(ring);
+
+	// The final instruction's duration isn't yet known.
+	const auto entries = profiler.entries();
+	XCTAssertEqual(entries.size(), 2);
+	XCTAssertEqual(entries[0].address, 0x200);
+	XCTAssertEqual(entries[0].cycles, 6);
+	XCTAssertEqual(entries[0].instructions, 3);
+	XCTAssertEqual(entries[1].address, 0x202);
+	XCTAssertEqual(entries[1].cycles, 6);
+	XCTAssertEqual(entries[1].instructions, 2);
+}
+
+- (void)testAnnotation {
+	std::vector<uint8_t> memory(65536);
+	memory[0x200] = 0xe8;	// INX
+	memory[0x201] = 0xd0;	// BNE $0200
+	memory[0x202] = 0xfd;
+
+	CPU::TraceRing &ring = CPU::TraceRing::current();
+	ring.clear();
+	for(uint64_t c = 0; c < 3; ++c) {
+		auto &record = ring.begin_record();
+		record.time = c * 2;
+		record.program_counter = 0x200 + uint32_t(c & 1);
+		record.source = CPU::TraceRing::Source::MOS6502;
+		record.register_count = 0;
+		ring.end_record();
+	}
+
+	Analyser::Dynamic::Profiler profiler(CPU::TraceRing::Source::MOS6502);
+	profiler.add_symbol("loop", 0x200, 0x203);
+	profiler.sample(ring);
+
+	// The disassembler should be asked about all addresses at once.
+	std::ostringstream stream;
+	const auto disassembler = Analyser::Dynamic::Profiler::MOS6502Disassembler(memory);
+	int disassemblies = 0;
+	profiler.print(stream, [&] (const std::vector<uint32_t> &addresses) {
+		++disassemblies;
+		return disassembler(addresses);
+	});
+	XCTAssertEqual(disassemblies, 1);
+	XCTAssertNotEqual(stream.str().find("loop+0\tINX"), std::string::npos);
+	XCTAssertNotEqual(stream.str().find("loop+1\tBNE $0200"), std::string::npos);
+}
+
+@end
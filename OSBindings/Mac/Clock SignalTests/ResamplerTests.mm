@@ -0,0 +1,127 @@
+//
+//  ResamplerTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../SignalProcessing/Resampler.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// Passes all of @c input through @c resampler, returning all output that results.
+std::vector<int16_t> resample(SignalProcessing::Resampler &resampler, const std::vector<int16_t> &input) {
+	std::vector<int16_t> output;
+	int16_t block[512];
+
+	std::size_t offset = 0;
+	while(offset < input.size()) {
+		std::size_t capacity;
+		int16_t *const destination = resampler.input_buffer(capacity);
+		const std::size_t count = std::min(capacity, input.size() - offset);
+		std::copy(input.begin() + long(offset), input.begin() + long(offset + count), destination);
+		resampler.did_write_input(count);
+		offset += count;
+
+		while(true) {
+			const std::size_t produced = resampler.get_output(block, 512);
+			output.insert(output.end(), block, block + produced);
+			if(produced < 512) break;
+		}
+	}
+
+	return output;
+}
+
+}
+
+@interface ResamplerTests : XCTestCase
+@end
+
+@implementation ResamplerTests
+
+/// Checks that a single impulse emerges as a single symmetric pulse that preserves the input's
+/// energy, both where every output uses the same filter and where phases are selected.
+- (void)testImpulseResponse {
+	const struct {
+		float input_rate, output_rate;
+	} rates[] = {
+		{44100.0f, 44100.0f},
+		{88200.0f, 44100.0f},
+		{22050.0f, 44100.0f},
+		{11025.0f, 44100.0f},
+	};
+
+	for(const auto &rate: rates) {
+		SignalProcessing::Resampler resampler(rate.input_rate, rate.output_rate, 4000.0f);
+
+		std::vector<int16_t> input(8192);
+		input[4096] = 16384;
+		const auto output = resample(resampler, input);
+
+		// The sum of the output should be that of the input, scaled by the number of outputs per input.
+		int sum = 0;
+		for(const auto sample: output) sum += sample;
+		const float expected = 16384.0f * rate.output_rate / rate.input_rate;
+		XCTAssertEqualWithAccuracy(float(sum), expected, expected * 0.02f, @"Impulse energy not preserved from %0.0f to %0.0f", rate.input_rate, rate.output_rate);
+
+		// The response should rise to a single peak and fall away again either side of it.
+		const auto peak = std::max_element(output.begin(), output.end()) - output.begin();
+		XCTAssertGreaterThan(output[std::size_t(peak)], 0);
+		for(std::size_t c = 1; c < 3; ++c) {
+			XCTAssertLessThanOrEqual(output[std::size_t(peak) - c], output[std::size_t(peak) - c + 1]);
+			XCTAssertLessThanOrEqual(output[std::size_t(peak) + c], output[std::size_t(peak) + c - 1]);
+		}
+	}
+}
+
+/// Checks that the number of outputs produced is in the proportion of the two rates, including where
+/// the rates are not integers and where the output rate is below 1Hz.
+- (void)testRateRatio {
+	const struct {
+		float input_rate, output_rate;
+	} rates[] = {
+		{1000000.0f, 44100.0f},
+		{44100.0f, 48000.0f},
+		{1000.5f, 1000.0f},
+		{3546.875f, 441.25f},
+		{1.5f, 0.5f},
+		{0.75f, 1.25f},
+	};
+
+	const std::size_t input_length = 200000;
+	for(const auto &rate: rates) {
+		SignalProcessing::Resampler resampler(rate.input_rate, rate.output_rate);
+
+		const std::vector<int16_t> input(input_length, 8192);
+		const auto output = resample(resampler, input);
+
+		// Allow for output lost to the filter's latency.
+		const double expected = double(input_length) * double(rate.output_rate) / double(rate.input_rate);
+		XCTAssertLessThanOrEqual(double(output.size()), expected + 1.0, @"Too many samples from %f to %f", rate.input_rate, rate.output_rate);
+		XCTAssertGreaterThan(double(output.size()), expected * 0.99, @"Too few samples from %f to %f", rate.input_rate, rate.output_rate);
+
+		// A constant input should produce the same constant output.
+		XCTAssertEqualWithAccuracy(output[output.size() / 2], 8192, 82);
+	}
+}
+
+- (void)testRejectsNonPositiveRates {
+	for(const auto &rates: {std::make_pair(0.0f, 44100.0f), std::make_pair(44100.0f, 0.0f), std::make_pair(-1.0f, 44100.0f), std::make_pair(44100.0f, -44100.0f)}) {
+		bool did_throw = false;
+		try {
+			SignalProcessing::Resampler resampler(rates.first, rates.second);
+		} catch(SignalProcessing::Resampler::Error) {
+			did_throw = true;
+		}
+		XCTAssertTrue(did_throw, @"Rates %f and %f were accepted", rates.first, rates.second);
+	}
+}
+
+@end
@@ -0,0 +1,108 @@
+//
+//  RewindBufferTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Utility/RewindBuffer.hpp"
+#include "../../../Machines/Oric/Oric.hpp"
+#include "../../../Analyser/Static/Oric/Target.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Supplies an Oric with a BASIC ROM that enables a VIA timer interrupt, then continually
+/// increments X and writes it to both VIA ports and to screen memory; the interrupt handler
+/// increments a location within screen memory.
+std::vector<std::unique_ptr<std::vector<uint8_t>>> fetch_test_roms(const std::vector<ROMMachine::ROM> &roms) {
+	const uint8_t program[] = {
+		0xa9, 0xc0, 0x8d, 0x0e, 0x03,		// LDA #$c0; STA $030e		(enable timer 1 interrupts)
+		0xa9, 0x40, 0x8d, 0x0b, 0x03,		// LDA #$40; STA $030b		(timer 1 free-running)
+		0xa9, 0x10, 0x8d, 0x04, 0x03,		// LDA #$10; STA $0304
+		0x8d, 0x05, 0x03,					// STA $0305
+		0x58,								// CLI
+		0xe8,								// loop: INX
+		0x8e, 0x01, 0x03,					// STX $0301
+		0x8e, 0x00, 0x03,					// STX $0300
+		0x8e, 0x00, 0xbb,					// STX $bb00
+		0x4c, 0x13, 0xc0,					// JMP loop
+	};
+	const uint8_t interrupt_handler[] = {
+		0xad, 0x04, 0x03,					// LDA $0304				(acknowledge the interrupt)
+		0xee, 0x80, 0xbb,					// INC $bb80
+		0x40,								// RTI
+	};
+
+	std::vector<std::unique_ptr<std::vector<uint8_t>>> results;
+	for(const auto &rom: roms) {
+		results.push_back(std::make_unique<std::vector<uint8_t>>(rom.size, 0));
+	}
+
+	auto &basic = *results[1];
+	std::copy(std::begin(program), std::end(program), basic.begin());
+	std::copy(std::begin(interrupt_handler), std::end(interrupt_handler), basic.begin() + 0x100);
+	basic[0x3ffc] = 0x00;	basic[0x3ffd] = 0xc0;
+	basic[0x3ffe] = 0x00;	basic[0x3fff] = 0xc1;
+	return results;
+}
+
+}
+
+@interface RewindBufferTests : XCTestCase
+@end
+
+@implementation RewindBufferTests
+
+- (void)testRoundTrip {
+	Analyser::Static::Oric::Target target;
+	std::unique_ptr<Oric::Machine> machine(Oric::Machine::Oric(&target, fetch_test_roms));
+	XCTAssert(machine);
+
+	auto crt_machine = dynamic_cast<CRTMachine::Machine *>(machine.get());
+	auto snapshot_machine = dynamic_cast<SnapshotMachine::Machine *>(machine.get());
+	Machine::RewindBuffer rewind_buffer(*crt_machine, *snapshot_machine, 5.0, 10);
+
+	// The Oric runs at 50Hz, so there should be one capture per field.
+	rewind_buffer.run_for(2.0);
+	XCTAssertGreaterThanOrEqual(rewind_buffer.size(), 99);
+	XCTAssertLessThanOrEqual(rewind_buffer.size(), 101);
+
+	// Each run ends with a capture unless earlier overrun time covered it, in which case the state
+	// is unchanged since the previous capture. So after each run the machine's state is that of the
+	// most recent frame; record it along with the number of frames.
+	std::vector<std::pair<std::size_t, std::vector<uint8_t>>> states;
+	for(int c = 0; c < 40; ++c) {
+		rewind_buffer.run_for(0.015);
+		states.emplace_back(rewind_buffer.size(), snapshot_machine->snapshot());
+	}
+	XCTAssertGreaterThan(states.back().first, states.front().first + 20);
+
+	// Rewinding to each of those points, some between keyframes, should restore exactly the state
+	// recorded there. History after the point rewound to is discarded, so each subsequent rewind
+	// counts from there.
+	for(const std::size_t index: {39, 36, 30, 23, 17}) {
+		XCTAssert(rewind_buffer.rewind(rewind_buffer.size() - states[index].first));
+		XCTAssertEqual(rewind_buffer.size(), states[index].first);
+		XCTAssert(snapshot_machine->snapshot() == states[index].second, @"Rewind to point %zu failed", index);
+	}
+
+	// Running forward and then rewinding by the number of frames added should return to the same point.
+	const std::size_t size = rewind_buffer.size();
+	rewind_buffer.run_for(0.5);
+	XCTAssert(snapshot_machine->snapshot() != states[17].second);
+	XCTAssert(rewind_buffer.rewind(rewind_buffer.size() - size));
+	XCTAssert(snapshot_machine->snapshot() == states[17].second);
+
+	// Rewinding beyond the available history should fail without modifying the machine.
+	XCTAssertFalse(rewind_buffer.rewind(rewind_buffer.size()));
+	XCTAssert(snapshot_machine->snapshot() == states[17].second);
+}
+
+@end
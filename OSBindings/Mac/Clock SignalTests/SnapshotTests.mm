@@ -0,0 +1,199 @@
+//
+//  SnapshotTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Snapshot.hpp"
+#include "../../../Storage/Tape/Tape.hpp"
+#include "../../../Components/9918/9918.hpp"
+#include "../../../Components/DiskII/DiskII.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// A tape of pulses that alternate between high and low, of varying lengths.
+class AlternatingTape: public Storage::Tape::Tape {
+	public:
+		bool is_at_end() final {
+			return count_ >= 10000;
+		}
+
+	private:
+		int count_ = 0;
+
+		Pulse virtual_get_next_pulse() final {
+			++count_;
+			return Pulse((count_ & 1) ? Pulse::High : Pulse::Low, Storage::Time(unsigned(count_ % 7) + 1, 10000u));
+		}
+
+		void virtual_reset() final {
+			count_ = 0;
+		}
+};
+
+/// @returns The input levels observed from @c player, sampled every 10 cycles, over @c count samples.
+std::vector<bool> sample_tape(Storage::Tape::BinaryTapePlayer &player, int count) {
+	std::vector<bool> levels;
+	while(count--) {
+		player.run_for(Cycles(10));
+		levels.push_back(player.get_input());
+	}
+	return levels;
+}
+
+}
+
+@interface SnapshotTests : XCTestCase
+@end
+
+@implementation SnapshotTests
+
+- (void)testRoundTrip {
+	Storage::Snapshot::Writer writer;
+	writer.begin("TEST", 2);
+	writer.put(uint8_t(0x12), int32_t(-5), Cycles(1234), true);
+	writer.put_vector(std::vector<uint16_t>{1, 2, 3});
+	writer.end();
+
+	Storage::Snapshot::Reader reader(writer.data());
+	uint16_t version;
+	XCTAssert(reader.begin("TEST", 2, &version));
+	XCTAssertEqual(version, 2);
+
+	uint8_t byte;
+	int32_t integer;
+	Cycles cycles;
+	bool flag;
+	std::vector<uint16_t> vector;
+	XCTAssert(reader.get(byte, integer, cycles, flag));
+	XCTAssert(reader.get_vector(vector));
+	XCTAssert(reader.end());
+
+	XCTAssertEqual(byte, 0x12);
+	XCTAssertEqual(integer, -5);
+	XCTAssertEqual(cycles.as_integral(), 1234);
+	XCTAssert(flag);
+	XCTAssert((vector == std::vector<uint16_t>{1, 2, 3}));
+}
+
+- (void)testFailureIsSticky {
+	Storage::Snapshot::Writer writer;
+	writer.begin("TEST", 2);
+	writer.put(uint16_t(7));
+	writer.end();
+
+	// A newer version than that understood should be rejected.
+	{
+		Storage::Snapshot::Reader reader(writer.data());
+		XCTAssertFalse(reader.begin("TEST", 1));
+		XCTAssertFalse(reader.is_valid());
+	}
+
+	// As should reading beyond the end of a chunk, along with all subsequent reads.
+	{
+		Storage::Snapshot::Reader reader(writer.data());
+		uint32_t value;
+		XCTAssert(reader.begin("TEST", 2));
+		XCTAssertFalse(reader.get(value));
+		XCTAssertFalse(reader.end());
+	}
+
+	// As should a truncated snapshot.
+	{
+		std::vector<uint8_t> truncated = writer.data();
+		truncated.pop_back();
+
+		Storage::Snapshot::Reader reader(truncated);
+		XCTAssertFalse(reader.begin("TEST", 2));
+	}
+}
+
+- (void)testVDPRestore {
+	TI::TMS::TMS9918 vdp(TI::TMS::Personality::SMSVDP);
+
+	// Enable the display and output some video.
+	vdp.write(1, 0x40);
+	vdp.write(1, 0x81);
+	for(int c = 0; c < 256; ++c) {
+		vdp.write(0, uint8_t(c));
+	}
+	vdp.run_for(HalfCycles(12345));
+
+	Storage::Snapshot::Writer before;
+	vdp.save_state(before);
+
+	// Perturb the VDP; restoring should put it back exactly as it was.
+	vdp.write(1, 0x00);
+	vdp.write(1, 0x81);
+	vdp.run_for(HalfCycles(54321));
+
+	Storage::Snapshot::Reader reader(before.data());
+	XCTAssert(vdp.restore_state(reader));
+
+	Storage::Snapshot::Writer after;
+	vdp.save_state(after);
+	XCTAssert(before.data() == after.data());
+}
+
+- (void)testTapeRestore {
+	Storage::Tape::BinaryTapePlayer player(1000000);
+	player.set_tape(std::make_shared<AlternatingTape>());
+	player.set_motor_control(true);
+	player.run_for(Cycles(123456));
+
+	Storage::Snapshot::Writer writer;
+	player.save_state(writer);
+	const auto expected = sample_tape(player, 5000);
+
+	// A second player, with the same tape inserted, should continue from exactly the same point.
+	Storage::Tape::BinaryTapePlayer restored_player(1000000);
+	restored_player.set_tape(std::make_shared<AlternatingTape>());
+
+	Storage::Snapshot::Reader reader(writer.data());
+	XCTAssert(restored_player.restore_state(reader));
+	XCTAssert(restored_player.get_motor_control());
+	XCTAssert(sample_tape(restored_player, 5000) == expected);
+}
+
+- (void)testDiskIIRestore {
+	Apple::DiskII disk_ii(2000000);
+
+	// Turn the motor on and step outward by cycling through the stepper phases.
+	disk_ii.read_address(0x9);
+	for(int c = 0; c < 8; ++c) {
+		disk_ii.read_address(0x1 + ((c & 3) << 1));
+		disk_ii.read_address(0x0 + ((c & 3) << 1));
+	}
+	disk_ii.run_for(Cycles(1000));
+	XCTAssertFalse(disk_ii.get_drive(0).get_is_track_zero());
+
+	Storage::Snapshot::Writer before;
+	disk_ii.save_state(before);
+
+	Apple::DiskII restored_disk_ii(2000000);
+	Storage::Snapshot::Reader reader(before.data());
+	XCTAssert(restored_disk_ii.restore_state(reader));
+	XCTAssert(restored_disk_ii.get_drive(0).get_motor_on());
+	XCTAssertFalse(restored_disk_ii.get_drive(0).get_is_track_zero());
+
+	Storage::Snapshot::Writer after;
+	restored_disk_ii.save_state(after);
+	XCTAssert(before.data() == after.data());
+
+	// Stepping back inward by the same amount should reach track zero.
+	for(int c = 7; c >= 0; --c) {
+		restored_disk_ii.read_address(0x1 + ((c & 3) << 1));
+		restored_disk_ii.read_address(0x0 + ((c & 3) << 1));
+	}
+	XCTAssert(restored_disk_ii.get_drive(0).get_is_track_zero());
+}
+
+@end
@@ -0,0 +1,120 @@
+//
+//  SoftwareScanTargetTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Outputs/CRT/CRT.hpp"
+#include "../../../Outputs/Software/ScanTarget.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int Width = 320, Height = 240;
+
+/// Counts field completion announcements.
+struct FieldCounter: public Outputs::Display::Software::ScanTarget::Delegate {
+	int fields = 0;
+	void scan_target_did_complete_field(Outputs::Display::Software::ScanTarget *) final {
+		++fields;
+	}
+};
+
+/// Outputs @c fields PAL fields of white lines to @c crt.
+void output_fields(Outputs::CRT::CRT &crt, int fields) {
+	for(int field = 0; field < fields; ++field) {
+		crt.output_sync(256 * 3);
+		for(int line = 3; line < 312; ++line) {
+			crt.output_sync(20);
+			crt.output_blank(20);
+
+			uint8_t *const pixels = crt.begin_data(200);
+			if(pixels) memset(pixels, 0xff, 200 * 4);
+			crt.output_data(200);
+
+			crt.output_blank(16);
+		}
+	}
+}
+
+}
+
+@interface SoftwareScanTargetTests : XCTestCase
+@end
+
+@implementation SoftwareScanTargetTests
+
+- (void)testFieldCounting {
+	std::vector<uint8_t> buffer(Width * Height * 4);
+	Outputs::Display::Software::ScanTarget scan_target;
+	scan_target.set_target_buffer(buffer.data(), Width, Height);
+
+	FieldCounter counter;
+	scan_target.set_delegate(&counter);
+
+	Outputs::CRT::CRT crt(256, 1, Outputs::Display::Type::PAL50, Outputs::Display::InputDataType::Red8Green8Blue8);
+	crt.set_display_type(Outputs::Display::DisplayType::RGB);
+	crt.set_scan_target(&scan_target);
+
+	// Allow the CRT to synchronise, then count further fields.
+	output_fields(crt, 10);
+	const int initial_fields = scan_target.completed_fields();
+	XCTAssertGreaterThan(initial_fields, 0);
+	XCTAssertEqual(counter.fields, initial_fields);
+
+	output_fields(crt, 20);
+	XCTAssertEqual(scan_target.completed_fields() - initial_fields, 20);
+	XCTAssertEqual(counter.fields, scan_target.completed_fields());
+
+	// The centre of the display should be white and opaque.
+	const uint8_t *const centre = &buffer[((Height / 2) * Width + Width / 2) * 4];
+	XCTAssertEqual(centre[0], 255);
+	XCTAssertEqual(centre[1], 255);
+	XCTAssertEqual(centre[2], 255);
+	XCTAssertEqual(centre[3], 255);
+}
+
+- (void)testFieldSkipping {
+	std::vector<uint8_t> buffer(Width * Height * 4);
+	Outputs::Display::Software::ScanTarget scan_target;
+	scan_target.set_target_buffer(buffer.data(), Width, Height);
+
+	Outputs::Display::FieldSkippingScanTarget skipper(&scan_target);
+	skipper.set_field_interval(3);
+
+	Outputs::CRT::CRT crt(256, 1, Outputs::Display::Type::PAL50, Outputs::Display::InputDataType::Red8Green8Blue8);
+	crt.set_display_type(Outputs::Display::DisplayType::RGB);
+	crt.set_scan_target(&skipper);
+
+	output_fields(crt, 10);
+	const int initial_fields = scan_target.completed_fields();
+
+	// Only every third field should reach the software target, and each one that does should still be painted.
+	output_fields(crt, 30);
+	XCTAssertEqual(scan_target.completed_fields() - initial_fields, 10);
+
+	const uint8_t *const centre = &buffer[((Height / 2) * Width + Width / 2) * 4];
+	XCTAssertEqual(centre[0], 255);
+	XCTAssertEqual(centre[3], 255);
+
+	// Advance to the end of a forwarded field. Clearing the buffer and then outputting
+	// the two skipped fields that follow should leave it untouched.
+	const int forwarded_fields = scan_target.completed_fields();
+	for(int c = 0; c < 3 && scan_target.completed_fields() == forwarded_fields; ++c) {
+		output_fields(crt, 1);
+	}
+	memset(buffer.data(), 0, buffer.size());
+	const int painted_fields = scan_target.completed_fields();
+	XCTAssertEqual(painted_fields, forwarded_fields + 1);
+	output_fields(crt, 2);
+	XCTAssertEqual(scan_target.completed_fields(), painted_fields);
+	XCTAssertEqual(centre[0], 0);
+}
+
+@end
@@ -0,0 +1,252 @@
+//
+//  TraceRingTests.mm
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Processors/TraceRing.hpp"
+#include "../../../Processors/6502/6502.hpp"
+#include "../../../Processors/68000/68000.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// Provides a 6502 with 64kb of RAM, with execution beginning at 0x200, and traces its execution.
+template <bool registers> struct TracedMOS6502: public CPU::MOS6502::BusHandler {
+	TracedMOS6502(const std::vector<uint8_t> &program) : mos6502(*this) {
+		std::copy(program.begin(), program.end(), ram.begin() + 0x200);
+		ram[0xfffc] = 0x00;
+		ram[0xfffd] = 0x02;
+	}
+
+	Cycles perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+		if(isReadOperation(operation)) {
+			*value = ram[address];
+		} else if(operation == CPU::MOS6502::BusOperation::Write) {
+			ram[address] = *value;
+		}
+		return Cycles(1);
+	}
+
+	static constexpr bool traces_execution = true;
+	static constexpr bool traces_registers = registers;
+
+	CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, TracedMOS6502, false> mos6502;
+	std::array<uint8_t, 65536> ram{};
+};
+
+/// Provides a 68000 with 64kb of RAM, with execution beginning at 0x400, and traces its execution.
+template <bool registers> struct TracedMC68000: public CPU::MC68000::BusHandler {
+	TracedMC68000(const std::vector<uint16_t> &program) : mc68000(*this) {
+		ram[1] = 0x1000;	// Supervisor stack pointer.
+		ram[3] = 0x0400;	// Initial PC.
+		std::copy(program.begin(), program.end(), ram.begin() + (0x400 >> 1));
+	}
+
+	HalfCycles perform_bus_operation(const CPU::MC68000::Microcycle &cycle, int) {
+		using Microcycle = CPU::MC68000::Microcycle;
+		if(cycle.data_select_active() && !(cycle.operation & Microcycle::InterruptAcknowledge)) {
+			uint16_t &word = ram[cycle.word_address() % ram.size()];
+			switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte | Microcycle::Read)) {
+				default: break;
+
+				case Microcycle::SelectWord | Microcycle::Read:
+					cycle.value->full = word;
+				break;
+				case Microcycle::SelectByte | Microcycle::Read:
+					cycle.value->halves.low = uint8_t(word >> cycle.byte_shift());
+				break;
+				case Microcycle::SelectWord:
+					word = cycle.value->full;
+				break;
+				case Microcycle::SelectByte:
+					word = uint16_t((cycle.value->halves.low << cycle.byte_shift()) | (word & cycle.untouched_byte_mask()));
+				break;
+			}
+		}
+		return HalfCycles(0);
+	}
+
+	static constexpr bool traces_execution = true;
+	static constexpr bool traces_registers = registers;
+
+	CPU::MC68000::Processor<TracedMC68000, true> mc68000;
+	std::array<uint16_t, 32768> ram{};
+};
+
+const std::vector<uint8_t> mos6502_program = {
+	0xa9, 0x12,			// LDA #$12
+	0xa2, 0x34,			// LDX #$34
+	0xa0, 0x56,			// LDY #$56
+	0xea,				// NOP
+	0x4c, 0x07, 0x02,	// JMP $0207
+};
+
+const std::vector<uint16_t> mc68000_program = {
+	0x7005,		// MOVEQ #5, D0
+	0x7207,		// MOVEQ #7, D1
+	0xd280,		// ADD.L D0, D1
+	0x60fe,		// BRA.s *
+};
+
+}
+
+@interface TraceRingTests : XCTestCase
+@end
+
+@implementation TraceRingTests
+
+- (void)testWraparound {
+	CPU::TraceRing &ring = CPU::TraceRing::current();
+	ring.set_capacity(5);
+
+	for(uint32_t c = 0; c < 20; ++c) {
+		auto &record = ring.begin_record();
+		record.time = c;
+		record.program_counter = c * 2;
+		record.register_count = 0;
+		ring.end_record();
+	}
+
+	// The capacity should have been rounded up to 8, and the most recent 8 records retained, oldest first.
+	const auto records = ring.records();
+	XCTAssertEqual(records.size(), 8);
+	for(std::size_t c = 0; c < records.size(); ++c) {
+		XCTAssertEqual(records[c].time, c + 12);
+		XCTAssertEqual(records[c].program_counter, (c + 12) * 2);
+	}
+
+	ring.clear();
+	XCTAssert(ring.records().empty());
+}
+
+- (void)testRegisters {
+	CPU::TraceRing &ring = CPU::TraceRing::current();
+	ring.set_capacity(4);
+
+	for(uint32_t c = 0; c < 6; ++c) {
+		auto &record = ring.begin_record();
+		record.time = c;
+		record.register_count = uint8_t(c & 1);
+		ring.record_registers()[0] = c * 3;
+		ring.end_record();
+	}
+
+	// Only as many registers as each record declares should be reported.
+	const auto records = ring.records();
+	XCTAssertEqual(records.size(), 4);
+	for(std::size_t c = 0; c < records.size(); ++c) {
+		XCTAssertEqual(records[c].register_count, (c + 2) & 1);
+		XCTAssertEqual(records[c].registers[0], (c & 1) ? (c + 2) * 3 : 0);
+	}
+}
+
+- (void)test6502 {
+	CPU::TraceRing &ring = CPU::TraceRing::current();
+	ring.set_capacity(64);
+
+	auto machine = std::make_unique<TracedMOS6502<true>>(mos6502_program);
+	machine->mos6502.run_for(Cycles(40));
+
+	// Expect LDA, LDX, LDY, NOP and then repetitions of the JMP; the processor may already be part way
+	// through the reset sequence when the ring begins, so locate the LDA first.
+	const auto records = ring.records();
+	std::size_t first = 0;
+	while(first < records.size() && records[first].program_counter != 0x200) ++first;
+	XCTAssertLessThan(first + 6, records.size());
+	if(first + 6 >= records.size()) return;
+
+	const uint32_t addresses[] = {0x200, 0x202, 0x204, 0x206, 0x207, 0x207};
+	const uint16_t opcodes[] = {0xa9, 0xa2, 0xa0, 0xea, 0x4c, 0x4c};
+	const uint64_t durations[] = {2, 2, 2, 2, 3};
+	for(std::size_t c = 0; c < 6; ++c) {
+		const auto &record = records[first + c];
+		XCTAssertEqual(record.source, CPU::TraceRing::Source::MOS6502);
+		XCTAssertEqual(record.program_counter, addresses[c]);
+		XCTAssertEqual(record.opcode, opcodes[c]);
+		XCTAssertEqual(record.register_count, 5);
+		if(c < 5) {
+			XCTAssertEqual(records[first + c + 1].time - record.time, durations[c]);
+		}
+	}
+
+	// Registers are as at the start of each instruction.
+	XCTAssertEqual(records[first + 1].registers[0], 0x12);
+	XCTAssertEqual(records[first + 2].registers[1], 0x34);
+	XCTAssertEqual(records[first + 3].registers[2], 0x56);
+}
+
+- (void)test6502WithoutRegisters {
+	CPU::TraceRing &ring = CPU::TraceRing::current();
+	ring.set_capacity(64);
+
+	auto machine = std::make_unique<TracedMOS6502<false>>(mos6502_program);
+	machine->mos6502.run_for(Cycles(40));
+
+	const auto records = ring.records();
+	XCTAssertFalse(records.empty());
+	for(const auto &record: records) {
+		XCTAssertEqual(record.register_count, 0);
+	}
+	XCTAssertEqual(records.back().program_counter, 0x207);
+	XCTAssertEqual(records.back().opcode, 0x4c);
+}
+
+- (void)test68000 {
+	CPU::TraceRing &ring = CPU::TraceRing::current();
+	ring.set_capacity(64);
+
+	auto machine = std::make_unique<TracedMC68000<true>>(mc68000_program);
+	machine->mc68000.run_for(HalfCycles(400));
+
+	// Expect MOVEQ, MOVEQ, ADD and then repetitions of the BRA.
+	const auto records = ring.records();
+	XCTAssertGreaterThanOrEqual(records.size(), 5);
+	if(records.size() < 5) return;
+
+	const uint32_t addresses[] = {0x400, 0x402, 0x404, 0x406, 0x406};
+	const uint16_t opcodes[] = {0x7005, 0x7207, 0xd280, 0x60fe, 0x60fe};
+	const uint64_t durations[] = {4, 4, 8, 10};
+	for(std::size_t c = 0; c < 5; ++c) {
+		const auto &record = records[c];
+		XCTAssertEqual(record.source, CPU::TraceRing::Source::MC68000);
+		XCTAssertEqual(record.program_counter, addresses[c]);
+		XCTAssertEqual(record.opcode, opcodes[c]);
+		XCTAssertEqual(record.register_count, 17);
+		if(c < 4) {
+			XCTAssertEqual(records[c + 1].time - record.time, durations[c]);
+		}
+	}
+
+	// Registers are as at the start of each instruction: D0–D7, A0–A7 and then the status register.
+	XCTAssertEqual(records[2].registers[0], 5);
+	XCTAssertEqual(records[2].registers[1], 7);
+	XCTAssertEqual(records[3].registers[1], 12);
+	XCTAssertEqual(records[3].registers[15], 0x1000);
+	XCTAssertEqual(records[3].registers[16] & 0x2000, 0x2000);
+}
+
+- (void)test68000WithoutRegisters {
+	CPU::TraceRing &ring = CPU::TraceRing::current();
+	ring.set_capacity(64);
+
+	auto machine = std::make_unique<TracedMC68000<false>>(mc68000_program);
+	machine->mc68000.run_for(HalfCycles(400));
+
+	const auto records = ring.records();
+	XCTAssertGreaterThanOrEqual(records.size(), 5);
+	for(const auto &record: records) {
+		XCTAssertEqual(record.register_count, 0);
+	}
+	XCTAssertEqual(records.back().program_counter, 0x406);
+	XCTAssertEqual(records.back().opcode, 0x60fe);
+}
+
+@end
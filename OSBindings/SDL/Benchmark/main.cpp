@@ -0,0 +1,365 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../../../Processors/6502/AllRAM/6502AllRAM.hpp"
+#include "../../../Processors/68000/AllRAM/68000AllRAM.hpp"
+#include "../../../Processors/Z80/AllRAM/Z80AllRAM.hpp"
+
+namespace {
+
+// MARK: - Default programs.
+
+/// A loop that exercises the base, CB, DD and ED pages and both taken and untaken conditional calls.
+const std::vector<uint8_t> z80_program = {
+	0x31, 0x00, 0xf0,			// LD SP, $f000
+	0x21, 0x00, 0x80,			// LD HL, $8000
+	0xdd, 0x21, 0x00, 0x90,		// LD IX, $9000
+
+	// loop:
+	0x7e,						// LD A, (HL)
+	0x3c,						// INC A
+	0x77,						// LD (HL), A
+	0xcb, 0x07,					// RLC A
+	0xdd, 0x77, 0x05,			// LD (IX+5), A
+	0xed, 0x44,					// NEG
+	0xc5,						// PUSH BC
+	0xc1,						// POP BC
+	0xcd, 0x20, 0x00,			// CALL $0020
+	0x23,						// INC HL
+	0xc4, 0x20, 0x00,			// CALL NZ, $0020
+	0x18, 0xeb,					// JR loop
+
+	0x00,
+
+	// $0020:
+	0xc9,						// RET
+};
+
+/// A loop of loads, stores, arithmetic, stack operations and subroutine calls, to be loaded at $0200.
+const std::vector<uint8_t> mos6502_program = {
+	0xa2, 0xff,			// LDX #$ff
+	0x9a,				// TXS
+	0xa2, 0x00,			// LDX #0
+	0xa0, 0x00,			// LDY #0
+	0x18,				// CLC
+	0xd8,				// CLD
+
+	// loop:
+	0xbd, 0x00, 0x30,	// LDA $3000, X
+	0x69, 0x03,			// ADC #3
+	0x9d, 0x00, 0x30,	// STA $3000, X
+	0x91, 0x10,			// STA ($10), Y
+	0x48,				// PHA
+	0x68,				// PLA
+	0x2a,				// ROL A
+	0x20, 0x40, 0x02,	// JSR $0240
+	0xe8,				// INX
+	0xd0, 0xec,			// BNE loop
+	0xc8,				// INY
+	0x4c, 0x09, 0x02,	// JMP loop
+};
+const std::vector<uint8_t> mos6502_subroutine = {
+	0xe6, 0x20,			// INC $20
+	0x60,				// RTS
+};
+const std::vector<uint8_t> mos6502_pointer = {0x00, 0x40};
+
+/// A loop of register arithmetic, memory reads and writes and a subroutine call, to be loaded at $1000.
+const std::vector<uint8_t> mc68000_program = {
+	// start:
+	0x41, 0xf9, 0x00, 0x00, 0x30, 0x00,		// LEA $3000, A0
+	0x70, 0x63,								// MOVEQ #99, D0
+
+	// loop:
+	0x32, 0x18,								// MOVE.W (A0)+, D1
+	0xd2, 0x41,								// ADD.W D1, D1
+	0x31, 0x41, 0x00, 0x10,					// MOVE.W D1, 16(A0)
+	0xe3, 0x49,								// LSL.W #1, D1
+	0xb3, 0x42,								// EOR.W D1, D2
+	0x4a, 0x42,								// TST.W D2
+	0x61, 0x00, 0x00, 0x0c,					// BSR sub
+	0x51, 0xc8, 0xff, 0xec,					// DBRA D0, loop
+	0x60, 0x00, 0xff, 0xe0,					// BRA start
+
+	0x00, 0x00,
+
+	// sub:
+	0x52, 0x83,								// ADDQ.L #1, D3
+	0x4e, 0x75,								// RTS
+};
+
+// MARK: - Host performance counters.
+
+/*!
+	Counts host hardware events between calls to start and stop, where the host permits;
+	currently that means Linux via perf_event_open, subject to the kernel's paranoia setting.
+*/
+class HostCounters {
+	public:
+		HostCounters() {
+#ifdef __linux__
+			for(auto &counter: counters_) {
+				perf_event_attr attributes;
+				std::memset(&attributes, 0, sizeof(attributes));
+				attributes.type = PERF_TYPE_HARDWARE;
+				attributes.size = sizeof(attributes);
+				attributes.config = counter.config;
+				attributes.disabled = 1;
+				attributes.exclude_kernel = 1;
+				attributes.exclude_hv = 1;
+				counter.descriptor = int(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+			}
+#endif
+		}
+
+		~HostCounters() {
+#ifdef __linux__
+			for(const auto &counter: counters_) {
+				if(counter.descriptor >= 0) close(counter.descriptor);
+			}
+#endif
+		}
+
+		void start() {
+#ifdef __linux__
+			for(const auto &counter: counters_) {
+				if(counter.descriptor < 0) continue;
+				ioctl(counter.descriptor, PERF_EVENT_IOC_RESET, 0);
+				ioctl(counter.descriptor, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+
+		void stop() {
+#ifdef __linux__
+			for(auto &counter: counters_) {
+				if(counter.descriptor < 0) continue;
+				ioctl(counter.descriptor, PERF_EVENT_IOC_DISABLE, 0);
+				if(read(counter.descriptor, &counter.value, sizeof(counter.value)) != sizeof(counter.value)) {
+					counter.value = 0;
+				}
+			}
+#endif
+		}
+
+		/// Prints all available counts, or a note that none are available.
+		void print(std::ostream &stream) const {
+			bool printed_any = false;
+#ifdef __linux__
+			for(const auto &counter: counters_) {
+				if(counter.descriptor < 0) continue;
+				stream << "\t" << counter.name << ": " << counter.value << std::endl;
+				printed_any = true;
+			}
+#endif
+			if(!printed_any) {
+				stream << "\thost counters unavailable" << std::endl;
+			}
+		}
+
+	private:
+#ifdef __linux__
+		struct Counter {
+			const char *name;
+			uint64_t config;
+			int descriptor = -1;
+			uint64_t value = 0;
+		};
+		Counter counters_[5] = {
+			{"host instructions", PERF_COUNT_HW_INSTRUCTIONS},
+			{"cache references", PERF_COUNT_HW_CACHE_REFERENCES},
+			{"cache misses", PERF_COUNT_HW_CACHE_MISSES},
+			{"branch instructions", PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+			{"branch misses", PERF_COUNT_HW_BRANCH_MISSES},
+		};
+#endif
+};
+
+// MARK: - Benchmarking.
+
+/// Describes a binary image and the address it should be loaded to, which is also the address execution begins from.
+struct Image {
+	std::vector<uint8_t> data;
+	uint32_t address = 0;
+};
+
+/// Counts opcode fetches via the trap mechanism, trapping every address.
+struct OpcodeCounter: public CPU::AllRAMProcessor::TrapHandler {
+	void processor_did_trap(CPU::AllRAMProcessor &, uint16_t) final {
+		++instructions;
+	}
+	uint64_t instructions = 0;
+};
+
+void trap_all_addresses(CPU::AllRAMProcessor &processor, OpcodeCounter &counter) {
+	processor.set_trap_handler(&counter);
+	for(int address = 0; address < 65536; ++address) {
+		processor.add_trap_address(uint16_t(address));
+	}
+}
+
+/// Runs @c processor for @c cycles while timing it and counting host events; then prints a summary.
+template <typename ProcessorT> void measure(const char *name, ProcessorT &processor, long cycles, uint64_t instructions, uint64_t (*instruction_count)(ProcessorT &)) {
+	HostCounters counters;
+
+	counters.start();
+	const auto start = std::chrono::steady_clock::now();
+	processor.run_for(Cycles(cycles));
+	const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+	counters.stop();
+
+	if(instruction_count) instructions = instruction_count(processor);
+
+	std::cout << name << ": " << cycles << " cycles in " << duration.count() << "s; ";
+	std::cout << double(cycles) / duration.count() / 1e6 << " million cycles/s; ";
+	std::cout << instructions << " instructions, " << double(instructions) / duration.count() / 1e6 << " MIPS" << std::endl;
+	counters.print(std::cout);
+}
+
+void benchmark_z80(const Image &image, long cycles) {
+	const auto setup = [&image] (CPU::Z80::AllRAMProcessor &processor) {
+		processor.set_data_at_address(uint16_t(image.address), image.data.size(), image.data.data());
+		processor.set_value_of_register(CPU::Z80::Register::ProgramCounter, uint16_t(image.address));
+	};
+
+	// Opcode fetches, including prefixes, are counted in a first run; the second is timed without traps.
+	OpcodeCounter counter;
+	{
+		std::unique_ptr<CPU::Z80::AllRAMProcessor> processor(CPU::Z80::AllRAMProcessor::Processor());
+		setup(*processor);
+		trap_all_addresses(*processor, counter);
+		processor->run_for(Cycles(cycles));
+	}
+
+	std::unique_ptr<CPU::Z80::AllRAMProcessor> processor(CPU::Z80::AllRAMProcessor::Processor());
+	setup(*processor);
+	measure<CPU::Z80::AllRAMProcessor>("Z80", *processor, cycles, counter.instructions, nullptr);
+}
+
+void benchmark_6502(const Image &image, bool uses_default, long cycles) {
+	const auto setup = [&image, uses_default] (CPU::MOS6502::AllRAMProcessor &processor) {
+		processor.set_data_at_address(uint16_t(image.address), image.data.size(), image.data.data());
+		if(uses_default) {
+			processor.set_data_at_address(0x0240, mos6502_subroutine.size(), mos6502_subroutine.data());
+			processor.set_data_at_address(0x0010, mos6502_pointer.size(), mos6502_pointer.data());
+		}
+		processor.set_value_of_register(CPU::MOS6502::Register::Flags, 0);
+		processor.set_value_of_register(CPU::MOS6502::Register::ProgramCounter, uint16_t(image.address));
+	};
+
+	for(const bool threaded: {false, true}) {
+		OpcodeCounter counter;
+		{
+			std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processor(CPU::MOS6502::AllRAMProcessor::Processor(CPU::MOS6502::Personality::P6502, threaded));
+			setup(*processor);
+			trap_all_addresses(*processor, counter);
+			processor->run_for(Cycles(cycles));
+		}
+
+		std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processor(CPU::MOS6502::AllRAMProcessor::Processor(CPU::MOS6502::Personality::P6502, threaded));
+		setup(*processor);
+		measure<CPU::MOS6502::AllRAMProcessor>(threaded ? "6502 (threaded)" : "6502", *processor, cycles, counter.instructions, nullptr);
+	}
+}
+
+void benchmark_68000(const Image &image, long cycles) {
+	std::unique_ptr<CPU::MC68000::AllRAMProcessor> processor(CPU::MC68000::AllRAMProcessor::Processor());
+
+	// An image loaded at address 0 supplies its own reset vectors; otherwise the stack is placed at
+	// the top of memory and execution begins from the load address.
+	if(image.address) {
+		const uint8_t vectors[] = {
+			0x01, 0x00, 0x00, 0x00,
+			uint8_t(image.address >> 24), uint8_t(image.address >> 16), uint8_t(image.address >> 8), uint8_t(image.address),
+		};
+		processor->set_data_at_address(0, sizeof(vectors), vectors);
+	}
+	processor->set_data_at_address(image.address, image.data.size(), image.data.data());
+
+	measure<CPU::MC68000::AllRAMProcessor>("68000", *processor, cycles, 0, [] (CPU::MC68000::AllRAMProcessor &processor) {
+		return processor.get_instruction_count();
+	});
+}
+
+// MARK: - Arguments.
+
+/// Parses an image argument of the form file[@address], loading the file; @returns @c false on failure.
+bool load_image(const std::string &argument, Image &image) {
+	const std::size_t split_index = argument.rfind('@');
+	const std::string file_name = argument.substr(0, split_index);
+	if(split_index != std::string::npos) {
+		image.address = uint32_t(std::strtoul(argument.c_str() + split_index + 1, nullptr, 0));
+	}
+
+	std::ifstream file(file_name, std::ios::binary);
+	if(!file) {
+		std::cerr << "Could not open " << file_name << std::endl;
+		return false;
+	}
+	image.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return true;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	// Accepted format is --name=value, with the following names:
+	//
+	//	cycles		the number of cycles for which to run each processor;
+	//	cores		a comma-separated list of the processors to run, from z80, 6502 and 68000;
+	//	z80, 6502, 68000
+	//				a file[@address] to run in place of the built-in program for that processor.
+	std::map<std::string, std::string> arguments;
+	for(int index = 1; index < argc; ++index) {
+		std::string argument = argv[index];
+		const std::size_t split_index = argument.find('=');
+		if(argument.substr(0, 2) != "--" || split_index == std::string::npos) {
+			std::cerr << "Usage: " << argv[0] << " [--cycles=N] [--cores=z80,6502,68000] [--z80=file[@address]] [--6502=file[@address]] [--68000=file[@address]]" << std::endl;
+			return EXIT_FAILURE;
+		}
+		arguments[argument.substr(2, split_index - 2)] = argument.substr(split_index + 1);
+	}
+
+	const long cycles = arguments.count("cycles") ? std::strtol(arguments["cycles"].c_str(), nullptr, 0) : 50'000'000;
+	const std::string cores = arguments.count("cores") ? "," + arguments["cores"] + "," : ",z80,6502,68000,";
+	const auto should_run = [&cores] (const char *core) {
+		return cores.find(std::string(",") + core + ",") != std::string::npos;
+	};
+
+	Image z80{z80_program, 0x0000};
+	Image mos6502{mos6502_program, 0x0200};
+	Image mc68000{mc68000_program, 0x1000};
+	if(arguments.count("z80") && !load_image(arguments["z80"], z80)) return EXIT_FAILURE;
+	if(arguments.count("6502") && !load_image(arguments["6502"], mos6502)) return EXIT_FAILURE;
+	if(arguments.count("68000") && !load_image(arguments["68000"], mc68000)) return EXIT_FAILURE;
+
+	if(should_run("z80")) benchmark_z80(z80, cycles);
+	if(should_run("6502")) benchmark_6502(mos6502, !arguments.count("6502"), cycles);
+	if(should_run("68000")) benchmark_68000(mc68000, cycles);
+
+	return EXIT_SUCCESS;
+}
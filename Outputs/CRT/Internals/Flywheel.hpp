@@ -119,6 +119,7 @@ struct Flywheel {
 			case StartRetrace:
 				counter_before_retrace_ = counter_ - retrace_time_;
 				counter_ = 0;
+				++number_of_retraces_;
 			return;
 		}
 	}
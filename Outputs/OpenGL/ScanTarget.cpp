@@ -43,7 +43,6 @@ constexpr GLenum AccumulationTextureUnit = GL_TEXTURE3;
 #define TextureAddress(x, y)	(((y) << 11) | (x))
 #define TextureAddressGetY(v)	uint16_t((v) >> 11)
 #define TextureAddressGetX(v)	uint16_t((v) & 0x7ff)
-#define TextureSub(a, b)		(((a) - (b)) & 0x3fffff)
 
 const GLint internalFormatForDepth(std::size_t depth) {
 	switch(depth) {
@@ -84,10 +83,6 @@ ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 	unprocessed_line_texture_(LineBufferWidth, LineBufferHeight, UnprocessedLineBufferTextureUnit, GL_NEAREST, false),
 	full_display_rectangle_(-1.0f, -1.0f, 2.0f, 2.0f) {
 
-	// Ensure proper initialisation of the two atomic pointer sets.
-	read_pointers_.store(write_pointers_);
-	submit_pointers_.store(write_pointers_);
-
 	// Allocate space for the scans and lines.
 	allocate_buffer(scan_buffer_, scan_buffer_name_, scan_vertex_array_);
 	allocate_buffer(line_buffer_, line_buffer_name_, line_vertex_array_);
@@ -131,22 +126,17 @@ void ScanTarget::set_modals(Modals modals) {
 Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
 	if(allocation_has_failed_) return nullptr;
 
-	const auto result = &scan_buffer_[write_pointers_.scan_buffer];
-	const auto read_pointers = read_pointers_.load();
-
-	// Advance the pointer.
-	const auto next_write_pointer = decltype(write_pointers_.scan_buffer)((write_pointers_.scan_buffer + 1) % scan_buffer_.size());
+	const auto result = &scan_buffer_[scan_ring_.write_position()];
 
-	// Check whether that's too many.
-	if(next_write_pointer == read_pointers.scan_buffer) {
+	// Advance the pointer, checking whether that's too many.
+	if(!scan_ring_.advance()) {
 		allocation_has_failed_ = true;
 		return nullptr;
 	}
-	write_pointers_.scan_buffer = next_write_pointer;
 	++provided_scans_;
 
 	// Fill in extra OpenGL-specific details.
-	result->line = write_pointers_.line;
+	result->line = uint16_t(line_ring_.write_position());
 
 	vended_scan_ = result;
 	return &result->scan;
@@ -155,7 +145,7 @@ Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
 void ScanTarget::end_scan() {
 	if(vended_scan_) {
 		vended_scan_->data_y = TextureAddressGetY(vended_write_area_pointer_);
-		vended_scan_->line = write_pointers_.line;
+		vended_scan_->line = uint16_t(line_ring_.write_position());
 		vended_scan_->scan.end_points[0].data_offset += TextureAddressGetX(vended_write_area_pointer_);
 		vended_scan_->scan.end_points[1].data_offset += TextureAddressGetX(vended_write_area_pointer_);
 
@@ -183,9 +173,10 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 	}
 
 	// Determine where the proposed write area would start and end.
-	uint16_t output_y = TextureAddressGetY(write_pointers_.write_area);
+	const auto write_area = write_area_ring_.write_position();
+	uint16_t output_y = TextureAddressGetY(write_area);
 
-	uint16_t aligned_start_x = TextureAddressGetX(write_pointers_.write_area & 0xffff) + 1;
+	uint16_t aligned_start_x = TextureAddressGetX(write_area & 0xffff) + 1;
 	aligned_start_x += uint16_t((required_alignment - aligned_start_x%required_alignment)%required_alignment);
 
 	uint16_t end_x = aligned_start_x + uint16_t(1 + required_length);
@@ -196,51 +187,47 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 		end_x = aligned_start_x + uint16_t(1 + required_length);
 	}
 
-	// Check whether that steps over the read pointer.
+	// Check whether that steps over the read pointer; if allocating this would somehow make
+	// the write pointer back away from the read pointer, there must not be enough space left.
 	const auto end_address = TextureAddress(end_x, output_y);
-	const auto read_pointers = read_pointers_.load();
-
-	const auto end_distance = TextureSub(end_address, read_pointers.write_area);
-	const auto previous_distance = TextureSub(write_pointers_.write_area, read_pointers.write_area);
-
-	// If allocating this would somehow make the write pointer back away from the read pointer,
-	// there must not be enough space left.
-	if(end_distance < previous_distance) {
+	if(!write_area_ring_.can_write_to(end_address)) {
 		allocation_has_failed_ = true;
 		return nullptr;
 	}
 
 	// Everything checks out, note expectation of a future end_data and return the pointer.
 	data_is_allocated_ = true;
-	vended_write_area_pointer_ = write_pointers_.write_area = TextureAddress(aligned_start_x, output_y);
-	return &write_area_texture_[size_t(write_pointers_.write_area) * data_type_size_];
+	vended_write_area_pointer_ = TextureAddress(aligned_start_x, output_y);
+	write_area_ring_.set_write_position(uint32_t(vended_write_area_pointer_));
+	return &write_area_texture_[size_t(vended_write_area_pointer_) * data_type_size_];
 
 	// Note state at exit:
-	//		write_pointers_.write_area points to the first pixel the client is expected to draw to.
+	//		the write area ring's write position is the first pixel the client is expected to draw to.
 }
 
 void ScanTarget::end_data(size_t actual_length) {
 	if(allocation_has_failed_ || !data_is_allocated_) return;
 
 	// Bookend the start of the new data, to safeguard for precision errors in sampling.
+	auto write_area = write_area_ring_.write_position();
 	memcpy(
-		&write_area_texture_[size_t(write_pointers_.write_area - 1) * data_type_size_],
-		&write_area_texture_[size_t(write_pointers_.write_area) * data_type_size_],
+		&write_area_texture_[size_t(write_area - 1) * data_type_size_],
+		&write_area_texture_[size_t(write_area) * data_type_size_],
 		data_type_size_);
 
 	// Advance to the end of the current run.
-	write_pointers_.write_area += actual_length + 1;
+	write_area += actual_length + 1;
 
 	// Also bookend the end.
 	memcpy(
-		&write_area_texture_[size_t(write_pointers_.write_area - 1) * data_type_size_],
-		&write_area_texture_[size_t(write_pointers_.write_area - 2) * data_type_size_],
+		&write_area_texture_[size_t(write_area - 1) * data_type_size_],
+		&write_area_texture_[size_t(write_area - 2) * data_type_size_],
 		data_type_size_);
 
 	// The write area was allocated in the knowledge that there's sufficient
 	// distance left on the current line, but there's a risk of exactly filling
-	// the final line, in which case this should wrap back to 0.
-	write_pointers_.write_area %= (write_area_texture_.size() / data_type_size_);
+	// the final line, in which case the ring will wrap back to 0.
+	write_area_ring_.set_write_position(write_area);
 
 	// Record that no further end_data calls are expected.
 	data_is_allocated_ = false;
@@ -255,11 +242,17 @@ void ScanTarget::submit() {
 	if(allocation_has_failed_) {
 		// Reset all pointers to where they were; this also means
 		// the stencil won't be properly populated.
-		write_pointers_ = submit_pointers_.load();
+		write_area_ring_.rollback();
+		scan_ring_.rollback();
+		line_ring_.rollback();
 		frame_is_complete_ = false;
 	} else {
-		// Advance submit pointer.
-		submit_pointers_.store(write_pointers_);
+		// Advance submit pointers, as a single submission so that the consumer sees all or none.
+		submission_sequence_.submit([this] {
+			write_area_ring_.submit();
+			scan_ring_.submit();
+			line_ring_.submit();
+		});
 	}
 
 	// Continue defaulting to a failed allocation for as long as there isn't a line available.
@@ -284,38 +277,30 @@ void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::
 
 	if(output_is_visible_ == is_visible) return;
 	if(is_visible) {
-		const auto read_pointers = read_pointers_.load();
-
 		// Commit the most recent line only if any scans fell on it.
 		// Otherwise there's no point outputting it, it'll contribute nothing.
 		if(provided_scans_) {
 			// Store metadata if concluding a previous line.
 			if(active_line_) {
-				line_metadata_buffer_[size_t(write_pointers_.line)].is_first_in_frame = is_first_in_frame_;
-				line_metadata_buffer_[size_t(write_pointers_.line)].previous_frame_was_complete = previous_frame_was_complete_;
+				line_metadata_buffer_[line_ring_.write_position()].is_first_in_frame = is_first_in_frame_;
+				line_metadata_buffer_[line_ring_.write_position()].previous_frame_was_complete = previous_frame_was_complete_;
 				is_first_in_frame_ = false;
 			}
 
 			// Attempt to allocate a new line; note allocation failure if necessary.
-			const auto next_line = uint16_t((write_pointers_.line + 1) % LineBufferHeight);
-			if(next_line == read_pointers.line) {
+			if(!line_ring_.advance()) {
 				line_allocation_has_failed_ = allocation_has_failed_ = true;
 				active_line_ = nullptr;
 			} else {
 				line_allocation_has_failed_ = false;
-				write_pointers_.line = next_line;
-				active_line_ = &line_buffer_[size_t(write_pointers_.line)];
+				active_line_ = &line_buffer_[line_ring_.write_position()];
 			}
 			provided_scans_ = 0;
 		} else {
 			// Just check whether a new line is available now, if waiting.
-			if(line_allocation_has_failed_) {
-				const auto next_line = uint16_t((write_pointers_.line + 1) % LineBufferHeight);
-				if(next_line != read_pointers.line) {
-					line_allocation_has_failed_ = false;
-					write_pointers_.line = next_line;
-					active_line_ = &line_buffer_[size_t(write_pointers_.line)];
-				}
+			if(line_allocation_has_failed_ && line_ring_.advance()) {
+				line_allocation_has_failed_ = false;
+				active_line_ = &line_buffer_[line_ring_.write_position()];
 			}
 		}
 
@@ -324,7 +309,7 @@ void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::
 			active_line_->end_points[0].y = location.y;
 			active_line_->end_points[0].cycles_since_end_of_horizontal_retrace = location.cycles_since_end_of_horizontal_retrace;
 			active_line_->end_points[0].composite_angle = location.composite_angle;
-			active_line_->line = write_pointers_.line;
+			active_line_->line = uint16_t(line_ring_.write_position());
 			active_line_->composite_amplitude = composite_amplitude;
 		}
 	} else {
@@ -357,8 +342,8 @@ void ScanTarget::setup_pipeline() {
 		data_type_size_ = data_type_size;
 		write_area_texture_.resize(WriteAreaWidth*WriteAreaHeight*data_type_size_);
 
-		write_pointers_.scan_buffer = 0;
-		write_pointers_.write_area = 0;
+		scan_ring_.set_write_position(0);
+		write_area_ring_.set_write_position(0);
 	}
 
 	// Prepare to bind line shaders.
@@ -403,6 +388,14 @@ Outputs::Display::Metrics &ScanTarget::display_metrics() {
 	return display_metrics_;
 }
 
+ScanTarget::BufferStatistics ScanTarget::buffer_statistics() const {
+	BufferStatistics statistics;
+	statistics.write_area = write_area_ring_.statistics();
+	statistics.scans = scan_ring_.statistics();
+	statistics.lines = line_ring_.statistics();
+	return statistics;
+}
+
 bool ScanTarget::is_soft_display_type() {
 	return modals_.display_type == DisplayType::CompositeColour || modals_.display_type == DisplayType::CompositeMonochrome;
 }
@@ -438,9 +431,19 @@ void ScanTarget::update(int output_width, int output_height) {
 	// Determine the start time of this submission group.
 	line_submission_begin_time_ = std::chrono::high_resolution_clock::now();
 
-	// Grab the current read and submit pointers.
-	const auto submit_pointers = submit_pointers_.load();
-	const auto read_pointers = read_pointers_.load();
+	// Grab the current read and submit pointers; submit pointers are obtained as a single
+	// snapshot so that lines, scans and data all describe the same submission.
+	struct {
+		uint32_t line, scan_buffer, write_area;
+	} submit_pointers, read_pointers;
+	submission_sequence_.read([&] {
+		submit_pointers.line = line_ring_.submitted_position();
+		submit_pointers.scan_buffer = scan_ring_.submitted_position();
+		submit_pointers.write_area = write_area_ring_.submitted_position();
+	});
+	read_pointers.line = line_ring_.read_position();
+	read_pointers.scan_buffer = scan_ring_.read_position();
+	read_pointers.write_area = write_area_ring_.read_position();
 
 	// Determine how many lines are about to be submitted.
 	lines_submitted_ = (read_pointers.line + line_buffer_.size() - submit_pointers.line) % line_buffer_.size();
@@ -725,7 +728,9 @@ void ScanTarget::update(int output_width, int output_height) {
 
 	// All data now having been spooled to the GPU, update the read pointers to
 	// the submit pointer location.
-	read_pointers_.store(submit_pointers);
+	line_ring_.set_read_position(submit_pointers.line);
+	scan_ring_.set_read_position(submit_pointers.scan_buffer);
+	write_area_ring_.set_read_position(submit_pointers.write_area);
 
 	// Grab a fence sync object to avoid busy waiting upon the next extry into this
 	// function, and reset the is_updating_ flag.
@@ -17,6 +17,7 @@
 #include "Primitives/TextureTarget.hpp"
 #include "Primitives/Rectangle.hpp"
 
+#include "../../Concurrency/SPSCRing.hpp"
 #include "../../SignalProcessing/FIRFilter.hpp"
 
 #include <array>
@@ -52,6 +53,15 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		/*! @returns The DisplayMetrics object that this ScanTarget has been providing with announcements and draw overages. */
 		Metrics &display_metrics();
 
+		struct BufferStatistics {
+			Concurrency::RingStatistics write_area, scans, lines;
+		};
+		/*!
+			@returns Statistics describing back-pressure on each of this scan target's internal buffers;
+			any overflow implies that data was lost because the producer outran the consumer.
+		*/
+		BufferStatistics buffer_statistics() const;
+
 	private:
 #ifndef NDEBUG
 		struct OpenGLVersionDumper {
@@ -101,27 +111,16 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 			uint16_t line;
 		};
 
-		struct PointerSet {
-			// This constructor is here to appease GCC's interpretation of
-			// an ambiguity in the C++ standard; cf. https://stackoverflow.com/questions/17430377
-			PointerSet() noexcept {}
-
-			// The sizes below might be less hassle as something more natural like ints,
-			// but squeezing this struct into 64 bits makes the std::atomics more likely
-			// to be lock free; they are under LLVM x86-64.
-			int write_area = 0;
-			uint16_t scan_buffer = 0;
-			uint16_t line = 0;
-		};
-
-		/// A pointer to the next thing that should be provided to the caller for data.
-		PointerSet write_pointers_;
-
-		/// A pointer to the final thing currently cleared for submission.
-		std::atomic<PointerSet> submit_pointers_;
-
-		/// A pointer to the first thing not yet submitted for display.
-		std::atomic<PointerSet> read_pointers_;
+		// Positions within the write area, the scan buffer and the line buffer are each
+		// managed by a single-producer, single-consumer ring. The producer submits all three
+		// as one entry in submission_sequence_, so that the consumer obtains a consistent snapshot.
+		//
+		// The write area position is a texture address; the line position is that of
+		// the line currently being populated.
+		Concurrency::SPSCRing<WriteAreaWidth * WriteAreaHeight> write_area_ring_;
+		Concurrency::SPSCRing<16384> scan_ring_;
+		Concurrency::SPSCRing<LineBufferHeight> line_ring_;
+		Concurrency::SubmissionSequence submission_sequence_;
 
 		/// Maintains a buffer of the most recent scans.
 		std::array<Scan, 16384> scan_buffer_;
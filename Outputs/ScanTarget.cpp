@@ -8,6 +8,62 @@
 
 #include "ScanTarget.hpp"
 
+#include <algorithm>
+
 using namespace Outputs::Display;
 
 NullScanTarget NullScanTarget::singleton;
+
+// MARK: - FieldSkippingScanTarget.
+
+void FieldSkippingScanTarget::set_target(ScanTarget *target) {
+	target_ = target ? target : &NullScanTarget::singleton;
+	data_is_forwarded_ = scan_is_forwarded_ = false;
+}
+
+void FieldSkippingScanTarget::set_field_interval(int interval) {
+	field_interval_ = std::max(interval, 1);
+}
+
+void FieldSkippingScanTarget::set_modals(Modals modals) {
+	target_->set_modals(modals);
+}
+
+ScanTarget::Scan *FieldSkippingScanTarget::begin_scan() {
+	// Every scan refers to the most recent run of data, so can be forwarded only if that was.
+	scan_is_forwarded_ = is_forwarding_ && data_is_forwarded_;
+	return scan_is_forwarded_ ? target_->begin_scan() : nullptr;
+}
+
+void FieldSkippingScanTarget::end_scan() {
+	if(scan_is_forwarded_) target_->end_scan();
+}
+
+uint8_t *FieldSkippingScanTarget::begin_data(size_t required_length, size_t required_alignment) {
+	data_is_forwarded_ = is_forwarding_;
+	return data_is_forwarded_ ? target_->begin_data(required_length, required_alignment) : nullptr;
+}
+
+void FieldSkippingScanTarget::end_data(size_t actual_length) {
+	if(data_is_forwarded_) target_->end_data(actual_length);
+}
+
+void FieldSkippingScanTarget::will_change_owner() {
+	target_->will_change_owner();
+}
+
+void FieldSkippingScanTarget::submit() {
+	target_->submit();
+}
+
+void FieldSkippingScanTarget::announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) {
+	// A new field begins at the end of vertical retrace.
+	if(event == Event::EndVerticalRetrace) {
+		field_ = (field_ + 1) % field_interval_;
+		is_forwarding_ = !field_;
+	}
+
+	if(is_forwarding_) {
+		target_->announce(event, is_visible, location, composite_amplitude);
+	}
+}
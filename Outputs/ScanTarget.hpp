@@ -371,6 +371,47 @@ struct NullScanTarget: public ScanTarget {
 	static NullScanTarget singleton;
 };
 
+/*!
+	Forwards only every nth field to another scan target, discarding all others.
+
+	Data allocations are refused throughout discarded fields, so a machine outputting to
+	a field-skipping scan target will usually also skip the work of generating pixels for
+	them. Fields are delimited by vertical retrace; the destination continues to receive a
+	balanced sequence of retrace announcements.
+*/
+struct FieldSkippingScanTarget: public ScanTarget {
+	public:
+		FieldSkippingScanTarget(ScanTarget *target = &NullScanTarget::singleton) : target_(target) {}
+
+		/// Sets the scan target to which fields are forwarded.
+		void set_target(ScanTarget *target);
+
+		/// Sets the interval between forwarded fields; 1 indicates that every field should be forwarded.
+		/// Any change takes effect from the next field.
+		void set_field_interval(int interval);
+
+		// ScanTarget overrides.
+		void set_modals(Modals) final;
+		Scan *begin_scan() final;
+		void end_scan() final;
+		uint8_t *begin_data(size_t required_length, size_t required_alignment = 1) final;
+		void end_data(size_t actual_length) final;
+		void will_change_owner() final;
+		void submit() final;
+		void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) final;
+
+	private:
+		ScanTarget *target_;
+		int field_interval_ = 1;
+		int field_ = 0;
+
+		// Fields are forwarded only while is_forwarding_ is true; data is tracked separately since
+		// a run of data may be allocated in one field and the scans that use it output in the next.
+		bool is_forwarding_ = true;
+		bool data_is_forwarded_ = false;
+		bool scan_is_forwarded_ = false;
+};
+
 }
 }
 
@@ -0,0 +1,649 @@
+//
+//  ScanTarget.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "ScanTarget.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace Outputs::Display::Software;
+
+namespace {
+
+constexpr double Pi = 3.14159265358979323846;
+
+/// Sets @c target[c] = @c lhs[c] * @c rhs[c] for all c in [begin, end).
+void multiply(const float *lhs, const float *rhs, float *target, int begin, int end) {
+	int c = begin;
+#if defined(__SSE2__)
+	for(; c + 4 <= end; c += 4) {
+		_mm_storeu_ps(&target[c], _mm_mul_ps(_mm_loadu_ps(&lhs[c]), _mm_loadu_ps(&rhs[c])));
+	}
+#elif defined(__ARM_NEON)
+	for(; c + 4 <= end; c += 4) {
+		vst1q_f32(&target[c], vmulq_f32(vld1q_f32(&lhs[c]), vld1q_f32(&rhs[c])));
+	}
+#endif
+	for(; c < end; ++c) {
+		target[c] = lhs[c] * rhs[c];
+	}
+}
+
+/// Applies the column-major 3x3 @c matrix to each of the vectors (source[0][c], source[1][c], source[2][c])
+/// for c in [begin, end), storing the results to @c target.
+void apply_matrix(const float *matrix, const std::vector<float> *source, std::vector<float> *target, int begin, int end) {
+	const float *const x = source[0].data(), *const y = source[1].data(), *const z = source[2].data();
+	float *const outputs[3] = {target[0].data(), target[1].data(), target[2].data()};
+
+	int c = begin;
+#if defined(__SSE2__)
+	__m128 m[9];
+	for(int i = 0; i < 9; ++i) m[i] = _mm_set1_ps(matrix[i]);
+
+	for(; c + 4 <= end; c += 4) {
+		const __m128 xs = _mm_loadu_ps(&x[c]), ys = _mm_loadu_ps(&y[c]), zs = _mm_loadu_ps(&z[c]);
+		for(int row = 0; row < 3; ++row) {
+			_mm_storeu_ps(&outputs[row][c],
+				_mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(xs, m[row]), _mm_mul_ps(ys, m[row + 3])),
+					_mm_mul_ps(zs, m[row + 6])
+				)
+			);
+		}
+	}
+#elif defined(__ARM_NEON)
+	for(; c + 4 <= end; c += 4) {
+		const float32x4_t xs = vld1q_f32(&x[c]), ys = vld1q_f32(&y[c]), zs = vld1q_f32(&z[c]);
+		for(int row = 0; row < 3; ++row) {
+			float32x4_t result = vmulq_n_f32(xs, matrix[row]);
+			result = vmlaq_n_f32(result, ys, matrix[row + 3]);
+			result = vmlaq_n_f32(result, zs, matrix[row + 6]);
+			vst1q_f32(&outputs[row][c], result);
+		}
+	}
+#endif
+	for(; c < end; ++c) {
+		const float xs = x[c], ys = y[c], zs = z[c];
+		for(int row = 0; row < 3; ++row) {
+			outputs[row][c] = xs * matrix[row] + ys * matrix[row + 3] + zs * matrix[row + 6];
+		}
+	}
+}
+
+/// Maps a single input sample of type @c type to the four-byte form used in the composition buffer.
+/// This is the equivalent of the OpenGL scan target's composition shader.
+template <Outputs::Display::InputDataType type> void normalise(const uint8_t *source, uint8_t *target) {
+	using InputDataType = Outputs::Display::InputDataType;
+	switch(type) {
+		case InputDataType::Luminance1:
+			target[0] = target[1] = target[2] = target[3] = source[0] ? 255 : 0;
+		break;
+
+		case InputDataType::Luminance8:
+			target[0] = target[1] = target[2] = target[3] = source[0];
+		break;
+
+		case InputDataType::Luminance8Phase8:
+			target[0] = source[0];
+			target[1] = source[1];
+		break;
+
+		case InputDataType::PhaseLinkedLuminance8:
+		case InputDataType::Red8Green8Blue8:
+			memcpy(target, source, 4);
+		break;
+
+		case InputDataType::Red1Green1Blue1:
+			target[0] = (source[0] & 4) ? 255 : 0;
+			target[1] = (source[0] & 2) ? 255 : 0;
+			target[2] = (source[0] & 1) ? 255 : 0;
+		break;
+
+		case InputDataType::Red2Green2Blue2:
+			target[0] = uint8_t(((source[0] >> 4) & 3) * 85);
+			target[1] = uint8_t(((source[0] >> 2) & 3) * 85);
+			target[2] = uint8_t((source[0] & 3) * 85);
+		break;
+
+		case InputDataType::Red4Green4Blue4:
+			target[0] = uint8_t(std::min(source[0], uint8_t(15)) * 17);
+			target[1] = uint8_t((source[1] >> 4) * 17);
+			target[2] = uint8_t((source[1] & 15) * 17);
+		break;
+	}
+}
+
+/// Distributes the samples at @c data[begin_offset, end_offset) across @c row[begin_clock, end_clock),
+/// point sampling and normalising each.
+template <Outputs::Display::InputDataType type> void compose_run(const uint8_t *data, uint8_t *row, int begin_clock, int end_clock, int begin_offset, int end_offset) {
+	const int sample_size = int(Outputs::Display::size_for_data_type(type));
+	const int clocks = end_clock - begin_clock;
+	const int samples = std::max(end_offset - begin_offset, 1);
+
+	for(int c = 0; c < clocks; ++c) {
+		const int offset = begin_offset + ((2*c + 1) * samples) / (2*clocks);
+		normalise<type>(&data[offset * sample_size], &row[(begin_clock + c) * 4]);
+	}
+}
+
+}
+
+ScanTarget::ScanTarget(float output_gamma) :
+	output_gamma_(output_gamma),
+	composition_buffer_(LineBufferWidth * LineBufferHeight * 4),
+	prefix_sum_(LineBufferWidth + 1) {
+	for(auto buffer: {&signal_, &chroma_, &cosine_, &sine_, &channels_[0], &channels_[1], &channels_[2], &rgb_[0], &rgb_[1], &rgb_[2]}) {
+		buffer->resize(LineBufferWidth);
+	}
+}
+
+void ScanTarget::set_target_buffer(uint8_t *buffer, int width, int height, size_t bytes_per_row) {
+	target_buffer_ = buffer;
+	target_width_ = width;
+	target_height_ = height;
+	target_bytes_per_row_ = bytes_per_row ? bytes_per_row : size_t(width) * 4;
+	row_fields_.assign(size_t(std::max(height, 0)), -1);
+}
+
+void ScanTarget::set_modals(Modals modals) {
+	modals_ = modals;
+
+	// Resize the write area if the data type size has changed; anything
+	// pending is lost.
+	const auto data_type_size = Outputs::Display::size_for_data_type(modals_.input_data_type);
+	if(data_type_size != data_type_size_) {
+		data_type_size_ = data_type_size;
+		write_area_.resize(WriteAreaSize * data_type_size_);
+		write_pointer_ = 0;
+		allocation_has_failed_ = true;
+	}
+
+	// Determine what a blank sample looks like: for luminance + phase that means both
+	// zero luminance and a phase that indicates the absence of colour.
+	blank_sample_ = {0, 0, 0, 0};
+	if(modals_.input_data_type == InputDataType::Luminance8Phase8) {
+		blank_sample_[1] = 255;
+	}
+
+	clocks_per_colour_cycle_ = std::max(
+		float(modals_.cycles_per_line) * float(modals_.colour_cycle_denominator) / float(modals_.colour_cycle_numerator),
+		1.0f);
+
+	// Set up colour space conversions; these are stored column-major.
+	switch(modals_.composite_colour_space) {
+		case ColourSpace::YIQ: {
+			const float rgb_to_yiq[] = {0.299f, 0.596f, 0.211f, 0.587f, -0.274f, -0.523f, 0.114f, -0.322f, 0.312f};
+			const float yiq_to_rgb[] = {1.0f, 1.0f, 1.0f, 0.956f, -0.272f, -1.106f, 0.621f, -0.647f, 1.703f};
+			memcpy(rgb_to_luma_chroma_, rgb_to_yiq, sizeof(rgb_to_yiq));
+			memcpy(luma_chroma_to_rgb_, yiq_to_rgb, sizeof(yiq_to_rgb));
+		} break;
+
+		case ColourSpace::YUV: {
+			const float rgb_to_yuv[] = {0.299f, -0.14713f, 0.615f, 0.587f, -0.28886f, -0.51499f, 0.114f, 0.436f, -0.10001f};
+			const float yuv_to_rgb[] = {1.0f, 1.0f, 1.0f, 0.0f, -0.39465f, 2.03211f, 1.13983f, -0.58060f, 0.0f};
+			memcpy(rgb_to_luma_chroma_, rgb_to_yuv, sizeof(rgb_to_yuv));
+			memcpy(luma_chroma_to_rgb_, yuv_to_rgb, sizeof(yuv_to_rgb));
+		} break;
+	}
+
+	// Tabulate the phase offsets implied by Luminance8Phase8 data; a phase of greater
+	// than 0.75 implies that there should be no colour.
+	for(size_t c = 0; c < phase_cos_.size(); ++c) {
+		const double phase = double(c) / 255.0;
+		if(phase > 0.75) {
+			phase_cos_[c] = phase_sin_[c] = 0.0f;
+		} else {
+			phase_cos_[c] = float(cos(Pi * 4.0 * phase));
+			phase_sin_[c] = float(sin(Pi * 4.0 * phase));
+		}
+	}
+
+	// Tabulate output levels, folding in brightness and gamma.
+	const bool apply_gamma = fabs(output_gamma_ - modals_.intended_gamma) > 0.05f;
+	const float gamma_ratio = output_gamma_ / modals_.intended_gamma;
+	for(size_t c = 0; c < output_levels_.size(); ++c) {
+		float level = std::min(float(c) * modals_.brightness / float(output_levels_.size() - 1), 1.0f);
+		if(apply_gamma) level = powf(level, gamma_ratio);
+		output_levels_[c] = uint8_t(level * 255.0f + 0.5f);
+	}
+}
+
+Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
+	if(allocation_has_failed_ || !active_line_) return nullptr;
+
+	if(scans_pending_ == scan_buffer_.size()) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+
+	vended_scan_ = &scan_buffer_[scans_pending_];
+	vended_scan_->line = write_line_;
+	++scans_pending_;
+	++provided_scans_;
+	return &vended_scan_->scan;
+}
+
+void ScanTarget::end_scan() {
+	if(vended_scan_) {
+		vended_scan_->data_base = vended_write_area_pointer_;
+	}
+	vended_scan_ = nullptr;
+}
+
+uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignment) {
+	assert(required_alignment);
+
+	if(allocation_has_failed_) return nullptr;
+	if(write_area_.empty()) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+
+	const size_t start = size_t(write_pointer_) + (required_alignment - size_t(write_pointer_) % required_alignment) % required_alignment;
+	if(start + required_length > WriteAreaSize) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+
+	data_is_allocated_ = true;
+	vended_write_area_pointer_ = write_pointer_ = int(start);
+	return &write_area_[start * data_type_size_];
+}
+
+void ScanTarget::end_data(size_t actual_length) {
+	if(allocation_has_failed_ || !data_is_allocated_) return;
+
+	write_pointer_ += int(actual_length);
+	data_is_allocated_ = false;
+}
+
+void ScanTarget::will_change_owner() {
+	allocation_has_failed_ = true;
+	vended_scan_ = nullptr;
+}
+
+void ScanTarget::submit() {
+	if(allocation_has_failed_) {
+		// Discard all scans and lines since the previous submit, retaining only
+		// the record of any fields that ended.
+		scans_pending_ = 0;
+		uint16_t line = read_line_;
+		while(line != write_line_) {
+			line = uint16_t((line + 1) % LineBufferHeight);
+			fields_ended_before_line_[read_line_] += fields_ended_before_line_[line];
+			fields_ended_before_line_[line] = 0;
+		}
+		write_line_ = read_line_;
+		active_line_ = nullptr;
+		provided_scans_ = 0;
+
+		write_pointer_ = 0;
+		data_is_allocated_ = false;
+		allocation_has_failed_ = false;
+		return;
+	}
+
+	// Compose all new scans into their lines.
+	for(size_t c = 0; c < scans_pending_; ++c) {
+		compose(scan_buffer_[c]);
+	}
+	scans_pending_ = 0;
+
+	// Rasterise all completed lines, noting the ends of fields along the way.
+	while(true) {
+		while(fields_ended_before_line_[read_line_]) {
+			--fields_ended_before_line_[read_line_];
+			complete_field();
+		}
+		if(read_line_ == write_line_) break;
+
+		rasterise(line_buffer_[read_line_], read_line_);
+		read_line_ = uint16_t((read_line_ + 1) % LineBufferHeight);
+	}
+
+	// The write area can be reused from the start if nobody is currently writing to it.
+	if(!data_is_allocated_) {
+		write_pointer_ = 0;
+	}
+}
+
+void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::ScanTarget::Scan::EndPoint &location, uint8_t composite_amplitude) {
+	if(event == Event::EndVerticalRetrace) {
+		// If there's nothing yet to rasterise then the field can be declared complete
+		// immediately; otherwise the end of the field will be noted upon the next submit.
+		if(read_line_ == write_line_) {
+			complete_field();
+		} else {
+			++fields_ended_before_line_[write_line_];
+		}
+	}
+
+	if(output_is_visible_ == is_visible) return;
+	output_is_visible_ = is_visible;
+
+	if(is_visible) {
+		// Attempt to begin a new line, ensuring that it'll be possible
+		// to distinguish a full buffer from an empty one.
+		if((write_line_ + 1) % LineBufferHeight == read_line_) {
+			allocation_has_failed_ = true;
+			active_line_ = nullptr;
+			return;
+		}
+
+		active_line_ = &line_buffer_[write_line_];
+		active_line_->end_points[0] = active_line_->end_points[1] = location;
+		active_line_->composite_amplitude = composite_amplitude;
+		provided_scans_ = 0;
+
+		// Clear the corresponding composition row.
+		uint8_t *const row = &composition_buffer_[size_t(write_line_) * LineBufferWidth * 4];
+		if(!blank_sample_[0] && !blank_sample_[1]) {
+			memset(row, 0, LineBufferWidth * 4);
+		} else {
+			for(int c = 0; c < LineBufferWidth; ++c) {
+				memcpy(&row[c * 4], blank_sample_.data(), 4);
+			}
+		}
+	} else if(active_line_) {
+		// Complete the current line; it is retained only if any scans fell upon it.
+		active_line_->end_points[1] = location;
+		if(provided_scans_) {
+			write_line_ = uint16_t((write_line_ + 1) % LineBufferHeight);
+		}
+		active_line_ = nullptr;
+	}
+}
+
+void ScanTarget::compose(const Scan &scan) {
+	uint8_t *const row = &composition_buffer_[size_t(scan.line) * LineBufferWidth * 4];
+	const int begin_clock = std::min(int(scan.scan.end_points[0].cycles_since_end_of_horizontal_retrace), LineBufferWidth);
+	const int end_clock = std::min(int(scan.scan.end_points[1].cycles_since_end_of_horizontal_retrace), LineBufferWidth);
+	if(end_clock <= begin_clock) return;
+
+	const int begin_offset = std::min(scan.data_base + scan.scan.end_points[0].data_offset, WriteAreaSize - 1);
+	const int end_offset = std::min(scan.data_base + scan.scan.end_points[1].data_offset, WriteAreaSize);
+
+#define Compose(type)	\
+	case InputDataType::type: compose_run<InputDataType::type>(write_area_.data(), row, begin_clock, end_clock, begin_offset, end_offset); break;
+
+	switch(modals_.input_data_type) {
+		Compose(Luminance1);
+		Compose(Luminance8);
+		Compose(PhaseLinkedLuminance8);
+		Compose(Luminance8Phase8);
+		Compose(Red1Green1Blue1);
+		Compose(Red2Green2Blue2);
+		Compose(Red4Green4Blue4);
+		Compose(Red8Green8Blue8);
+	}
+
+#undef Compose
+}
+
+void ScanTarget::box_filter(const float *source, float *target, int begin, int end, float window, float scale) {
+	const int length = end - begin;
+
+	// A window of a single sample or less is a straight copy.
+	if(window <= 1.0f) {
+		for(int c = begin; c < end; ++c) {
+			target[c] = source[c] * scale;
+		}
+		return;
+	}
+
+	// Otherwise build a prefix sum, and use linear interpolation within it to
+	// support fractional window sizes. The window is clipped at either end of
+	// the line.
+	prefix_sum_[0] = 0.0;
+	for(int c = 0; c < length; ++c) {
+		prefix_sum_[size_t(c + 1)] = prefix_sum_[size_t(c)] + double(source[begin + c]);
+	}
+
+	const auto integral = [&](float position) {
+		const int whole = int(position);
+		if(whole >= length) return prefix_sum_[size_t(length)];
+		return prefix_sum_[size_t(whole)] + double(position - float(whole)) * double(source[begin + whole]);
+	};
+
+	const float half_window = window * 0.5f;
+	for(int c = 0; c < length; ++c) {
+		const float centre = float(c) + 0.5f;
+		const float low = std::max(centre - half_window, 0.0f);
+		const float high = std::min(centre + half_window, float(length));
+		target[begin + c] = float((integral(high) - integral(low)) / double(high - low)) * scale;
+	}
+}
+
+void ScanTarget::rasterise(const Line &line, uint16_t line_index) {
+	if(!target_buffer_) return;
+
+	const uint8_t *const row = &composition_buffer_[size_t(line_index) * LineBufferWidth * 4];
+	const int line_begin = line.end_points[0].cycles_since_end_of_horizontal_retrace;
+	const int line_end = line.end_points[1].cycles_since_end_of_horizontal_retrace;
+	const int begin = std::min(line_begin, LineBufferWidth);
+	const int end = std::min(line_end, LineBufferWidth);
+	if(end <= begin) return;
+
+	// Determine the output area: which pixel rows this line covers and the columns at either end.
+	const float scale_x = float(modals_.output_scale.x);
+	const float scale_y = float(modals_.output_scale.y) * modals_.aspect_ratio * (3.0f / 4.0f);
+	const float x0 = ((float(line.end_points[0].x) / scale_x) - modals_.visible_area.origin.x) * float(target_width_) / modals_.visible_area.size.width;
+	const float x1 = ((float(line.end_points[1].x) / scale_x) - modals_.visible_area.origin.x) * float(target_width_) / modals_.visible_area.size.width;
+	const float y = ((float(line.end_points[0].y) / scale_y) - modals_.visible_area.origin.y) * float(target_height_) / modals_.visible_area.size.height;
+
+	// As per the OpenGL target, slightly over-amp row height to ensure lines converge; cf. the
+	// painted-once-per-field test below.
+	const float half_height = (1.05f / float(modals_.expected_vertical_lines)) * float(target_height_) / (modals_.visible_area.size.height * 2.0f);
+
+	const int first_row = std::max(int(ceilf(y - half_height - 0.5f)), 0);
+	const int last_row = std::min(int(floorf(y + half_height - 0.5f)), target_height_ - 1);
+	const int first_column = std::max(int(ceilf(x0 - 0.5f)), 0);
+	const int last_column = std::min(int(ceilf(x1 - 0.5f)) - 1, target_width_ - 1);
+	if(last_row < first_row || last_column < first_column || x1 <= x0) return;
+
+	// Skip work entirely if every row has already been painted this field.
+	int row_count = 0;
+	for(int row = first_row; row <= last_row; ++row) {
+		row_count += row_fields_[size_t(row)] != completed_fields_;
+	}
+	if(!row_count) return;
+
+	// Obtain RGB for every cycle across the line; for anything other than RGB output
+	// this means generating a composite or S-Video signal and then decoding it.
+	const float amplitude = float(line.composite_amplitude) / 255.0f;
+	const auto display_type = modals_.display_type;
+	const auto input_data_type = modals_.input_data_type;
+
+	if(display_type == DisplayType::RGB) {
+		const bool is_luminance =
+			input_data_type == InputDataType::Luminance1 ||
+			input_data_type == InputDataType::Luminance8;
+		for(int c = begin; c < end; ++c) {
+			rgb_[0][size_t(c)] = float(row[c*4 + 0]) / 255.0f;
+			rgb_[1][size_t(c)] = float(row[c*4 + (is_luminance ? 0 : 1)]) / 255.0f;
+			rgb_[2][size_t(c)] = float(row[c*4 + (is_luminance ? 0 : 2)]) / 255.0f;
+		}
+	} else {
+		const bool is_svideo = display_type == DisplayType::SVideo;
+
+		// Generate the colour subcarrier across the line; composite angles are in units of 1/64th
+		// of a colour cycle and are interpolated linearly. Sine and cosine are evaluated directly
+		// only periodically, with a rotation applied in between.
+		const double angle_scale = 2.0 * Pi / 64.0;
+		const double start_angle = double(line.end_points[0].composite_angle) * angle_scale;
+		const double angle_step =
+			double(line.end_points[1].composite_angle - line.end_points[0].composite_angle) * angle_scale / double(line_end - line_begin);
+		const double step_cos = cos(angle_step), step_sin = sin(angle_step);
+		double cosine = 0.0, sine = 0.0;
+		for(int c = begin; c < end; ++c) {
+			if(!((c - begin) & 31)) {
+				const double angle = start_angle + angle_step * (double(c - line_begin) + 0.5);
+				cosine = cos(angle);
+				sine = sin(angle);
+			}
+			cosine_[size_t(c)] = float(cosine);
+			sine_[size_t(c)] = float(sine);
+
+			const double next_cosine = cosine * step_cos - sine * step_sin;
+			sine = sine * step_cos + cosine * step_sin;
+			cosine = next_cosine;
+		}
+
+		// Sample the input as either composite or S-Video.
+		switch(input_data_type) {
+			case InputDataType::Luminance1:
+			case InputDataType::Luminance8:
+				for(int c = begin; c < end; ++c) {
+					signal_[size_t(c)] = float(row[c*4]) / 255.0f;
+					chroma_[size_t(c)] = 0.0f;
+				}
+			break;
+
+			case InputDataType::PhaseLinkedLuminance8: {
+				// Select one of the four supplied luminances, by quarter of the colour cycle.
+				const double offset = double(modals_.input_data_tweaks.phase_linked_luminance_offset);
+				const double start_phase = double(line.end_points[0].composite_angle) / 64.0;
+				const double phase_step = double(line.end_points[1].composite_angle - line.end_points[0].composite_angle) / (64.0 * double(line_end - line_begin));
+				const int inversion = (start_phase <= 0.0) ? 3 : 0;
+				for(int c = begin; c < end; ++c) {
+					const double phase = fabs(start_phase + phase_step * (double(c - line_begin) + 0.5) + offset);
+					const int index = (int(phase * 4.0) & 3) ^ inversion;
+					signal_[size_t(c)] = float(row[c*4 + index]) / 255.0f;
+					chroma_[size_t(c)] = 0.0f;
+				}
+			} break;
+
+			case InputDataType::Luminance8Phase8:
+				for(int c = begin; c < end; ++c) {
+					const float luminance = float(row[c*4]) / 255.0f;
+					const uint8_t phase = row[c*4 + 1];
+					const float chroma = cosine_[size_t(c)] * phase_cos_[phase] - sine_[size_t(c)] * phase_sin_[phase];
+					if(is_svideo) {
+						signal_[size_t(c)] = luminance;
+						chroma_[size_t(c)] = chroma;
+					} else {
+						signal_[size_t(c)] = luminance + (chroma - luminance) * amplitude;
+					}
+				}
+			break;
+
+			case InputDataType::Red1Green1Blue1:
+			case InputDataType::Red2Green2Blue2:
+			case InputDataType::Red4Green4Blue4:
+			case InputDataType::Red8Green8Blue8:
+				for(int c = begin; c < end; ++c) {
+					channels_[0][size_t(c)] = float(row[c*4 + 0]) / 255.0f;
+					channels_[1][size_t(c)] = float(row[c*4 + 1]) / 255.0f;
+					channels_[2][size_t(c)] = float(row[c*4 + 2]) / 255.0f;
+				}
+				apply_matrix(rgb_to_luma_chroma_, channels_, rgb_, begin, end);
+				for(int c = begin; c < end; ++c) {
+					const float luminance = rgb_[0][size_t(c)];
+					const float chroma = cosine_[size_t(c)] * rgb_[1][size_t(c)] + sine_[size_t(c)] * rgb_[2][size_t(c)];
+					if(is_svideo) {
+						signal_[size_t(c)] = luminance;
+						chroma_[size_t(c)] = chroma;
+					} else {
+						signal_[size_t(c)] = luminance + (chroma - luminance) * amplitude;
+					}
+				}
+			break;
+		}
+
+		// Decode. Both luminance and QAM-demodulated chrominance are lowpass filtered
+		// over a single colour cycle.
+		const float window = clocks_per_colour_cycle_;
+		if(is_svideo || (display_type == DisplayType::CompositeColour && line.composite_amplitude)) {
+			const float *const source = is_svideo ? chroma_.data() : signal_.data();
+			const float chroma_scale = is_svideo ? 2.0f : 2.0f / amplitude;
+
+			if(is_svideo) {
+				std::copy(&signal_[size_t(begin)], &signal_[size_t(end)], &channels_[0][size_t(begin)]);
+			} else {
+				box_filter(signal_.data(), channels_[0].data(), begin, end, window, 1.0f / (1.0f - amplitude));
+			}
+
+			multiply(source, cosine_.data(), rgb_[0].data(), begin, end);
+			box_filter(rgb_[0].data(), channels_[1].data(), begin, end, window, chroma_scale);
+			multiply(source, sine_.data(), rgb_[0].data(), begin, end);
+			box_filter(rgb_[0].data(), channels_[2].data(), begin, end, window, chroma_scale);
+
+			apply_matrix(luma_chroma_to_rgb_, channels_, rgb_, begin, end);
+		} else {
+			box_filter(signal_.data(), rgb_[0].data(), begin, end, window);
+			std::copy(&rgb_[0][size_t(begin)], &rgb_[0][size_t(end)], &rgb_[1][size_t(begin)]);
+			std::copy(&rgb_[0][size_t(begin)], &rgb_[0][size_t(end)], &rgb_[2][size_t(begin)]);
+		}
+	}
+
+	// If output pixels are wider than input cycles, filter to the output pixel width.
+	const float cycles_per_pixel = float(line_end - line_begin) / (x1 - x0);
+	if(cycles_per_pixel > 1.5f) {
+		for(int channel = 0; channel < 3; ++channel) {
+			box_filter(rgb_[channel].data(), channels_[channel].data(), begin, end, cycles_per_pixel);
+			std::swap(rgb_[channel], channels_[channel]);
+		}
+	}
+
+	// Produce the first row of output, by linear interpolation between cycles.
+	uint8_t *first_output = nullptr;
+	const float levels_scale = float(output_levels_.size() - 1);
+	for(int row_index = first_row; row_index <= last_row; ++row_index) {
+		if(row_fields_[size_t(row_index)] == completed_fields_) continue;
+		row_fields_[size_t(row_index)] = completed_fields_;
+
+		uint8_t *const output = &target_buffer_[size_t(row_index) * target_bytes_per_row_ + size_t(first_column) * 4];
+		if(first_output) {
+			memcpy(output, first_output, size_t(last_column + 1 - first_column) * 4);
+			continue;
+		}
+		first_output = output;
+
+		for(int column = first_column; column <= last_column; ++column) {
+			const float position = float(line_begin) + (float(column) + 0.5f - x0) * cycles_per_pixel - 0.5f;
+			const int whole = std::clamp(int(floorf(position)), begin, end - 1);
+			const int next = std::min(whole + 1, end - 1);
+			const float fraction = std::clamp(position - float(whole), 0.0f, 1.0f);
+
+			uint8_t *const pixel = &output[(column - first_column) * 4];
+			for(int channel = 0; channel < 3; ++channel) {
+				const float value = rgb_[channel][size_t(whole)] + (rgb_[channel][size_t(next)] - rgb_[channel][size_t(whole)]) * fraction;
+				pixel[channel] = output_levels_[size_t(std::clamp(value, 0.0f, 1.0f) * levels_scale + 0.5f)];
+			}
+			pixel[3] = 255;
+		}
+	}
+}
+
+void ScanTarget::complete_field() {
+	// Clear any rows that weren't painted during this field.
+	if(target_buffer_) {
+		for(int row = 0; row < target_height_; ++row) {
+			if(row_fields_[size_t(row)] == completed_fields_) continue;
+
+			uint8_t *const output = &target_buffer_[size_t(row) * target_bytes_per_row_];
+			for(int column = 0; column < target_width_; ++column) {
+				output[column*4 + 0] = output[column*4 + 1] = output[column*4 + 2] = 0;
+				output[column*4 + 3] = 255;
+			}
+		}
+	}
+
+	++completed_fields_;
+	if(delegate_) {
+		delegate_->scan_target_did_complete_field(this);
+	}
+}
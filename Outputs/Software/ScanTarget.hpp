@@ -0,0 +1,173 @@
+//
+//  ScanTarget.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Software_ScanTarget_hpp
+#define Software_ScanTarget_hpp
+
+#include "../ScanTarget.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+namespace Software {
+
+/*!
+	Provides a ScanTarget that rasterises entirely on the CPU, producing one RGBA
+	image per field into a caller-owned buffer.
+
+	No graphics context is required, and all work is performed synchronously on
+	whichever thread feeds the scan target — which is usually the emulation thread.
+	So it is intended for headless use, e.g. automated testing and batch capture,
+	in which any number of instances may run concurrently, one per machine.
+
+	Like the OpenGL target, input is composed into lines in its original encoding
+	and then converted to RGB in accordance with the current display type, including
+	QAM decoding of composite and S-Video signals.
+*/
+class ScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		ScanTarget(float output_gamma = 2.2f);
+
+		/*!
+			Sets the buffer to which output will be rasterised, which should be at least
+			@c bytes_per_row * @c height bytes in size. Pixels are stored as four bytes, in
+			the order red, green, blue, alpha.
+
+			If @c bytes_per_row is 0 then rows are assumed to be exactly @c width * 4 bytes apart.
+			Supplying @c nullptr will cause output to be discarded, though fields will continue
+			to be counted and announced.
+		*/
+		void set_target_buffer(uint8_t *buffer, int width, int height, size_t bytes_per_row = 0);
+
+		struct Delegate {
+			/*!
+				Announces that a complete field has been rasterised to the target buffer.
+				The delegate may inspect the buffer or call @c set_target_buffer to supply a new
+				one before returning.
+			*/
+			virtual void scan_target_did_complete_field(ScanTarget *scan_target) = 0;
+		};
+		void set_delegate(Delegate *delegate) {
+			delegate_ = delegate;
+		}
+
+		/// @returns The number of fields completed so far.
+		int completed_fields() const {
+			return completed_fields_;
+		}
+
+	private:
+		static constexpr int WriteAreaSize = 32768;
+		static constexpr int ScanBufferSize = 4096;
+
+		static constexpr int LineBufferWidth = 2048;
+		static constexpr int LineBufferHeight = 256;
+
+		const float output_gamma_;
+
+		// Outputs::Display::ScanTarget finals.
+		void set_modals(Modals) final;
+		Scan *begin_scan() final;
+		void end_scan() final;
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) final;
+		void end_data(size_t actual_length) final;
+		void submit() final;
+		void announce(Event event, bool is_visible, const Outputs::Display::ScanTarget::Scan::EndPoint &location, uint8_t colour_burst_amplitude) final;
+		void will_change_owner() final;
+
+		// Target buffer and delegate.
+		uint8_t *target_buffer_ = nullptr;
+		int target_width_ = 0, target_height_ = 0;
+		size_t target_bytes_per_row_ = 0;
+		Delegate *delegate_ = nullptr;
+
+		// Extends the definition of a Scan to record where its data sits in the
+		// write area and the line it falls upon.
+		struct Scan {
+			Outputs::Display::ScanTarget::Scan scan;
+
+			/// Stores the index within the write area of the sample at data offset 0.
+			int data_base;
+			/// Stores the index within the line buffer of the line that this scan falls upon.
+			uint16_t line;
+		};
+		std::array<Scan, ScanBufferSize> scan_buffer_;
+		size_t scans_pending_ = 0;
+
+		// Provides a simple linear write area; since all pending scans are consumed
+		// upon every submit, it can return to its start whenever data isn't currently allocated.
+		std::vector<uint8_t> write_area_;
+		size_t data_type_size_ = 0;
+		int write_pointer_ = 0;
+		int vended_write_area_pointer_ = 0;
+
+		// Lines are kept in a circular buffer; each line has a corresponding row of
+		// composed samples, four bytes per cycle, which holds input data in the
+		// form in which it was received but normalised to be directly indexable.
+		struct Line {
+			Outputs::Display::ScanTarget::Scan::EndPoint end_points[2];
+			uint8_t composite_amplitude;
+		};
+		std::array<Line, LineBufferHeight> line_buffer_;
+		std::vector<uint8_t> composition_buffer_;
+
+		/// Counts the number of fields that ended prior to each line; this is not
+		/// reset upon line allocation.
+		std::array<int, LineBufferHeight> fields_ended_before_line_{};
+
+		/// The first line not yet rasterised.
+		uint16_t read_line_ = 0;
+		/// The line currently being populated, or that will be next allocated if there is no active line.
+		uint16_t write_line_ = 0;
+		Line *active_line_ = nullptr;
+		bool output_is_visible_ = false;
+		int provided_scans_ = 0;
+
+		// Ephemeral information for the begin/end functions.
+		Scan *vended_scan_ = nullptr;
+
+		// Track allocation failures.
+		bool data_is_allocated_ = false;
+		bool allocation_has_failed_ = false;
+
+		// Receives scan target modals, and derived values.
+		Modals modals_;
+		std::array<uint8_t, 4> blank_sample_{};
+		float clocks_per_colour_cycle_ = 1.0f;
+		float rgb_to_luma_chroma_[9];
+		float luma_chroma_to_rgb_[9];
+		std::array<float, 256> phase_cos_, phase_sin_;
+		std::array<uint8_t, 1024> output_levels_;
+
+		// Working storage for line decoding; each buffer holds one float per cycle.
+		std::vector<float> signal_, chroma_, cosine_, sine_;
+		std::vector<float> channels_[3], rgb_[3];
+		std::vector<double> prefix_sum_;
+
+		// Output state: the number of the field currently being rasterised, and the
+		// field in which each row of the target buffer was last painted.
+		int completed_fields_ = 0;
+		std::vector<int> row_fields_;
+
+		void compose(const Scan &scan);
+		void rasterise(const Line &line, uint16_t line_index);
+		void complete_field();
+
+		/// Applies a box filter of width @c window to @c source[begin, end), writing the result,
+		/// multiplied by @c scale, to @c target.
+		void box_filter(const float *source, float *target, int begin, int end, float window, float scale = 1.0f);
+};
+
+}
+}
+}
+
+#endif /* Software_ScanTarget_hpp */
@@ -94,7 +94,7 @@ template <typename... T> class CompoundSource:
 				}
 
 				void skip_samples(const std::size_t number_of_samples) {
-					source_.skip_samples(number_of_samples);
+					Outputs::Speaker::skip_samples(source_, number_of_samples);
 					next_source_.skip_samples(number_of_samples);
 				}
 
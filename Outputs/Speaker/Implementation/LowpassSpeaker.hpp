@@ -10,8 +10,8 @@
 #define FilteringSpeaker_h
 
 #include "../Speaker.hpp"
-#include "../../../SignalProcessing/Stepper.hpp"
-#include "../../../SignalProcessing/FIRFilter.hpp"
+#include "SampleSource.hpp"
+#include "../../../SignalProcessing/Resampler.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../Concurrency/AsyncTaskQueue.hpp"
 
@@ -121,6 +121,12 @@ template <typename T> class LowpassSpeaker: public Speaker {
 				delegate_->speaker_did_change_input_clock(this);
 			}
 
+			// If output is being skipped, just advance the source.
+			if(skips_output_) {
+				Outputs::Speaker::skip_samples(sample_source_, cycles_remaining);
+				return;
+			}
+
 			// If input and output rates exactly match, and no additional cut-off has been specified,
 			// just accumulate results and pass on.
 			if(	filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second &&
@@ -143,58 +149,35 @@ template <typename T> class LowpassSpeaker: public Speaker {
 				return;
 			}
 
-			// If the output rate is less than the input rate, or an additional cut-off has been specified, use the filter.
-			if(	filter_parameters.input_cycles_per_second > filter_parameters.output_cycles_per_second ||
-				(filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second && filter_parameters.high_frequency_cutoff >= 0.0)) {
-				while(cycles_remaining) {
-					const auto cycles_to_read = std::min(cycles_remaining, input_buffer_.size() - input_buffer_depth_);
-					sample_source_.get_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
-					cycles_remaining -= cycles_to_read;
-					input_buffer_depth_ += cycles_to_read;
-
-					if(input_buffer_depth_ == input_buffer_.size()) {
-						output_buffer_[output_buffer_pointer_] = filter_->apply(input_buffer_.data());
-						output_buffer_pointer_++;
-
-						// Announce to delegate if full.
-						if(output_buffer_pointer_ == output_buffer_.size()) {
-							output_buffer_pointer_ = 0;
-							did_complete_samples(this, output_buffer_);
-						}
-
-						// If the next loop around is going to reuse some of the samples just collected, use a memmove to
-						// preserve them in the correct locations (TODO: use a longer buffer to fix that) and don't skip
-						// anything. Otherwise skip as required to get to the next sample batch and don't expect to reuse.
-						const auto steps = stepper_->step();
-						if(steps < input_buffer_.size()) {
-							auto *const input_buffer = input_buffer_.data();
-							std::memmove(	input_buffer,
-											&input_buffer[steps],
-											sizeof(int16_t) * (input_buffer_.size() - steps));
-							input_buffer_depth_ -= steps;
-						} else {
-							if(steps > input_buffer_.size())
-								sample_source_.skip_samples(steps - input_buffer_.size());
-							input_buffer_depth_ = 0;
-						}
-					}
+			// Otherwise, resample.
+			if(!resampler_) return;
+			while(cycles_remaining) {
+				std::size_t capacity;
+				int16_t *const input = resampler_->input_buffer(capacity);
+				const auto cycles_to_read = std::min(cycles_remaining, capacity);
+				sample_source_.get_samples(cycles_to_read, input);
+				resampler_->did_write_input(cycles_to_read);
+				cycles_remaining -= cycles_to_read;
+
+				while(true) {
+					output_buffer_pointer_ += resampler_->get_output(
+						&output_buffer_[output_buffer_pointer_],
+						output_buffer_.size() - output_buffer_pointer_);
+
+					// Announce to delegate if full; otherwise more input is required.
+					if(output_buffer_pointer_ != output_buffer_.size()) break;
+					output_buffer_pointer_ = 0;
+					did_complete_samples(this, output_buffer_);
 				}
-
-				return;
 			}
-
-			// TODO: input rate is less than output rate
 		}
 
 		T &sample_source_;
 
 		std::size_t output_buffer_pointer_ = 0;
-		std::size_t input_buffer_depth_ = 0;
-		std::vector<int16_t> input_buffer_;
 		std::vector<int16_t> output_buffer_;
 
-		std::unique_ptr<SignalProcessing::Stepper> stepper_;
-		std::unique_ptr<SignalProcessing::FIRFilter> filter_;
+		std::unique_ptr<SignalProcessing::Resampler> resampler_;
 
 		std::mutex filter_parameters_mutex_;
 		struct FilterParameters {
@@ -207,31 +190,14 @@ template <typename T> class LowpassSpeaker: public Speaker {
 		} filter_parameters_;
 
 		void update_filter_coefficients(const FilterParameters &filter_parameters) {
-			float high_pass_frequency = filter_parameters.output_cycles_per_second / 2.0f;
-			if(filter_parameters.high_frequency_cutoff > 0.0) {
-				high_pass_frequency = std::min(filter_parameters.high_frequency_cutoff, high_pass_frequency);
-			}
-
-			// Make a guess at a good number of taps.
-			std::size_t number_of_taps = std::size_t(
-				ceilf((filter_parameters.input_cycles_per_second + high_pass_frequency) / high_pass_frequency)
-			);
-			number_of_taps = (number_of_taps * 2) | 1;
-
 			output_buffer_pointer_ = 0;
-			stepper_ = std::make_unique<SignalProcessing::Stepper>(
-				uint64_t(filter_parameters.input_cycles_per_second),
-				uint64_t(filter_parameters.output_cycles_per_second));
+			resampler_.reset();
+			if(filter_parameters.input_cycles_per_second <= 0.0f || filter_parameters.output_cycles_per_second <= 0.0f) return;
 
-			filter_ = std::make_unique<SignalProcessing::FIRFilter>(
-				static_cast<unsigned int>(number_of_taps),
+			resampler_ = std::make_unique<SignalProcessing::Resampler>(
 				filter_parameters.input_cycles_per_second,
-				0.0,
-				high_pass_frequency,
-				SignalProcessing::FIRFilter::DefaultAttenuation);
-
-			input_buffer_.resize(std::size_t(number_of_taps));
-			input_buffer_depth_ = 0;
+				filter_parameters.output_cycles_per_second,
+				filter_parameters.high_frequency_cutoff);
 		}
 };
 
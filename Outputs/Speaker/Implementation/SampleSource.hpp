@@ -9,8 +9,10 @@
 #ifndef SampleSource_hpp
 #define SampleSource_hpp
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 namespace Outputs {
 namespace Speaker {
@@ -55,6 +57,24 @@ class SampleSource {
 		}
 };
 
+/*!
+	Skips the next @c number_of_samples of @c source. Since SampleSource is not polymorphic, its default
+	implementation of skip_samples cannot reach a subclass's get_samples; this calls @c source's own
+	skip_samples if it has one and otherwise generates and discards samples in modestly-sized batches.
+*/
+template <typename SourceT> void skip_samples(SourceT &source, std::size_t number_of_samples) {
+	if constexpr (std::is_same<decltype(&SourceT::skip_samples), decltype(&SampleSource::skip_samples)>::value) {
+		std::int16_t scratch_pad[256];
+		while(number_of_samples) {
+			const std::size_t batch = std::min(number_of_samples, sizeof(scratch_pad) / sizeof(*scratch_pad));
+			source.get_samples(batch, scratch_pad);
+			number_of_samples -= batch;
+		}
+	} else {
+		source.skip_samples(number_of_samples);
+	}
+}
+
 }
 }
 
@@ -9,6 +9,7 @@
 #ifndef Speaker_hpp
 #define Speaker_hpp
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -34,6 +35,15 @@ class Speaker {
 			compute_output_rate();
 		}
 
+		/*!
+			Sets whether output should be skipped. While skipping, a speaker advances its source as
+			cheaply as possible and provides no samples to its delegate; this is intended for running
+			well in excess of real time, when audio output is of no interest.
+		*/
+		virtual void set_skips_output(bool skips_output) {
+			skips_output_ = skips_output;
+		}
+
 		int completed_sample_sets() const { return completed_sample_sets_; }
 
 		struct Delegate {
@@ -52,6 +62,7 @@ class Speaker {
 			delegate_->speaker_did_complete_samples(this, buffer);
 		}
 		Delegate *delegate_ = nullptr;
+		std::atomic<bool> skips_output_{false};
 
 	private:
 		void compute_output_rate() {
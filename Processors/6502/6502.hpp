@@ -9,12 +9,19 @@
 #ifndef MOS6502_cpp
 #define MOS6502_cpp
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdio>
 #include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
 
 #include "../RegisterSizes.hpp"
+#include "../TraceRing.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Storage/Snapshot.hpp"
 
 namespace CPU {
 namespace MOS6502 {
@@ -117,6 +124,87 @@ class BusHandler {
 			bus handlers to perform any deferred output work.
 		*/
 		void flush() {}
+
+		/*!
+			Bus handlers may nominate pages of plain memory that the 6502 should access directly, in which case
+			perform_bus_operation will be called only for accesses elsewhere; this substantially reduces the cost
+			of code that mostly touches memory.
+
+			To do so, a bus handler should declare @c has_direct_pages as @c true and implement @c direct_read_page,
+			@c direct_write_page and @c advance. The 6502 will then call @c advance to report the time spent on
+			direct accesses before each call to perform_bus_operation, at the end of each instruction and at the
+			end of each run_for. So devices always observe their own accesses at exactly the correct time, and
+			interrupts are recognised exactly as they would otherwise be, but the set overflow input is observed
+			only as at the most recent of those calls.
+
+			The 6502 still steps through each instruction a cycle at a time; what is saved is the bus handler's work,
+			which becomes a single call to @c advance for an instruction that touches only direct pages.
+
+			Direct pages are not used by 6502s that have a ready line.
+		*/
+		static constexpr bool has_direct_pages = false;
+
+		/*!
+			@returns A pointer to the 256 bytes that should be read, including for opcode fetches, by accesses
+			to page @c page — i.e. addresses [page * 256, page * 256 + 255] — or @c nullptr if those reads
+			should be announced via perform_bus_operation.
+		*/
+		uint8_t *direct_read_page(int page) {
+			return nullptr;
+		}
+
+		/*!
+			@returns A pointer to the 256 bytes that should be written by accesses to page @c page, or @c nullptr
+			if those writes should be announced via perform_bus_operation.
+		*/
+		uint8_t *direct_write_page(int page) {
+			return nullptr;
+		}
+
+		/*!
+			Announces that @c cycles have passed, during which the 6502 accessed only direct pages.
+		*/
+		void advance(Cycles cycles) {}
+
+		/*!
+			If @c true, the 6502 will add a record to the current thread's TraceRing as it decodes each instruction.
+			This costs nothing if @c false.
+		*/
+		static constexpr bool traces_execution = false;
+
+		/*!
+			If @c true, each record added because of @c traces_execution also includes the 6502's registers; this
+			roughly doubles the cost of tracing. Otherwise only the time, program counter and opcode are recorded.
+		*/
+		static constexpr bool traces_registers = false;
+
+		/*!
+			Bus handlers may allow the 6502 to skip idle loops: short loops that write nothing and leave every
+			register as they found it, so that each iteration will exactly repeat the last until the 6502 is
+			signalled or something that the loop reads changes. The 6502 will then skip as many whole iterations
+			as fit before the bus handler's next event, announcing the time skipped via @c skip_idle_time.
+
+			To do so, a bus handler should declare @c skips_idle_loops as @c true and implement
+			@c get_time_until_event and @c skip_idle_time. It should also call the 6502's @c prevent_idle_skip
+			whenever it services a read that has side effects, or whose result may change other than at an event.
+
+			Idle loops are not skipped by 6502s that have a ready line.
+		*/
+		static constexpr bool skips_idle_loops = false;
+
+		/*!
+			@returns The time until the next event that might signal the 6502, via an interrupt or the set
+			overflow line, or change the value of anything read by an idle loop; or a negative value if no
+			such event is scheduled.
+		*/
+		Cycles get_time_until_event() {
+			return Cycles(0);
+		}
+
+		/*!
+			Announces that @c cycles have passed, during which the 6502 would have repeated an idle loop.
+		*/
+		void skip_idle_time(Cycles cycles) {}
 };
 
 #include "Implementation/6502Storage.hpp"
@@ -196,6 +284,34 @@ class ProcessorBase: public ProcessorStorage {
 			@returns @c true if the 6502 is jammed; @c false otherwise.
 		*/
 		bool is_jammed();
+
+		/*!
+			Appends the processor's complete state to @c writer; this may be called at any
+			point between calls to @c run_for.
+		*/
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/*!
+			Restores state previously captured by @c save_state by a processor of the same personality.
+
+			@returns @c true if state was restored; @c false otherwise.
+		*/
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
+		/*!
+			Prevents the loop that the 6502 is currently executing, if any, from being skipped as idle.
+
+			@see BusHandler::skips_idle_loops
+		*/
+		void prevent_idle_skip() {
+			idle_loop_.is_clean = false;
+		}
+
+	private:
+		// Lists all micro-programs that may be in progress, for translation of
+		// scheduled_program_counter_ to and from a snapshot.
+		using ProgramList = std::array<std::pair<const MicroOp *, std::size_t>, 8>;
+		ProgramList programs() const;
 };
 
 /*!
@@ -205,8 +321,12 @@ class ProcessorBase: public ProcessorStorage {
 	will announce its cycle-by-cycle activity via the bus handler, which is responsible for marrying it to a bus. They
 	can also nominate whether the processor includes support for the ready line. Declining to support the ready line
 	can produce a minor runtime performance improvement.
+
+	Machines that spend most of their time executing code may also opt in to threaded dispatch, in which micro-ops
+	are sequenced by computed goto rather than by a switch. This is faster but produces a larger run_for, and has
+	no effect if the compiler doesn't support labels as values.
 */
-template <Personality personality, typename T, bool uses_ready_line> class Processor: public ProcessorBase {
+template <Personality personality, typename T, bool uses_ready_line, bool uses_threaded_dispatch = false> class Processor: public ProcessorBase {
 	public:
 		/*!
 			Constructs an instance of the 6502 that will use @c bus_handler for all bus communications.
@@ -229,6 +349,15 @@ template <Personality personality, typename T, bool uses_ready_line> class Proce
 
 	private:
 		T &bus_handler_;
+
+		/// The total number of cycles supplied to run_for, if execution is being traced.
+		uint64_t traced_cycles_ = 0;
+
+		Cycles direct_cycles_;
+		uint16_t direct_interrupt_masks_ = 0;
+		void advance_direct_cycles();
+
+		inline void test_idle_loop(Cycles &number_of_cycles);
 };
 
 #include "Implementation/6502Implementation.hpp"
@@ -15,7 +15,7 @@ using namespace CPU::MOS6502;
 
 namespace {
 
-template <Personality personality> class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
+template <Personality personality, bool uses_threaded_dispatch> class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
 	public:
 		ConcreteAllRAMProcessor() :
 			mos6502_(*this) {
@@ -38,6 +38,21 @@ template <Personality personality> class ConcreteAllRAMProcessor: public AllRAMP
 			return Cycles(1);
 		}
 
+		// Pages without traps are accessed directly by the 6502.
+		static constexpr bool has_direct_pages = true;
+
+		inline uint8_t *direct_read_page(int page) {
+			return untrapped_page(page);
+		}
+
+		inline uint8_t *direct_write_page(int page) {
+			return &memory_[size_t(page) << 8];
+		}
+
+		inline void advance(Cycles cycles) {
+			timestamp_ += cycles;
+		}
+
 		void run_for(const Cycles cycles) {
 			mos6502_.run_for(cycles);
 		}
@@ -63,13 +78,16 @@ template <Personality personality> class ConcreteAllRAMProcessor: public AllRAMP
 		}
 
 	private:
-		CPU::MOS6502::Processor<personality, ConcreteAllRAMProcessor, false> mos6502_;
+		CPU::MOS6502::Processor<personality, ConcreteAllRAMProcessor, false, uses_threaded_dispatch> mos6502_;
 };
 
 }
 
-AllRAMProcessor *AllRAMProcessor::Processor(Personality personality) {
-#define Bind(p) case p: return new ConcreteAllRAMProcessor<p>();
+AllRAMProcessor *AllRAMProcessor::Processor(Personality personality, bool uses_threaded_dispatch) {
+#define Bind(p)	\
+	case p:	\
+		if(uses_threaded_dispatch) return new ConcreteAllRAMProcessor<p, true>();	\
+		return new ConcreteAllRAMProcessor<p, false>();
 	switch(personality) {
 		default:
 		Bind(Personality::P6502)
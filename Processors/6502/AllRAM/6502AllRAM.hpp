@@ -19,7 +19,11 @@ class AllRAMProcessor:
 	public ::CPU::AllRAMProcessor {
 
 	public:
-		static AllRAMProcessor *Processor(Personality personality);
+		/*!
+			@returns A 6502 of type @c personality with 64kb of RAM, which uses threaded dispatch if
+				@c uses_threaded_dispatch is @c true. See CPU::MOS6502::Processor.
+		*/
+		static AllRAMProcessor *Processor(Personality personality, bool uses_threaded_dispatch = false);
 		virtual ~AllRAMProcessor() {}
 
 		virtual void run_for(const Cycles cycles) = 0;
@@ -42,3 +42,89 @@ void ProcessorBase::set_value_of_register(Register r, uint16_t value) {
 bool ProcessorBase::is_jammed() {
 	return is_jammed_;
 }
+
+// MARK: - Snapshots.
+
+ProcessorBase::ProgramList ProcessorBase::programs() const {
+	return ProgramList{{
+		{&operations_[0][0], sizeof(operations_) / sizeof(MicroOp)},
+		{fetch_decode_execute_, std::size(fetch_decode_execute_)},
+		{do_branch_, std::size(do_branch_)},
+		{do_bbrbbs_branch_, std::size(do_bbrbbs_branch_)},
+		{do_not_bbrbbs_branch_, std::size(do_not_bbrbbs_branch_)},
+		{reset_program_, std::size(reset_program_)},
+		{irq_program_, std::size(irq_program_)},
+		{nmi_program_, std::size(nmi_program_)},
+	}};
+}
+
+void ProcessorBase::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("6502", 1);
+
+	writer.put(pc_, last_operation_pc_, a_, x_, y_, s_);
+	writer.put(carry_flag_, negative_result_, zero_result_, decimal_flag_, overflow_flag_, inverse_interrupt_flag_);
+	writer.put(operation_, operand_, address_, next_address_, throwaway_target_);
+	writer.put(next_bus_operation_, bus_address_);
+	writer.put(is_jammed_, cycles_left_to_run_, interrupt_requests_);
+	writer.put(ready_is_active_, ready_line_is_enabled_, stop_is_active_, wait_is_active_);
+	writer.put(irq_line_, irq_request_history_, nmi_line_is_enabled_, set_overflow_line_is_enabled_);
+
+	// Record the current program as an index into programs() plus an offset, with
+	// index -1 meaning none.
+	int32_t program = -1, program_offset = 0;
+	if(scheduled_program_counter_) {
+		const auto all_programs = programs();
+		for(std::size_t c = 0; c < all_programs.size(); ++c) {
+			if(
+				scheduled_program_counter_ >= all_programs[c].first &&
+				scheduled_program_counter_ < all_programs[c].first + all_programs[c].second
+			) {
+				program = int32_t(c);
+				program_offset = int32_t(scheduled_program_counter_ - all_programs[c].first);
+				break;
+			}
+		}
+	}
+	writer.put(program, program_offset);
+
+	// The bus value always points to a member of this class; record it as an offset.
+	const ProcessorStorage *const storage = this;
+	writer.put(int32_t(bus_value_ - reinterpret_cast<const uint8_t *>(storage)));
+
+	writer.end();
+}
+
+bool ProcessorBase::restore_state(Storage::Snapshot::Reader &reader) {
+	if(!reader.begin("6502", 1)) return false;
+
+	reader.get(pc_, last_operation_pc_, a_, x_, y_, s_);
+	reader.get(carry_flag_, negative_result_, zero_result_, decimal_flag_, overflow_flag_, inverse_interrupt_flag_);
+	reader.get(operation_, operand_, address_, next_address_, throwaway_target_);
+	reader.get(next_bus_operation_, bus_address_);
+	reader.get(is_jammed_, cycles_left_to_run_, interrupt_requests_);
+	reader.get(ready_is_active_, ready_line_is_enabled_, stop_is_active_, wait_is_active_);
+	reader.get(irq_line_, irq_request_history_, nmi_line_is_enabled_, set_overflow_line_is_enabled_);
+
+	int32_t program, program_offset, bus_value_offset;
+	if(!reader.get(program, program_offset, bus_value_offset)) return false;
+
+	const auto all_programs = programs();
+	if(program < 0) {
+		scheduled_program_counter_ = nullptr;
+	} else if(
+		size_t(program) < all_programs.size() &&
+		program_offset >= 0 &&
+		size_t(program_offset) < all_programs[size_t(program)].second
+	) {
+		scheduled_program_counter_ = all_programs[size_t(program)].first + program_offset;
+	} else {
+		return false;
+	}
+
+	if(bus_value_offset < 0 || size_t(bus_value_offset) >= sizeof(ProcessorStorage)) return false;
+	ProcessorStorage *const storage = this;
+	bus_value_ = reinterpret_cast<uint8_t *>(storage) + bus_value_offset;
+	idle_loop_.is_clean = false;
+
+	return reader.end();
+}
@@ -12,19 +12,7 @@
 	6502.hpp, but it's implementation stuff.
 */
 
-template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::run_for(const Cycles cycles) {
-	static const MicroOp do_branch[] = {
-		CycleReadFromPC,
-		CycleAddSignedOperandToPC,
-		OperationMoveToNextProgram
-	};
-	static uint8_t throwaway_target;
-	static const MicroOp fetch_decode_execute[] = {
-		CycleFetchOperation,
-		CycleFetchOperand,
-		OperationDecodeOperation
-	};
-
+template <Personality personality, typename T, bool uses_ready_line, bool uses_threaded_dispatch> void Processor<personality, T, uses_ready_line, uses_threaded_dispatch>::run_for(const Cycles cycles) {
 	// These plus program below act to give the compiler permission to update these values
 	// without touching the class storage (i.e. it explicitly says they need be completely up
 	// to date in this stack frame only); which saves some complicated addressing
@@ -38,30 +26,246 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	if(interrupt_requests_) {\
 		if(interrupt_requests_ & (InterruptRequestFlags::Reset | InterruptRequestFlags::PowerOn)) {\
 			interrupt_requests_ &= ~InterruptRequestFlags::PowerOn;\
-			scheduled_program_counter_ = get_reset_program();\
+			scheduled_program_counter_ = reset_program_;\
 		} else if(interrupt_requests_ & InterruptRequestFlags::NMI) {\
 			interrupt_requests_ &= ~InterruptRequestFlags::NMI;\
-			scheduled_program_counter_ = get_nmi_program();\
+			scheduled_program_counter_ = nmi_program_;\
 		} else if(interrupt_requests_ & InterruptRequestFlags::IRQ) {\
-			scheduled_program_counter_ = get_irq_program();\
+			scheduled_program_counter_ = irq_program_;\
 		} \
 	} else {\
-		scheduled_program_counter_ = fetch_decode_execute;\
+		scheduled_program_counter_ = fetch_decode_execute_;\
 	}\
 		op;\
 	}
 
-#define bus_access() \
+#define sample_interrupts()	\
 	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::IRQ) | irq_request_history_;	\
-	irq_request_history_ = irq_line_ & inverse_interrupt_flag_;	\
-	number_of_cycles -= bus_handler_.perform_bus_operation(nextBusOperation, busAddress, busValue);	\
+	irq_request_history_ = irq_line_ & inverse_interrupt_flag_;
+
+	// Accesses to the bus handler's direct pages, if any, are performed here; they don't involve
+	// the bus handler until advance_direct_cycles is called, so the interrupt inputs that they
+	// sample may be stale until then.
+	constexpr bool uses_direct_pages = T::has_direct_pages && !uses_ready_line;
+
+	// Idle loops may be skipped only if nothing other than the bus handler's events can alter their course.
+	constexpr bool skips_idle_loops = T::skips_idle_loops && !uses_ready_line;
+
+#define bus_access() \
+	if constexpr (skips_idle_loops) {	\
+		if(nextBusOperation == BusOperation::Write) idle_loop_.is_clean = false;	\
+	}	\
+	if constexpr (uses_direct_pages) {	\
+		uint8_t *const page = isReadOperation(nextBusOperation) ?	\
+			bus_handler_.direct_read_page(busAddress >> 8) :	\
+			bus_handler_.direct_write_page(busAddress >> 8);	\
+		if(page) {	\
+			sample_interrupts();	\
+			direct_interrupt_masks_ = uint16_t((direct_interrupt_masks_ << 8) | inverse_interrupt_flag_);	\
+			if(isReadOperation(nextBusOperation)) {	\
+				*busValue = page[busAddress & 0xff];	\
+			} else {	\
+				page[busAddress & 0xff] = *busValue;	\
+			}	\
+			direct_cycles_ += Cycles(1);	\
+			number_of_cycles -= Cycles(1);	\
+		} else {	\
+			advance_direct_cycles();	\
+			sample_interrupts();	\
+			number_of_cycles -= bus_handler_.perform_bus_operation(nextBusOperation, busAddress, busValue);	\
+		}	\
+	} else {	\
+		sample_interrupts();	\
+		number_of_cycles -= bus_handler_.perform_bus_operation(nextBusOperation, busAddress, busValue);	\
+	}	\
 	nextBusOperation = BusOperation::None;	\
 	if(number_of_cycles <= Cycles(0)) break;
 
+#if defined(__GNUC__)
+	// Each micro-op is implemented by a case of the switch below, which is also labelled so that,
+	// if threaded dispatch is in use, each can jump directly to the next rather than returning
+	// to a single shared dispatch point. Cycle timing is identical in either case.
+#define micro_op(x)	case x: x##_handler
+#define next_micro_op()	\
+	if constexpr (uses_threaded_dispatch) {	\
+		cycle = *scheduled_program_counter_;	\
+		scheduled_program_counter_++;	\
+		goto *dispatch_table[cycle];	\
+	}	\
+	continue
+
+	// OperationScheduleStop is the final micro-op.
+	using DispatchTable = std::array<void *, OperationScheduleStop + 1>;
+	static const DispatchTable dispatch_table = [] (std::initializer_list<std::pair<MicroOp, void *>> handlers) {
+		DispatchTable table{};
+		if(!uses_threaded_dispatch) return table;
+
+		for(const auto &handler: handlers) {
+			assert(size_t(handler.first) < table.size());
+			table[size_t(handler.first)] = handler.second;
+		}
+		assert(std::find(table.begin(), table.end(), nullptr) == table.end());
+		return table;
+	} ({
+		{CycleFetchOperation, &&CycleFetchOperation_handler},
+		{CycleFetchOperand, &&CycleFetchOperand_handler},
+		{OperationDecodeOperation, &&OperationDecodeOperation_handler},
+		{OperationMoveToNextProgram, &&OperationMoveToNextProgram_handler},
+		{CycleIncPCPushPCH, &&CycleIncPCPushPCH_handler},
+		{CyclePushPCL, &&CyclePushPCL_handler},
+		{CyclePushPCH, &&CyclePushPCH_handler},
+		{CyclePushA, &&CyclePushA_handler},
+		{CyclePushX, &&CyclePushX_handler},
+		{CyclePushY, &&CyclePushY_handler},
+		{CyclePushOperand, &&CyclePushOperand_handler},
+		{OperationSetIRQFlags, &&OperationSetIRQFlags_handler},
+		{OperationSetNMIRSTFlags, &&OperationSetNMIRSTFlags_handler},
+		{OperationBRKPickVector, &&OperationBRKPickVector_handler},
+		{OperationNMIPickVector, &&OperationNMIPickVector_handler},
+		{OperationRSTPickVector, &&OperationRSTPickVector_handler},
+		{CycleReadVectorLow, &&CycleReadVectorLow_handler},
+		{CycleReadVectorHigh, &&CycleReadVectorHigh_handler},
+		{CycleReadFromS, &&CycleReadFromS_handler},
+		{CycleReadFromPC, &&CycleReadFromPC_handler},
+		{CyclePullPCL, &&CyclePullPCL_handler},
+		{CyclePullPCH, &&CyclePullPCH_handler},
+		{CyclePullA, &&CyclePullA_handler},
+		{CyclePullX, &&CyclePullX_handler},
+		{CyclePullY, &&CyclePullY_handler},
+		{CyclePullOperand, &&CyclePullOperand_handler},
+		{CycleNoWritePush, &&CycleNoWritePush_handler},
+		{CycleReadAndIncrementPC, &&CycleReadAndIncrementPC_handler},
+		{CycleIncrementPCAndReadStack, &&CycleIncrementPCAndReadStack_handler},
+		{CycleIncrementPCReadPCHLoadPCL, &&CycleIncrementPCReadPCHLoadPCL_handler},
+		{CycleReadPCHLoadPCL, &&CycleReadPCHLoadPCL_handler},
+		{CycleReadAddressHLoadAddressL, &&CycleReadAddressHLoadAddressL_handler},
+		{CycleReadPCLFromAddress, &&CycleReadPCLFromAddress_handler},
+		{CycleReadPCHFromAddressLowInc, &&CycleReadPCHFromAddressLowInc_handler},
+		{CycleReadPCHFromAddressFixed, &&CycleReadPCHFromAddressFixed_handler},
+		{CycleReadPCHFromAddressInc, &&CycleReadPCHFromAddressInc_handler},
+		{CycleLoadAddressAbsolute, &&CycleLoadAddressAbsolute_handler},
+		{OperationLoadAddressZeroPage, &&OperationLoadAddressZeroPage_handler},
+		{CycleLoadAddessZeroX, &&CycleLoadAddessZeroX_handler},
+		{CycleLoadAddessZeroY, &&CycleLoadAddessZeroY_handler},
+		{CycleAddXToAddressLow, &&CycleAddXToAddressLow_handler},
+		{CycleAddYToAddressLow, &&CycleAddYToAddressLow_handler},
+		{CycleAddXToAddressLowRead, &&CycleAddXToAddressLowRead_handler},
+		{CycleAddYToAddressLowRead, &&CycleAddYToAddressLowRead_handler},
+		{OperationCorrectAddressHigh, &&OperationCorrectAddressHigh_handler},
+		{OperationIncrementPC, &&OperationIncrementPC_handler},
+		{CycleFetchOperandFromAddress, &&CycleFetchOperandFromAddress_handler},
+		{CycleWriteOperandToAddress, &&CycleWriteOperandToAddress_handler},
+		{CycleIncrementPCFetchAddressLowFromOperand, &&CycleIncrementPCFetchAddressLowFromOperand_handler},
+		{CycleAddXToOperandFetchAddressLow, &&CycleAddXToOperandFetchAddressLow_handler},
+		{CycleIncrementOperandFetchAddressHigh, &&CycleIncrementOperandFetchAddressHigh_handler},
+		{OperationDecrementOperand, &&OperationDecrementOperand_handler},
+		{OperationIncrementOperand, &&OperationIncrementOperand_handler},
+		{CycleFetchAddressLowFromOperand, &&CycleFetchAddressLowFromOperand_handler},
+		{OperationORA, &&OperationORA_handler},
+		{OperationAND, &&OperationAND_handler},
+		{OperationEOR, &&OperationEOR_handler},
+		{OperationINS, &&OperationINS_handler},
+		{OperationADC, &&OperationADC_handler},
+		{OperationSBC, &&OperationSBC_handler},
+		{OperationCMP, &&OperationCMP_handler},
+		{OperationCPX, &&OperationCPX_handler},
+		{OperationCPY, &&OperationCPY_handler},
+		{OperationBIT, &&OperationBIT_handler},
+		{OperationBITNoNV, &&OperationBITNoNV_handler},
+		{OperationLDA, &&OperationLDA_handler},
+		{OperationLDX, &&OperationLDX_handler},
+		{OperationLDY, &&OperationLDY_handler},
+		{OperationLAX, &&OperationLAX_handler},
+		{OperationCopyOperandToA, &&OperationCopyOperandToA_handler},
+		{OperationSTA, &&OperationSTA_handler},
+		{OperationSTX, &&OperationSTX_handler},
+		{OperationSTY, &&OperationSTY_handler},
+		{OperationSTZ, &&OperationSTZ_handler},
+		{OperationSAX, &&OperationSAX_handler},
+		{OperationSHA, &&OperationSHA_handler},
+		{OperationSHX, &&OperationSHX_handler},
+		{OperationSHY, &&OperationSHY_handler},
+		{OperationSHS, &&OperationSHS_handler},
+		{OperationASL, &&OperationASL_handler},
+		{OperationASO, &&OperationASO_handler},
+		{OperationROL, &&OperationROL_handler},
+		{OperationRLA, &&OperationRLA_handler},
+		{OperationLSR, &&OperationLSR_handler},
+		{OperationLSE, &&OperationLSE_handler},
+		{OperationASR, &&OperationASR_handler},
+		{OperationROR, &&OperationROR_handler},
+		{OperationRRA, &&OperationRRA_handler},
+		{OperationCLC, &&OperationCLC_handler},
+		{OperationCLI, &&OperationCLI_handler},
+		{OperationCLV, &&OperationCLV_handler},
+		{OperationCLD, &&OperationCLD_handler},
+		{OperationSEC, &&OperationSEC_handler},
+		{OperationSEI, &&OperationSEI_handler},
+		{OperationSED, &&OperationSED_handler},
+		{OperationRMB, &&OperationRMB_handler},
+		{OperationSMB, &&OperationSMB_handler},
+		{OperationTRB, &&OperationTRB_handler},
+		{OperationTSB, &&OperationTSB_handler},
+		{OperationINC, &&OperationINC_handler},
+		{OperationDEC, &&OperationDEC_handler},
+		{OperationINX, &&OperationINX_handler},
+		{OperationDEX, &&OperationDEX_handler},
+		{OperationINY, &&OperationINY_handler},
+		{OperationDEY, &&OperationDEY_handler},
+		{OperationINA, &&OperationINA_handler},
+		{OperationDEA, &&OperationDEA_handler},
+		{OperationBPL, &&OperationBPL_handler},
+		{OperationBMI, &&OperationBMI_handler},
+		{OperationBVC, &&OperationBVC_handler},
+		{OperationBVS, &&OperationBVS_handler},
+		{OperationBCC, &&OperationBCC_handler},
+		{OperationBCS, &&OperationBCS_handler},
+		{OperationBNE, &&OperationBNE_handler},
+		{OperationBEQ, &&OperationBEQ_handler},
+		{OperationBRA, &&OperationBRA_handler},
+		{OperationBBRBBS, &&OperationBBRBBS_handler},
+		{OperationTXA, &&OperationTXA_handler},
+		{OperationTYA, &&OperationTYA_handler},
+		{OperationTXS, &&OperationTXS_handler},
+		{OperationTAY, &&OperationTAY_handler},
+		{OperationTAX, &&OperationTAX_handler},
+		{OperationTSX, &&OperationTSX_handler},
+		{OperationARR, &&OperationARR_handler},
+		{OperationSBX, &&OperationSBX_handler},
+		{OperationLXA, &&OperationLXA_handler},
+		{OperationANE, &&OperationANE_handler},
+		{OperationANC, &&OperationANC_handler},
+		{OperationLAS, &&OperationLAS_handler},
+		{CycleFetchFromHalfUpdatedPC, &&CycleFetchFromHalfUpdatedPC_handler},
+		{CycleAddSignedOperandToPC, &&CycleAddSignedOperandToPC_handler},
+		{OperationAddSignedOperandToPC16, &&OperationAddSignedOperandToPC16_handler},
+		{OperationSetFlagsFromOperand, &&OperationSetFlagsFromOperand_handler},
+		{OperationSetOperandFromFlagsWithBRKSet, &&OperationSetOperandFromFlagsWithBRKSet_handler},
+		{OperationSetOperandFromFlags, &&OperationSetOperandFromFlags_handler},
+		{OperationSetFlagsFromA, &&OperationSetFlagsFromA_handler},
+		{OperationSetFlagsFromX, &&OperationSetFlagsFromX_handler},
+		{OperationSetFlagsFromY, &&OperationSetFlagsFromY_handler},
+		{OperationScheduleJam, &&OperationScheduleJam_handler},
+		{OperationScheduleWait, &&OperationScheduleWait_handler},
+		{OperationScheduleStop, &&OperationScheduleStop_handler},
+	});
+#else
+	// Without support for labels as values, the switch below is the only means of dispatch.
+#define micro_op(x)	case x
+#define next_micro_op()	continue
+#endif
+
+	// If execution is being traced, records go to the ring of whichever thread is running the 6502.
+	TraceRing *const trace_ring = T::traces_execution ? &TraceRing::current() : nullptr;
+	if constexpr (T::traces_execution) traced_cycles_ += uint64_t(cycles.as_integral());
+
+	if constexpr (skips_idle_loops) idle_loop_.start += cycles;
+
 	checkSchedule();
 	Cycles number_of_cycles = cycles + cycles_left_to_run_;
 
 	while(number_of_cycles > Cycles(0)) {
+		if constexpr (uses_direct_pages) advance_direct_cycles();
 
 		// Deal with a potential RDY state, if this 6502 has anything connected to ready.
 		while(uses_ready_line && ready_is_active_ && number_of_cycles > Cycles(0)) {
@@ -96,25 +300,31 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 			while(1) {
 
-				const MicroOp cycle = *scheduled_program_counter_;
+				MicroOp cycle = *scheduled_program_counter_;
 				scheduled_program_counter_++;
 
 #define read_op(val, addr)		nextBusOperation = BusOperation::ReadOpcode;	busAddress = addr;		busValue = &val;				val = 0xff
 #define read_mem(val, addr)		nextBusOperation = BusOperation::Read;			busAddress = addr;		busValue = &val;				val	= 0xff
-#define throwaway_read(addr)	nextBusOperation = BusOperation::Read;			busAddress = addr;		busValue = &throwaway_target;	throwaway_target = 0xff
+#define throwaway_read(addr)	nextBusOperation = BusOperation::Read;			busAddress = addr;		busValue = &throwaway_target_;	throwaway_target_ = 0xff
 #define write_mem(val, addr)	nextBusOperation = BusOperation::Write;			busAddress = addr;		busValue = &val
 
+#if defined(__GNUC__)
+				if constexpr (uses_threaded_dispatch) {
+					goto *dispatch_table[cycle];
+				}
+#endif
+
 				switch(cycle) {
 
 // MARK: - Fetch/Decode
 
-					case CycleFetchOperation: {
+					micro_op(CycleFetchOperation): {
 						last_operation_pc_ = pc_;
 						pc_.full++;
 						read_op(operation_, last_operation_pc_.full);
 					} break;
 
-					case CycleFetchOperand:
+					micro_op(CycleFetchOperand):
 						// This is supposed to produce the 65C02's 1-cycle NOPs; they're
 						// treated as a special case because they break the rule that
 						// governs everything else on the 6502: that two bytes will always
@@ -128,32 +338,53 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 							read_mem(operand_, pc_.full);
 							break;
 						} else {
-							continue;
+							next_micro_op();
 						}
 					break;
 
-					case OperationDecodeOperation:
+					micro_op(OperationDecodeOperation):
+						if constexpr (T::traces_execution) {
+							auto &record = trace_ring->begin_record();
+							record.time = traced_cycles_ - uint64_t(number_of_cycles.as_integral());
+							record.program_counter = last_operation_pc_.full;
+							record.opcode = operation_;
+							record.source = TraceRing::Source::MOS6502;
+							if constexpr (T::traces_registers) {
+								uint32_t *const registers = trace_ring->record_registers();
+								record.register_count = 5;
+								registers[0] = a_;
+								registers[1] = x_;
+								registers[2] = y_;
+								registers[3] = s_;
+								registers[4] = get_flags();
+							} else {
+								record.register_count = 0;
+							}
+							trace_ring->end_record();
+						}
+						if constexpr (skips_idle_loops) test_idle_loop(number_of_cycles);
 						scheduled_program_counter_ = operations_[operation_];
-					continue;
+					next_micro_op();
 
-					case OperationMoveToNextProgram:
+					micro_op(OperationMoveToNextProgram):
+						if constexpr (uses_direct_pages) advance_direct_cycles();
 						scheduled_program_counter_ = nullptr;
 						checkSchedule();
-					continue;
+					next_micro_op();
 
 #define push(v) {\
 	uint16_t targetAddress = s_ | 0x100; s_--;\
 	write_mem(v, targetAddress);\
 }
 
-					case CycleIncPCPushPCH:				pc_.full++;														// deliberate fallthrough
-					case CyclePushPCH:					push(pc_.halves.high);											break;
-					case CyclePushPCL:					push(pc_.halves.low);											break;
-					case CyclePushOperand:				push(operand_);													break;
-					case CyclePushA:					push(a_);														break;
-					case CyclePushX:					push(x_);														break;
-					case CyclePushY:					push(y_);														break;
-					case CycleNoWritePush: {
+					micro_op(CycleIncPCPushPCH):				pc_.full++;														// deliberate fallthrough
+					micro_op(CyclePushPCH):					push(pc_.halves.high);											break;
+					micro_op(CyclePushPCL):					push(pc_.halves.low);											break;
+					micro_op(CyclePushOperand):				push(operand_);													break;
+					micro_op(CyclePushA):					push(a_);														break;
+					micro_op(CyclePushX):					push(x_);														break;
+					micro_op(CyclePushY):					push(y_);														break;
+					micro_op(CycleNoWritePush): {
 						uint16_t targetAddress = s_ | 0x100; s_--;
 						read_mem(operand_, targetAddress);
 					}
@@ -161,50 +392,51 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 #undef push
 
-					case CycleReadFromS:				throwaway_read(s_ | 0x100);										break;
-					case CycleReadFromPC:				throwaway_read(pc_.full);										break;
+					micro_op(CycleReadFromS):				throwaway_read(s_ | 0x100);										break;
+					micro_op(CycleReadFromPC):				throwaway_read(pc_.full);										break;
 
-					case OperationBRKPickVector:
+					micro_op(OperationBRKPickVector):
 						if(is_65c02(personality)) {
 							nextAddress.full = 0xfffe;
 						} else {
 							// NMI can usurp BRK-vector operations on the pre-C 6502s.
+							if constexpr (uses_direct_pages) advance_direct_cycles();
 							nextAddress.full = (interrupt_requests_ & InterruptRequestFlags::NMI) ? 0xfffa : 0xfffe;
 							interrupt_requests_ &= ~InterruptRequestFlags::NMI;
 						}
-					continue;
-					case OperationNMIPickVector:		nextAddress.full = 0xfffa;											continue;
-					case OperationRSTPickVector:		nextAddress.full = 0xfffc;											continue;
-					case CycleReadVectorLow:			read_mem(pc_.halves.low, nextAddress.full);							break;
-					case CycleReadVectorHigh:			read_mem(pc_.halves.high, nextAddress.full+1);						break;
-					case OperationSetIRQFlags:
+					next_micro_op();
+					micro_op(OperationNMIPickVector):		nextAddress.full = 0xfffa;											next_micro_op();
+					micro_op(OperationRSTPickVector):		nextAddress.full = 0xfffc;											next_micro_op();
+					micro_op(CycleReadVectorLow):			read_mem(pc_.halves.low, nextAddress.full);							break;
+					micro_op(CycleReadVectorHigh):			read_mem(pc_.halves.high, nextAddress.full+1);						break;
+					micro_op(OperationSetIRQFlags):
 						inverse_interrupt_flag_ = 0;
 						if(is_65c02(personality)) decimal_flag_ = false;
-					continue;
-					case OperationSetNMIRSTFlags:
+					next_micro_op();
+					micro_op(OperationSetNMIRSTFlags):
 						if(is_65c02(personality)) decimal_flag_ = false;
-					continue;
-
-					case CyclePullPCL:					s_++; read_mem(pc_.halves.low, s_ | 0x100);							break;
-					case CyclePullPCH:					s_++; read_mem(pc_.halves.high, s_ | 0x100);						break;
-					case CyclePullA:					s_++; read_mem(a_, s_ | 0x100);										break;
-					case CyclePullX:					s_++; read_mem(x_, s_ | 0x100);										break;
-					case CyclePullY:					s_++; read_mem(y_, s_ | 0x100);										break;
-					case CyclePullOperand:				s_++; read_mem(operand_, s_ | 0x100);								break;
-					case OperationSetFlagsFromOperand:	set_flags(operand_);												continue;
-					case OperationSetOperandFromFlagsWithBRKSet: operand_ = get_flags() | Flag::Break;						continue;
-					case OperationSetOperandFromFlags:  operand_ = get_flags();												continue;
-					case OperationSetFlagsFromA:		zero_result_ = negative_result_ = a_;								continue;
-					case OperationSetFlagsFromX:		zero_result_ = negative_result_ = x_;								continue;
-					case OperationSetFlagsFromY:		zero_result_ = negative_result_ = y_;								continue;
-
-					case CycleIncrementPCAndReadStack:	pc_.full++; throwaway_read(s_ | 0x100);														break;
-					case CycleReadPCLFromAddress:		read_mem(pc_.halves.low, address_.full);													break;
-					case CycleReadPCHFromAddressLowInc:	address_.halves.low++; read_mem(pc_.halves.high, address_.full);							break;
-					case CycleReadPCHFromAddressFixed:	if(!address_.halves.low) address_.halves.high++; read_mem(pc_.halves.high, address_.full);	break;
-					case CycleReadPCHFromAddressInc:	address_.full++; read_mem(pc_.halves.high, address_.full);									break;
-
-					case CycleReadAndIncrementPC: {
+					next_micro_op();
+
+					micro_op(CyclePullPCL):					s_++; read_mem(pc_.halves.low, s_ | 0x100);							break;
+					micro_op(CyclePullPCH):					s_++; read_mem(pc_.halves.high, s_ | 0x100);						break;
+					micro_op(CyclePullA):					s_++; read_mem(a_, s_ | 0x100);										break;
+					micro_op(CyclePullX):					s_++; read_mem(x_, s_ | 0x100);										break;
+					micro_op(CyclePullY):					s_++; read_mem(y_, s_ | 0x100);										break;
+					micro_op(CyclePullOperand):				s_++; read_mem(operand_, s_ | 0x100);								break;
+					micro_op(OperationSetFlagsFromOperand):	set_flags(operand_);												next_micro_op();
+					micro_op(OperationSetOperandFromFlagsWithBRKSet): operand_ = get_flags() | Flag::Break;						next_micro_op();
+					micro_op(OperationSetOperandFromFlags):  operand_ = get_flags();												next_micro_op();
+					micro_op(OperationSetFlagsFromA):		zero_result_ = negative_result_ = a_;								next_micro_op();
+					micro_op(OperationSetFlagsFromX):		zero_result_ = negative_result_ = x_;								next_micro_op();
+					micro_op(OperationSetFlagsFromY):		zero_result_ = negative_result_ = y_;								next_micro_op();
+
+					micro_op(CycleIncrementPCAndReadStack):	pc_.full++; throwaway_read(s_ | 0x100);														break;
+					micro_op(CycleReadPCLFromAddress):		read_mem(pc_.halves.low, address_.full);													break;
+					micro_op(CycleReadPCHFromAddressLowInc):	address_.halves.low++; read_mem(pc_.halves.high, address_.full);							break;
+					micro_op(CycleReadPCHFromAddressFixed):	if(!address_.halves.low) address_.halves.high++; read_mem(pc_.halves.high, address_.full);	break;
+					micro_op(CycleReadPCHFromAddressInc):	address_.full++; read_mem(pc_.halves.high, address_.full);									break;
+
+					micro_op(CycleReadAndIncrementPC): {
 						uint16_t oldPC = pc_.full;
 						pc_.full++;
 						throwaway_read(oldPC);
@@ -212,99 +444,99 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 // MARK: - JAM, WAI, STP
 
-					case OperationScheduleJam: {
+					micro_op(OperationScheduleJam): {
 						is_jammed_ = true;
 						scheduled_program_counter_ = operations_[CPU::MOS6502::JamOpcode];
-					} continue;
+					} next_micro_op();
 
-					case OperationScheduleStop:
+					micro_op(OperationScheduleStop):
 						stop_is_active_ = true;
 					break;
 
-					case OperationScheduleWait:
+					micro_op(OperationScheduleWait):
 						wait_is_active_ = true;
 					break;
 
 // MARK: - Bitwise
 
-					case OperationORA:	a_ |= operand_;	negative_result_ = zero_result_ = a_;		continue;
-					case OperationAND:	a_ &= operand_;	negative_result_ = zero_result_ = a_;		continue;
-					case OperationEOR:	a_ ^= operand_;	negative_result_ = zero_result_ = a_;		continue;
+					micro_op(OperationORA):	a_ |= operand_;	negative_result_ = zero_result_ = a_;		next_micro_op();
+					micro_op(OperationAND):	a_ &= operand_;	negative_result_ = zero_result_ = a_;		next_micro_op();
+					micro_op(OperationEOR):	a_ ^= operand_;	negative_result_ = zero_result_ = a_;		next_micro_op();
 
 // MARK: - Load and Store
 
-					case OperationLDA:	a_ = negative_result_ = zero_result_ = operand_;			continue;
-					case OperationLDX:	x_ = negative_result_ = zero_result_ = operand_;			continue;
-					case OperationLDY:	y_ = negative_result_ = zero_result_ = operand_;			continue;
-					case OperationLAX:	a_ = x_ = negative_result_ = zero_result_ = operand_;		continue;
-					case OperationCopyOperandToA:		a_ = operand_;								continue;
-
-					case OperationSTA:	operand_ = a_;											continue;
-					case OperationSTX:	operand_ = x_;											continue;
-					case OperationSTY:	operand_ = y_;											continue;
-					case OperationSTZ:	operand_ = 0;											continue;
-					case OperationSAX:	operand_ = a_ & x_;										continue;
-					case OperationSHA:	operand_ = a_ & x_ & (address_.halves.high+1);			continue;
-					case OperationSHX:	operand_ = x_ & (address_.halves.high+1);				continue;
-					case OperationSHY:	operand_ = y_ & (address_.halves.high+1);				continue;
-					case OperationSHS:	s_ = a_ & x_; operand_ = s_ & (address_.halves.high+1);	continue;
-
-					case OperationLXA:
+					micro_op(OperationLDA):	a_ = negative_result_ = zero_result_ = operand_;			next_micro_op();
+					micro_op(OperationLDX):	x_ = negative_result_ = zero_result_ = operand_;			next_micro_op();
+					micro_op(OperationLDY):	y_ = negative_result_ = zero_result_ = operand_;			next_micro_op();
+					micro_op(OperationLAX):	a_ = x_ = negative_result_ = zero_result_ = operand_;		next_micro_op();
+					micro_op(OperationCopyOperandToA):		a_ = operand_;								next_micro_op();
+
+					micro_op(OperationSTA):	operand_ = a_;											next_micro_op();
+					micro_op(OperationSTX):	operand_ = x_;											next_micro_op();
+					micro_op(OperationSTY):	operand_ = y_;											next_micro_op();
+					micro_op(OperationSTZ):	operand_ = 0;											next_micro_op();
+					micro_op(OperationSAX):	operand_ = a_ & x_;										next_micro_op();
+					micro_op(OperationSHA):	operand_ = a_ & x_ & (address_.halves.high+1);			next_micro_op();
+					micro_op(OperationSHX):	operand_ = x_ & (address_.halves.high+1);				next_micro_op();
+					micro_op(OperationSHY):	operand_ = y_ & (address_.halves.high+1);				next_micro_op();
+					micro_op(OperationSHS):	s_ = a_ & x_; operand_ = s_ & (address_.halves.high+1);	next_micro_op();
+
+					micro_op(OperationLXA):
 						a_ = x_ = (a_ | 0xee) & operand_;
 						negative_result_ = zero_result_ = a_;
-					continue;
+					next_micro_op();
 
 // MARK: - Compare
 
-					case OperationCMP: {
+					micro_op(OperationCMP): {
 						const uint16_t temp16 = a_ - operand_;
 						negative_result_ = zero_result_ = static_cast<uint8_t>(temp16);
 						carry_flag_ = ((~temp16) >> 8)&1;
-					} continue;
-					case OperationCPX: {
+					} next_micro_op();
+					micro_op(OperationCPX): {
 						const uint16_t temp16 = x_ - operand_;
 						negative_result_ = zero_result_ = static_cast<uint8_t>(temp16);
 						carry_flag_ = ((~temp16) >> 8)&1;
-					} continue;
-					case OperationCPY: {
+					} next_micro_op();
+					micro_op(OperationCPY): {
 						const uint16_t temp16 = y_ - operand_;
 						negative_result_ = zero_result_ = static_cast<uint8_t>(temp16);
 						carry_flag_ = ((~temp16) >> 8)&1;
-					} continue;
+					} next_micro_op();
 
 // MARK: - BIT, TSB, TRB
 
-					case OperationBIT:
+					micro_op(OperationBIT):
 						zero_result_ = operand_ & a_;
 						negative_result_ = operand_;
 						overflow_flag_ = operand_&Flag::Overflow;
-					continue;
-					case OperationBITNoNV:
+					next_micro_op();
+					micro_op(OperationBITNoNV):
 						zero_result_ = operand_ & a_;
-					continue;
-					case OperationTRB:
+					next_micro_op();
+					micro_op(OperationTRB):
 						zero_result_ = operand_ & a_;
 						operand_ &= ~a_;
-					continue;
-					case OperationTSB:
+					next_micro_op();
+					micro_op(OperationTSB):
 						zero_result_ = operand_ & a_;
 						operand_ |= a_;
-					continue;
+					next_micro_op();
 
 // MARK: - RMB and SMB
 
-					case OperationRMB:
+					micro_op(OperationRMB):
 						operand_ &= ~(1 << (operation_ >> 4));
-					continue;
-					case OperationSMB:
+					next_micro_op();
+					micro_op(OperationSMB):
 						operand_ |= 1 << ((operation_ >> 4)&7);
-					continue;
+					next_micro_op();
 
 // MARK: - ADC/SBC (and INS)
 
-					case OperationINS:
+					micro_op(OperationINS):
 						operand_++;			// deliberate fallthrough
-					case OperationSBC:
+					micro_op(OperationSBC):
 						if(decimal_flag_ && has_decimal_mode(personality)) {
 							const uint16_t notCarry = carry_flag_ ^ 0x1;
 							const uint16_t decimalResult = static_cast<uint16_t>(a_) - static_cast<uint16_t>(operand_) - notCarry;
@@ -329,13 +561,13 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 								read_mem(operand_, address_.full);
 								break;
 							}
-							continue;
+							next_micro_op();
 						} else {
 							operand_ = ~operand_;
 						}
 
 					// deliberate fallthrough
-					case OperationADC:
+					micro_op(OperationADC):
 						if(decimal_flag_ && has_decimal_mode(personality)) {
 							const uint16_t decimalResult = static_cast<uint16_t>(a_) + static_cast<uint16_t>(operand_) + static_cast<uint16_t>(carry_flag_);
 
@@ -364,105 +596,105 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 						// fix up in case this was INS
 						if(cycle == OperationINS) operand_ = ~operand_;
-					continue;
+					next_micro_op();
 
 // MARK: - Shifts and Rolls
 
-					case OperationASL:
+					micro_op(OperationASL):
 						carry_flag_ = operand_ >> 7;
 						operand_ <<= 1;
 						negative_result_ = zero_result_ = operand_;
-					continue;
+					next_micro_op();
 
-					case OperationASO:
+					micro_op(OperationASO):
 						carry_flag_ = operand_ >> 7;
 						operand_ <<= 1;
 						a_ |= operand_;
 						negative_result_ = zero_result_ = a_;
-					continue;
+					next_micro_op();
 
-					case OperationROL: {
+					micro_op(OperationROL): {
 						const uint8_t temp8 = static_cast<uint8_t>((operand_ << 1) | carry_flag_);
 						carry_flag_ = operand_ >> 7;
 						operand_ = negative_result_ = zero_result_ = temp8;
-					} continue;
+					} next_micro_op();
 
-					case OperationRLA: {
+					micro_op(OperationRLA): {
 						const uint8_t temp8 = static_cast<uint8_t>((operand_ << 1) | carry_flag_);
 						carry_flag_ = operand_ >> 7;
 						operand_ = temp8;
 						a_ &= operand_;
 						negative_result_ = zero_result_ = a_;
-					} continue;
+					} next_micro_op();
 
-					case OperationLSR:
+					micro_op(OperationLSR):
 						carry_flag_ = operand_ & 1;
 						operand_ >>= 1;
 						negative_result_ = zero_result_ = operand_;
-					continue;
+					next_micro_op();
 
-					case OperationLSE:
+					micro_op(OperationLSE):
 						carry_flag_ = operand_ & 1;
 						operand_ >>= 1;
 						a_ ^= operand_;
 						negative_result_ = zero_result_ = a_;
-					continue;
+					next_micro_op();
 
-					case OperationASR:
+					micro_op(OperationASR):
 						a_ &= operand_;
 						carry_flag_ = a_ & 1;
 						a_ >>= 1;
 						negative_result_ = zero_result_ = a_;
-					continue;
+					next_micro_op();
 
-					case OperationROR: {
+					micro_op(OperationROR): {
 						const uint8_t temp8 = static_cast<uint8_t>((operand_ >> 1) | (carry_flag_ << 7));
 						carry_flag_ = operand_ & 1;
 						operand_ = negative_result_ = zero_result_ = temp8;
-					} continue;
+					} next_micro_op();
 
-					case OperationRRA: {
+					micro_op(OperationRRA): {
 						const uint8_t temp8 = static_cast<uint8_t>((operand_ >> 1) | (carry_flag_ << 7));
 						carry_flag_ = operand_ & 1;
 						operand_ = temp8;
-					} continue;
-
-					case OperationDecrementOperand: operand_--; continue;
-					case OperationIncrementOperand: operand_++; continue;
-
-					case OperationCLC: carry_flag_ = 0;								continue;
-					case OperationCLI: inverse_interrupt_flag_ = Flag::Interrupt;	continue;
-					case OperationCLV: overflow_flag_ = 0;							continue;
-					case OperationCLD: decimal_flag_ = 0;							continue;
-
-					case OperationSEC: carry_flag_ = Flag::Carry;		continue;
-					case OperationSEI: inverse_interrupt_flag_ = 0;		continue;
-					case OperationSED: decimal_flag_ = Flag::Decimal;	continue;
-
-					case OperationINC: operand_++; negative_result_ = zero_result_ = operand_; continue;
-					case OperationDEC: operand_--; negative_result_ = zero_result_ = operand_; continue;
-					case OperationINA: a_++; negative_result_ = zero_result_ = a_; continue;
-					case OperationDEA: a_--; negative_result_ = zero_result_ = a_; continue;
-					case OperationINX: x_++; negative_result_ = zero_result_ = x_; continue;
-					case OperationDEX: x_--; negative_result_ = zero_result_ = x_; continue;
-					case OperationINY: y_++; negative_result_ = zero_result_ = y_; continue;
-					case OperationDEY: y_--; negative_result_ = zero_result_ = y_; continue;
-
-					case OperationANE:
+					} next_micro_op();
+
+					micro_op(OperationDecrementOperand): operand_--; next_micro_op();
+					micro_op(OperationIncrementOperand): operand_++; next_micro_op();
+
+					micro_op(OperationCLC): carry_flag_ = 0;								next_micro_op();
+					micro_op(OperationCLI): inverse_interrupt_flag_ = Flag::Interrupt;	next_micro_op();
+					micro_op(OperationCLV): overflow_flag_ = 0;							next_micro_op();
+					micro_op(OperationCLD): decimal_flag_ = 0;							next_micro_op();
+
+					micro_op(OperationSEC): carry_flag_ = Flag::Carry;		next_micro_op();
+					micro_op(OperationSEI): inverse_interrupt_flag_ = 0;		next_micro_op();
+					micro_op(OperationSED): decimal_flag_ = Flag::Decimal;	next_micro_op();
+
+					micro_op(OperationINC): operand_++; negative_result_ = zero_result_ = operand_; next_micro_op();
+					micro_op(OperationDEC): operand_--; negative_result_ = zero_result_ = operand_; next_micro_op();
+					micro_op(OperationINA): a_++; negative_result_ = zero_result_ = a_; next_micro_op();
+					micro_op(OperationDEA): a_--; negative_result_ = zero_result_ = a_; next_micro_op();
+					micro_op(OperationINX): x_++; negative_result_ = zero_result_ = x_; next_micro_op();
+					micro_op(OperationDEX): x_--; negative_result_ = zero_result_ = x_; next_micro_op();
+					micro_op(OperationINY): y_++; negative_result_ = zero_result_ = y_; next_micro_op();
+					micro_op(OperationDEY): y_--; negative_result_ = zero_result_ = y_; next_micro_op();
+
+					micro_op(OperationANE):
 						a_ = (a_ | 0xee) & operand_ & x_;
 						negative_result_ = zero_result_ = a_;
-					continue;
+					next_micro_op();
 
-					case OperationANC:
+					micro_op(OperationANC):
 						a_ &= operand_;
 						negative_result_ = zero_result_ = a_;
 						carry_flag_ = a_ >> 7;
-					continue;
+					next_micro_op();
 
-					case OperationLAS:
+					micro_op(OperationLAS):
 						a_ = x_ = s_ = s_ & operand_;
 						negative_result_ = zero_result_ = a_;
-					continue;
+					next_micro_op();
 
 // MARK: - Addressing Mode Work
 
@@ -473,28 +705,28 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 		throwaway_read(address_.full);	\
 	}
 
-					case CycleAddXToAddressLow:
+					micro_op(CycleAddXToAddressLow):
 						nextAddress.full = address_.full + x_;
 						address_.halves.low = nextAddress.halves.low;
 						if(address_.halves.high != nextAddress.halves.high) {
 							page_crossing_stall_read();
 							break;
 						}
-					continue;
-					case CycleAddXToAddressLowRead:
+					next_micro_op();
+					micro_op(CycleAddXToAddressLowRead):
 						nextAddress.full = address_.full + x_;
 						address_.halves.low = nextAddress.halves.low;
 						page_crossing_stall_read();
 					break;
-					case CycleAddYToAddressLow:
+					micro_op(CycleAddYToAddressLow):
 						nextAddress.full = address_.full + y_;
 						address_.halves.low = nextAddress.halves.low;
 						if(address_.halves.high != nextAddress.halves.high) {
 							page_crossing_stall_read();
 							break;
 						}
-					continue;
-					case CycleAddYToAddressLowRead:
+					next_micro_op();
+					micro_op(CycleAddYToAddressLowRead):
 						nextAddress.full = address_.full + y_;
 						address_.halves.low = nextAddress.halves.low;
 						page_crossing_stall_read();
@@ -502,86 +734,86 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 #undef page_crossing_stall_read
 
-					case OperationCorrectAddressHigh:
+					micro_op(OperationCorrectAddressHigh):
 						address_.full = nextAddress.full;
-					continue;
-					case CycleIncrementPCFetchAddressLowFromOperand:
+					next_micro_op();
+					micro_op(CycleIncrementPCFetchAddressLowFromOperand):
 						pc_.full++;
 						read_mem(address_.halves.low, operand_);
 					break;
-					case CycleAddXToOperandFetchAddressLow:
+					micro_op(CycleAddXToOperandFetchAddressLow):
 						operand_ += x_;
 						read_mem(address_.halves.low, operand_);
 					break;
-					case CycleFetchAddressLowFromOperand:
+					micro_op(CycleFetchAddressLowFromOperand):
 						read_mem(address_.halves.low, operand_);
 					break;
-					case CycleIncrementOperandFetchAddressHigh:
+					micro_op(CycleIncrementOperandFetchAddressHigh):
 						operand_++;
 						read_mem(address_.halves.high, operand_);
 					break;
-					case CycleIncrementPCReadPCHLoadPCL:	// deliberate fallthrough
+					micro_op(CycleIncrementPCReadPCHLoadPCL):	// deliberate fallthrough
 						pc_.full++;
-					case CycleReadPCHLoadPCL: {
+					micro_op(CycleReadPCHLoadPCL): {
 						uint16_t oldPC = pc_.full;
 						pc_.halves.low = operand_;
 						read_mem(pc_.halves.high, oldPC);
 					} break;
 
-					case CycleReadAddressHLoadAddressL:
+					micro_op(CycleReadAddressHLoadAddressL):
 						address_.halves.low = operand_; pc_.full++;
 						read_mem(address_.halves.high, pc_.full);
 					break;
 
-					case CycleLoadAddressAbsolute: {
+					micro_op(CycleLoadAddressAbsolute): {
 						uint16_t nextPC = pc_.full+1;
 						pc_.full += 2;
 						address_.halves.low = operand_;
 						read_mem(address_.halves.high, nextPC);
 					} break;
 
-					case OperationLoadAddressZeroPage:
+					micro_op(OperationLoadAddressZeroPage):
 						pc_.full++;
 						address_.full = operand_;
-					continue;
+					next_micro_op();
 
-					case CycleLoadAddessZeroX:
+					micro_op(CycleLoadAddessZeroX):
 						pc_.full++;
 						address_.full = (operand_ + x_)&0xff;
 						throwaway_read(operand_);
 					break;
 
-					case CycleLoadAddessZeroY:
+					micro_op(CycleLoadAddessZeroY):
 						pc_.full++;
 						address_.full = (operand_ + y_)&0xff;
 						throwaway_read(operand_);
 					break;
 
-					case OperationIncrementPC:			pc_.full++;						continue;
-					case CycleFetchOperandFromAddress:	read_mem(operand_, address_.full);	break;
-					case CycleWriteOperandToAddress:	write_mem(operand_, address_.full);	break;
+					micro_op(OperationIncrementPC):			pc_.full++;						next_micro_op();
+					micro_op(CycleFetchOperandFromAddress):	read_mem(operand_, address_.full);	break;
+					micro_op(CycleWriteOperandToAddress):	write_mem(operand_, address_.full);	break;
 
 // MARK: - Branching
 
 #define BRA(condition)	\
 	pc_.full++; \
 	if(condition) {	\
-		scheduled_program_counter_ = do_branch;	\
+		scheduled_program_counter_ = do_branch_;	\
 	}
 
-					case OperationBPL: BRA(!(negative_result_&0x80));				continue;
-					case OperationBMI: BRA(negative_result_&0x80);					continue;
-					case OperationBVC: BRA(!overflow_flag_);						continue;
-					case OperationBVS: BRA(overflow_flag_);							continue;
-					case OperationBCC: BRA(!carry_flag_);							continue;
-					case OperationBCS: BRA(carry_flag_);							continue;
-					case OperationBNE: BRA(zero_result_);							continue;
-					case OperationBEQ: BRA(!zero_result_);							continue;
-					case OperationBRA: BRA(true);									continue;
+					micro_op(OperationBPL): BRA(!(negative_result_&0x80));				next_micro_op();
+					micro_op(OperationBMI): BRA(negative_result_&0x80);					next_micro_op();
+					micro_op(OperationBVC): BRA(!overflow_flag_);						next_micro_op();
+					micro_op(OperationBVS): BRA(overflow_flag_);							next_micro_op();
+					micro_op(OperationBCC): BRA(!carry_flag_);							next_micro_op();
+					micro_op(OperationBCS): BRA(carry_flag_);							next_micro_op();
+					micro_op(OperationBNE): BRA(zero_result_);							next_micro_op();
+					micro_op(OperationBEQ): BRA(!zero_result_);							next_micro_op();
+					micro_op(OperationBRA): BRA(true);									next_micro_op();
 
 #undef BRA
 
-					case CycleAddSignedOperandToPC:
+					micro_op(CycleAddSignedOperandToPC):
 						nextAddress.full = static_cast<uint16_t>(pc_.full + (int8_t)operand_);
 						pc_.halves.low = nextAddress.halves.low;
 						if(nextAddress.halves.high != pc_.halves.high) {
@@ -593,53 +825,40 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 							// 65C02 modification to all branches: a branch that is taken but requires only a single cycle
 							// to target its destination skips any pending interrupts.
 							// Cf. http://forum.6502.org/viewtopic.php?f=4&t=1634
-							scheduled_program_counter_ = fetch_decode_execute;
+							scheduled_program_counter_ = fetch_decode_execute_;
 						}
-					continue;
+					next_micro_op();
 
-					case CycleFetchFromHalfUpdatedPC: {
+					micro_op(CycleFetchFromHalfUpdatedPC): {
 						uint16_t halfUpdatedPc = static_cast<uint16_t>(((pc_.halves.low + (int8_t)operand_) & 0xff) | (pc_.halves.high << 8));
 						throwaway_read(halfUpdatedPc);
 					} break;
 
-					case OperationAddSignedOperandToPC16:
+					micro_op(OperationAddSignedOperandToPC16):
 						pc_.full = static_cast<uint16_t>(pc_.full + (int8_t)operand_);
-					continue;
+					next_micro_op();
 
-					case OperationBBRBBS: {
+					micro_op(OperationBBRBBS): {
 						// To reach here, the 6502 has (i) read the operation; (ii) read the first operand;
 						// and (iii) read from the corresponding zero page.
 						const uint8_t mask = static_cast<uint8_t>(1 << ((operation_ >> 4)&7));
 						if((operand_ & mask) == ((operation_ & 0x80) ? mask : 0)) {
-							static const MicroOp do_branch[] = {
-								CycleFetchOperand,			// Fetch offset.
-								OperationIncrementPC,
-								CycleFetchFromHalfUpdatedPC,
-								OperationAddSignedOperandToPC16,
-								OperationMoveToNextProgram
-							};
-							scheduled_program_counter_ = do_branch;
+							scheduled_program_counter_ = do_bbrbbs_branch_;
 						} else {
-							static const MicroOp do_not_branch[] = {
-								CycleFetchOperand,
-								OperationIncrementPC,
-								CycleFetchFromHalfUpdatedPC,
-								OperationMoveToNextProgram
-							};
-							scheduled_program_counter_ = do_not_branch;
+							scheduled_program_counter_ = do_not_bbrbbs_branch_;
 						}
 					} break;
 
 // MARK: - Transfers
 
-					case OperationTXA: zero_result_ = negative_result_ = a_ = x_;	continue;
-					case OperationTYA: zero_result_ = negative_result_ = a_ = y_;	continue;
-					case OperationTXS: s_ = x_;										continue;
-					case OperationTAY: zero_result_ = negative_result_ = y_ = a_;	continue;
-					case OperationTAX: zero_result_ = negative_result_ = x_ = a_;	continue;
-					case OperationTSX: zero_result_ = negative_result_ = x_ = s_;	continue;
+					micro_op(OperationTXA): zero_result_ = negative_result_ = a_ = x_;	next_micro_op();
+					micro_op(OperationTYA): zero_result_ = negative_result_ = a_ = y_;	next_micro_op();
+					micro_op(OperationTXS): s_ = x_;										next_micro_op();
+					micro_op(OperationTAY): zero_result_ = negative_result_ = y_ = a_;	next_micro_op();
+					micro_op(OperationTAX): zero_result_ = negative_result_ = x_ = a_;	next_micro_op();
+					micro_op(OperationTSX): zero_result_ = negative_result_ = x_ = s_;	next_micro_op();
 
-					case OperationARR:
+					micro_op(OperationARR):
 						if(decimal_flag_) {
 							a_ &= operand_;
 							uint8_t unshiftedA = a_;
@@ -658,15 +877,15 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 							carry_flag_ = (a_ >> 6)&1;
 							overflow_flag_ = (a_^(a_ << 1))&Flag::Overflow;
 						}
-					continue;
+					next_micro_op();
 
-					case OperationSBX:
+					micro_op(OperationSBX):
 						x_ &= a_;
 						uint16_t difference = x_ - operand_;
 						x_ = static_cast<uint8_t>(difference);
 						negative_result_ = zero_result_ = x_;
 						carry_flag_ = ((difference >> 8)&1)^1;
-					continue;
+					next_micro_op();
 				}
 
 				if(has_stpwai(personality) && (stop_is_active_ || wait_is_active_)) {
@@ -687,10 +906,38 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	bus_address_ = busAddress;
 	bus_value_ = busValue;
 
+	if constexpr (uses_direct_pages) advance_direct_cycles();
 	bus_handler_.flush();
+
+#undef sample_interrupts
+#undef micro_op
+#undef next_micro_op
+}
+
+template <Personality personality, typename T, bool uses_ready_line, bool uses_threaded_dispatch> void Processor<personality, T, uses_ready_line, uses_threaded_dispatch>::advance_direct_cycles() {
+	if(direct_cycles_ == Cycles(0)) return;
+
+	// If interrupts were enabled during either of the final two direct cycles then the bus handler
+	// needs to be advanced in steps, so that the interrupt line can be sampled exactly when it would
+	// have been: at the start of each of those cycles. Samples from any earlier cycles have already
+	// been superseded.
+	if(direct_interrupt_masks_) {
+		if(direct_cycles_ > Cycles(1)) {
+			if(direct_cycles_ > Cycles(2)) bus_handler_.advance(direct_cycles_ - Cycles(2));
+			interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::IRQ) | (irq_line_ & (direct_interrupt_masks_ >> 8));
+			bus_handler_.advance(Cycles(1));
+		}
+		irq_request_history_ = irq_line_ & uint8_t(direct_interrupt_masks_);
+		bus_handler_.advance(Cycles(1));
+	} else {
+		bus_handler_.advance(direct_cycles_);
+	}
+
+	direct_cycles_ = Cycles(0);
+	direct_interrupt_masks_ = 0;
 }
 
-template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::set_ready_line(bool active) {
+template <Personality personality, typename T, bool uses_ready_line, bool uses_threaded_dispatch> void Processor<personality, T, uses_ready_line, uses_threaded_dispatch>::set_ready_line(bool active) {
 	assert(uses_ready_line);
 	if(active) {
 		ready_line_is_enabled_ = true;
@@ -730,56 +977,6 @@ void ProcessorBase::set_nmi_line(bool active) {
 	nmi_line_is_enabled_ = active;
 }
 
-inline const ProcessorStorage::MicroOp *ProcessorStorage::get_reset_program() {
-	static const MicroOp reset[] = {
-		CycleFetchOperand,
-		CycleFetchOperand,
-		CycleNoWritePush,
-		CycleNoWritePush,
-		OperationRSTPickVector,
-		CycleNoWritePush,
-		OperationSetNMIRSTFlags,
-		CycleReadVectorLow,
-		CycleReadVectorHigh,
-		OperationMoveToNextProgram
-	};
-	return reset;
-}
-
-inline const ProcessorStorage::MicroOp *ProcessorStorage::get_irq_program() {
-	static const MicroOp reset[] = {
-		CycleFetchOperand,
-		CycleFetchOperand,
-		CyclePushPCH,
-		CyclePushPCL,
-		OperationBRKPickVector,
-		OperationSetOperandFromFlags,
-		CyclePushOperand,
-		OperationSetIRQFlags,
-		CycleReadVectorLow,
-		CycleReadVectorHigh,
-		OperationMoveToNextProgram
-	};
-	return reset;
-}
-
-inline const ProcessorStorage::MicroOp *ProcessorStorage::get_nmi_program() {
-	static const MicroOp reset[] = {
-		CycleFetchOperand,
-		CycleFetchOperand,
-		CyclePushPCH,
-		CyclePushPCL,
-		OperationNMIPickVector,
-		OperationSetOperandFromFlags,
-		CyclePushOperand,
-		OperationSetNMIRSTFlags,
-		CycleReadVectorLow,
-		CycleReadVectorHigh,
-		OperationMoveToNextProgram
-	};
-	return reset;
-}
-
 uint8_t ProcessorStorage::get_flags() {
 	return carry_flag_ | overflow_flag_ | (inverse_interrupt_flag_ ^ Flag::Interrupt) | (negative_result_ & 0x80) | (zero_result_ ? 0 : Flag::Zero) | Flag::Always | decimal_flag_;
 }
@@ -792,3 +989,48 @@ void ProcessorStorage::set_flags(uint8_t flags) {
 	inverse_interrupt_flag_	= (~flags)	& Flag::Interrupt;
 	decimal_flag_			= flags		& Flag::Decimal;
 }
+
+template <Personality personality, typename T, bool uses_ready_line, bool uses_threaded_dispatch> void Processor<personality, T, uses_ready_line, uses_threaded_dispatch>::test_idle_loop(Cycles &number_of_cycles) {
+	// Loops that take longer than this are not detected.
+	constexpr Cycles max_loop_length(256);
+
+	// The 6502 has just fetched an opcode. If this isn't a revisit to the candidate loop address,
+	// make it the new candidate only if the old one has gone unvisited for too long to be a loop.
+	const Cycles loop_length = idle_loop_.start - number_of_cycles;
+	if(last_operation_pc_.full != idle_loop_.program_counter && loop_length <= max_loop_length) {
+		return;
+	}
+
+	const uint8_t registers[] = {a_, x_, y_, s_, get_flags()};
+
+	// If this is a revisit and the last iteration changed nothing, the next will be identical unless an
+	// event intervenes; so skip as many iterations as fit before the next event and the end of this run_for.
+	if(
+		last_operation_pc_.full == idle_loop_.program_counter &&
+		idle_loop_.is_clean &&
+		std::equal(std::begin(registers), std::end(registers), idle_loop_.registers)
+	) {
+		if constexpr (T::has_direct_pages && !uses_ready_line) advance_direct_cycles();
+
+		// At least one cycle must remain for the bus access that follows decoding, which will be performed
+		// regardless; skipping up to the end of this run_for would otherwise overrun it.
+		Cycles limit = number_of_cycles - Cycles(1);
+		const Cycles time_until_event = bus_handler_.get_time_until_event();
+		if(time_until_event >= Cycles(0) && time_until_event <= limit) {
+			limit = time_until_event - Cycles(1);
+		}
+
+		const auto iterations = limit.as_integral() / loop_length.as_integral();
+		// An IRQ that arrived during the opcode fetch isn't yet in the request history, so check the line too.
+		if(!interrupt_requests_ && !irq_request_history_ && !(irq_line_ & inverse_interrupt_flag_) && iterations > 0) {
+			const Cycles skipped(loop_length.as_integral() * iterations);
+			number_of_cycles -= skipped;
+			bus_handler_.skip_idle_time(skipped);
+		}
+	}
+
+	idle_loop_.program_counter = last_operation_pc_.full;
+	std::copy(std::begin(registers), std::end(registers), idle_loop_.registers);
+	idle_loop_.start = number_of_cycles;
+	idle_loop_.is_clean = true;
+}
@@ -221,7 +221,7 @@ class ProcessorStorage {
 		*/
 		BusOperation next_bus_operation_ = BusOperation::None;
 		uint16_t bus_address_;
-		uint8_t *bus_value_;
+		uint8_t *bus_value_ = &throwaway_target_;
 
 		/*!
 			Gets the flags register.
@@ -261,26 +261,85 @@ class ProcessorStorage {
 		uint8_t irq_line_ = 0, irq_request_history_ = 0;
 		bool nmi_line_is_enabled_ = false, set_overflow_line_is_enabled_ = false;
 
-		/*!
-			Gets the program representing an RST response.
-
-			@returns The program representing an RST response.
-		*/
-		inline const MicroOp *get_reset_program();
-
-		/*!
-			Gets the program representing an IRQ response.
+		// The most recent visit to the address that is currently a candidate for the top of an idle loop: the
+		// registers then, the number of cycles then left to run, and whether anything has happened since that
+		// would prevent the loop from being skipped. See BusHandler::skips_idle_loops.
+		struct IdleLoop {
+			uint16_t program_counter = 0;
+			uint8_t registers[5]{};
+			Cycles start;
+			bool is_clean = false;
+		} idle_loop_;
 
-			@returns The program representing an IRQ response.
+		/*
+			Programs that are scheduled other than by instruction decoding. These are kept here,
+			rather than as function statics, so that a program in progress can be identified when
+			capturing state.
 		*/
-		inline const MicroOp *get_irq_program();
-
-		/*!
-			Gets the program representing an NMI response.
+		static constexpr MicroOp fetch_decode_execute_[] = {
+			CycleFetchOperation,
+			CycleFetchOperand,
+			OperationDecodeOperation
+		};
+		static constexpr MicroOp do_branch_[] = {
+			CycleReadFromPC,
+			CycleAddSignedOperandToPC,
+			OperationMoveToNextProgram
+		};
+		static constexpr MicroOp do_bbrbbs_branch_[] = {
+			CycleFetchOperand,			// Fetch offset.
+			OperationIncrementPC,
+			CycleFetchFromHalfUpdatedPC,
+			OperationAddSignedOperandToPC16,
+			OperationMoveToNextProgram
+		};
+		static constexpr MicroOp do_not_bbrbbs_branch_[] = {
+			CycleFetchOperand,
+			OperationIncrementPC,
+			CycleFetchFromHalfUpdatedPC,
+			OperationMoveToNextProgram
+		};
+		static constexpr MicroOp reset_program_[] = {
+			CycleFetchOperand,
+			CycleFetchOperand,
+			CycleNoWritePush,
+			CycleNoWritePush,
+			OperationRSTPickVector,
+			CycleNoWritePush,
+			OperationSetNMIRSTFlags,
+			CycleReadVectorLow,
+			CycleReadVectorHigh,
+			OperationMoveToNextProgram
+		};
+		static constexpr MicroOp irq_program_[] = {
+			CycleFetchOperand,
+			CycleFetchOperand,
+			CyclePushPCH,
+			CyclePushPCL,
+			OperationBRKPickVector,
+			OperationSetOperandFromFlags,
+			CyclePushOperand,
+			OperationSetIRQFlags,
+			CycleReadVectorLow,
+			CycleReadVectorHigh,
+			OperationMoveToNextProgram
+		};
+		static constexpr MicroOp nmi_program_[] = {
+			CycleFetchOperand,
+			CycleFetchOperand,
+			CyclePushPCH,
+			CyclePushPCL,
+			OperationNMIPickVector,
+			OperationSetOperandFromFlags,
+			CyclePushOperand,
+			OperationSetNMIRSTFlags,
+			CycleReadVectorLow,
+			CycleReadVectorHigh,
+			OperationMoveToNextProgram
+		};
 
-			@returns The program representing an NMI response.
-		*/
-		inline const MicroOp *get_nmi_program();
+		/// The target of reads for which the result is discarded.
+		uint8_t throwaway_target_ = 0xff;
 };
 
 #endif /* _502Storage_h */
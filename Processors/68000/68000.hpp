@@ -9,11 +9,13 @@
 #ifndef MC68000_h
 #define MC68000_h
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <ostream>
 #include <vector>
@@ -21,6 +23,8 @@
 #include "../../ClockReceiver/ForceInline.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../RegisterSizes.hpp"
+#include "../TraceRing.hpp"
+#include "../../Storage/Snapshot.hpp"
 
 namespace CPU {
 namespace MC68000 {
@@ -344,6 +348,84 @@ class BusHandler {
 			Provides information about the path of execution if enabled via the template.
 		*/
 		void will_perform(uint32_t address, uint16_t opcode) {}
+
+		/*!
+			Bus handlers may nominate 64kb pages of plain memory that the 68000 should access directly, in which case
+			perform_bus_operation will be called only for accesses elsewhere, for interrupt acknowledgement and
+			for reset and bus grant cycles; this substantially reduces the cost of code that mostly touches memory.
+
+			To do so, a bus handler should declare @c has_direct_pages as @c true and implement @c direct_read_page,
+			@c direct_write_page and @c advance. The 68000 will then call @c advance to report the time spent on
+			direct accesses and idle microcycles before each call to perform_bus_operation or will_perform, before
+			sampling the interrupt inputs and at the end of each run_for. So devices always observe their own
+			accesses at exactly the correct time, and interrupts are recognised exactly as they would otherwise be.
+
+			Accesses to direct pages are never delayed by DTack or VPA; the halt, DTack, VPA and bus error inputs
+			are observed only as of the most recent call to the bus handler. The 68000 still steps through each
+			microcycle individually; it is only the calls to the bus handler that are saved.
+		*/
+		static constexpr bool has_direct_pages = false;
+
+		/*!
+			@returns A pointer to the 65,536 bytes that should be read by accesses to page @c page — i.e. 24-bit addresses
+			[page * 65536, page * 65536 + 65535] — stored such that Microcycle::apply can be used with them, or @c nullptr
+			if those reads should be announced via perform_bus_operation.
+		*/
+		uint8_t *direct_read_page(int page) {
+			return nullptr;
+		}
+
+		/*!
+			@returns A pointer to the 65,536 bytes that should be written by accesses to page @c page, or @c nullptr
+			if those writes should be announced via perform_bus_operation.
+		*/
+		uint8_t *direct_write_page(int page) {
+			return nullptr;
+		}
+
+		/*!
+			Announces that @c duration has passed, during which the 68000 performed only direct accesses and
+			idle microcycles.
+		*/
+		void advance(HalfCycles duration) {}
+
+		/*!
+			If @c true, the 68000 will add a record to the current thread's TraceRing as it begins each instruction.
+			This costs nothing if @c false.
+		*/
+		static constexpr bool traces_execution = false;
+
+		/*!
+			If @c true, each record added because of @c traces_execution also includes the 68000's registers; this
+			roughly doubles the cost of tracing. Otherwise only the time, program counter and opcode are recorded.
+		*/
+		static constexpr bool traces_registers = false;
+
+		/*!
+			Bus handlers may allow the 68000 to skip idle loops: short loops that write nothing, access no
+			peripherals, never wait for DTack and leave every register as they found it, so that each iteration
+			will exactly repeat the last until an interrupt is requested or something that the loop reads changes.
+			The 68000 will then skip as many whole iterations as fit before the bus handler's next event, announcing
+			the time skipped via @c skip_idle_time.
+
+			To do so, a bus handler should declare @c skips_idle_loops as @c true and implement
+			@c get_time_until_event and @c skip_idle_time. It should also call the 68000's @c prevent_idle_skip
+			whenever it services a read that has side effects, or whose result may change other than at an event.
+		*/
+		static constexpr bool skips_idle_loops = false;
+
+		/*!
+			@returns The time until the next event that might change the interrupt level or the value of
+			anything read by an idle loop, or a negative value if no such event is scheduled.
+		*/
+		HalfCycles get_time_until_event() {
+			return HalfCycles(0);
+		}
+
+		/*!
+			Announces that @c duration has passed, during which the 68000 would have repeated an idle loop.
+		*/
+		void skip_idle_time(HalfCycles duration) {}
 };
 
 #include "Implementation/68000Storage.hpp"
@@ -434,8 +516,24 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform = false> cla
 			halt_ = halt;
 		}
 
+		/// Prevents the loop that the 68000 is currently executing, if any, from being skipped as idle;
+		/// see BusHandler::skips_idle_loops.
+		inline void prevent_idle_skip() {
+			idle_loop_.is_clean = false;
+		}
+
 	private:
 		T &bus_handler_;
+
+		/// The total number of half cycles run for, if execution is being traced.
+		uint64_t traced_half_cycles_ = 0;
+
+		HalfCycles direct_cycles_;
+		forceinline uint8_t *direct_page(const Microcycle &cycle);
+		forceinline bool perform_direct_microcycle(const Microcycle &cycle);
+		inline void advance_direct_cycles();
+
+		inline void test_idle_loop(HalfCycles &cycles_run_for, HalfCycles remaining_duration);
 };
 
 #include "Implementation/68000Implementation.hpp"
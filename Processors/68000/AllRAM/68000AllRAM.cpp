@@ -0,0 +1,105 @@
+//
+//  68000AllRAM.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "68000AllRAM.hpp"
+
+#include <algorithm>
+
+using namespace CPU::MC68000;
+
+namespace {
+
+// Memory is stored as host-endian words, so that Microcycle::apply can be used directly with it.
+#if TARGET_RT_BIG_ENDIAN
+constexpr std::size_t byte_swizzle = 0;
+#else
+constexpr std::size_t byte_swizzle = 1;
+#endif
+
+class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
+	public:
+		ConcreteAllRAMProcessor() : m68000_(*this) {}
+
+		inline HalfCycles perform_bus_operation(const Microcycle &cycle, int) {
+			timestamp_ += cycle.length;
+			if(!(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte))) {
+				return HalfCycles(0);
+			}
+
+			if(cycle.operation & Microcycle::InterruptAcknowledge) {
+				// Supply the autovector for the level being acknowledged; it is indicated by address lines 1–3.
+				cycle.value->halves.low = uint8_t(24 + ((*cycle.address >> 1) & 7));
+			} else {
+				cycle.apply(&memory_[cycle.host_endian_byte_address()]);
+			}
+			return HalfCycles(0);
+		}
+
+		// All memory is accessed directly by the 68000.
+		static constexpr bool has_direct_pages = true;
+
+		uint8_t *direct_read_page(int page) {
+			return &memory_[size_t(page) << 16];
+		}
+
+		uint8_t *direct_write_page(int page) {
+			return &memory_[size_t(page) << 16];
+		}
+
+		void advance(HalfCycles duration) {
+			timestamp_ += duration;
+		}
+
+		void will_perform(uint32_t, uint16_t) {
+			++instruction_count_;
+		}
+
+		void run_for(const Cycles cycles) {
+			m68000_.run_for(cycles);
+		}
+
+		ProcessorState get_state() {
+			return m68000_.get_state();
+		}
+
+		void set_state(const ProcessorState &state) {
+			m68000_.set_state(state);
+		}
+
+		void set_interrupt_level(int level) {
+			m68000_.set_interrupt_level(level);
+		}
+
+		uint64_t get_instruction_count() {
+			return instruction_count_;
+		}
+
+	private:
+		CPU::MC68000::Processor<ConcreteAllRAMProcessor, true, true> m68000_;
+		uint64_t instruction_count_ = 0;
+};
+
+}
+
+void AllRAMProcessor::set_data_at_address(uint32_t start_address, std::size_t length, const uint8_t *data) {
+	const std::size_t end_address = std::min(start_address + length, memory_.size());
+	for(std::size_t address = start_address; address < end_address; ++address) {
+		memory_[address ^ byte_swizzle] = data[address - start_address];
+	}
+}
+
+void AllRAMProcessor::get_data_at_address(uint32_t start_address, std::size_t length, uint8_t *data) {
+	const std::size_t end_address = std::min(start_address + length, memory_.size());
+	for(std::size_t address = start_address; address < end_address; ++address) {
+		data[address - start_address] = memory_[address ^ byte_swizzle];
+	}
+}
+
+AllRAMProcessor *AllRAMProcessor::Processor() {
+	return new ConcreteAllRAMProcessor;
+}
@@ -0,0 +1,56 @@
+//
+//  68000AllRAM.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef MC68000AllRAM_hpp
+#define MC68000AllRAM_hpp
+
+#include "../68000.hpp"
+#include "../../AllRAMProcessor.hpp"
+
+namespace CPU {
+namespace MC68000 {
+
+class AllRAMProcessor:
+	public ::CPU::AllRAMProcessor {
+
+	public:
+		/*!
+			@returns A 68000 with 16mb of RAM. It will begin by loading its initial stack pointer
+				and program counter from the reset vectors at address 0.
+		*/
+		static AllRAMProcessor *Processor();
+		virtual ~AllRAMProcessor() {}
+
+		/*!
+			Copies @c length bytes from @c data into memory from @c start_address, in the byte order that
+			the 68000 sees them; i.e. @c data should be big endian. Data beyond the end of memory is ignored.
+		*/
+		void set_data_at_address(uint32_t start_address, std::size_t length, const uint8_t *data);
+
+		/*!
+			Copies @c length bytes from memory at @c start_address into @c data, in the byte order that
+			the 68000 sees them.
+		*/
+		void get_data_at_address(uint32_t start_address, std::size_t length, uint8_t *data);
+
+		virtual void run_for(const Cycles cycles) = 0;
+		virtual ProcessorState get_state() = 0;
+		virtual void set_state(const ProcessorState &state) = 0;
+		virtual void set_interrupt_level(int level) = 0;
+
+		/// @returns The number of instructions begun so far.
+		virtual uint64_t get_instruction_count() = 0;
+
+	protected:
+		AllRAMProcessor() : ::CPU::AllRAMProcessor(16*1024*1024) {}
+};
+
+}
+}
+
+#endif /* MC68000AllRAM_hpp */
@@ -70,6 +70,13 @@
 template <class T, bool dtack_is_implicit, bool signal_will_perform> void Processor<T, dtack_is_implicit, signal_will_perform>::run_for(HalfCycles duration) {
 	const HalfCycles remaining_duration = duration + half_cycles_left_to_run_;
 
+	// Accesses to the bus handler's direct pages, if any, and idle microcycles are performed without
+	// involving the bus handler until advance_direct_cycles is called.
+	constexpr bool uses_direct_pages = T::has_direct_pages;
+
+	// If execution is being traced, records go to the ring of whichever thread is running the 68000.
+	TraceRing *const trace_ring = T::traces_execution ? &TraceRing::current() : nullptr;
+
 	// This loop counts upwards rather than downwards because it simplifies calculation of
 	// E as and when required.
 	HalfCycles cycles_run_for;
@@ -88,7 +95,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 
 					if(active_step_->microcycle.data_select_active()) {
 						// Check whether the processor needs to await DTack.
-						if(!dtack_is_implicit && !dtack_ && !bus_error_) {
+						if(!dtack_is_implicit && !dtack_ && !bus_error_ && !(uses_direct_pages && direct_page(active_step_->microcycle))) {
 							execution_state_ = ExecutionState::WaitingForDTack;
 							dtack_cycle_ = active_step_->microcycle;
 							dtack_cycle_.length = HalfCycles(2);
@@ -132,7 +139,21 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 					// would normally strobe one of the data selects and VPA is active, it will also need
 					// stretching.
 					if(active_step_->microcycle.length != HalfCycles(0)) {
-						if(is_peripheral_address_ && active_step_->microcycle.data_select_active()) {
+						if constexpr (T::skips_idle_loops) {
+							if(
+								active_step_->microcycle.data_select_active() &&
+								(is_peripheral_address_ || !(active_step_->microcycle.operation & Microcycle::Read))
+							) {
+								idle_loop_.is_clean = false;
+							}
+						}
+
+						if(uses_direct_pages && perform_direct_microcycle(active_step_->microcycle)) {
+							direct_cycles_ += active_step_->microcycle.length;
+							cycles_run_for += active_step_->microcycle.length;
+						} else if(is_peripheral_address_ && active_step_->microcycle.data_select_active()) {
+							if constexpr (uses_direct_pages) advance_direct_cycles();
+
 							auto cycle_copy = active_step_->microcycle;
 							cycle_copy.operation |= Microcycle::IsPeripheral;
 
@@ -145,6 +166,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 								cycle_copy.length +
 								bus_handler_.perform_bus_operation(cycle_copy, is_supervisor_);
 						} else {
+							if constexpr (uses_direct_pages) advance_direct_cycles();
 							cycles_run_for +=
 								active_step_->microcycle.length +
 								bus_handler_.perform_bus_operation(active_step_->microcycle, is_supervisor_);
@@ -194,6 +216,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 
 								// During prefetch advance seems to be the only time the interrupt inputs are sampled;
 								// TODO: determine whether this really happens on *every* advance.
+								if constexpr (uses_direct_pages) advance_direct_cycles();
 								if(bus_interrupt_level_ > interrupt_level_) {
 									pending_interrupt_level_ = bus_interrupt_level_;
 								}
@@ -205,6 +228,8 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 				break;
 
 				case ExecutionState::Stopped:
+					if constexpr (uses_direct_pages) advance_direct_cycles();
+
 					// If an interrupt (TODO: or reset) has finally arrived that will be serviced,
 					// exit the STOP.
 					if(bus_interrupt_level_ > interrupt_level_) {
@@ -221,6 +246,9 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 				continue;
 
 				case ExecutionState::WaitingForDTack:
+					if constexpr (uses_direct_pages) advance_direct_cycles();
+					if constexpr (T::skips_idle_loops) idle_loop_.is_clean = false;
+
 					// If DTack or bus error has been signalled, stop waiting.
 					if(dtack_ || bus_error_) {
 						execution_state_ = ExecutionState::Executing;
@@ -234,6 +262,8 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 				continue;
 
 				case ExecutionState::Halted:
+					if constexpr (uses_direct_pages) advance_direct_cycles();
+
 					if(!halt_) {
 						execution_state_ = ExecutionState::Executing;
 						continue;
@@ -312,9 +342,32 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 #endif
 
 							if constexpr (signal_will_perform) {
+								if constexpr (uses_direct_pages) advance_direct_cycles();
 								bus_handler_.will_perform(program_counter_.full - 4, decoded_instruction_.full);
 							}
 
+							if constexpr (T::traces_execution) {
+								auto &record = trace_ring->begin_record();
+								record.time = uint64_t(traced_half_cycles_ + cycles_run_for.as_integral()) >> 1;
+								record.program_counter = program_counter_.full - 4;
+								record.opcode = decoded_instruction_.full;
+								record.source = TraceRing::Source::MC68000;
+								if constexpr (T::traces_registers) {
+									uint32_t *const registers = trace_ring->record_registers();
+									record.register_count = 17;
+									for(int c = 0; c < 8; ++c) {
+										registers[c] = data_[c].full;
+										registers[c + 8] = address_[c].full;
+									}
+									registers[16] = get_status();
+								} else {
+									record.register_count = 0;
+								}
+								trace_ring->end_record();
+							}
+
+							if constexpr (T::skips_idle_loops) test_idle_loop(cycles_run_for, remaining_duration);
+
 #ifdef LOG_TRACE
 //							const uint32_t fetched_pc = (program_counter_.full - 4)&0xffffff;
 
@@ -2187,9 +2240,95 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 #undef destination
 #undef destination_address
 
+	if constexpr (uses_direct_pages) advance_direct_cycles();
 	bus_handler_.flush();
 	e_clock_phase_ = (e_clock_phase_ + cycles_run_for) % 10;
 	half_cycles_left_to_run_ = remaining_duration - cycles_run_for;
+	if constexpr (T::traces_execution) traced_half_cycles_ += cycles_run_for.as_integral();
+	if constexpr (T::skips_idle_loops) idle_loop_.start -= cycles_run_for;
+}
+
+template <class T, bool dtack_is_implicit, bool signal_will_perform> uint8_t *Processor<T, dtack_is_implicit, signal_will_perform>::direct_page(const Microcycle &cycle) {
+	// Only ordinary address and data strobes, without interrupt acknowledgement, can be directed to a direct page.
+	if(
+		!(cycle.operation & (Microcycle::NewAddress | Microcycle::SameAddress | Microcycle::SelectByte | Microcycle::SelectWord)) ||
+		(cycle.operation & (Microcycle::InterruptAcknowledge | Microcycle::Reset | Microcycle::BusGrant))
+	) {
+		return nullptr;
+	}
+
+	const int page = int((*cycle.address & 0xffffff) >> 16);
+	return (cycle.operation & Microcycle::Read) ? bus_handler_.direct_read_page(page) : bus_handler_.direct_write_page(page);
+}
+
+template <class T, bool dtack_is_implicit, bool signal_will_perform> bool Processor<T, dtack_is_implicit, signal_will_perform>::perform_direct_microcycle(const Microcycle &cycle) {
+	// Idle microcycles don't involve the bus, so are always direct.
+	if(!(cycle.operation & ~(Microcycle::IsData | Microcycle::IsProgram | Microcycle::Read))) {
+		return true;
+	}
+
+	uint8_t *const page = direct_page(cycle);
+	if(!page) return false;
+	if(cycle.operation & (Microcycle::SelectByte | Microcycle::SelectWord)) {
+		cycle.apply(page + (cycle.host_endian_byte_address() & 0xffff));
+	}
+	return true;
+}
+
+template <class T, bool dtack_is_implicit, bool signal_will_perform> void Processor<T, dtack_is_implicit, signal_will_perform>::advance_direct_cycles() {
+	if(direct_cycles_ == HalfCycles(0)) return;
+	bus_handler_.advance(direct_cycles_);
+	direct_cycles_ = HalfCycles(0);
+}
+
+template <class T, bool dtack_is_implicit, bool signal_will_perform> void Processor<T, dtack_is_implicit, signal_will_perform>::test_idle_loop(HalfCycles &cycles_run_for, HalfCycles remaining_duration) {
+	// Loops that take longer than this are not detected.
+	constexpr HalfCycles max_loop_length(512);
+
+	// The 68000 is about to begin an instruction. If this isn't a revisit to the candidate loop address,
+	// make it the new candidate only if the old one has gone unvisited for too long to be a loop.
+	const uint32_t program_counter = program_counter_.full - 4;
+	const HalfCycles loop_length = cycles_run_for - idle_loop_.start;
+	if(program_counter != idle_loop_.program_counter && loop_length <= max_loop_length) {
+		return;
+	}
+
+	uint32_t registers[19];
+	for(int c = 0; c < 8; ++c) {
+		registers[c] = data_[c].full;
+		registers[c + 8] = address_[c].full;
+	}
+	registers[16] = stack_pointers_[is_supervisor_ ^ 1].full;
+	registers[17] = get_status();
+	registers[18] = prefetch_queue_.full;
+
+	// If this is a revisit and the last iteration changed nothing, the next will be identical unless an
+	// event intervenes; so skip as many iterations as fit before the next event and the end of this run_for.
+	if(
+		program_counter == idle_loop_.program_counter &&
+		idle_loop_.is_clean &&
+		std::equal(std::begin(registers), std::end(registers), idle_loop_.registers)
+	) {
+		if constexpr (T::has_direct_pages) advance_direct_cycles();
+
+		HalfCycles limit = remaining_duration - cycles_run_for;
+		const HalfCycles time_until_event = bus_handler_.get_time_until_event();
+		if(time_until_event >= HalfCycles(0) && time_until_event <= limit) {
+			limit = time_until_event - HalfCycles(1);
+		}
+
+		const auto iterations = limit.as_integral() / loop_length.as_integral();
+		if(!pending_interrupt_level_ && bus_interrupt_level_ <= interrupt_level_ && iterations > 0) {
+			const HalfCycles skipped(loop_length.as_integral() * iterations);
+			cycles_run_for += skipped;
+			bus_handler_.skip_idle_time(skipped);
+		}
+	}
+
+	idle_loop_.program_counter = program_counter;
+	std::copy(std::begin(registers), std::end(registers), idle_loop_.registers);
+	idle_loop_.start = cycles_run_for;
+	idle_loop_.is_clean = true;
 }
 
 template <class T, bool dtack_is_implicit, bool signal_will_perform> ProcessorState Processor<T, dtack_is_implicit, signal_will_perform>::get_state() {
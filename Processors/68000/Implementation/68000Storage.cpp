@@ -14,6 +14,7 @@
 #include <map>
 #include <vector>
 #include <sstream>
+#include <type_traits>
 
 namespace CPU {
 namespace MC68000 {
@@ -32,7 +33,7 @@ namespace MC68000 {
 #define Imm		0x14
 
 struct ProcessorStorageConstructor {
-	ProcessorStorageConstructor(ProcessorStorage &storage) : storage_(storage) {}
+	ProcessorStorageConstructor(ProcessorStorage &storage, ProcessorStorage::Tables &tables) : storage_(storage), tables_(tables) {}
 
 	using BusStep = ProcessorStorage::BusStep;
 
@@ -470,7 +471,7 @@ struct ProcessorStorageConstructor {
 		Walks through the sequence of micro-ops beginning at @c start, replacing the value supplied for each write
 		encountered in each micro-op's bus steps with the respective value from @c values.
 	*/
-	void replace_write_values(ProcessorBase::MicroOp *start, const std::initializer_list<RegisterPair16 *> &values) {
+	void replace_write_values(const ProcessorBase::MicroOp *start, const std::initializer_list<RegisterPair16 *> &values) {
 		auto value = values.begin();
 		while(!start->is_terminal()) {
 			value = replace_write_values(&storage_.all_bus_steps_[start->bus_program], value);
@@ -829,7 +830,7 @@ struct ProcessorStorageConstructor {
 		// storage_.all_bus_steps_ at the end.
 //		BusStep arbitrary_base;
 
-#define op(...) 	storage_.all_micro_ops_.emplace_back(__VA_ARGS__)
+#define op(...) 	tables_.micro_ops.emplace_back(__VA_ARGS__)
 #define seq(...)	assemble_program(__VA_ARGS__)
 #define ea(n)		&storage_.effective_address_[n].full
 #define a(n)		&storage_.address_[n].full
@@ -845,7 +846,7 @@ struct ProcessorStorageConstructor {
 			for(const auto &mapping: mappings) {
 				if((instruction & mapping.mask) == mapping.value) {
 					auto operation = mapping.operation;
-					const auto micro_op_start = storage_.all_micro_ops_.size();
+					const auto micro_op_start = tables_.micro_ops.size();
 
 					// The following fields are used commonly enough to be worth pulling out here.
 					const int ea_register = instruction & 7;
@@ -3005,17 +3006,17 @@ struct ProcessorStorageConstructor {
 					}
 
 					// Add a terminating micro operation if necessary.
-					if(!storage_.all_micro_ops_.back().is_terminal()) {
-						storage_.all_micro_ops_.emplace_back();
+					if(!tables_.micro_ops.back().is_terminal()) {
+						tables_.micro_ops.emplace_back();
 					}
 
 					// Ensure that steps that weren't meant to look terminal aren't terminal; also check
 					// for improperly encoded address calculation-type actions.
-					for(auto index = micro_op_start; index < storage_.all_micro_ops_.size() - 1; ++index) {
+					for(auto index = micro_op_start; index < tables_.micro_ops.size() - 1; ++index) {
 
 #ifdef DEBUG
 						// All of the actions below must also nominate a source and/or destination.
-						switch(storage_.all_micro_ops_[index].action) {
+						switch(tables_.micro_ops[index].action) {
 							default: break;
 							case int(Action::CalcD16PC):
 							case int(Action::CalcD8PCXn):
@@ -3034,14 +3035,14 @@ struct ProcessorStorageConstructor {
 						}
 #endif
 
-						if(storage_.all_micro_ops_[index].is_terminal()) {
-							storage_.all_micro_ops_[index].bus_program = uint16_t(seq(""));
+						if(tables_.micro_ops[index].is_terminal()) {
+							tables_.micro_ops[index].bus_program = uint16_t(seq(""));
 						}
 					}
 
 					// Install the operation and make a note of where micro-ops begin.
 					program.operation = operation;
-					storage_.instructions[instruction] = program;
+					tables_.instructions[instruction] = program;
 					micro_op_pointers[size_t(instruction)] = size_t(micro_op_start);
 
 					// Don't search further through the list of possibilities, unless this is a debugging build,
@@ -3060,7 +3061,7 @@ struct ProcessorStorageConstructor {
 		}
 
 		// Throw in the interrupt program.
-		const auto interrupt_pointer = storage_.all_micro_ops_.size();
+		const auto interrupt_pointer = tables_.micro_ops.size();
 
 		// WORKAROUND FOR THE 68000 MAIN LOOP. Hopefully temporary.
 		op(Action::None, seq(""));
@@ -3113,21 +3114,22 @@ struct ProcessorStorageConstructor {
 		// Finalise micro-op and program pointers.
 		for(size_t instruction = 0; instruction < 65536; ++instruction) {
 			if(micro_op_pointers[instruction] != std::numeric_limits<size_t>::max()) {
-				storage_.instructions[instruction].micro_operations = uint32_t(micro_op_pointers[instruction]);
-//				link_operations(&storage_.all_micro_ops_[micro_op_pointers[instruction]], &arbitrary_base);
+				tables_.instructions[instruction].micro_operations = uint32_t(micro_op_pointers[instruction]);
+//				link_operations(&tables_.micro_ops[micro_op_pointers[instruction]], &arbitrary_base);
 			}
 		}
 
 		// Link up the interrupt micro ops.
-		storage_.interrupt_micro_ops_ = &storage_.all_micro_ops_[interrupt_pointer];
+		storage_.interrupt_micro_ops_ = &tables_.micro_ops[interrupt_pointer];
 //		link_operations(storage_.interrupt_micro_ops_, &arbitrary_base);
 
 		std::cout << storage_.all_bus_steps_.size() << " total bus steps" << std::endl;
-		std::cout << storage_.all_micro_ops_.size() << " total micro ops" << std::endl;
+		std::cout << tables_.micro_ops.size() << " total micro ops" << std::endl;
 	}
 
 	private:
 		ProcessorStorage &storage_;
+		ProcessorStorage::Tables &tables_;
 
 		std::initializer_list<RegisterPair16 *>::const_iterator replace_write_values(BusStep *start, std::initializer_list<RegisterPair16 *>::const_iterator value) {
 			while(!start->is_terminal()) {
@@ -3164,8 +3166,10 @@ struct ProcessorStorageConstructor {
 }
 }
 
-CPU::MC68000::ProcessorStorage::ProcessorStorage() {
-	ProcessorStorageConstructor constructor(*this);
+CPU::MC68000::ProcessorStorage::ProcessorStorage(Tables &tables) :
+	all_micro_ops_(tables.micro_ops),
+	instructions(tables.instructions) {
+	ProcessorStorageConstructor constructor(*this, tables);
 
 	// Create the special programs.
 	const size_t reset_offset = constructor.assemble_program("n n n n n nn nF nf nV nv np np");
@@ -3211,13 +3215,13 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 	);
 
 	// Chuck in the proper micro-ops for handling an exception.
-	const auto short_exception_offset = all_micro_ops_.size();
-	all_micro_ops_.emplace_back(ProcessorBase::MicroOp::Action::None);
-	all_micro_ops_.emplace_back();
+	const auto short_exception_offset = tables.micro_ops.size();
+	tables.micro_ops.emplace_back(ProcessorBase::MicroOp::Action::None);
+	tables.micro_ops.emplace_back();
 
-	const auto long_exception_offset = all_micro_ops_.size();
-	all_micro_ops_.emplace_back(ProcessorBase::MicroOp::Action::None);
-	all_micro_ops_.emplace_back();
+	const auto long_exception_offset = tables.micro_ops.size();
+	tables.micro_ops.emplace_back(ProcessorBase::MicroOp::Action::None);
+	tables.micro_ops.emplace_back();
 
 	// Install operations.
 //#ifndef NDEBUG
@@ -3276,15 +3280,66 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 		steps[4].microcycle.value = steps[5].microcycle.value = &program_counter_.halves.low;
 	}
 
-	// Setup the stop cycle.
-	stop_cycle_.length = HalfCycles(2);
-
 	// Complete linkage of the exception micro program.
+	tables.micro_ops[short_exception_offset].bus_program = uint16_t(trap_offset);
 	short_exception_micro_ops_ = &all_micro_ops_[short_exception_offset];
-	short_exception_micro_ops_->bus_program = uint16_t(trap_offset);
 
+	tables.micro_ops[long_exception_offset].bus_program = uint16_t(bus_error_offset);
 	long_exception_micro_ops_ = &all_micro_ops_[long_exception_offset];
-	long_exception_micro_ops_->bus_program = uint16_t(bus_error_offset);
+
+	reset_state();
+}
+
+const CPU::MC68000::ProcessorStorage &CPU::MC68000::ProcessorStorage::prototype() {
+	static Tables tables;
+	static const ProcessorStorage prototype(tables);
+	return prototype;
+}
+
+CPU::MC68000::ProcessorStorage::ProcessorStorage() :
+	all_bus_steps_(prototype().all_bus_steps_),
+	all_micro_ops_(prototype().all_micro_ops_),
+	instructions(prototype().instructions),
+	long_exception_micro_ops_(prototype().long_exception_micro_ops_),
+	short_exception_micro_ops_(prototype().short_exception_micro_ops_),
+	interrupt_micro_ops_(prototype().interrupt_micro_ops_) {
+	const ProcessorStorage &source = prototype();
+
+	// The prototype's bus steps refer to its own registers; repoint them to this instance's.
+	const auto relocate = [&source, this] (auto *&pointer) {
+		const auto offset = reinterpret_cast<const uint8_t *>(pointer) - reinterpret_cast<const uint8_t *>(&source);
+		if(pointer && offset >= 0 && size_t(offset) < sizeof(ProcessorStorage)) {
+			pointer = reinterpret_cast<std::remove_reference_t<decltype(pointer)>>(reinterpret_cast<uint8_t *>(this) + offset);
+		}
+	};
+	for(auto &step: all_bus_steps_) {
+		relocate(step.microcycle.address);
+		relocate(step.microcycle.value);
+	}
+
+	// Realise the special programs as pointers into this instance's bus steps.
+	const auto step = [&source, this] (BusStep *pointer) {
+		return &all_bus_steps_[size_t(pointer - source.all_bus_steps_.data())];
+	};
+	reset_bus_steps_ = step(source.reset_bus_steps_);
+	branch_taken_bus_steps_ = step(source.branch_taken_bus_steps_);
+	branch_byte_not_taken_bus_steps_ = step(source.branch_byte_not_taken_bus_steps_);
+	branch_word_not_taken_bus_steps_ = step(source.branch_word_not_taken_bus_steps_);
+	bsr_bus_steps_ = step(source.bsr_bus_steps_);
+	dbcc_condition_true_steps_ = step(source.dbcc_condition_true_steps_);
+	dbcc_condition_false_no_branch_steps_ = step(source.dbcc_condition_false_no_branch_steps_);
+	dbcc_condition_false_branch_steps_ = step(source.dbcc_condition_false_branch_steps_);
+	movem_read_steps_ = step(source.movem_read_steps_);
+	movem_write_steps_ = step(source.movem_write_steps_);
+	trap_steps_ = step(source.trap_steps_);
+	bus_error_steps_ = step(source.bus_error_steps_);
+
+	reset_state();
+}
+
+void CPU::MC68000::ProcessorStorage::reset_state() {
+	// Setup the stop cycle.
+	stop_cycle_.length = HalfCycles(2);
 
 	// Set initial state.
 	active_step_ = reset_bus_steps_;
@@ -3306,3 +3361,128 @@ void CPU::MC68000::ProcessorStorage::set_is_supervisor(bool is_supervisor) {
 		address_[7] = stack_pointers_[is_supervisor_];
 	}
 }
+
+// MARK: - Snapshots.
+
+namespace {
+
+constexpr uint32_t NoPointer = std::numeric_limits<uint32_t>::max();
+
+/// @returns The offset of @c pointer from @c base, or @c NoPointer if @c pointer is @c nullptr.
+uint32_t offset_of(const void *base, const void *pointer) {
+	if(!pointer) return NoPointer;
+	return uint32_t(reinterpret_cast<const uint8_t *>(pointer) - reinterpret_cast<const uint8_t *>(base));
+}
+
+/// @returns The index of @c pointer within @c vector, or @c NoPointer if @c pointer is @c nullptr.
+template <typename T> uint32_t index_of(const std::vector<T> &vector, const T *pointer) {
+	if(!pointer) return NoPointer;
+	return uint32_t(pointer - vector.data());
+}
+
+/// Sets @c pointer to the @c index th element of @c vector, or to @c nullptr if @c index is @c NoPointer; @returns @c false if @c index is invalid.
+template <typename VectorT, typename T> bool set_index(VectorT &vector, T *&pointer, uint32_t index) {
+	if(index == NoPointer) {
+		pointer = nullptr;
+		return true;
+	}
+	if(index >= vector.size()) return false;
+	pointer = &vector[index];
+	return true;
+}
+
+}
+
+void CPU::MC68000::ProcessorStorage::save_microcycle(Storage::Snapshot::Writer &writer, const Microcycle &cycle) const {
+	writer.put(cycle.operation, cycle.length, offset_of(this, cycle.address), offset_of(this, cycle.value));
+}
+
+bool CPU::MC68000::ProcessorStorage::restore_microcycle(Storage::Snapshot::Reader &reader, Microcycle &cycle) {
+	uint32_t address, value;
+	if(!reader.get(cycle.operation, cycle.length, address, value)) return false;
+
+	// All addresses and values are members of this class; permit nothing else.
+	if(address != NoPointer && address > sizeof(*this) - sizeof(*cycle.address)) return false;
+	if(value != NoPointer && value > sizeof(*this) - sizeof(*cycle.value)) return false;
+
+	uint8_t *const base = reinterpret_cast<uint8_t *>(this);
+	cycle.address = (address == NoPointer) ? nullptr : reinterpret_cast<const uint32_t *>(base + address);
+	cycle.value = (value == NoPointer) ? nullptr : reinterpret_cast<RegisterPair16 *>(base + value);
+	return true;
+}
+
+void CPU::MC68000::ProcessorStorage::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("6800", 1);
+
+	writer.put(data_, address_, program_counter_, stack_pointers_, prefetch_queue_);
+	writer.put(execution_state_);
+	save_microcycle(writer, dtack_cycle_);
+	save_microcycle(writer, stop_cycle_);
+
+	writer.put(is_supervisor_, interrupt_level_);
+	writer.put(zero_result_, carry_flag_, extend_flag_, overflow_flag_, negative_flag_, trace_flag_, last_trace_flag_);
+	writer.put(bus_interrupt_level_, dtack_, is_peripheral_address_, bus_error_, bus_request_, bus_acknowledge_, halt_);
+	writer.put(pending_interrupt_level_, accepted_interrupt_level_, is_starting_interrupt_);
+	writer.put(effective_address_, source_bus_data_, destination_bus_data_);
+	writer.put(half_cycles_left_to_run_, e_clock_phase_);
+	writer.put(dbcc_false_address_, decoded_instruction_, next_word_);
+	writer.put(precomputed_addresses_, throwaway_value_, movem_final_address_);
+
+	// Record the program, micro-op and bus step in progress by index.
+	writer.put(
+		active_program_ ? uint32_t(active_program_ - instructions) : NoPointer,
+		index_of(all_micro_ops_, active_micro_op_),
+		index_of(all_bus_steps_, active_step_));
+
+	// Bus steps are adjusted as instructions run — e.g. MOVEM fills in addresses and targets,
+	// and exceptions alter their timing — so record each step's microcycle.
+	writer.put(uint32_t(all_bus_steps_.size()));
+	for(const auto &step: all_bus_steps_) {
+		save_microcycle(writer, step.microcycle);
+	}
+
+	writer.end();
+}
+
+bool CPU::MC68000::ProcessorStorage::restore_state(Storage::Snapshot::Reader &reader) {
+	if(!reader.begin("6800", 1)) return false;
+
+	reader.get(data_, address_, program_counter_, stack_pointers_, prefetch_queue_);
+	reader.get(execution_state_);
+	restore_microcycle(reader, dtack_cycle_);
+	restore_microcycle(reader, stop_cycle_);
+
+	reader.get(is_supervisor_, interrupt_level_);
+	reader.get(zero_result_, carry_flag_, extend_flag_, overflow_flag_, negative_flag_, trace_flag_, last_trace_flag_);
+	reader.get(bus_interrupt_level_, dtack_, is_peripheral_address_, bus_error_, bus_request_, bus_acknowledge_, halt_);
+	reader.get(pending_interrupt_level_, accepted_interrupt_level_, is_starting_interrupt_);
+	reader.get(effective_address_, source_bus_data_, destination_bus_data_);
+	reader.get(half_cycles_left_to_run_, e_clock_phase_);
+	reader.get(dbcc_false_address_, decoded_instruction_, next_word_);
+	reader.get(precomputed_addresses_, throwaway_value_, movem_final_address_);
+
+	uint32_t program, micro_op, step, step_count;
+	if(!reader.get(program, micro_op, step, step_count)) return false;
+
+	if(program == NoPointer) {
+		active_program_ = nullptr;
+	} else if(program < sizeof(Tables::instructions) / sizeof(Program)) {
+		active_program_ = &instructions[program];
+	} else {
+		return false;
+	}
+	if(
+		!set_index(all_micro_ops_, active_micro_op_, micro_op) ||
+		!set_index(all_bus_steps_, active_step_, step) ||
+		step_count != all_bus_steps_.size()
+	) {
+		return false;
+	}
+
+	for(auto &bus_step: all_bus_steps_) {
+		if(!restore_microcycle(reader, bus_step.microcycle)) return false;
+	}
+	idle_loop_.is_clean = false;
+
+	return reader.end();
+}
@@ -13,6 +13,19 @@ class ProcessorStorage {
 	public:
 		ProcessorStorage();
 
+		/*!
+			Appends the processor's complete state to @c writer; this may be called at any
+			point between calls to @c run_for.
+		*/
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/*!
+			Restores state previously captured by @c save_state.
+
+			@returns @c true if state was restored; @c false otherwise.
+		*/
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	protected:
 		RegisterPair32 data_[8];
 		RegisterPair32 address_[8];
@@ -81,6 +94,17 @@ class ProcessorStorage {
 		HalfCycles half_cycles_left_to_run_;
 		HalfCycles e_clock_phase_;
 
+		// The most recent visit to the address that is currently a candidate for the top of an idle loop:
+		// the registers, status and prefetch queue then, the time then relative to the start of the current
+		// run_for, and whether anything has happened since that would prevent the loop from being skipped.
+		// See BusHandler::skips_idle_loops.
+		struct IdleLoop {
+			uint32_t program_counter = 0;
+			uint32_t registers[19]{};
+			HalfCycles start;
+			bool is_clean = false;
+		} idle_loop_;
+
 		enum class Operation: uint8_t {
 			None,
 			ABCD,	SBCD,	NBCD,
@@ -410,19 +434,28 @@ class ProcessorStorage {
 			}
 		};
 
+		/*!
+			Micro-ops and the lookup table from instructions to implementations are the same for
+			every instance, so they are built once per process and thereafter shared, read-only.
+		*/
+		struct Tables {
+			std::vector<MicroOp> micro_ops;
+			Program instructions[65536];
+		};
+
 		// Storage for all the sequences of bus steps and micro-ops used throughout
-		// the 68000.
+		// the 68000. Bus steps are adjusted at runtime, so each instance has its own.
 		std::vector<BusStep> all_bus_steps_;
-		std::vector<MicroOp> all_micro_ops_;
+		const std::vector<MicroOp> &all_micro_ops_;
 
 		// A lookup table from instructions to implementations.
-		Program instructions[65536];
+		const Program *const instructions;
 
 		// Special steps and programs for exception handlers.
 		BusStep *reset_bus_steps_;
-		MicroOp *long_exception_micro_ops_;		// i.e. those that leave 14 bytes on the stack — bus error and address error.
-		MicroOp *short_exception_micro_ops_;	// i.e. those that leave 6 bytes on the stack — everything else (other than interrupts).
-		MicroOp *interrupt_micro_ops_;
+		const MicroOp *long_exception_micro_ops_;	// i.e. those that leave 14 bytes on the stack — bus error and address error.
+		const MicroOp *short_exception_micro_ops_;	// i.e. those that leave 6 bytes on the stack — everything else (other than interrupts).
+		const MicroOp *interrupt_micro_ops_;
 
 		// Special micro-op sequences and storage for conditionals.
 		BusStep *branch_taken_bus_steps_;
@@ -442,8 +475,8 @@ class ProcessorStorage {
 		BusStep *bus_error_steps_;
 
 		// Current bus step pointer, and outer program pointer.
-		Program *active_program_ = nullptr;
-		MicroOp *active_micro_op_ = nullptr;
+		const Program *active_program_ = nullptr;
+		const MicroOp *active_micro_op_ = nullptr;
 		BusStep *active_step_ = nullptr;
 		RegisterPair16 decoded_instruction_ = 0;
 		uint16_t next_word_ = 0;
@@ -540,6 +573,19 @@ class ProcessorStorage {
 		}
 
 	private:
+		/// Builds @c tables, and this instance's bus steps to match.
+		ProcessorStorage(Tables &tables);
+
+		/// @returns The instance that built the shared tables, from which all others copy their bus steps.
+		static const ProcessorStorage &prototype();
+
+		/// Sets the initial state, other than that which is derived from the prototype.
+		void reset_state();
+
+		// Microcycles hold pointers into this class; these convert them to and from offsets for snapshots.
+		void save_microcycle(Storage::Snapshot::Writer &writer, const Microcycle &cycle) const;
+		bool restore_microcycle(Storage::Snapshot::Reader &reader, Microcycle &cycle);
+
 		friend class ProcessorStorageConstructor;
 		friend class ProcessorStorageTests;
 };
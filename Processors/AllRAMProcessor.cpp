@@ -8,12 +8,16 @@
 
 #include "AllRAMProcessor.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace CPU;
 
 AllRAMProcessor::AllRAMProcessor(std::size_t memory_size) :
 	memory_(memory_size),
+	timestamp_(0),
 	traps_(memory_size, false),
-	timestamp_(0) {}
+	trapped_pages_((memory_size + 255) >> 8, false) {}
 
 void AllRAMProcessor::set_data_at_address(uint16_t startAddress, std::size_t length, const uint8_t *data) {
 	std::size_t endAddress = std::min(startAddress + length, static_cast<std::size_t>(65536));
@@ -35,4 +39,5 @@ void AllRAMProcessor::set_trap_handler(TrapHandler *trap_handler) {
 
 void AllRAMProcessor::add_trap_address(uint16_t address) {
 	traps_[address] = true;
+	trapped_pages_[address >> 8] = true;
 }
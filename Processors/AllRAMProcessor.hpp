@@ -41,9 +41,15 @@ class AllRAMProcessor {
 			}
 		}
 
+		/// @returns A pointer to the 256-byte page @c page of memory if it contains no trap addresses; @c nullptr otherwise.
+		inline uint8_t *untrapped_page(int page) {
+			return trapped_pages_[std::size_t(page)] ? nullptr : &memory_[std::size_t(page) << 8];
+		}
+
 	private:
 		TrapHandler *trap_handler_;
 		std::vector<bool> traps_;
+		std::vector<bool> trapped_pages_;
 };
 
 }
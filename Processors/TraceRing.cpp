@@ -0,0 +1,85 @@
+//
+//  TraceRing.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "TraceRing.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace CPU;
+
+namespace {
+
+constexpr std::size_t DefaultCapacity = 16384;
+
+template <typename IntT> void put(std::vector<uint8_t> &buffer, IntT value) {
+	for(std::size_t c = 0; c < sizeof(IntT); ++c) {
+		buffer.push_back(uint8_t(value >> (c * 8)));
+	}
+}
+
+}
+
+TraceRing &TraceRing::current() {
+	thread_local TraceRing ring;
+	return ring;
+}
+
+TraceRing::TraceRing() : write_index_(0) {
+	set_capacity(DefaultCapacity);
+}
+
+void TraceRing::set_capacity(std::size_t capacity) {
+	std::size_t size = 1;
+	while(size < capacity) size <<= 1;
+
+	headers_.resize(size);
+	registers_.resize(size);
+	mask_ = size - 1;
+	clear();
+}
+
+void TraceRing::clear() {
+	write_index_.store(0, std::memory_order_release);
+}
+
+uint64_t TraceRing::count() const {
+	return write_index_.load(std::memory_order_acquire);
+}
+
+std::vector<TraceRing::Record> TraceRing::records(uint64_t begin) const {
+	const uint64_t end = write_index_.load(std::memory_order_acquire);
+	begin = std::min(std::max(begin, end - std::min(end, uint64_t(headers_.size()))), end);
+
+	std::vector<Record> result(std::size_t(end - begin));
+	for(uint64_t index = begin; index < end; ++index) {
+		Record &record = result[std::size_t(index - begin)];
+		static_cast<Header &>(record) = headers_[index & mask_];
+		std::copy(registers_[index & mask_].begin(), registers_[index & mask_].begin() + std::min(std::size_t(record.register_count), MaxRegisters), record.registers);
+	}
+	return result;
+}
+
+bool TraceRing::dump(const std::string &file_name) const {
+	std::vector<uint8_t> buffer = {'C', 'L', 'K', 'T', 'R', 'A', 'C', 'E'};
+	for(const auto &record: records()) {
+		put(buffer, record.time);
+		put(buffer, record.program_counter);
+		put(buffer, record.opcode);
+		put(buffer, uint8_t(record.source));
+		put(buffer, record.register_count);
+		for(uint8_t c = 0; c < record.register_count; ++c) {
+			put(buffer, record.registers[c]);
+		}
+	}
+
+	FILE *const file = std::fopen(file_name.c_str(), "wb");
+	if(!file) return false;
+	const bool did_write = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+	return (std::fclose(file) == 0) && did_write;
+}
@@ -0,0 +1,114 @@
+//
+//  TraceRing.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef TraceRing_hpp
+#define TraceRing_hpp
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../ClockReceiver/ForceInline.hpp"
+
+namespace CPU {
+
+/*!
+	A trace ring retains the most recent instructions begun by any processor whose bus handler
+	declares @c traces_execution as @c true, each with the number of cycles it had run for when it
+	decoded that instruction and, if its bus handler also declares @c traces_registers as @c true,
+	the processor's registers.
+
+	Each thread has its own ring, obtained via TraceRing::current(), so recording needs no locks;
+	a ring can be read or dumped by its own thread at any time, or by another while its owner is
+	between calls to a processor's run_for.
+*/
+class TraceRing {
+	public:
+		enum class Source: uint8_t {
+			MOS6502, Z80, MC68000
+		};
+
+		/// The fixed part of a record, which is all that is stored for a record without registers.
+		struct Header {
+			/// The number of cycles this processor had run for when it decoded this instruction.
+			uint64_t time;
+			uint32_t program_counter;
+			uint16_t opcode;
+			Source source;
+
+			/// The number of entries in @c Record::registers that are meaningful; their order depends on @c source:
+			///
+			///	* MOS6502: A, X, Y, S, P;
+			///	* Z80: AF, BC, DE, HL, IX, IY, SP, AF', BC', DE', HL';
+			///	* MC68000: D0–D7, A0–A7, SR; A7 being the active stack pointer.
+			uint8_t register_count;
+		};
+
+		static constexpr std::size_t MaxRegisters = 17;
+
+		struct Record: public Header {
+			uint32_t registers[MaxRegisters];
+		};
+
+		/// @returns The calling thread's trace ring.
+		static TraceRing &current();
+
+		/// Discards all records and sets the number retained to @c capacity, which is rounded up to a power of two.
+		void set_capacity(std::size_t capacity);
+
+		/// Discards all records.
+		void clear();
+
+		/// @returns The total number of records ever retained, which is also the index that the next will have.
+		uint64_t count() const;
+
+		/// @returns All records currently retained with indices of at least @c begin, oldest first.
+		std::vector<Record> records(uint64_t begin = 0) const;
+
+		/*!
+			Writes all records currently retained, oldest first, to @c file_name: an eight-byte
+			signature "CLKTRACE" is followed by each record in turn as its fields in declaration order,
+			in little-endian form and without padding, with only the first @c register_count registers.
+
+			@returns @c true on success; @c false otherwise.
+		*/
+		bool dump(const std::string &file_name) const;
+
+		/*!
+			Obtains a record to fill in; it is retained only once @c end_record is called. Registers are
+			stored separately, via @c record_registers, so that records without them stay small.
+		*/
+		forceinline Header &begin_record() {
+			return headers_[write_index_.load(std::memory_order_relaxed) & mask_];
+		}
+
+		/// @returns Storage for the registers of the record most recently obtained via @c begin_record.
+		forceinline uint32_t *record_registers() {
+			return registers_[write_index_.load(std::memory_order_relaxed) & mask_].data();
+		}
+
+		/// Retains the record most recently obtained via @c begin_record.
+		forceinline void end_record() {
+			write_index_.store(write_index_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+	private:
+		TraceRing();
+
+		std::vector<Header> headers_;
+		std::vector<std::array<uint32_t, MaxRegisters>> registers_;
+		std::size_t mask_ = 0;
+		std::atomic<uint64_t> write_index_;
+};
+
+}
+
+#endif /* TraceRing_hpp */
@@ -62,6 +62,21 @@ class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
 			return HalfCycles(0);
 		}
 
+		// If there is no delegate, pages without traps are accessed directly by the Z80.
+		static constexpr bool has_direct_pages = true;
+		uint8_t *direct_read_page(int page) {
+			return delegate_ ? nullptr : untrapped_page(page);
+		}
+		uint8_t *direct_write_page(int page) {
+			return delegate_ ? nullptr : &memory_[size_t(page) << 8];
+		}
+		bool direct_internal_cycles() {
+			return !delegate_;
+		}
+		void advance(HalfCycles duration) {
+			timestamp_ += duration;
+		}
+
 		void run_for(const Cycles cycles) {
 			z80_.run_for(cycles);
 		}
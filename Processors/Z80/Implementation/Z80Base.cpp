@@ -8,6 +8,8 @@
 
 #include "../Z80.hpp"
 
+#include <algorithm>
+
 using namespace CPU::Z80;
 
 void ProcessorBase::reset_power_on() {
@@ -119,3 +121,109 @@ void ProcessorBase::set_value_of_register(Register r, uint16_t value) {
 		default: break;
 	}
 }
+
+// MARK: - Snapshots.
+
+ProcessorBase::PageList ProcessorBase::pages() const {
+	return PageList{{
+		&base_page_, &ed_page_, &fd_page_, &dd_page_,
+		&cb_page_, &fdcb_page_, &ddcb_page_,
+	}};
+}
+
+ProcessorBase::ProgramList ProcessorBase::programs() const {
+	ProgramList result;
+	auto program = result.begin();
+
+	for(const auto source: {
+		&conditional_call_untaken_program_,
+		&reset_program_,
+		&irq_program_[0], &irq_program_[1], &irq_program_[2],
+		&nmi_program_,
+	}) {
+		*program = std::make_pair(source->data, source->size);
+		++program;
+	}
+
+	for(const auto page: pages()) {
+		*program = std::make_pair(page->all_operations.data, page->all_operations.size);
+		++program;
+		*program = std::make_pair(page->fetch_decode_execute.data, page->fetch_decode_execute.size);
+		++program;
+	}
+
+	return result;
+}
+
+void ProcessorBase::save_state(Storage::Snapshot::Writer &writer) const {
+	writer.begin("Z80 ", 1);
+
+	writer.put(a_, bc_, de_, hl_, afDash_, bcDash_, deDash_, hlDash_);
+	writer.put(ix_, iy_, pc_, sp_, ir_, refresh_addr_);
+	writer.put(iff1_, iff2_, interrupt_mode_, pc_increment_);
+	writer.put(sign_result_, zero_result_, half_carry_result_, bit53_result_, parity_overflow_flag(), subtract_flag_, carry_result_);
+	writer.put(halt_mask_, flag_adjustment_history_, number_of_cycles_);
+	writer.put(request_status_, last_request_status_, irq_line_, nmi_line_, bus_request_line_, wait_line_);
+	writer.put(operation_, temp16_, memptr_, temp8_);
+
+	// Record the current program as an index into programs() plus an offset, with
+	// index -1 meaning none, and the current page as an index into pages().
+	int32_t program = -1, program_offset = 0;
+	if(scheduled_program_counter_) {
+		const auto all_programs = programs();
+		for(std::size_t c = 0; c < all_programs.size(); ++c) {
+			if(
+				scheduled_program_counter_ >= all_programs[c].first &&
+				scheduled_program_counter_ < all_programs[c].first + all_programs[c].second
+			) {
+				program = int32_t(c);
+				program_offset = int32_t(scheduled_program_counter_ - all_programs[c].first);
+				break;
+			}
+		}
+	}
+	writer.put(program, program_offset);
+
+	const auto all_pages = pages();
+	writer.put(uint8_t(std::find(all_pages.begin(), all_pages.end(), current_instruction_page_) - all_pages.begin()));
+
+	writer.end();
+}
+
+bool ProcessorBase::restore_state(Storage::Snapshot::Reader &reader) {
+	if(!reader.begin("Z80 ", 1)) return false;
+
+	reader.get(a_, bc_, de_, hl_, afDash_, bcDash_, deDash_, hlDash_);
+	reader.get(ix_, iy_, pc_, sp_, ir_, refresh_addr_);
+	reader.get(iff1_, iff2_, interrupt_mode_, pc_increment_);
+	uint8_t parity_overflow_result = 0;
+	reader.get(sign_result_, zero_result_, half_carry_result_, bit53_result_, parity_overflow_result, subtract_flag_, carry_result_);
+	parity_overflow_result_ = parity_overflow_result;
+	reader.get(halt_mask_, flag_adjustment_history_, number_of_cycles_);
+	reader.get(request_status_, last_request_status_, irq_line_, nmi_line_, bus_request_line_, wait_line_);
+	reader.get(operation_, temp16_, memptr_, temp8_);
+
+	int32_t program, program_offset;
+	uint8_t page;
+	if(!reader.get(program, program_offset, page)) return false;
+
+	const auto all_programs = programs();
+	if(program < 0) {
+		scheduled_program_counter_ = nullptr;
+	} else if(
+		size_t(program) < all_programs.size() &&
+		program_offset >= 0 &&
+		size_t(program_offset) < all_programs[size_t(program)].second
+	) {
+		scheduled_program_counter_ = all_programs[size_t(program)].first + program_offset;
+	} else {
+		return false;
+	}
+
+	const auto all_pages = pages();
+	if(page >= all_pages.size() || interrupt_mode_ < 0 || interrupt_mode_ > 2) return false;
+	current_instruction_page_ = all_pages[page];
+	idle_loop_.is_clean = false;
+
+	return reader.end();
+}
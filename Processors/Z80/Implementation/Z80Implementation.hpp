@@ -10,32 +10,44 @@ template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> Processor <T, uses_bus_request, uses_wait_line>
 				::Processor(T &bus_handler) :
-					bus_handler_(bus_handler) {
-	install_default_instruction_set();
-}
+					ProcessorBase(uses_wait_line),
+					bus_handler_(bus_handler) {}
 
 template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
 				::run_for(const HalfCycles cycles) {
 #define advance_operation() \
+	if constexpr (uses_direct_pages) advance_direct_cycles();	\
 	pc_increment_ = 1;	\
 	if(last_request_status_) {	\
 		halt_mask_ = 0xff;	\
 		if(last_request_status_ & (Interrupt::PowerOn | Interrupt::Reset)) {	\
 			request_status_ &= ~Interrupt::PowerOn;	\
-			scheduled_program_counter_ = reset_program_.data();	\
+			scheduled_program_counter_ = reset_program_.data;	\
 		} else if(last_request_status_ & Interrupt::NMI) {	\
 			request_status_ &= ~Interrupt::NMI;	\
-			scheduled_program_counter_ = nmi_program_.data();	\
+			scheduled_program_counter_ = nmi_program_.data;	\
 		} else if(last_request_status_ & Interrupt::IRQ) {	\
-			scheduled_program_counter_ = irq_program_[interrupt_mode_].data();	\
+			scheduled_program_counter_ = irq_program_[interrupt_mode_].data;	\
 		}	\
 	} else {	\
 		current_instruction_page_ = &base_page_;	\
-		scheduled_program_counter_ = base_page_.fetch_decode_execute_data;	\
+		scheduled_program_counter_ = base_page_.fetch_decode_execute.data;	\
 	}
 
+	// Accesses to the bus handler's direct pages, if any, are performed without involving the bus handler
+	// until advance_direct_cycles is called, so the interrupt requests that they sample may be stale until then.
+	constexpr bool uses_direct_pages = T::has_direct_pages && !uses_bus_request;
+
+	// If execution is being traced, records go to the ring of whichever thread is running the Z80.
+	TraceRing *const trace_ring = T::traces_execution ? &TraceRing::current() : nullptr;
+	if constexpr (T::traces_execution) traced_half_cycles_ += uint64_t(cycles.as_integral());
+
+	// Idle loops may be skipped only if nothing other than the bus handler's events can alter their course.
+	constexpr bool skips_idle_loops = T::skips_idle_loops && !uses_bus_request && !uses_wait_line;
+	if constexpr (skips_idle_loops) idle_loop_.start += cycles;
+
 	number_of_cycles_ += cycles;
 	if(!scheduled_program_counter_) {
 		advance_operation();
@@ -48,6 +60,7 @@ template <	class T,
 			static PartialMachineCycle bus_acknowledge_cycle = {PartialMachineCycle::BusAcknowledge, HalfCycles(2), nullptr, nullptr, false};
 			number_of_cycles_ -= bus_handler_.perform_machine_cycle(bus_acknowledge_cycle) + HalfCycles(1);
 			if(!number_of_cycles_) {
+				if constexpr (uses_direct_pages) advance_direct_cycles();
 				bus_handler_.flush();
 				return;
 			}
@@ -61,15 +74,13 @@ template <	class T,
 	flag_adjustment_history_ |= 1;
 
 #define set_parity(v)	\
-	parity_overflow_result_ = static_cast<uint8_t>(v^1);\
-	parity_overflow_result_ ^= parity_overflow_result_ >> 4;\
-	parity_overflow_result_ ^= parity_overflow_result_ << 2;\
-	parity_overflow_result_ ^= parity_overflow_result_ >> 1;
+	parity_overflow_result_ = uint16_t(0x100 | static_cast<uint8_t>(v));
 
 			switch(operation->type) {
 				case MicroOp::BusOperation:
 					if(number_of_cycles_ < operation->machine_cycle.length) {
 						scheduled_program_counter_--;
+						if constexpr (uses_direct_pages) advance_direct_cycles();
 						bus_handler_.flush();
 						return;
 					}
@@ -82,6 +93,27 @@ template <	class T,
 					}
 					number_of_cycles_ -= operation->machine_cycle.length;
 					last_request_status_ = request_status_;
+					if constexpr (skips_idle_loops) {
+						switch(operation->machine_cycle.operation) {
+							case PartialMachineCycle::Write:
+							case PartialMachineCycle::Output:
+							case PartialMachineCycle::Interrupt:
+								idle_loop_.is_clean = false;
+							break;
+							default: break;
+						}
+					}
+					if constexpr (uses_direct_pages) {
+						// Requested wait cycles are always announced, so that the bus handler can observe and release WAIT.
+						if(!(uses_wait_line && operation->machine_cycle.was_requested) && perform_direct_machine_cycle(operation->machine_cycle)) {
+							direct_cycles_ += operation->machine_cycle.length;
+							last_direct_cycle_length_ = operation->machine_cycle.length;
+							last_direct_cycle_iff1_ = iff1_;
+							break;
+						}
+						advance_direct_cycles();
+						last_request_status_ = request_status_;
+					}
 					number_of_cycles_ -= bus_handler_.perform_machine_cycle(operation->machine_cycle);
 					if(uses_bus_request && bus_request_line_) goto do_bus_acknowledge;
 				break;
@@ -89,6 +121,36 @@ template <	class T,
 					advance_operation();
 				break;
 				case MicroOp::DecodeOperation:
+					if constexpr (T::traces_execution) {
+						if(current_instruction_page_ == &base_page_) {
+							auto &record = trace_ring->begin_record();
+							record.time = (traced_half_cycles_ - uint64_t(number_of_cycles_.as_integral())) >> 1;
+							record.program_counter = pc_.full;
+							record.opcode = operation_;
+							record.source = TraceRing::Source::Z80;
+							if constexpr (T::traces_registers) {
+								uint32_t *const registers = trace_ring->record_registers();
+								record.register_count = 11;
+								registers[0] = uint32_t((a_ << 8) | get_flags());
+								registers[1] = bc_.full;
+								registers[2] = de_.full;
+								registers[3] = hl_.full;
+								registers[4] = ix_.full;
+								registers[5] = iy_.full;
+								registers[6] = sp_.full;
+								registers[7] = afDash_.full;
+								registers[8] = bcDash_.full;
+								registers[9] = deDash_.full;
+								registers[10] = hlDash_.full;
+							} else {
+								record.register_count = 0;
+							}
+							trace_ring->end_record();
+						}
+					}
+					if constexpr (skips_idle_loops) {
+						if(current_instruction_page_ == &base_page_) test_idle_loop();
+					}
 					refresh_addr_ = ir_;
 					ir_.halves.low = (ir_.halves.low & 0x80) | ((ir_.halves.low + current_instruction_page_->r_step) & 0x7f);
 					pc_.full += pc_increment_ & static_cast<uint16_t>(halt_mask_);
@@ -440,8 +502,8 @@ template <	class T,
 				case MicroOp::TestZ:	if(zero_result_)								{ decline_conditional(); }		break;
 				case MicroOp::TestNC:	if(carry_result_ & Flag::Carry)					{ decline_conditional(); }		break;
 				case MicroOp::TestC:	if(!(carry_result_ & Flag::Carry))				{ decline_conditional(); }		break;
-				case MicroOp::TestPO:	if(parity_overflow_result_ & Flag::Parity)		{ decline_conditional(); }		break;
-				case MicroOp::TestPE:	if(!(parity_overflow_result_ & Flag::Parity))	{ decline_conditional(); }		break;
+				case MicroOp::TestPO:	if(parity_overflow_flag())						{ decline_conditional(); }		break;
+				case MicroOp::TestPE:	if(!parity_overflow_flag())						{ decline_conditional(); }		break;
 				case MicroOp::TestP:	if(sign_result_ & Flag::Sign)					{ decline_conditional(); }		break;
 				case MicroOp::TestM:	if(!(sign_result_ & Flag::Sign))				{ decline_conditional(); }		break;
 
@@ -861,8 +923,8 @@ template <	class T,
 // MARK: - Internal bookkeeping
 
 				case MicroOp::SetInstructionPage:
-					current_instruction_page_ = (InstructionPage *)operation->source;
-					scheduled_program_counter_ = current_instruction_page_->fetch_decode_execute_data;
+					current_instruction_page_ = static_cast<const InstructionPage *>(operation->source);
+					scheduled_program_counter_ = current_instruction_page_->fetch_decode_execute.data;
 				break;
 
 				case MicroOp::CalculateIndexAddress:
@@ -882,122 +944,143 @@ template <	class T,
 	}
 }
 
-template <	class T,
-			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
-				::set_bus_request_line(bool value) {
-	assert(uses_bus_request);
-	bus_request_line_ = value;
-}
-
 template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> bool Processor <T, uses_bus_request, uses_wait_line>
-				::get_bus_request_line() {
-	return bus_request_line_;
+				::perform_direct_machine_cycle(const PartialMachineCycle &cycle) {
+	// Operations are tested in approximate order of frequency: reads, including opcode fetches, then writes,
+	// then the refresh and internal cycles, then the partial cycles that lead into reads and writes.
+	const auto operation = cycle.operation;
+	if(operation == PartialMachineCycle::ReadOpcode || operation == PartialMachineCycle::Read) {
+		uint8_t *const page = bus_handler_.direct_read_page(*cycle.address >> 8);
+		if(!page) return false;
+		*cycle.value = page[*cycle.address & 0xff];
+		return true;
+	}
+	if(operation == PartialMachineCycle::Write) {
+		uint8_t *const page = bus_handler_.direct_write_page(*cycle.address >> 8);
+		if(!page) return false;
+		page[*cycle.address & 0xff] = *cycle.value;
+		return true;
+	}
+	if(operation == PartialMachineCycle::Refresh || operation == PartialMachineCycle::Internal) {
+		return bus_handler_.direct_internal_cycles();
+	}
+	if(
+		operation == PartialMachineCycle::ReadOpcodeStart || operation == PartialMachineCycle::ReadStart ||
+		operation == PartialMachineCycle::ReadOpcodeWait || operation == PartialMachineCycle::ReadWait
+	) {
+		return bus_handler_.direct_read_page(*cycle.address >> 8);
+	}
+	if(operation == PartialMachineCycle::WriteStart || operation == PartialMachineCycle::WriteWait) {
+		return bus_handler_.direct_write_page(*cycle.address >> 8);
+	}
+	return false;
 }
 
 template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
-				::set_wait_line(bool value) {
-	assert(uses_wait_line);
-	wait_line_ = value;
-}
+				::advance_direct_cycles() {
+	if(!direct_cycles_) return;
+
+	// Interrupt requests were last sampled at the start of the most recent direct cycle; so advance the bus
+	// handler to that point, sample again and then advance it to now. Whether a maskable interrupt is requested
+	// is subject to IFF1 as it was then, in case it has been changed by an EI or DI since.
+	if(direct_cycles_ > last_direct_cycle_length_) {
+		bus_handler_.advance(direct_cycles_ - last_direct_cycle_length_);
+	}
+	last_request_status_ =
+		(request_status_ & ~Interrupt::IRQ) |
+		((irq_line_ && last_direct_cycle_iff1_) ? Interrupt::IRQ : 0);
+	bus_handler_.advance(last_direct_cycle_length_);
 
-template <	class T,
-			bool uses_bus_request,
-			bool uses_wait_line> bool Processor <T, uses_bus_request, uses_wait_line>
-				::get_wait_line() {
-	return wait_line_;
+	direct_cycles_ = 0;
 }
 
-#define isTerminal(n)	(n == MicroOp::MoveToNextProgram || n == MicroOp::DecodeOperation || n == MicroOp::DecodeOperationNoRChange)
-
 template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
-				::assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) {
-	std::size_t number_of_micro_ops = 0;
-	std::size_t lengths[256];
-
-	// Count number of micro-ops required.
-	for(int c = 0; c < 256; c++) {
-		std::size_t length = 0;
-		while(!isTerminal(table[c][length].type)) length++;
-		length++;
-		lengths[c] = length;
-		number_of_micro_ops += length;
+				::test_idle_loop() {
+	// Loops that take longer than this are not detected.
+	constexpr HalfCycles max_loop_length(512);
+
+	// The Z80 is at the start of an instruction. If this isn't a revisit to the candidate loop address,
+	// make it the new candidate only if the old one has gone unvisited for too long to be a loop.
+	const HalfCycles loop_length = idle_loop_.start - number_of_cycles_;
+	if(pc_.full != idle_loop_.program_counter && loop_length <= max_loop_length) {
+		return;
 	}
 
-	// Allocate a landing area.
-	std::vector<std::size_t> operation_indices;
-	target.all_operations.reserve(number_of_micro_ops);
-	target.instructions.resize(256, nullptr);
-
-	// Copy in all programs, recording where they go.
-	std::size_t destination = 0;
-	for(std::size_t c = 0; c < 256; c++) {
-		operation_indices.push_back(target.all_operations.size());
-		for(std::size_t t = 0; t < lengths[c];) {
-			// Skip zero-length bus cycles.
-			if(table[c][t].type == MicroOp::BusOperation && table[c][t].machine_cycle.length.as_integral() == 0) {
-				t++;
-				continue;
-			}
+	const uint16_t registers[] = {
+		uint16_t((a_ << 8) | get_flags()), bc_.full, de_.full, hl_.full, ix_.full, iy_.full, sp_.full,
+		afDash_.full, bcDash_.full, deDash_.full, hlDash_.full, memptr_.full,
+		uint16_t((ir_.halves.high << 8) | (halt_mask_ & 0x10) | (interrupt_mode_ << 2) | (iff2_ << 1) | iff1_),
+	};
+
+	// If this is a revisit and the last iteration changed nothing, the next will be identical unless an
+	// event intervenes; so skip as many iterations as fit before the next event and the end of this run_for.
+	if(
+		pc_.full == idle_loop_.program_counter &&
+		idle_loop_.is_clean &&
+		std::equal(std::begin(registers), std::end(registers), idle_loop_.registers)
+	) {
+		if constexpr (T::has_direct_pages && !uses_bus_request) advance_direct_cycles();
+
+		HalfCycles limit = number_of_cycles_;
+		const HalfCycles time_until_event = bus_handler_.get_time_until_event();
+		if(time_until_event >= HalfCycles(0) && time_until_event <= limit) {
+			limit = time_until_event - HalfCycles(1);
+		}
 
-			// Skip optional waits if this instance doesn't use the wait line.
-			if(table[c][t].machine_cycle.was_requested && !uses_wait_line) {
-				t++;
-				continue;
-			}
+		const auto iterations = limit.as_integral() / loop_length.as_integral();
+		if(!request_status_ && !last_request_status_ && iterations > 0) {
+			const HalfCycles skipped(loop_length.as_integral() * iterations);
+			number_of_cycles_ -= skipped;
+			bus_handler_.skip_idle_time(skipped);
 
-			// If an index placeholder is hit then drop it, and if offsets aren't being added,
-			// then also drop the indexing that follows, which is assumed to be everything
-			// up to and including the next ::CalculateIndexAddress. Coupled to the INDEX() macro.
-			if(table[c][t].type == MicroOp::IndexedPlaceHolder) {
-				t++;
-				if(!add_offsets) {
-					while(table[c][t].type != MicroOp::CalculateIndexAddress) t++;
-					t++;
-				}
-			}
-			target.all_operations.emplace_back(table[c][t]);
-			destination++;
-			t++;
+			// Keep the refresh counter as if every iteration had been performed.
+			const auto refresh_step = ir_.halves.low - idle_loop_.refresh;
+			ir_.halves.low = uint8_t((ir_.halves.low & 0x80) | ((ir_.halves.low + refresh_step * iterations) & 0x7f));
 		}
 	}
 
-	// Since the vector won't change again, it's now safe to set pointers.
-	std::size_t c = 0;
-	for(std::size_t index : operation_indices) {
-		target.instructions[c] = &target.all_operations[index];
-		c++;
-	}
+	idle_loop_.program_counter = pc_.full;
+	std::copy(std::begin(registers), std::end(registers), idle_loop_.registers);
+	idle_loop_.refresh = ir_.halves.low;
+	idle_loop_.start = number_of_cycles_;
+	idle_loop_.is_clean = true;
 }
 
 template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
-		::copy_program(const MicroOp *source, std::vector<MicroOp> &destination) {
-	std::size_t length = 0;
-	while(!isTerminal(source[length].type)) length++;
-	std::size_t pointer = 0;
-	while(true) {
-		// TODO: This test is duplicated from assemble_page; can a better factoring be found?
-		// Skip optional waits if this instance doesn't use the wait line.
-		if(source[pointer].machine_cycle.was_requested && !uses_wait_line) {
-			pointer++;
-			continue;
-		}
+				::set_bus_request_line(bool value) {
+	assert(uses_bus_request);
+	bus_request_line_ = value;
+}
 
-		destination.emplace_back(source[pointer]);
-		if(isTerminal(source[pointer].type)) break;
-		pointer++;
-	}
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line> bool Processor <T, uses_bus_request, uses_wait_line>
+				::get_bus_request_line() {
+	return bus_request_line_;
+}
+
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+				::set_wait_line(bool value) {
+	assert(uses_wait_line);
+	wait_line_ = value;
 }
 
-#undef isTerminal
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line> bool Processor <T, uses_bus_request, uses_wait_line>
+				::get_wait_line() {
+	return wait_line_;
+}
 
 bool ProcessorBase::get_halt_line() {
 	return halt_mask_ == 0x00;
@@ -7,11 +7,89 @@
 //
 
 #include "../Z80.hpp"
+
+#include <cassert>
 #include <cstring>
 
 using namespace CPU::Z80;
 
-ProcessorStorage::ProcessorStorage() {
+ProcessorStorage::ProcessorStorage(Assemble, bool uses_wait_line) : uses_wait_line_(uses_wait_line) {
+	// Programs and pages point into micro_ops_ as they are assembled, so it mustn't be reallocated
+	// part way through. A first pass therefore establishes the capacity required, and a second
+	// assembles everything in place.
+	install_default_instruction_set();
+	[[maybe_unused]] const auto size = micro_ops_.size();
+	micro_ops_.clear();
+	install_default_instruction_set();
+	assert(micro_ops_.size() == size);
+}
+
+const ProcessorStorage &ProcessorStorage::prototype(bool uses_wait_line) {
+	if(uses_wait_line) {
+		static const ProcessorStorage prototype(Assemble(), true);
+		return prototype;
+	}
+
+	static const ProcessorStorage prototype(Assemble(), false);
+	return prototype;
+}
+
+ProcessorStorage::ProcessorStorage(bool uses_wait_line) : uses_wait_line_(uses_wait_line) {
+	const ProcessorStorage &source = prototype(uses_wait_line);
+	micro_ops_.reserve(source.micro_ops_.size());
+
+	// The prototype's micro-ops refer to its own registers, pages and micro-ops; repoint them to this instance's.
+	const auto relocate = [&source, this] (auto *pointer) {
+		using PointerT = decltype(pointer);
+		const auto address = reinterpret_cast<const uint8_t *>(pointer);
+
+		const auto object_offset = address - reinterpret_cast<const uint8_t *>(&source);
+		if(pointer && object_offset >= 0 && size_t(object_offset) < sizeof(ProcessorStorage)) {
+			return reinterpret_cast<PointerT>(reinterpret_cast<uint8_t *>(this) + object_offset);
+		}
+
+		const auto micro_op_offset = address - reinterpret_cast<const uint8_t *>(source.micro_ops_.data());
+		if(pointer && micro_op_offset >= 0 && size_t(micro_op_offset) < source.micro_ops_.size() * sizeof(MicroOp)) {
+			return reinterpret_cast<PointerT>(reinterpret_cast<uint8_t *>(micro_ops_.data()) + micro_op_offset);
+		}
+
+		return pointer;
+	};
+
+	for(const auto &operation: source.micro_ops_) {
+		const auto &cycle = operation.machine_cycle;
+		micro_ops_.push_back(MicroOp{
+			operation.type,
+			relocate(operation.source),
+			relocate(operation.destination),
+			PartialMachineCycle(cycle.operation, cycle.length, const_cast<uint16_t *>(relocate(cycle.address)), relocate(cycle.value), cycle.was_requested)
+		});
+	}
+
+	const auto program = [&relocate] (Program program) {
+		program.data = relocate(program.data);
+		return program;
+	};
+	conditional_call_untaken_program_ = program(source.conditional_call_untaken_program_);
+	reset_program_ = program(source.reset_program_);
+	nmi_program_ = program(source.nmi_program_);
+	for(int c = 0; c < 3; ++c) {
+		irq_program_[c] = program(source.irq_program_[c]);
+	}
+
+	for(const auto page: {
+		&ProcessorStorage::base_page_, &ProcessorStorage::ed_page_, &ProcessorStorage::fd_page_, &ProcessorStorage::dd_page_,
+		&ProcessorStorage::cb_page_, &ProcessorStorage::fdcb_page_, &ProcessorStorage::ddcb_page_,
+	}) {
+		InstructionPage &target = this->*page;
+		target = source.*page;
+		for(auto &instruction: target.instructions) {
+			instruction = relocate(instruction);
+		}
+		target.all_operations = program(target.all_operations);
+		target.fetch_decode_execute = program(target.fetch_decode_execute);
+	}
+
 	set_flags(0xff);
 }
 
@@ -105,7 +183,7 @@ ProcessorStorage::ProcessorStorage() {
 #define NOP						Sequence(BusOp(Refresh(4)))
 
 #define JP(cc)					StdInstr(Read16Inc(pc_, temp16_), {MicroOp::cc, nullptr}, {MicroOp::Move16, &temp16_.full, &pc_.full})
-#define CALL(cc)				StdInstr(ReadInc(pc_, temp16_.halves.low), {MicroOp::cc, conditional_call_untaken_program_.data()}, Read4Inc(pc_, temp16_.halves.high), Push(pc_), {MicroOp::Move16, &temp16_.full, &pc_.full})
+#define CALL(cc)				StdInstr(ReadInc(pc_, temp16_.halves.low), {MicroOp::cc, conditional_call_untaken_program_.data}, Read4Inc(pc_, temp16_.halves.high), Push(pc_), {MicroOp::Move16, &temp16_.full, &pc_.full})
 #define RET(cc)					Instr(6, {MicroOp::cc, nullptr}, Pop(memptr_), {MicroOp::Move16, &memptr_.full, &pc_.full})
 #define JR(cc)					StdInstr(ReadInc(pc_, temp8_), {MicroOp::cc, nullptr}, InternalOperation(10), {MicroOp::CalculateIndexAddress, &pc_.full}, {MicroOp::Move16, &memptr_.full, &pc_.full})
 #define RST()					Instr(6, {MicroOp::CalculateRSTDestination}, Push(pc_), {MicroOp::Move16, &memptr_.full, &pc_.full})
@@ -167,7 +245,7 @@ ProcessorStorage::ProcessorStorage() {
 
 void ProcessorStorage::install_default_instruction_set() {
 	MicroOp conditional_call_untaken_program[] = Sequence(ReadInc(pc_, temp16_.halves.high));
-	copy_program(conditional_call_untaken_program, conditional_call_untaken_program_);
+	conditional_call_untaken_program_ = copy_program(conditional_call_untaken_program);
 
 	assemble_base_page(base_page_, hl_, false, cb_page_);
 	assemble_base_page(dd_page_, ix_, true, ddcb_page_);
@@ -235,11 +313,11 @@ void ProcessorStorage::install_default_instruction_set() {
 		{ MicroOp::MoveToNextProgram }
 	};
 
-	copy_program(reset_program, reset_program_);
-	copy_program(nmi_program, nmi_program_);
-	copy_program(irq_mode0_program, irq_program_[0]);
-	copy_program(irq_mode1_program, irq_program_[1]);
-	copy_program(irq_mode2_program, irq_program_[2]);
+	reset_program_ = copy_program(reset_program);
+	nmi_program_ = copy_program(nmi_program);
+	irq_program_[0] = copy_program(irq_mode0_program);
+	irq_program_[1] = copy_program(irq_mode1_program);
+	irq_program_[2] = copy_program(irq_mode2_program);
 }
 
 void ProcessorStorage::assemble_ed_page(InstructionPage &target) {
@@ -540,6 +618,67 @@ void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, in
 		BusOp(ReadOpcodeEnd()),
 		{ MicroOp::DecodeOperation }
 	};
-	copy_program((length == 4) ? normal_fetch_decode_execute : short_fetch_decode_execute, target.fetch_decode_execute);
-	target.fetch_decode_execute_data = target.fetch_decode_execute.data();
+	target.fetch_decode_execute = copy_program((length == 4) ? normal_fetch_decode_execute : short_fetch_decode_execute);
+}
+
+#define isTerminal(n)	(n == MicroOp::MoveToNextProgram || n == MicroOp::DecodeOperation || n == MicroOp::DecodeOperationNoRChange)
+
+void ProcessorStorage::assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) {
+	const std::size_t start = micro_ops_.size();
+
+	// Copy in all programs, recording where they go.
+	for(std::size_t c = 0; c < 256; c++) {
+		target.instructions[c] = micro_ops_.data() + micro_ops_.size();
+
+		std::size_t length = 0;
+		while(!isTerminal(table[c][length].type)) length++;
+		length++;
+
+		for(std::size_t t = 0; t < length;) {
+			// Skip zero-length bus cycles.
+			if(table[c][t].type == MicroOp::BusOperation && table[c][t].machine_cycle.length.as_integral() == 0) {
+				t++;
+				continue;
+			}
+
+			// Skip optional waits if this instance doesn't use the wait line.
+			if(table[c][t].machine_cycle.was_requested && !uses_wait_line_) {
+				t++;
+				continue;
+			}
+
+			// If an index placeholder is hit then drop it, and if offsets aren't being added,
+			// then also drop the indexing that follows, which is assumed to be everything
+			// up to and including the next ::CalculateIndexAddress. Coupled to the INDEX() macro.
+			if(table[c][t].type == MicroOp::IndexedPlaceHolder) {
+				t++;
+				if(!add_offsets) {
+					while(table[c][t].type != MicroOp::CalculateIndexAddress) t++;
+					t++;
+				}
+			}
+			micro_ops_.emplace_back(table[c][t]);
+			t++;
+		}
+	}
+
+	target.all_operations = Program{&micro_ops_[start], micro_ops_.size() - start};
 }
+
+ProcessorStorage::Program ProcessorStorage::copy_program(const MicroOp *source) {
+	const std::size_t start = micro_ops_.size();
+	while(true) {
+		// Skip optional waits if this instance doesn't use the wait line.
+		if(source->machine_cycle.was_requested && !uses_wait_line_) {
+			source++;
+			continue;
+		}
+
+		micro_ops_.emplace_back(*source);
+		if(isTerminal(source->type)) break;
+		source++;
+	}
+	return Program{&micro_ops_[start], micro_ops_.size() - start};
+}
+
+#undef isTerminal
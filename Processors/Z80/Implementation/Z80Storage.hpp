@@ -101,21 +101,23 @@ class ProcessorStorage {
 			PartialMachineCycle machine_cycle;
 		};
 
+		/// A contiguous run of micro-ops within micro_ops_.
+		struct Program {
+			MicroOp *data = nullptr;
+			std::size_t size = 0;
+		};
+
 		struct InstructionPage {
-			std::vector<MicroOp *> instructions;
-			std::vector<MicroOp> all_operations;
-			std::vector<MicroOp> fetch_decode_execute;
-			MicroOp *fetch_decode_execute_data;
-			uint8_t r_step;
-			bool is_indexed;
-
-			InstructionPage() : r_step(1), is_indexed(false) {}
+			const MicroOp *instructions[256];
+			Program all_operations;
+			Program fetch_decode_execute;
+			uint8_t r_step = 1;
+			bool is_indexed = false;
 		};
 
 		typedef MicroOp InstructionTable[256][30];
 
-		ProcessorStorage();
-		void install_default_instruction_set();
+		ProcessorStorage(bool uses_wait_line);
 
 		uint8_t a_;
 		RegisterPair16 bc_, de_, hl_;
@@ -129,7 +131,8 @@ class ProcessorStorage {
 		uint8_t zero_result_;				// the zero flag is set if the value in zero_result_ is zero
 		uint8_t half_carry_result_;			// the half-carry flag is set if bit 4 of half_carry_result_ is set
 		uint8_t bit53_result_;				// the bit 3 and 5 flags are set if the corresponding bits of bit53_result_ are set
-		uint8_t parity_overflow_result_;	// the parity/overflow flag is set if the corresponding bit of parity_overflow_result_ is set
+		uint16_t parity_overflow_result_;	// the parity/overflow flag is set if the corresponding bit of parity_overflow_result_ is set
+											// or, if bit 8 is set, if the low eight bits have even parity; see parity_overflow_flag
 		uint8_t subtract_flag_;				// contains a copy of the subtract flag in isolation
 		uint8_t carry_result_;				// the carry flag is set if bit 0 of carry_result_ is set
 		uint8_t halt_mask_ = 0xff;
@@ -156,13 +159,27 @@ class ProcessorStorage {
 		RegisterPair16 temp16_, memptr_;
 		uint8_t temp8_;
 
+		// The most recent visit to the address that is currently a candidate for the top of an idle loop: the state
+		// then, the value of number_of_cycles_ then, and whether anything has happened since that would prevent
+		// the loop from being skipped. See BusHandler::skips_idle_loops.
+		struct IdleLoop {
+			uint16_t program_counter = 0;
+			uint16_t registers[13]{};
+			uint8_t refresh = 0;
+			HalfCycles start;
+			bool is_clean = false;
+		} idle_loop_;
+
 		const MicroOp *scheduled_program_counter_ = nullptr;
 
-		std::vector<MicroOp> conditional_call_untaken_program_;
-		std::vector<MicroOp> reset_program_;
-		std::vector<MicroOp> irq_program_[3];
-		std::vector<MicroOp> nmi_program_;
-		InstructionPage *current_instruction_page_;
+		// Storage for every micro-op used by this processor; all programs and pages point into this.
+		std::vector<MicroOp> micro_ops_;
+
+		Program conditional_call_untaken_program_;
+		Program reset_program_;
+		Program irq_program_[3];
+		Program nmi_program_;
+		const InstructionPage *current_instruction_page_ = &base_page_;
 
 		InstructionPage base_page_;
 		InstructionPage ed_page_;
@@ -186,12 +203,28 @@ class ProcessorStorage {
 				(zero_result_ ? 0 : Flag::Zero) |
 				(bit53_result_ & (Flag::Bit5 | Flag::Bit3)) |
 				(half_carry_result_ & Flag::HalfCarry) |
-				(parity_overflow_result_ & Flag::Parity) |
+				parity_overflow_flag() |
 				subtract_flag_ |
 				(carry_result_ & Flag::Carry);
 			return result;
 		}
 
+		/*!
+			Parity is evaluated only when the flag is read, as it usually isn't before being overwritten;
+			logical operations just store their result with bit 8 set.
+
+			@returns The parity/overflow flag in isolation.
+		*/
+		uint8_t parity_overflow_flag() const {
+			if(!(parity_overflow_result_ & 0x100)) return parity_overflow_result_ & Flag::Parity;
+
+			uint8_t parity = uint8_t(parity_overflow_result_ ^ 1);
+			parity ^= parity >> 4;
+			parity ^= parity << 2;
+			parity ^= parity >> 1;
+			return parity & Flag::Parity;
+		}
+
 		/*!
 			Sets the flags register.
 
@@ -209,8 +242,23 @@ class ProcessorStorage {
 			carry_result_			= flags;
 		}
 
-		virtual void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) = 0;
-		virtual void copy_program(const MicroOp *source, std::vector<MicroOp> &destination) = 0;
+	private:
+		/*!
+			Micro-op programs depend only on whether the wait line is in use, so they are assembled
+			once per process for each option, by a prototype from which all other instances copy.
+			Micro-ops point at registers, so each instance still needs its own copy.
+		*/
+		struct Assemble {};
+		ProcessorStorage(Assemble, bool uses_wait_line);
+
+		/// @returns The prototype for processors with or without a wait line, as per @c uses_wait_line.
+		static const ProcessorStorage &prototype(bool uses_wait_line);
+
+		const bool uses_wait_line_;
+
+		void install_default_instruction_set();
+		void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets);
+		Program copy_program(const MicroOp *source);
 
 		void assemble_fetch_decode_execute(InstructionPage &target, int length);
 		void assemble_ed_page(InstructionPage &target);
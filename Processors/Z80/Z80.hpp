@@ -9,13 +9,19 @@
 #ifndef Z80_hpp
 #define Z80_hpp
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <iterator>
 #include <vector>
 #include <cstdint>
+#include <utility>
 
 #include "../RegisterSizes.hpp"
+#include "../TraceRing.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ForceInline.hpp"
+#include "../../Storage/Snapshot.hpp"
 
 namespace CPU {
 namespace Z80 {
@@ -154,6 +160,99 @@ class BusHandler {
 			bus handlers to perform any deferred output work.
 		*/
 		void flush() {}
+
+		/*!
+			Bus handlers may nominate pages of plain memory that the Z80 should access directly, in which case
+			perform_machine_cycle will be called only for accesses elsewhere, for input and output, and for
+			interrupt acknowledgement; this substantially reduces the cost of code that mostly touches memory.
+
+			To do so, a bus handler should declare @c has_direct_pages as @c true and implement @c direct_read_page,
+			@c direct_write_page, @c direct_internal_cycles and @c advance. The Z80 will then call @c advance to report
+			the time spent on direct accesses, and on refresh and internal cycles if permitted, before each call to
+			perform_machine_cycle, at the end of each instruction and at the end of each run_for. So devices always
+			observe their own accesses at exactly the correct time, and interrupts are recognised exactly as they would
+			otherwise be.
+
+			The Z80 still steps through each instruction a machine cycle at a time; what is saved is the bus handler's
+			work, which becomes a single call to @c advance for an instruction that touches only direct pages.
+
+			If the wait line is active then the extra wait cycles that it causes are always announced via
+			perform_machine_cycle, so that the bus handler can release it; but since the wait cycles of direct accesses
+			are not themselves announced, a bus handler that asserts WAIT in response to particular accesses should not
+			nominate the pages they touch. Direct pages are not used by Z80s that have a bus request line.
+		*/
+		static constexpr bool has_direct_pages = false;
+
+		/*!
+			@returns A pointer to the 256 bytes that should be read, including for opcode fetches, by accesses
+			to page @c page — i.e. addresses [page * 256, page * 256 + 255] — or @c nullptr if those reads
+			should be announced via perform_machine_cycle.
+		*/
+		uint8_t *direct_read_page(int page) {
+			return nullptr;
+		}
+
+		/*!
+			@returns A pointer to the 256 bytes that should be written by accesses to page @c page, or @c nullptr
+			if those writes should be announced via perform_machine_cycle.
+		*/
+		uint8_t *direct_write_page(int page) {
+			return nullptr;
+		}
+
+		/*!
+			@returns @c true if refresh and internal cycles should be included in calls to @c advance; @c false if
+			they should be announced via perform_machine_cycle.
+		*/
+		bool direct_internal_cycles() {
+			return false;
+		}
+
+		/*!
+			Announces that @c duration has passed, during which the Z80 performed only direct accesses, refresh
+			cycles and internal operations.
+		*/
+		void advance(HalfCycles duration) {}
+
+		/*!
+			If @c true, the Z80 will add a record to the current thread's TraceRing as it decodes the first byte
+			of each instruction, whether that is a prefix or an opcode. This costs nothing if @c false.
+		*/
+		static constexpr bool traces_execution = false;
+
+		/*!
+			If @c true, each record added because of @c traces_execution also includes the Z80's registers; this
+			roughly doubles the cost of tracing. Otherwise only the time, program counter and opcode are recorded.
+		*/
+		static constexpr bool traces_registers = false;
+
+		/*!
+			Bus handlers may allow the Z80 to skip idle loops: short loops that write nothing, perform no output
+			and leave every register as they found it, so that each iteration will exactly repeat the last until
+			an interrupt is requested or something that the loop reads changes. The Z80 will then skip as many
+			whole iterations as fit before the bus handler's next event, announcing the time skipped via
+			@c skip_idle_time.
+
+			To do so, a bus handler should declare @c skips_idle_loops as @c true and implement
+			@c get_time_until_event and @c skip_idle_time. It should also call the Z80's @c prevent_idle_skip
+			whenever it services a read that has side effects, or whose result may change other than at an event.
+
+			Idle loops are not skipped by Z80s that have a bus request or wait line.
+		*/
+		static constexpr bool skips_idle_loops = false;
+
+		/*!
+			@returns The time until the next event that might request an interrupt or change the value of
+			anything read by an idle loop, or a negative value if no such event is scheduled.
+		*/
+		HalfCycles get_time_until_event() {
+			return HalfCycles(0);
+		}
+
+		/*!
+			Announces that @c duration has passed, during which the Z80 would have repeated an idle loop.
+		*/
+		void skip_idle_time(HalfCycles duration) {}
 };
 
 #include "Implementation/Z80Storage.hpp"
@@ -163,6 +262,8 @@ class BusHandler {
 */
 class ProcessorBase: public ProcessorStorage {
 	public:
+		ProcessorBase(bool uses_wait_line) : ProcessorStorage(uses_wait_line) {}
+
 		/*!
 			Gets the value of a register.
 
@@ -224,6 +325,38 @@ class ProcessorBase: public ProcessorStorage {
 			reset at the first opportunity. Use @c reset_power_on to disable that behaviour.
 		*/
 		void reset_power_on();
+
+		/*!
+			Appends the processor's complete state to @c writer; this may be called at any
+			point between calls to @c run_for.
+		*/
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/*!
+			Restores state previously captured by @c save_state.
+
+			@returns @c true if state was restored; @c false otherwise.
+		*/
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
+		/*!
+			Prevents the loop that the Z80 is currently executing, if any, from being skipped as idle.
+
+			@see BusHandler::skips_idle_loops
+		*/
+		void prevent_idle_skip() {
+			idle_loop_.is_clean = false;
+		}
+
+	private:
+		// Lists all micro-programs that may be in progress, for translation of
+		// scheduled_program_counter_ to and from a snapshot.
+		using ProgramList = std::array<std::pair<const MicroOp *, std::size_t>, 20>;
+		ProgramList programs() const;
+
+		// Lists all instruction pages, for translation of current_instruction_page_.
+		using PageList = std::array<const InstructionPage *, 7>;
+		PageList pages() const;
 };
 
 /*!
@@ -272,8 +405,15 @@ template <class T, bool uses_bus_request, bool uses_wait_line> class Processor:
 	private:
 		T &bus_handler_;
 
-		void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets);
-		void copy_program(const MicroOp *source, std::vector<MicroOp> &destination);
+		/// The total number of half cycles supplied to run_for, if execution is being traced.
+		uint64_t traced_half_cycles_ = 0;
+
+		HalfCycles direct_cycles_, last_direct_cycle_length_;
+		bool last_direct_cycle_iff1_ = false;
+		forceinline bool perform_direct_machine_cycle(const PartialMachineCycle &cycle);
+		inline void advance_direct_cycles();
+
+		inline void test_idle_loop();
 };
 
 #include "Implementation/Z80Implementation.hpp"
@@ -9,6 +9,21 @@
 #include "FIRFilter.hpp"
 #include <cmath>
 
+#if defined(__SSE2__)
+#define FIR_SSE2
+#include <emmintrin.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FIR_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FIR_NEON
+#include <arm_neon.h>
+#endif
+
 using namespace SignalProcessing;
 
 /*
@@ -46,7 +61,7 @@ float FIRFilter::ino(float a) {
 	return s;
 }
 
-void FIRFilter::coefficients_for_idealised_filter_response(short *filter_coefficients, float *A, float attenuation, std::size_t number_of_taps) {
+std::vector<float> FIRFilter::coefficients_for_idealised_filter_response(const float *A, float attenuation, std::size_t number_of_taps) {
 	/* calculate alpha, which is the Kaiser-Bessel window shape factor */
 	float a;	// to take the place of alpha in the normal derivation
 
@@ -83,11 +98,11 @@ void FIRFilter::coefficients_for_idealised_filter_response(short *filter_coeffic
 		coefficientTotal += filter_coefficients_float[i];
 	}
 
-	/* we'll also need integer versions, potentially */
 	float coefficientMultiplier = 1.0f / coefficientTotal;
 	for(std::size_t i = 0; i < number_of_taps; ++i) {
-		filter_coefficients[i] = static_cast<short>(filter_coefficients_float[i] * FixedMultiplier * coefficientMultiplier);
+		filter_coefficients_float[i] *= coefficientMultiplier;
 	}
+	return filter_coefficients_float;
 }
 
 std::vector<float> FIRFilter::get_coefficients() const {
@@ -99,6 +114,13 @@ std::vector<float> FIRFilter::get_coefficients() const {
 }
 
 FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation) {
+	// we'll also need integer versions
+	for(const auto coefficient: coefficients(number_of_taps, input_sample_rate, low_frequency, high_frequency, attenuation)) {
+		filter_coefficients_.push_back(static_cast<short>(coefficient * FixedMultiplier));
+	}
+}
+
+std::vector<float> FIRFilter::coefficients(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation) {
 	// we must be asked to filter based on an odd number of
 	// taps, and at least three
 	if(number_of_taps < 3) number_of_taps = 3;
@@ -107,9 +129,6 @@ FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float
 	// ensure we have an odd number of taps
 	number_of_taps |= 1;
 
-	// store instance variables
-	filter_coefficients_.resize(number_of_taps);
-
 	/* calculate idealised filter response */
 	std::size_t Np = (number_of_taps - 1) / 2;
 	float two_over_sample_rate = 2.0f / input_sample_rate;
@@ -128,7 +147,7 @@ FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float
 			) / i_pi;
 	}
 
-	FIRFilter::coefficients_for_idealised_filter_response(filter_coefficients_.data(), A.data(), attenuation, number_of_taps);
+	return FIRFilter::coefficients_for_idealised_filter_response(A.data(), attenuation, number_of_taps);
 }
 
 FIRFilter::FIRFilter(const std::vector<float> &coefficients) {
@@ -170,3 +189,254 @@ FIRFilter FIRFilter::operator*(const FIRFilter &rhs) const {
 
 	return FIRFilter(sum);
 }
+
+// MARK: - Kernels.
+
+/*
+
+	Each kernel computes its dot product as a sum of 32-bit products, with wraparound; since that
+	is associative, results are identical to the scalar reference whatever order the kernel adds
+	products in.
+
+	The batch kernels compute four dot products at a time, so that each load of coefficients
+	is shared between them.
+
+*/
+
+namespace {
+
+constexpr int FixedShift = 15;
+
+int dot_product_scalar(const short *coefficients, const short *src, std::size_t count) {
+	int result = 0;
+	for(std::size_t c = 0; c < count; ++c) {
+		result += coefficients[c] * src[c];
+	}
+	return result;
+}
+
+/// Computes the dot products of @c coefficients with four successive batches of @c src,
+/// @c src_step samples apart, one at a time.
+void dot_product_x4_scalar(const short *coefficients, std::size_t count, const short *src, std::size_t src_step, int *results) {
+	for(int c = 0; c < 4; ++c) {
+		results[c] = dot_product_scalar(coefficients, &src[std::size_t(c) * src_step], count);
+	}
+}
+
+/// Provides a complete implementation of batch filtering given suitable single and four-way dot products.
+template <
+	int (*DotProduct)(const short *, const short *, std::size_t),
+	void (*DotProductX4)(const short *, std::size_t, const short *, std::size_t, int *)
+> void apply_batches(const short *coefficients, std::size_t count, const short *src, short *dst, std::size_t dst_count, std::size_t src_step) {
+	int results[4];
+	while(dst_count >= 4) {
+		DotProductX4(coefficients, count, src, src_step, results);
+		for(int c = 0; c < 4; ++c) {
+			dst[c] = static_cast<short>(results[c] >> FixedShift);
+		}
+
+		src += src_step * 4;
+		dst += 4;
+		dst_count -= 4;
+	}
+
+	while(dst_count--) {
+		*dst = static_cast<short>(DotProduct(coefficients, src, count) >> FixedShift);
+		src += src_step;
+		++dst;
+	}
+}
+
+#ifdef FIR_SSE2
+
+inline int horizontal_sum(__m128i sum) {
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+}
+
+inline __m128i load(const short *source) {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+}
+
+int dot_product_sse2(const short *coefficients, const short *src, std::size_t count) {
+	__m128i sum = _mm_setzero_si128();
+	std::size_t c = 0;
+	for(; c + 8 <= count; c += 8) {
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(load(&coefficients[c]), load(&src[c])));
+	}
+	return horizontal_sum(sum) + dot_product_scalar(&coefficients[c], &src[c], count - c);
+}
+
+void dot_product_x4_sse2(const short *coefficients, std::size_t count, const short *src, std::size_t src_step, int *results) {
+	__m128i sums[4] = {_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()};
+	std::size_t c = 0;
+	for(; c + 8 <= count; c += 8) {
+		const __m128i coefficient_vector = load(&coefficients[c]);
+		for(int s = 0; s < 4; ++s) {
+			sums[s] = _mm_add_epi32(sums[s], _mm_madd_epi16(coefficient_vector, load(&src[std::size_t(s) * src_step + c])));
+		}
+	}
+	for(int s = 0; s < 4; ++s) {
+		results[s] = horizontal_sum(sums[s]) + dot_product_scalar(&coefficients[c], &src[std::size_t(s) * src_step + c], count - c);
+	}
+}
+
+#endif
+
+#ifdef FIR_AVX2
+
+__attribute__((target("avx2"))) inline int horizontal_sum(__m256i sum) {
+	return horizontal_sum(_mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+}
+
+__attribute__((target("avx2"))) inline __m256i load_wide(const short *source) {
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source));
+}
+
+__attribute__((target("avx2"))) int dot_product_avx2(const short *coefficients, const short *src, std::size_t count) {
+	__m256i sum = _mm256_setzero_si256();
+	std::size_t c = 0;
+	for(; c + 16 <= count; c += 16) {
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(load_wide(&coefficients[c]), load_wide(&src[c])));
+	}
+	return horizontal_sum(sum) + dot_product_scalar(&coefficients[c], &src[c], count - c);
+}
+
+__attribute__((target("avx2"))) void dot_product_x4_avx2(const short *coefficients, std::size_t count, const short *src, std::size_t src_step, int *results) {
+	__m256i sums[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+	std::size_t c = 0;
+	for(; c + 16 <= count; c += 16) {
+		const __m256i coefficient_vector = load_wide(&coefficients[c]);
+		for(int s = 0; s < 4; ++s) {
+			sums[s] = _mm256_add_epi32(sums[s], _mm256_madd_epi16(coefficient_vector, load_wide(&src[std::size_t(s) * src_step + c])));
+		}
+	}
+	for(int s = 0; s < 4; ++s) {
+		results[s] = horizontal_sum(sums[s]) + dot_product_scalar(&coefficients[c], &src[std::size_t(s) * src_step + c], count - c);
+	}
+}
+
+#endif
+
+#ifdef FIR_NEON
+
+inline int horizontal_sum(int32x4_t sum) {
+	const int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(pair, pair), 0);
+}
+
+inline int32x4_t multiply_accumulate(int32x4_t sum, int16x8_t lhs, int16x8_t rhs) {
+	sum = vmlal_s16(sum, vget_low_s16(lhs), vget_low_s16(rhs));
+	return vmlal_s16(sum, vget_high_s16(lhs), vget_high_s16(rhs));
+}
+
+int dot_product_neon(const short *coefficients, const short *src, std::size_t count) {
+	int32x4_t sum = vdupq_n_s32(0);
+	std::size_t c = 0;
+	for(; c + 8 <= count; c += 8) {
+		sum = multiply_accumulate(sum, vld1q_s16(&coefficients[c]), vld1q_s16(&src[c]));
+	}
+	return horizontal_sum(sum) + dot_product_scalar(&coefficients[c], &src[c], count - c);
+}
+
+void dot_product_x4_neon(const short *coefficients, std::size_t count, const short *src, std::size_t src_step, int *results) {
+	int32x4_t sums[4] = {vdupq_n_s32(0), vdupq_n_s32(0), vdupq_n_s32(0), vdupq_n_s32(0)};
+	std::size_t c = 0;
+	for(; c + 8 <= count; c += 8) {
+		const int16x8_t coefficient_vector = vld1q_s16(&coefficients[c]);
+		for(int s = 0; s < 4; ++s) {
+			sums[s] = multiply_accumulate(sums[s], coefficient_vector, vld1q_s16(&src[std::size_t(s) * src_step + c]));
+		}
+	}
+	for(int s = 0; s < 4; ++s) {
+		results[s] = horizontal_sum(sums[s]) + dot_product_scalar(&coefficients[c], &src[std::size_t(s) * src_step + c], count - c);
+	}
+}
+
+#endif
+
+}
+
+bool FIRFilter::is_available(Kernel kernel) {
+	switch(kernel) {
+		case Kernel::Scalar:	return true;
+
+#ifdef FIR_SSE2
+		case Kernel::SSE2:		return true;
+#endif
+
+#ifdef FIR_AVX2
+		case Kernel::AVX2:		return __builtin_cpu_supports("avx2");
+#endif
+
+#ifdef FIR_NEON
+		case Kernel::NEON:		return true;
+#endif
+
+		default:				return false;
+	}
+}
+
+FIRFilter::Kernel FIRFilter::preferred_kernel() {
+	static const Kernel preferred = [] {
+		for(const auto kernel: {Kernel::AVX2, Kernel::SSE2, Kernel::NEON}) {
+			if(is_available(kernel)) return kernel;
+		}
+		return Kernel::Scalar;
+	}();
+	return preferred;
+}
+
+const FIRFilter::KernelFunctions &FIRFilter::kernel_functions(Kernel kernel) {
+	static constexpr KernelFunctions scalar = {
+		dot_product_scalar, apply_batches<dot_product_scalar, dot_product_x4_scalar>
+	};
+
+	switch(kernel) {
+		default: return scalar;
+
+#ifdef FIR_SSE2
+		case Kernel::SSE2: {
+			static constexpr KernelFunctions sse2 = {
+				dot_product_sse2, apply_batches<dot_product_sse2, dot_product_x4_sse2>
+			};
+			return sse2;
+		}
+#endif
+
+#ifdef FIR_AVX2
+		case Kernel::AVX2: {
+			static constexpr KernelFunctions avx2 = {
+				dot_product_avx2, apply_batches<dot_product_avx2, dot_product_x4_avx2>
+			};
+			return avx2;
+		}
+#endif
+
+#ifdef FIR_NEON
+		case Kernel::NEON: {
+			static constexpr KernelFunctions neon = {
+				dot_product_neon, apply_batches<dot_product_neon, dot_product_x4_neon>
+			};
+			return neon;
+		}
+#endif
+	}
+}
+
+int FIRFilter::dot_product(const short *src, Kernel kernel) const {
+	return kernel_functions(kernel).dot_product(filter_coefficients_.data(), src, filter_coefficients_.size());
+}
+
+void FIRFilter::apply(const short *src, short *dst, std::size_t count, std::size_t src_step) const {
+#ifdef __APPLE__
+	// vDSP's rounding differs from that of the kernels above, so retain it for consistency with
+	// the single-batch form of apply.
+	for(std::size_t c = 0; c < count; ++c) {
+		dst[c] = apply(&src[c * src_step]);
+	}
+#else
+	kernel_->apply(filter_coefficients_.data(), filter_coefficients_.size(), src, dst, count, src_step);
+#endif
+}
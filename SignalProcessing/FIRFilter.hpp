@@ -55,19 +55,55 @@ class FIRFilter {
 				vDSP_dotpr_s1_15(filter_coefficients_.data(), 1, src, 1, &result, filter_coefficients_.size());
 				return result;
 			#else
-				int outputValue = 0;
-				for(std::size_t c = 0; c < filter_coefficients_.size(); ++c) {
-					outputValue += filter_coefficients_[c] * src[c];
-				}
-				return static_cast<short>(outputValue >> FixedShift);
+				return static_cast<short>(kernel_->dot_product(filter_coefficients_.data(), src, filter_coefficients_.size()) >> FixedShift);
 			#endif
 		}
 
+		/*!
+			Applies the filter to @c count batches of input samples, the first beginning at @c src and
+			each subsequent batch beginning @c src_step samples after its predecessor, writing the
+			results to @c dst.
+
+			Results are identical to those that would be obtained by calling @c apply once per batch,
+			but where SIMD is available several batches are processed together.
+
+			@param src The source buffer to apply the filter to; this should hold at least
+				@c (count - 1) * @c src_step + @c get_number_of_taps() samples.
+			@param dst The buffer to which results are written.
+			@param count The number of results to produce.
+			@param src_step The distance between the start of each batch in @c src.
+		*/
+		void apply(const short *src, short *dst, std::size_t count, std::size_t src_step = 1) const;
+
+		/// Identifies an implementation of the inner loop of @c apply.
+		enum class Kernel {
+			Scalar, SSE2, AVX2, NEON
+		};
+
+		/// @returns @c true if @c kernel was compiled in and is supported by this processor; @c false otherwise.
+		static bool is_available(Kernel kernel);
+
+		/// @returns The kernel that will be used by all filters, which is the fastest available.
+		static Kernel preferred_kernel();
+
+		/*!
+			Computes the unscaled dot product of this filter's coefficients and @c src using the nominated
+			@c kernel, which must be available. This is provided so that kernels can be compared against
+			the scalar reference; otherwise @c apply should be used.
+		*/
+		int dot_product(const short *src, Kernel kernel) const;
+
 		/*! @returns The number of taps used by this filter. */
 		inline std::size_t get_number_of_taps() const {
 			return filter_coefficients_.size();
 		}
 
+		/*!
+			@returns The coefficients of the filter that would be created by the constructor with the same
+				arguments, at full precision rather than quantised as they are for application.
+		*/
+		static std::vector<float> coefficients(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation = DefaultAttenuation);
+
 		/*! @returns The weighted coefficients that describe this filter. */
 		std::vector<float> get_coefficients() const;
 
@@ -91,7 +127,17 @@ class FIRFilter {
 	private:
 		std::vector<short> filter_coefficients_;
 
-		static void coefficients_for_idealised_filter_response(short *filterCoefficients, float *A, float attenuation, std::size_t numberOfTaps);
+		struct KernelFunctions {
+			/// Returns the sum of @c coefficients[n] * @c src[n] for all n in [0, @c count).
+			int (*dot_product)(const short *coefficients, const short *src, std::size_t count);
+
+			/// Provides the full implementation of the batch form of @c apply.
+			void (*apply)(const short *coefficients, std::size_t count, const short *src, short *dst, std::size_t dst_count, std::size_t src_step);
+		};
+		static const KernelFunctions &kernel_functions(Kernel);
+		const KernelFunctions *kernel_ = &kernel_functions(preferred_kernel());
+
+		static std::vector<float> coefficients_for_idealised_filter_response(const float *A, float attenuation, std::size_t numberOfTaps);
 		static float ino(float a);
 };
 
@@ -0,0 +1,136 @@
+//
+//  Resampler.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace SignalProcessing;
+
+namespace {
+
+/// Makes a guess at a good number of taps for a filter at @c sample_rate that cuts off at @c high_frequency.
+std::size_t number_of_taps(float sample_rate, float high_frequency) {
+	const auto taps = std::size_t(ceilf((sample_rate + high_frequency) / high_frequency));
+	return (taps * 2) | 1;
+}
+
+/// @returns @c rate in units of 1/scale Hz, throwing if the result is not positive.
+uint64_t scaled_rate(float rate, double scale) {
+	const double scaled = std::round(double(rate) * scale);
+	if(!(scaled >= 1.0)) throw SignalProcessing::Resampler::Error::InvalidRate;
+	return uint64_t(scaled);
+}
+
+}
+
+Resampler::Resampler(float input_rate, float output_rate, float high_frequency_cutoff) :
+	input_rate_(scaled_rate(input_rate, RateScale)),
+	output_rate_(scaled_rate(output_rate, RateScale)),
+	whole_step_(input_rate_ / output_rate_),
+	fractional_step_(input_rate_ % output_rate_) {
+
+	float high_frequency = output_rate * 0.5f;
+	if(high_frequency_cutoff > 0.0f) {
+		high_frequency = std::min(high_frequency_cutoff, high_frequency);
+	}
+
+	if(input_rate_ >= output_rate_) {
+		taps_ = number_of_taps(input_rate, high_frequency);
+		filters_.emplace_back(taps_, input_rate, 0.0f, high_frequency, FIRFilter::DefaultAttenuation);
+	} else {
+		// Design a prototype filter for an input that has been zero-stuffed to Phases times its
+		// original rate, then split it into one filter per phase. Zero-stuffing reduces volume
+		// by a factor of Phases, so multiply back up. The prototype is kept at full precision
+		// since each of its coefficients is only around 1/Phases the size of those that are applied.
+		high_frequency = std::min(high_frequency, input_rate * 0.5f);
+		const auto coefficients = FIRFilter::coefficients(
+			number_of_taps(input_rate, high_frequency) * Phases,
+			input_rate * float(Phases),
+			0.0f,
+			high_frequency,
+			FIRFilter::DefaultAttenuation);
+
+		// Applied from input sample n, phase p produces the output p sub-samples prior to n,
+		// so it uses every Phases-th coefficient, starting from p.
+		taps_ = (coefficients.size() + Phases - 1) / Phases;
+		for(std::size_t phase = 0; phase < Phases; ++phase) {
+			std::vector<float> phase_coefficients(taps_);
+			for(std::size_t tap = 0; tap < taps_; ++tap) {
+				const std::size_t index = tap * Phases + phase;
+				if(index < coefficients.size()) {
+					phase_coefficients[tap] = std::min(coefficients[index] * float(Phases), 1.0f);
+				}
+			}
+			filters_.emplace_back(phase_coefficients);
+		}
+	}
+
+	input_.resize(taps_ + BlockSize);
+}
+
+int16_t *Resampler::input_buffer(std::size_t &capacity) {
+	// If the buffer is full, move any samples that are still required to its start.
+	if(input_depth_ == input_.size()) {
+		if(input_position_ < input_depth_) {
+			std::memmove(input_.data(), &input_[input_position_], sizeof(int16_t) * (input_depth_ - input_position_));
+			input_depth_ -= input_position_;
+			input_position_ = 0;
+		} else {
+			input_position_ -= input_depth_;
+			input_depth_ = 0;
+		}
+	}
+
+	capacity = input_.size() - input_depth_;
+	return &input_[input_depth_];
+}
+
+std::size_t Resampler::get_output(int16_t *target, std::size_t count) {
+	if(input_depth_ < taps_) return 0;
+	const std::size_t last_position = input_depth_ - taps_;
+
+	// If input and output rates are integrally related then every output uses the same filter
+	// and the input advances by a fixed amount, so the filter can be applied as a batch.
+	if(filters_.size() == 1 && !fractional_step_) {
+		if(input_position_ > last_position) return 0;
+
+		const std::size_t available = (last_position - input_position_) / whole_step_ + 1;
+		const std::size_t produced = std::min(count, available);
+		filters_.front().apply(&input_[input_position_], target, produced, whole_step_);
+		input_position_ += produced * whole_step_;
+		return produced;
+	}
+
+	std::size_t produced = 0;
+	while(produced < count) {
+		// Determine the phase and first input sample for this output; anything that rounds to a
+		// nonzero sub-sample position is produced by a phase applied prior to the following sample.
+		std::size_t position = input_position_;
+		std::size_t phase = 0;
+		if(filters_.size() > 1) {
+			const auto sub_sample = std::size_t((fraction_ * Phases + output_rate_ / 2) / output_rate_);
+			if(sub_sample) {
+				++position;
+				phase = Phases - sub_sample;
+			}
+		}
+		if(position > last_position) break;
+
+		target[produced] = filters_[phase].apply(&input_[position]);
+		++produced;
+
+		fraction_ += fractional_step_;
+		input_position_ += whole_step_ + fraction_ / output_rate_;
+		fraction_ %= output_rate_;
+	}
+
+	return produced;
+}
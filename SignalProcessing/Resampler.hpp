@@ -0,0 +1,102 @@
+//
+//  Resampler.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Resampler_hpp
+#define Resampler_hpp
+
+#include "FIRFilter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SignalProcessing {
+
+/*!
+	Converts a 1d PCM signal from one sample rate to another, applying a low-pass filter
+	at the lower of half the output rate and any nominated cut-off.
+
+	Input is written directly into the resampler's own buffer and output is then drawn
+	from it in blocks, so that nothing is copied per sample:
+
+		1.	@c input_buffer supplies space for new input, which the caller populates and
+			then announces via @c did_write_input;
+		2.	@c get_output produces as many output samples as the buffered input permits.
+
+	The caller should drain all available output before requesting further input space.
+
+	Where the input rate is at least the output rate, each output sample is a single application
+	of the filter to the input. Otherwise a polyphase filter is used: the prototype filter is
+	designed for the input rate multiplied by a fixed number of phases, and the phase applied
+	for each output sample is that nearest to its position between input samples.
+
+	Rates need not be integral; the ratio between them is tracked in fixed point, with a precision
+	of 1/RateScale Hz.
+*/
+class Resampler {
+	public:
+		/// Thrown by the constructor if either rate is not positive.
+		enum class Error {
+			InvalidRate
+		};
+
+		/*!
+			Creates an instance of @c Resampler.
+
+			@param input_rate The sampling rate of the input signal.
+			@param output_rate The sampling rate of the output signal.
+			@param high_frequency_cutoff The highest frequency to retain in the output, if it is
+				lower than half the output rate; supply a negative number to use half the output rate.
+		*/
+		Resampler(float input_rate, float output_rate, float high_frequency_cutoff = -1.0f);
+
+		/*!
+			@returns A pointer to which up to @c capacity input samples may be written. The
+				caller should announce the number actually written via @c did_write_input.
+		*/
+		int16_t *input_buffer(std::size_t &capacity);
+
+		/// Announces that @c count samples have been written to the pointer last returned by @c input_buffer.
+		void did_write_input(std::size_t count) {
+			input_depth_ += count;
+		}
+
+		/*!
+			Writes up to @c count output samples to @c target.
+
+			@returns The number of samples written, which will be fewer than @c count only
+				if further input is required.
+		*/
+		std::size_t get_output(int16_t *target, std::size_t count);
+
+	private:
+		static constexpr int Phases = 32;
+		static constexpr std::size_t BlockSize = 4096;
+		static constexpr double RateScale = 65536.0;
+
+		const uint64_t input_rate_, output_rate_;
+
+		// One filter per phase; if the input rate is at least the output rate then there is only one.
+		std::vector<FIRFilter> filters_;
+		std::size_t taps_ = 0;
+
+		// Input is buffered linearly; retained samples are moved to the start of the buffer
+		// only when it fills.
+		std::vector<int16_t> input_;
+		std::size_t input_depth_ = 0;
+
+		// Rates are held multiplied by RateScale. The position of the next output sample is
+		// input_position_ + (fraction_ / output_rate_), in units of input samples.
+		std::size_t input_position_ = 0;
+		uint64_t fraction_ = 0;
+		const uint64_t whole_step_, fractional_step_;
+};
+
+}
+
+#endif /* Resampler_hpp */
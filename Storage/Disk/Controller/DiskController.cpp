@@ -45,13 +45,28 @@ void Controller::process_event(const Drive::Event &event) {
 }
 
 void Controller::advance(const Cycles cycles) {
-	if(is_reading_) pll_.run_for(Cycles(cycles.as_integral() * clock_rate_multiplier_));
+	if(is_reading_ && needs_flux_events_) pll_.run_for(Cycles(cycles.as_integral() * clock_rate_multiplier_));
+}
+
+bool Controller::needs_flux_events() {
+	return needs_flux_events_;
 }
 
 void Controller::process_write_completed() {
 	// Provided for subclasses to override.
 }
 
+// MARK: - Snapshots
+
+void Controller::save_state(Snapshot::Writer &writer) const {
+	writer.put(bit_length_, is_reading_);
+	pll_.save_state(writer);
+}
+
+bool Controller::restore_state(Snapshot::Reader &reader) {
+	return reader.get(bit_length_, is_reading_) && pll_.restore_state(reader);
+}
+
 // MARK: - PLL control and delegate
 
 void Controller::set_expected_bit_length(Time bit_length) {
@@ -109,3 +124,12 @@ void Controller::end_writing() {
 bool Controller::is_reading() {
 	return is_reading_;
 }
+
+void Controller::set_needs_flux_events(bool needs_flux_events) {
+	if(needs_flux_events_ == needs_flux_events) return;
+	needs_flux_events_ = needs_flux_events;
+
+	// The PLL hasn't been run while flux events weren't needed, so the first pulse to follow says nothing about bit length.
+	if(needs_flux_events) pll_.resynchronise();
+	get_drive().update_flux_events_needed();
+}
@@ -92,6 +92,12 @@ class Controller:
 		*/
 		bool is_reading();
 
+		/*!
+			Indicates whether the controller currently needs to observe the bit stream. If not then the PLL
+			is suspended and the drive may skip flux transitions, reporting only index holes. Defaults to @c true.
+		*/
+		void set_needs_flux_events(bool needs_flux_events);
+
 		/*!
 			Returns the connected drive or, if none is connected, an invented one. No guarantees are
 			made about the lifetime or the exclusivity of the invented drive.
@@ -103,12 +109,22 @@ class Controller:
 		*/
 		ClockingHint::Preference preferred_clocking() override;
 
+		/*!
+			Appends the controller's reading state, including that of its PLL, to @c writer.
+			Drives are not included; they should be saved by their owner.
+		*/
+		void save_state(Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Snapshot::Reader &reader);
+
 	private:
 		Time bit_length_;
 		Cycles::IntType clock_rate_multiplier_ = 1;
 		Cycles::IntType clock_rate_ = 1;
 
 		bool is_reading_ = true;
+		bool needs_flux_events_ = true;
 
 		DigitalPhaseLockedLoop<Controller> pll_;
 		friend DigitalPhaseLockedLoop<Controller>;
@@ -123,6 +139,7 @@ class Controller:
 		// for Drive::EventDelegate
 		void process_event(const Drive::Event &event) final;
 		void advance(const Cycles cycles) final;
+		bool needs_flux_events() final;
 
 		// to satisfy DigitalPhaseLockedLoop::Delegate
 		void digital_phase_locked_loop_output_bit(int value);
@@ -166,3 +166,24 @@ void MFMController::write_start_of_track() {
 		write_n_bytes(26, 0xff);
 	}
 }
+
+// MARK: - Snapshots
+
+void MFMController::save_state(Snapshot::Writer &writer) const {
+	Controller::save_state(writer);
+	shifter_.save_state(writer);
+	writer.put(latest_token_, is_double_density_, data_mode_, last_bit_, crc_generator_.get_value());
+}
+
+bool MFMController::restore_state(Snapshot::Reader &reader) {
+	uint16_t crc;
+	if(
+		!Controller::restore_state(reader) ||
+		!shifter_.restore_state(reader) ||
+		!reader.get(latest_token_, is_double_density_, data_mode_, last_bit_, crc)
+	) {
+		return false;
+	}
+	crc_generator_.set_value(crc);
+	return true;
+}
@@ -145,6 +145,12 @@ class MFMController: public Controller {
 		*/
 		void write_start_of_track();
 
+		/// Appends the controller's decoding state, and that of its base class, to @c writer.
+		void save_state(Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Snapshot::Reader &reader);
+
 	private:
 		// Storage::Disk::Controller
 		virtual void process_input_bit(int value);
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Snapshot.hpp"
 
 namespace Storage {
 
@@ -69,11 +70,39 @@ template <typename BitHandler, size_t length_of_history = 3> class DigitalPhaseL
 			if(!window_was_filled_) {
 				bit_handler_.digital_phase_locked_loop_output_bit(1);
 				window_was_filled_ = true;
-				post_phase_offset(phase_, offset_);
+				if(is_resynchronising_) {
+					is_resynchronising_ = false;
+					phase_ = window_length_ >> 1;
+				} else {
+					post_phase_offset(phase_, offset_);
+				}
 				offset_ = 0;
 			}
 		}
 
+		/*!
+			Indicates that the loop has not been run for a while, e.g. because nothing was listening for bits.
+			The next pulse will reestablish phase but will not be taken as a measure of window length.
+		*/
+		void resynchronise() {
+			is_resynchronising_ = true;
+		}
+
+		/// Appends the loop's current phase and history to @c writer.
+		void save_state(Storage::Snapshot::Writer &writer) const {
+			writer.put(offset_history_, offset_history_pointer_, total_spacing_, total_divisor_);
+			writer.put(phase_, window_length_, offset_, window_was_filled_, clocks_per_bit_);
+		}
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader) {
+			return
+				reader.get(offset_history_, offset_history_pointer_, total_spacing_, total_divisor_) &&
+				reader.get(phase_, window_length_, offset_, window_was_filled_, clocks_per_bit_) &&
+				offset_history_pointer_ < offset_history_.size() &&
+				total_divisor_ > 0 && window_length_ > 0;
+		}
+
 	private:
 		BitHandler &bit_handler_;
 
@@ -127,6 +156,7 @@ template <typename BitHandler, size_t length_of_history = 3> class DigitalPhaseL
 
 		Cycles::IntType offset_ = 0;
 		bool window_was_filled_ = false;
+		bool is_resynchronising_ = false;
 
 		int clocks_per_bit_ = 0;
 };
@@ -9,8 +9,10 @@
 #ifndef DiskImage_hpp
 #define DiskImage_hpp
 
+#include <cstdlib>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "../Disk.hpp"
 #include "../Track/Track.hpp"
@@ -70,10 +72,49 @@ class DiskImage {
 };
 
 class DiskImageHolderBase: public Disk {
+	public:
+		/*!
+			Counts the outcomes of requests for tracks that were not already in use: a hit is a track that
+			had been decoded speculatively in advance; a miss is one that had to be decoded on demand.
+		*/
+		struct PrefetchStatistics {
+			std::size_t hits = 0;
+			std::size_t misses = 0;
+		};
+
+		/// @returns the counts of prefetch hits and misses so far.
+		const PrefetchStatistics &get_prefetch_statistics() const {
+			return prefetch_statistics_;
+		}
+
+		/// Blocks until all speculative decoding and pending writes have completed; primarily for testing.
+		void flush_update_queue() {
+			if(update_queue_) update_queue_->flush();
+		}
+
 	protected:
 		std::set<Track::Address> unwritten_tracks_;
 		std::map<Track::Address, std::shared_ptr<Track>> cached_tracks_;
 		std::unique_ptr<Concurrency::AsyncTaskQueue> update_queue_;
+
+		/// The maximum number of speculatively-decoded tracks that are held before first use.
+		static constexpr std::size_t MaximumPrefetchedTracks = 8;
+
+		// Tracks are decoded speculatively on update_queue_ into prefetched_tracks_, and moved from
+		// there to cached_tracks_ upon first use. A null track records that there was nothing to decode.
+		// All access to the disk image, whether to decode or to write, is serialised by image_mutex_;
+		// prefetch_mutex_ guards only prefetched_tracks_ and prefetch_centre_, so that a lookup never
+		// waits for a speculative decode.
+		std::mutex image_mutex_;
+		std::mutex prefetch_mutex_;
+		std::map<Track::Address, std::shared_ptr<Track>> prefetched_tracks_;
+		Track::Address prefetch_centre_ = Track::Address(0, HeadPosition(0));
+		PrefetchStatistics prefetch_statistics_;
+
+		/// @returns a measure of the distance between @c lhs and @c rhs, for selecting prefetched tracks to discard.
+		static int prefetch_distance(const Track::Address &lhs, const Track::Address &rhs) {
+			return std::abs(lhs.position.as_quarter() - rhs.position.as_quarter()) + std::abs(lhs.head - rhs.head);
+		}
 };
 
 /*!
@@ -96,6 +137,9 @@ template <typename T> class DiskImageHolder: public DiskImageHolderBase {
 
 	private:
 		T disk_image_;
+
+		/// Enqueues speculative decoding of the tracks either side of, and on other heads alongside, @c address.
+		void prefetch_around(Track::Address address);
 };
 
 #include "DiskImageImplementation.hpp"
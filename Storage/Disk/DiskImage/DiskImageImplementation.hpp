@@ -30,6 +30,7 @@ template <typename T> void DiskImageHolder<T>::flush_tracks() {
 		unwritten_tracks_.clear();
 
 		update_queue_->enqueue([this, track_copies]() {
+			std::lock_guard<std::mutex> lock_guard(image_mutex_);
 			disk_image_.set_tracks(*track_copies);
 		});
 	}
@@ -49,12 +50,89 @@ template <typename T> std::shared_ptr<Track> DiskImageHolder<T>::get_track_at_po
 	auto cached_track = cached_tracks_.find(address);
 	if(cached_track != cached_tracks_.end()) return cached_track->second;
 
-	std::shared_ptr<Track> track = disk_image_.get_track_at_position(address);
+	// Use a speculatively-decoded track if one is available; otherwise decode now.
+	std::shared_ptr<Track> track;
+	bool was_prefetched = false;
+	{
+		std::lock_guard<std::mutex> lock_guard(prefetch_mutex_);
+		auto prefetched_track = prefetched_tracks_.find(address);
+		if(prefetched_track != prefetched_tracks_.end()) {
+			track = prefetched_track->second;
+			prefetched_tracks_.erase(prefetched_track);
+			was_prefetched = true;
+		}
+	}
+	if(was_prefetched) {
+		++prefetch_statistics_.hits;
+	} else {
+		std::lock_guard<std::mutex> lock_guard(image_mutex_);
+		track = disk_image_.get_track_at_position(address);
+		++prefetch_statistics_.misses;
+	}
+	prefetch_around(address);
+
 	if(!track) return nullptr;
 	cached_tracks_[address] = track;
 	return track;
 }
 
+template <typename T> void DiskImageHolder<T>::prefetch_around(Track::Address address) {
+	// Nominate the tracks one step either side of this one, and those alongside it on other heads.
+	std::vector<Track::Address> addresses;
+	const int head_count = get_head_count();
+	const HeadPosition maximum_position = get_maximum_head_position();
+	for(int head = 0; head < head_count; ++head) {
+		for(int offset = -1; offset <= 1; ++offset) {
+			if(head == address.head && !offset) continue;
+
+			Track::Address candidate(head, address.position);
+			candidate.position += HeadPosition(offset);
+			if(candidate.position < HeadPosition(0) || candidate.position >= maximum_position) continue;
+			if(cached_tracks_.find(candidate) != cached_tracks_.end()) continue;
+			addresses.push_back(candidate);
+		}
+	}
+	if(addresses.empty()) return;
+
+	{
+		std::lock_guard<std::mutex> lock_guard(prefetch_mutex_);
+		prefetch_centre_ = address;
+	}
+
+	// Tracks are decoded on the same serial queue as writes are performed, so that a prefetch
+	// never observes a partially-written image. A track that is written after being prefetched
+	// will already be in cached_tracks_, which is consulted first.
+	if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
+	update_queue_->enqueue([this, addresses = std::move(addresses)]() {
+		for(const auto &target: addresses) {
+			{
+				std::lock_guard<std::mutex> lock_guard(prefetch_mutex_);
+				if(prefetched_tracks_.find(target) != prefetched_tracks_.end()) continue;
+			}
+
+			std::shared_ptr<Track> track;
+			{
+				std::lock_guard<std::mutex> lock_guard(image_mutex_);
+				track = disk_image_.get_track_at_position(target);
+			}
+
+			std::lock_guard<std::mutex> lock_guard(prefetch_mutex_);
+			prefetched_tracks_[target] = std::move(track);
+
+			// Keep the cache bounded by discarding whichever track is furthest from the head.
+			while(prefetched_tracks_.size() > MaximumPrefetchedTracks) {
+				auto furthest = prefetched_tracks_.begin();
+				for(auto iterator = prefetched_tracks_.begin(); iterator != prefetched_tracks_.end(); ++iterator) {
+					if(prefetch_distance(iterator->first, prefetch_centre_) > prefetch_distance(furthest->first, prefetch_centre_)) {
+						furthest = iterator;
+					}
+				}
+				prefetched_tracks_.erase(furthest);
+			}
+		}
+	});
+}
+
 template <typename T> DiskImageHolder<T>::~DiskImageHolder() {
 	if(update_queue_) update_queue_->flush();
 }
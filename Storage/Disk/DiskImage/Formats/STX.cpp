@@ -389,7 +389,7 @@ class TrackConstructor {
 
 }
 
-STX::STX(const std::string &file_name) : file_(file_name) {
+STX::STX(const std::string &file_name) : file_(file_name, FileHolder::FileMode::MappedRead) {
 	// Require that this be a version 3 Pasti.
 	if(!file_.check_signature("RSY", 4)) throw Error::InvalidFormat;
 	if(file_.get16le() != 3) throw Error::InvalidFormat;
@@ -468,8 +468,8 @@ std::shared_ptr<::Storage::Disk::Track> STX::get_track_at_position(::Storage::Di
 
 	// If this is a trivial .ST-style sector dump, life is easy.
 	if(!(flags & 1)) {
-		const auto sector_contents = file_.read(sector_count * 512);
-		return track_for_sectors(sector_contents.data(), sector_count, uint8_t(address.position.as_int()), uint8_t(address.head), 1, 2, true);
+		const auto sector_contents = file_.span(sector_count * 512);
+		return track_for_sectors(sector_contents.data(), int(sector_contents.size() / 512), uint8_t(address.position.as_int()), uint8_t(address.head), 1, 2, true);
 	}
 
 	// Grab sector records, if provided.
@@ -569,10 +569,9 @@ std::shared_ptr<::Storage::Disk::Track> STX::get_track_at_position(::Storage::Di
 			continue;
 		}
 
-		// This is going to be a new-format record.
-		for(size_t c = 0; c < timing_record_size; ++c) {
-			sector.timing[c] = file_.get16be();		// These values are big endian, unlike the rest of the file.
-		}
+		// This is going to be a new-format record. These values are big endian, unlike the rest of the file.
+		sector.timing = file_.read_be<uint16_t>(timing_record_size);
+		sector.timing.resize(timing_record_size, 0xffff);
 	}
 
 	// Sort the sectors by starting position. It's perfectly possible that they're always
@@ -11,12 +11,16 @@
 #include "../../Track/PCMTrack.hpp"
 #include "../../Track/TrackSerialiser.hpp"
 
+#define LOG_PREFIX "[WOZ] "
+#include "../../../../Outputs/Log.hpp"
+
 #include <cstring>
 
 using namespace Storage::Disk;
 
 WOZ::WOZ(const std::string &file_name) :
-	file_(file_name) {
+	file_(file_name, FileHolder::FileMode::MappedCopyOnWrite),
+	file_name_(file_name) {
 
 	const char signature[8] = {
 		'W', 'O', 'Z', '1',
@@ -27,11 +31,8 @@ WOZ::WOZ(const std::string &file_name) :
 	// Get the file's CRC32.
 	const uint32_t crc = file_.get32le();
 
-	// Get the collection of all data that contributes to the CRC.
-	post_crc_contents_ = file_.read(static_cast<std::size_t>(file_.stats().st_size - 12));
-
-	// Test the CRC.
-	const uint32_t computed_crc = crc_generator.compute_crc(post_crc_contents_);
+	// Test the CRC, which covers the entire remainder of the file.
+	const uint32_t computed_crc = crc_generator.compute_crc(post_crc_contents());
 	if(crc != computed_crc) {
 		 throw Error::InvalidFormat;
 	}
@@ -107,51 +108,69 @@ std::shared_ptr<Track> WOZ::get_track_at_position(Track::Address address) {
 	if(offset == NoSuchTrack) return nullptr;
 
 	// Seek to the real track.
-	std::vector<uint8_t> track_contents;
-	size_t number_of_bits;
-	{
-		std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
-		file_.seek(offset, SEEK_SET);
-
-		// In WOZ a track is up to 6646 bytes of data, followed by a two-byte record of the
-		// number of bytes that actually had data in them, then a two-byte count of the number
-		// of bits that were used. Other information follows but is not intended for emulation.
-		track_contents = file_.read(6646);
-		file_.seek(2, SEEK_CUR);
-		number_of_bits = std::min(file_.get16le(), static_cast<uint16_t>(6646*8));
-	}
+	std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
+	file_.seek(offset, SEEK_SET);
+
+	// In WOZ a track is up to 6646 bytes of data, followed by a two-byte record of the
+	// number of bytes that actually had data in them, then a two-byte count of the number
+	// of bits that were used. Other information follows but is not intended for emulation.
+	const auto track_contents = file_.span(6646);
+	file_.seek(2, SEEK_CUR);
+	const size_t number_of_bits = std::min(size_t(file_.get16le()), track_contents.size() * 8);
 
-	return std::make_shared<PCMTrack>(PCMSegment(number_of_bits, track_contents));
+	return std::make_shared<PCMTrack>(PCMSegment(number_of_bits, track_contents.data()));
+}
+
+Storage::FileHolder::Span WOZ::post_crc_contents() {
+	file_.seek(12, SEEK_SET);
+	return file_.span(static_cast<std::size_t>(file_.stats().st_size - 12));
 }
 
 void WOZ::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
+	std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
+
 	for(const auto &pair: tracks) {
-		// Decode the track and store, patching into the post_crc_contents_.
+		// Decode the track and patch it into the in-memory copy of the file.
 		auto segment = Storage::Disk::track_serialisation(*pair.second, Storage::Time(1, 50000));
-
-		auto offset = static_cast<std::size_t>(file_offset(pair.first) - 12);
 		std::vector<uint8_t> segment_bytes = segment.byte_data();
-		memcpy(&post_crc_contents_[offset - 12], segment_bytes.data(), segment_bytes.size());
+		segment_bytes.resize(std::min(segment_bytes.size(), size_t(6646)));
+
+		file_.seek(file_offset(pair.first), SEEK_SET);
+		file_.write(segment_bytes);
 
 		// Write number of bytes and number of bits.
-		post_crc_contents_[offset + 6646] = static_cast<uint8_t>(segment.data.size() >> 3);
-		post_crc_contents_[offset + 6647] = static_cast<uint8_t>(segment.data.size() >> 11);
-		post_crc_contents_[offset + 6648] = static_cast<uint8_t>(segment.data.size());
-		post_crc_contents_[offset + 6649] = static_cast<uint8_t>(segment.data.size() >> 8);
+		file_.seek(file_offset(pair.first) + 6646, SEEK_SET);
+		file_.put_le(static_cast<uint16_t>(segment.data.size() >> 3));
+		file_.put_le(static_cast<uint16_t>(segment.data.size()));
 
 		// Set no splice information now provided, since it's been lost if ever it was known.
-		post_crc_contents_[offset + 6650] = 0xff;
-		post_crc_contents_[offset + 6651] = 0xff;
+		file_.put16le(0xffff);
 	}
 
 	// Calculate the new CRC.
-	const uint32_t crc = crc_generator.compute_crc(post_crc_contents_);
-
-	// Grab the file lock, then write the CRC, then just dump the entire file buffer.
-	std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
+	const auto contents = post_crc_contents();
+	const uint32_t crc = crc_generator.compute_crc(contents);
 	file_.seek(8, SEEK_SET);
 	file_.put_le(crc);
-	file_.write(post_crc_contents_);
+
+	// Write the CRC and then just dump the entire in-memory copy. Since the file then matches the
+	// mapping exactly, it doesn't matter whether this write is visible through the mapping.
+	if(file_.get_is_known_read_only()) return;
+	try {
+		FileHolder output(file_name_, FileHolder::FileMode::ReadWrite);
+		if(output.get_is_known_read_only()) {
+			ERROR("Couldn't write back " << file_name_ << ": it can no longer be opened for writing");
+			return;
+		}
+
+		output.seek(8, SEEK_SET);
+		output.put_le(crc);
+		if(output.write(contents.data(), contents.size()) != contents.size()) {
+			ERROR("Couldn't write back " << file_name_ << ": only part of the file was written");
+		}
+	} catch(const FileHolder::Error &) {
+		ERROR("Couldn't write back " << file_name_ << ": it can no longer be opened");
+	}
 }
 
 bool WOZ::get_is_read_only() {
@@ -34,14 +34,17 @@ class WOZ: public DiskImage {
 
 	private:
 		Storage::FileHolder file_;
+		std::string file_name_;
 		bool is_read_only_ = false;
 		bool is_3_5_disk_ = false;
 		uint8_t track_map_[160];
 		long tracks_offset_ = -1;
 
-		std::vector<uint8_t> post_crc_contents_;
 		CRC::CRC32 crc_generator;
 
+		/// @returns a span of all file contents that contribute to the CRC.
+		FileHolder::Span post_crc_contents();
+
 		/*!
 			Gets the in-file offset of a track.
 
@@ -189,6 +189,24 @@ bool Drive::get_index_pulse() const {
 
 void Drive::set_event_delegate(Storage::Disk::Drive::EventDelegate *delegate) {
 	event_delegate_ = delegate;
+	update_flux_events_needed();
+}
+
+bool Drive::flux_events_needed() const {
+	return event_delegate_ && event_delegate_->needs_flux_events();
+}
+
+void Drive::update_flux_events_needed() {
+	if(!is_skipping_flux_ || !flux_events_needed()) return;
+
+	// Reacquire the track, and hence the events within it, at the current position. If an event is being
+	// processed then that'll happen as a result; otherwise the pending index hole is discarded.
+	is_skipping_flux_ = false;
+	track_ = nullptr;
+	if(!is_processing_event_) {
+		reset_timer();
+		get_next_event(0.0f);
+	}
 }
 
 void Drive::advance(const Cycles cycles) {
@@ -256,6 +274,21 @@ void Drive::get_next_event(float duration_already_passed) {
 		return;
 	}
 
+	// If nobody is interested in flux transitions, proceed directly to the next index hole.
+	if(is_reading_ && !flux_events_needed()) {
+		is_skipping_flux_ = true;
+		random_interval_ = 0.0f;
+
+		current_event_.type = Track::Event::IndexHole;
+		current_event_.length = std::max(1.0f - get_time_into_track(), 0.0f);
+		set_next_event_time_interval(current_event_.length * rotational_multiplier_);
+		return;
+	}
+	if(is_skipping_flux_) {
+		is_skipping_flux_ = false;
+		track_ = nullptr;
+	}
+
 	// Grab a new track if not already in possession of one. This will recursively call get_next_event,
 	// supplying a proper duration_already_passed.
 	if(!track_) {
@@ -316,12 +349,19 @@ void Drive::process_next_event() {
 			is_ready_ = true;
 		}
 		cycles_since_index_hole_ = 0;
+
+		// While skipping, the index pulse begins only as the index hole is reached.
+		if(is_skipping_flux_) {
+			index_pulse_remaining_ = Cycles((get_input_clock_rate() * 2) / 1000);
+		}
 	}
 	if(
 		event_delegate_ &&
 		(current_event_.type == Track::Event::IndexHole || is_reading_)
 	){
+		is_processing_event_ = true;
 		event_delegate_->process_event(current_event_);
+		is_processing_event_ = false;
 	}
 	get_next_event(0.0f);
 }
@@ -338,6 +378,10 @@ void Drive::set_track(const std::shared_ptr<Track> &track) {
 }
 
 void Drive::setup_track() {
+	get_next_event(acquire_track());
+}
+
+float Drive::acquire_track() {
 	track_ = get_track();
 	if(!track_) {
 		track_ = std::make_shared<UnformattedTrack>();
@@ -356,7 +400,7 @@ void Drive::setup_track() {
 	// but if the track has rounded one way or the other it may now be very slightly adrift.
 	cycles_since_index_hole_ = (int((time_found + offset) * cycles_per_revolution_)) % cycles_per_revolution_;
 
-	get_next_event(offset);
+	return offset;
 }
 
 void Drive::invalidate_track() {
@@ -375,9 +419,11 @@ void Drive::begin_writing(Time bit_length, bool clamp_to_index_hole) {
 	// TODO: cope properly if there's no disk to write to.
 	if(!is_reading_ || !disk_) return;
 
-	// Get a copy of the track if that hasn't happened yet.
+	// Get a copy of the track if that hasn't happened yet; if the pending event is a skip to
+	// the index hole then leave it pending.
 	if(!track_) {
-		setup_track();
+		if(is_skipping_flux_) acquire_track();
+		else setup_track();
 	}
 
 	// Store the relevant parameters, and kick off writing.
@@ -420,6 +466,7 @@ void Drive::end_writing() {
 		patched_track_->add_segment(write_start_time_, write_segment_, clamp_writing_to_index_hole_);
 		cycles_since_index_hole_ %= cycles_per_revolution_;
 		invalidate_track();
+		update_flux_events_needed();
 	}
 }
 
@@ -462,3 +509,95 @@ void Drive::set_activity_observer(Activity::Observer *observer, const std::strin
 		}
 	}
 }
+
+// MARK: - Snapshots
+
+void Drive::save_state(Snapshot::Writer &writer) const {
+	writer.begin("DRIV", 1);
+	TimedEventLoop::save_state(writer);
+	writer.put(
+		current_event_.type, current_event_.length,
+		rotational_multiplier_, cycles_per_revolution_, cycles_since_index_hole_,
+		head_position_, head_,
+		motor_input_is_on_, disk_is_rotating_, time_until_motor_transition,
+		index_pulse_remaining_,
+		ready_index_count_, is_ready_,
+		random_source_, random_interval_
+	);
+
+	// Any write in progress.
+	writer.put(is_reading_);
+	if(!is_reading_) {
+		writer.put(
+			clamp_writing_to_index_hole_, write_start_time_, write_segment_.length_of_a_bit,
+			cycles_until_bits_written_, cycles_per_bit_, uint32_t(write_segment_.data.size())
+		);
+		writer.put_vector(write_segment_.byte_data());
+	}
+	writer.end();
+}
+
+bool Drive::restore_state(Snapshot::Reader &reader) {
+	if(!reader.begin("DRIV", 1)) return false;
+
+	const bool was_rotating = disk_is_rotating_;
+	if(
+		!TimedEventLoop::restore_state(reader) ||
+		!reader.get(
+			current_event_.type, current_event_.length,
+			rotational_multiplier_, cycles_per_revolution_, cycles_since_index_hole_,
+			head_position_, head_,
+			motor_input_is_on_, disk_is_rotating_, time_until_motor_transition,
+			index_pulse_remaining_,
+			ready_index_count_, is_ready_,
+			random_source_, random_interval_,
+			is_reading_
+		) ||
+		cycles_per_revolution_ <= 0 || head_ < 0 || head_ >= std::max(available_heads_, 1)
+	) {
+		return false;
+	}
+
+	write_segment_.data.clear();
+	if(!is_reading_) {
+		uint32_t bit_count;
+		std::vector<uint8_t> bits;
+		if(
+			!reader.get(
+				clamp_writing_to_index_hole_, write_start_time_, write_segment_.length_of_a_bit,
+				cycles_until_bits_written_, cycles_per_bit_, bit_count
+			) ||
+			!reader.get_vector(bits) ||
+			bits.size() != (size_t(bit_count) + 7) >> 3
+		) {
+			return false;
+		}
+
+		write_segment_.data = PCMSegment(bit_count, bits).data;
+	}
+
+	// The position within the track isn't captured; drop the current track so that it is reacquired,
+	// and sought to by rotational position, once the pending event has occurred.
+	patched_track_ = nullptr;
+	track_ = nullptr;
+
+	// A pending index hole may have been a skip, if flux transitions aren't currently needed; if so then
+	// treat it as one, so that it is abandoned should they become needed before it occurs.
+	is_skipping_flux_ = current_event_.type == Track::Event::IndexHole && !flux_events_needed();
+	if(!is_reading_ && disk_) {
+		// end_writing will patch the current track, so one is needed immediately.
+		track_ = get_track();
+		if(!track_) track_ = std::make_shared<UnformattedTrack>();
+		track_->seek_to(Time(get_time_into_track()));
+	}
+
+	if(observer_ && was_rotating != disk_is_rotating_) {
+		observer_->set_drive_motor_status(drive_name_, motor_input_is_on_);
+		if(announce_motor_led_) {
+			observer_->set_led_status(drive_name_, motor_input_is_on_);
+		}
+	}
+	update_clocking_observer();
+
+	return reader.end();
+}
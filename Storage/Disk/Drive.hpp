@@ -125,6 +125,21 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		void run_for(const Cycles cycles);
 
+		/*!
+			Appends the drive's mechanical state — head position, motor, rotation and any
+			write in progress — to @c writer. The disk itself is not captured.
+		*/
+		void save_state(Snapshot::Writer &writer) const;
+
+		/*!
+			Restores state saved by @c save_state. The current event is restored exactly, but the
+			position within the track that follows it is subsequently re-derived from the disk's
+			rotation, as it would be after a step.
+
+			@returns @c true on success; @c false otherwise.
+		*/
+		bool restore_state(Snapshot::Reader &reader);
+
 		struct Event {
 			Track::Event::Type type;
 			float length = 0.0f;
@@ -146,11 +161,25 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 			/// Informs the delegate of the passing of @c cycles.
 			virtual void advance(const Cycles cycles) {}
+
+			/*!
+				@returns @c true if the delegate currently needs to be informed of flux transitions; @c false if
+				index holes alone will do, in which case the drive may skip directly from one index hole to the next.
+
+				A delegate whose answer changes from @c false to @c true should call @c Drive::update_flux_events_needed.
+			*/
+			virtual bool needs_flux_events() { return true; }
 		};
 
 		/// Sets the current event delegate.
 		void set_event_delegate(EventDelegate *);
 
+		/*!
+			Re-queries the event delegate's @c needs_flux_events. If flux transitions have been skipped
+			but are now needed then they resume immediately, from the current rotational position.
+		*/
+		void update_flux_events_needed();
+
 		// As per Sleeper.
 		ClockingHint::Preference preferred_clocking() final;
 
@@ -251,6 +280,12 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		Time cycles_until_bits_written_;
 		Time cycles_per_bit_;
 
+		// If no flux transitions are needed then events are scheduled only for index holes, and
+		// the track is sought to by rotational position once flux transitions are next needed.
+		bool is_skipping_flux_ = false;
+		bool is_processing_event_ = false;
+		bool flux_events_needed() const;
+
 		// TimedEventLoop call-ins and state.
 		void process_next_event() override;
 		void get_next_event(float duration_already_passed);
@@ -273,6 +308,7 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		void set_track(const std::shared_ptr<Track> &track);
 
 		void setup_track();
+		float acquire_track();
 		void invalidate_track();
 
 		// Activity observer description.
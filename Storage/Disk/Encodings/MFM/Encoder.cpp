@@ -24,7 +24,7 @@ enum class SurfaceItem {
 
 class MFMEncoder: public Encoder {
 	public:
-		MFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
+		MFMEncoder(Numeric::BitVector &target, Numeric::BitVector *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
 		virtual ~MFMEncoder() {}
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
@@ -103,7 +103,7 @@ class MFMEncoder: public Encoder {
 class FMEncoder: public Encoder {
 	// encodes each 16-bit part as clock, data, clock, data [...]
 	public:
-		FMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
+		FMEncoder(Numeric::BitVector &target, Numeric::BitVector *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
 			crc_generator_.add(input);
@@ -286,10 +286,10 @@ template<class T> std::shared_ptr<Storage::Disk::Track>
 	return std::make_shared<Storage::Disk::PCMTrack>(std::move(segment));
 }
 
-Encoder::Encoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target) :
+Encoder::Encoder(Numeric::BitVector &target, Numeric::BitVector *fuzzy_target) :
 	target_(&target), fuzzy_target_(fuzzy_target) {}
 
-void Encoder::reset_target(std::vector<bool> &target, std::vector<bool> *fuzzy_target) {
+void Encoder::reset_target(Numeric::BitVector &target, Numeric::BitVector *fuzzy_target) {
 	target_ = &target;
 	fuzzy_target_ = fuzzy_target;
 }
@@ -306,12 +306,8 @@ void Encoder::output_short(uint16_t value, uint16_t fuzzy_mask) {
 		value &= ~fuzzy_mask;
 	}
 
-	uint16_t mask = 0x8000;
-	while(mask) {
-		target_->push_back(value & mask);
-		if(write_fuzzy_bits) fuzzy_target_->push_back(fuzzy_mask & mask);
-		mask >>= 1;
-	}
+	target_->append_bits(uint64_t(value) << 48, 16);
+	if(write_fuzzy_bits) fuzzy_target_->append_bits(uint64_t(fuzzy_mask) << 48, 16);
 }
 
 void Encoder::add_crc(bool incorrectly) {
@@ -374,10 +370,10 @@ std::shared_ptr<Storage::Disk::Track> Storage::Encodings::MFM::GetMFMTrackWithSe
 		12500);	// unintelligently: double the single-density bytes/rotation (or: 500kbps @ 300 rpm)
 }
 
-std::unique_ptr<Encoder> Storage::Encodings::MFM::GetMFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target) {
+std::unique_ptr<Encoder> Storage::Encodings::MFM::GetMFMEncoder(Numeric::BitVector &target, Numeric::BitVector *fuzzy_target) {
 	return std::make_unique<MFMEncoder>(target, fuzzy_target);
 }
 
-std::unique_ptr<Encoder> Storage::Encodings::MFM::GetFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target) {
+std::unique_ptr<Encoder> Storage::Encodings::MFM::GetFMEncoder(Numeric::BitVector &target, Numeric::BitVector *fuzzy_target) {
 	return std::make_unique<FMEncoder>(target, fuzzy_target);
 }
@@ -132,3 +132,20 @@ uint8_t Shifter::get_byte() const {
 		((shift_register_ & 0x1000) >> 6) |
 		((shift_register_ & 0x4000) >> 7));
 }
+
+void Shifter::save_state(Snapshot::Writer &writer) const {
+	writer.put(bits_since_token_, shift_register_, is_awaiting_marker_value_, should_obey_syncs_, token_, is_double_density_);
+	if(owned_crc_generator_) writer.put(owned_crc_generator_->get_value());
+}
+
+bool Shifter::restore_state(Snapshot::Reader &reader) {
+	if(!reader.get(bits_since_token_, shift_register_, is_awaiting_marker_value_, should_obey_syncs_, token_, is_double_density_)) {
+		return false;
+	}
+	if(owned_crc_generator_) {
+		uint16_t crc;
+		if(!reader.get(crc)) return false;
+		owned_crc_generator_->set_value(crc);
+	}
+	return true;
+}
@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <memory>
 #include "../../../../Numeric/CRC.hpp"
+#include "../../../Snapshot.hpp"
 
 namespace Storage {
 namespace Encodings {
@@ -65,6 +66,12 @@ class Shifter {
 			return *crc_generator_;
 		}
 
+		/// Appends the shifter's state to @c writer, including that of its CRC generator if it owns one.
+		void save_state(Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Snapshot::Reader &reader);
+
 	private:
 		// Bit stream input state.
 		int bits_since_token_ = 0;
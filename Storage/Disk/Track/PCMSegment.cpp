@@ -47,27 +47,34 @@ void PCMSegmentEventSource::reset() {
 }
 
 PCMSegment &PCMSegment::operator +=(const PCMSegment &rhs) {
-	data.insert(data.end(), rhs.data.begin(), rhs.data.end());
+	data += rhs.data;
 	return *this;
 }
 
 void PCMSegment::rotate_right(size_t length) {
-	length %= data.size();
-	if(!length) return;
-
-	// To rotate to the right, front-insert the proper number
-	// of bits from the end and then resize. To rotate to
-	// the left, do the opposite.
-	std::vector<uint8_t> data_copy;
-	if(length > 0) {
-		data_copy.insert(data_copy.end(), data.end() - static_cast<off_t>(length), data.end());
-		data.erase(data.end() - static_cast<off_t>(length), data.end());
-		data.insert(data.begin(), data_copy.begin(), data_copy.end());
-	} else {
-		data_copy.insert(data_copy.end(), data.begin(), data.begin() - static_cast<off_t>(length));
-		data.erase(data.begin(), data.begin() - static_cast<off_t>(length));
-		data.insert(data.end(), data_copy.begin(), data_copy.end());
+	data.rotate_right(length);
+}
+
+std::vector<uint8_t> PCMSegment::byte_data(bool msb_first) const {
+	std::vector<uint8_t> bytes((data.size() + 7) >> 3);
+
+	// Bits are stored MSB first, so whole bytes can be lifted directly from each word.
+	auto output = bytes.begin();
+	for(const auto word: data.words()) {
+		for(int shift = 56; shift >= 0 && output != bytes.end(); shift -= 8) {
+			*output = uint8_t(word >> shift);
+			++output;
+		}
+	}
+
+	if(!msb_first) {
+		for(auto &byte: bytes) {
+			byte = uint8_t(((byte & 0xf0) >> 4) | ((byte & 0x0f) << 4));
+			byte = uint8_t(((byte & 0xcc) >> 2) | ((byte & 0x33) << 2));
+			byte = uint8_t(((byte & 0xaa) >> 1) | ((byte & 0x55) << 1));
+		}
 	}
+	return bytes;
 }
 
 Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
@@ -79,16 +86,28 @@ Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// is set, it should be in the centre of its window.
 	next_event_.length.length = bit_pointer_ ? 0 : -(segment_->length_of_a_bit.length >> 1);
 
-	// search for the next bit that is set, if any
-	while(bit_pointer_ < segment_->data.size()) {
-		bool bit = segment_->data[bit_pointer_];
-		++bit_pointer_;	// so this always points one beyond the most recent bit returned
-		next_event_.length.length += segment_->length_of_a_bit.length;
+	// Search for the next bit that is set, if any, a word at a time. A fuzzy bit that precedes
+	// it produces an event only if a random bit of 1 is selected.
+	const auto &data = segment_->data;
+	const auto &fuzzy_mask = segment_->fuzzy_mask;
+	while(bit_pointer_ < data.size()) {
+		std::size_t next_bit = data.find_next_set(bit_pointer_);
+
+		const std::size_t next_fuzzy_bit = fuzzy_mask.find_next_set(bit_pointer_);
+		const bool is_fuzzy = next_fuzzy_bit < next_bit && next_fuzzy_bit < fuzzy_mask.size();
+		if(is_fuzzy) next_bit = next_fuzzy_bit;
+
+		if(next_bit >= data.size()) {
+			next_event_.length.length += segment_->length_of_a_bit.length * static_cast<unsigned int>(data.size() - bit_pointer_);
+			bit_pointer_ = data.size();
+			break;
+		}
+
+		// Leave bit_pointer_ pointing one beyond the most recent bit considered.
+		next_event_.length.length += segment_->length_of_a_bit.length * static_cast<unsigned int>(next_bit + 1 - bit_pointer_);
+		bit_pointer_ = next_bit + 1;
 
-		// if this bit is set, or is fuzzy and a random bit of 1 is selected, return the event.
-		if(bit ||
-			(!segment_->fuzzy_mask.empty() && segment_->fuzzy_mask[bit_pointer_] && lfsr_.next())
-		)	return next_event_;
+		if(!is_fuzzy || lfsr_.next()) return next_event_;
 	}
 
 	// If the end is reached without a bit being set, it'll be index holes from now on.
@@ -98,7 +117,7 @@ Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// allow an extra half bit's length to run from the position of the potential final transition
 	// event to the end of the segment. Otherwise don't allow any extra time, as it's already
 	// been consumed.
-	if(initial_bit_pointer <= segment_->data.size()) {
+	if(initial_bit_pointer <= data.size()) {
 		next_event_.length.length += (segment_->length_of_a_bit.length >> 1);
 		bit_pointer_++;
 	}
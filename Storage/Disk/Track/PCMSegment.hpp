@@ -9,11 +9,13 @@
 #ifndef PCMSegment_hpp
 #define PCMSegment_hpp
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "../../Storage.hpp"
+#include "../../../Numeric/BitVector.hpp"
 #include "../../../Numeric/LFSR.hpp"
 #include "Track.hpp"
 
@@ -31,27 +33,26 @@ struct PCMSegment {
 	Time length_of_a_bit = Time(1);
 
 	/*!
-		This is the actual data, taking advantage of the std::vector<bool>
-		specialisation to use whatever one-bit-per-value encoding is
-		most suited to this architecture.
+		This is the actual data, packed 64 bits to a word so that the gaps
+		between flux transitions can be found a word at a time.
 
 		If a value is @c true then a flux transition occurs in that window.
 		If it is @c false then no flux transition occurs.
 	*/
-	std::vector<bool> data;
+	Numeric::BitVector data;
 
 	/*!
 		If a segment has a fuzzy mask then anywhere the mask has a value
 		of @c true, a random bit will be ORd onto whatever is in the
 		corresponding slot in @c data.
 	*/
-	std::vector<bool> fuzzy_mask;
+	Numeric::BitVector fuzzy_mask;
 
 	/*!
 		Constructs an instance of PCMSegment with the specified @c length_of_a_bit
 		and @c data.
 	*/
-	PCMSegment(Time length_of_a_bit, const std::vector<bool> &data)
+	PCMSegment(Time length_of_a_bit, const Numeric::BitVector &data)
 		: length_of_a_bit(length_of_a_bit), data(data) {}
 
 	/*!
@@ -59,12 +60,18 @@ struct PCMSegment {
 		long and @c data is populated from the supplied @c source by serialising it
 		from MSB to LSB for @c number_of_bits.
 	*/
-	PCMSegment(size_t number_of_bits, const uint8_t *source)
-		: data(number_of_bits, false) {
-		for(size_t c = 0; c < number_of_bits; ++c) {
-			if((source[c >> 3] >> (7 ^ (c & 7)))&1) {
-				data[c] = true;
+	PCMSegment(size_t number_of_bits, const uint8_t *source) {
+		data.reserve(number_of_bits);
+		while(number_of_bits) {
+			const size_t bits = std::min(number_of_bits, size_t(64));
+			uint64_t word = 0;
+			for(size_t c = 0; c < (bits + 7) >> 3; ++c) {
+				word |= uint64_t(source[c]) << (56 - c*8);
 			}
+			data.append_bits(word, bits);
+
+			source += 8;
+			number_of_bits -= bits;
 		}
 	}
 
@@ -129,16 +136,7 @@ struct PCMSegment {
 		If @c msb_first is @c false then each byte is expected to be deserialised from
 		LSB to MSB.
 	*/
-	std::vector<uint8_t> byte_data(bool msb_first = true) const {
-		std::vector<uint8_t> bytes((data.size() + 7) >> 3);
-		size_t pointer = 0;
-		const size_t pointer_mask = msb_first ? 7 : 0;
-		for(const auto bit: data) {
-			if(bit) bytes[pointer >> 3] |= 1 << ((pointer & 7) ^ pointer_mask);
-			++pointer;
-		}
-		return bytes;
-	}
+	std::vector<uint8_t> byte_data(bool msb_first = true) const;
 
 	/// Appends the data of @c rhs to the current data. Does not adjust @c length_of_a_bit.
 	PCMSegment &operator +=(const PCMSegment &rhs);
@@ -164,7 +164,7 @@ void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bo
 		const size_t selected_end_bit = std::min(end_bit, destination.data.size());
 
 		// Reset the destination.
-		std::fill(destination.data.begin() + off_t(start_bit), destination.data.begin() + off_t(selected_end_bit), false);
+		destination.data.fill(start_bit, selected_end_bit, false);
 
 		// Step through the source data from start to finish, stopping early if it goes out of bounds.
 		for(size_t bit = 0; bit < segment.data.size(); ++bit) {
@@ -181,10 +181,10 @@ void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bo
 		// This definitely runs over the index hole; check whether the whole track needs clearing, or whether
 		// a centre segment is untouched.
 		if(target_width >= destination.data.size()) {
-			std::fill(destination.data.begin(), destination.data.end(), false);
+			destination.data.fill(0, destination.data.size(), false);
 		} else {
-			std::fill(destination.data.begin(), destination.data.begin() + off_t(end_bit % destination.data.size()), false);
-			std::fill(destination.data.begin() + off_t(start_bit), destination.data.end(), false);
+			destination.data.fill(0, end_bit % destination.data.size(), false);
+			destination.data.fill(start_bit, destination.data.size(), false);
 		}
 
 		// Run backwards from final bit back to first, stopping early if overlapping the beginning.
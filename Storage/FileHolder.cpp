@@ -11,10 +11,19 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAS_MMAP
+#endif
+
 using namespace Storage;
 
 FileHolder::~FileHolder() {
 	if(file_) std::fclose(file_);
+#ifdef HAS_MMAP
+	if(is_memory_mapping_) munmap(mapping_, mapping_size_);
+#endif
 }
 
 FileHolder::FileHolder(const std::string &file_name, FileMode ideal_mode)
@@ -36,75 +45,166 @@ FileHolder::FileHolder(const std::string &file_name, FileMode ideal_mode)
 		case FileMode::Rewrite:
 			file_ = std::fopen(file_name.c_str(), "w");
 		break;
+
+		case FileMode::MappedRead:
+			file_ = std::fopen(file_name.c_str(), "rb");
+		break;
+
+		case FileMode::MappedCopyOnWrite:
+			file_ = std::fopen(file_name.c_str(), "rb+");
+			if(!file_) {
+				is_read_only_ = true;
+				file_ = std::fopen(file_name.c_str(), "rb");
+			}
+		break;
 	}
 
 	if(!file_) throw Error::CantOpen;
+
+	if(ideal_mode == FileMode::MappedRead || ideal_mode == FileMode::MappedCopyOnWrite) {
+		map(ideal_mode == FileMode::MappedCopyOnWrite);
+	}
+}
+
+void FileHolder::map(bool copy_on_write) {
+	is_mapped_ = true;
+	is_mapped_writeable_ = copy_on_write;
+
+	std::fseek(file_, 0, SEEK_END);
+	const long size = std::ftell(file_);
+	mapping_size_ = size > 0 ? std::size_t(size) : 0;
+
+#ifdef HAS_MMAP
+	// A private mapping is never written back, so copy-on-write is achieved by mapping
+	// privately with write access even if the underlying file is read-only.
+	if(mapping_size_) {
+		void *const mapping = mmap(
+			nullptr,
+			mapping_size_,
+			copy_on_write ? (PROT_READ | PROT_WRITE) : PROT_READ,
+			MAP_PRIVATE,
+			fileno(file_),
+			0);
+		if(mapping != MAP_FAILED) {
+			mapping_ = static_cast<uint8_t *>(mapping);
+			is_memory_mapping_ = true;
+		}
+	}
+#endif
+
+	if(!is_memory_mapping_) {
+		mapping_buffer_.resize(mapping_size_);
+		std::fseek(file_, 0, SEEK_SET);
+		mapping_size_ = std::fread(mapping_buffer_.data(), 1, mapping_size_, file_);
+		mapping_ = mapping_buffer_.data();
+	}
+
+	// Neither a mapping nor a copy needs the file to remain open.
+	std::fclose(file_);
+	file_ = nullptr;
+}
+
+bool FileHolder::is_mapped() const {
+	return is_mapped_;
+}
+
+void FileHolder::prefetch(long offset, std::size_t length) {
+#ifdef HAS_MMAP
+	if(!is_memory_mapping_ || offset < 0 || std::size_t(offset) >= mapping_size_) return;
+
+	// madvise requires a page-aligned start address.
+	static const std::size_t page_size = std::size_t(sysconf(_SC_PAGESIZE));
+	const std::size_t start = std::size_t(offset) & ~(page_size - 1);
+	const std::size_t end = std::min(std::size_t(offset) + length, mapping_size_);
+	madvise(mapping_ + start, end - start, MADV_WILLNEED);
+#else
+	(void)offset;
+	(void)length;
+#endif
+}
+
+int FileHolder::next_byte() {
+	if(!is_mapped_) return std::fgetc(file_);
+
+	if(position_ >= mapping_size_) {
+		is_at_eof_ = true;
+		return EOF;
+	}
+	return mapping_[position_++];
 }
 
 uint32_t FileHolder::get32le() {
-	uint32_t result = static_cast<uint32_t>(std::fgetc(file_));
-	result |= static_cast<uint32_t>(std::fgetc(file_)) << 8;
-	result |= static_cast<uint32_t>(std::fgetc(file_)) << 16;
-	result |= static_cast<uint32_t>(std::fgetc(file_)) << 24;
+	uint32_t result = static_cast<uint32_t>(next_byte());
+	result |= static_cast<uint32_t>(next_byte()) << 8;
+	result |= static_cast<uint32_t>(next_byte()) << 16;
+	result |= static_cast<uint32_t>(next_byte()) << 24;
 
 	return result;
 }
 
 uint32_t FileHolder::get32be() {
-	uint32_t result = static_cast<uint32_t>(std::fgetc(file_)) << 24;
-	result |= static_cast<uint32_t>(std::fgetc(file_)) << 16;
-	result |= static_cast<uint32_t>(std::fgetc(file_)) << 8;
-	result |= static_cast<uint32_t>(std::fgetc(file_));
+	uint32_t result = static_cast<uint32_t>(next_byte()) << 24;
+	result |= static_cast<uint32_t>(next_byte()) << 16;
+	result |= static_cast<uint32_t>(next_byte()) << 8;
+	result |= static_cast<uint32_t>(next_byte());
 
 	return result;
 }
 
 uint32_t FileHolder::get24le() {
-	uint32_t result = static_cast<uint32_t>(std::fgetc(file_));
-	result |= static_cast<uint32_t>(std::fgetc(file_)) << 8;
-	result |= static_cast<uint32_t>(std::fgetc(file_)) << 16;
+	uint32_t result = static_cast<uint32_t>(next_byte());
+	result |= static_cast<uint32_t>(next_byte()) << 8;
+	result |= static_cast<uint32_t>(next_byte()) << 16;
 
 	return result;
 }
 
 uint32_t FileHolder::get24be() {
-	uint32_t result = static_cast<uint32_t>(std::fgetc(file_)) << 16;
-	result |= static_cast<uint32_t>(std::fgetc(file_)) << 8;
-	result |= static_cast<uint32_t>(std::fgetc(file_));
+	uint32_t result = static_cast<uint32_t>(next_byte()) << 16;
+	result |= static_cast<uint32_t>(next_byte()) << 8;
+	result |= static_cast<uint32_t>(next_byte());
 
 	return result;
 }
 
 uint16_t FileHolder::get16le() {
-	uint16_t result = static_cast<uint16_t>(std::fgetc(file_));
-	result |= static_cast<uint16_t>(static_cast<uint16_t>(std::fgetc(file_)) << 8);
+	uint16_t result = static_cast<uint16_t>(next_byte());
+	result |= static_cast<uint16_t>(static_cast<uint16_t>(next_byte()) << 8);
 
 	return result;
 }
 
 uint16_t FileHolder::get16be() {
-	uint16_t result = static_cast<uint16_t>(static_cast<uint16_t>(std::fgetc(file_)) << 8);
-	result |= static_cast<uint16_t>(std::fgetc(file_));
+	uint16_t result = static_cast<uint16_t>(static_cast<uint16_t>(next_byte()) << 8);
+	result |= static_cast<uint16_t>(next_byte());
 
 	return result;
 }
 
 uint8_t FileHolder::get8() {
-	return static_cast<uint8_t>(std::fgetc(file_));
+	return static_cast<uint8_t>(next_byte());
 }
 
 void FileHolder::put16be(uint16_t value) {
-	std::fputc(value >> 8, file_);
-	std::fputc(value, file_);
+	put8(uint8_t(value >> 8));
+	put8(uint8_t(value));
 }
 
 void FileHolder::put16le(uint16_t value) {
-	std::fputc(value, file_);
-	std::fputc(value >> 8, file_);
+	put8(uint8_t(value));
+	put8(uint8_t(value >> 8));
 }
 
 void FileHolder::put8(uint8_t value) {
-	std::fputc(value, file_);
+	if(!is_mapped_) {
+		std::fputc(value, file_);
+		return;
+	}
+
+	if(is_mapped_writeable_ && position_ < mapping_size_) {
+		mapping_[position_] = value;
+	}
+	++position_;
 }
 
 void FileHolder::putn(std::size_t repeats, uint8_t value) {
@@ -112,41 +212,91 @@ void FileHolder::putn(std::size_t repeats, uint8_t value) {
 }
 
 std::vector<uint8_t> FileHolder::read(std::size_t size) {
-	std::vector<uint8_t> result(size);
-	result.resize(std::fread(result.data(), 1, size, file_));
-	return result;
+	if(!is_mapped_) {
+		std::vector<uint8_t> result(size);
+		result.resize(std::fread(result.data(), 1, size, file_));
+		return result;
+	}
+
+	const Span source = span(size);
+	return std::vector<uint8_t>(source.begin(), source.end());
 }
 
 std::size_t FileHolder::read(uint8_t *buffer, std::size_t size) {
-	return std::fread(buffer, 1, size, file_);
+	if(!is_mapped_) return std::fread(buffer, 1, size, file_);
+
+	const Span source = span(size);
+	std::copy(source.begin(), source.end(), buffer);
+	return source.size();
+}
+
+FileHolder::Span FileHolder::span(std::size_t size) {
+	if(!is_mapped_) {
+		span_buffer_.resize(size);
+		return Span(span_buffer_.data(), std::fread(span_buffer_.data(), 1, size, file_));
+	}
+
+	const std::size_t available = position_ < mapping_size_ ? mapping_size_ - position_ : 0;
+	if(size > available) {
+		size = available;
+		is_at_eof_ = true;
+	}
+
+	const Span result(mapping_ + std::min(position_, mapping_size_), size);
+	position_ += size;
+	return result;
 }
 
 std::size_t FileHolder::write(const std::vector<uint8_t> &buffer) {
-	return std::fwrite(buffer.data(), 1, buffer.size(), file_);
+	return write(buffer.data(), buffer.size());
 }
 
 std::size_t FileHolder::write(const uint8_t *buffer, std::size_t size) {
-	return std::fwrite(buffer, 1, size, file_);
+	if(!is_mapped_) return std::fwrite(buffer, 1, size, file_);
+	if(!is_mapped_writeable_) return 0;
+
+	const std::size_t available = position_ < mapping_size_ ? mapping_size_ - position_ : 0;
+	size = std::min(size, available);
+	std::copy(buffer, buffer + size, mapping_ + position_);
+	position_ += size;
+	return size;
 }
 
 void FileHolder::seek(long offset, int whence) {
-	std::fseek(file_, offset, whence);
+	if(!is_mapped_) {
+		std::fseek(file_, offset, whence);
+		return;
+	}
+
+	long base = 0;
+	switch(whence) {
+		default:		break;
+		case SEEK_CUR:	base = long(position_);		break;
+		case SEEK_END:	base = long(mapping_size_);	break;
+	}
+
+	// As per fseek: a seek to before the start of the file fails, and any successful seek clears the end-of-file indicator.
+	if(base + offset < 0) return;
+	position_ = std::size_t(base + offset);
+	is_at_eof_ = false;
 }
 
 long FileHolder::tell() {
+	if(is_mapped_) return long(position_);
 	return std::ftell(file_);
 }
 
 void FileHolder::flush() {
-	std::fflush(file_);
+	if(!is_mapped_) std::fflush(file_);
 }
 
 bool FileHolder::eof() {
+	if(is_mapped_) return is_at_eof_;
 	return std::feof(file_);
 }
 
 FileHolder::BitStream FileHolder::get_bitstream(bool lsb_first) {
-	return BitStream(file_, lsb_first);
+	return BitStream(*this, lsb_first);
 }
 
 bool FileHolder::check_signature(const char *signature, std::size_t length) {
@@ -170,6 +320,8 @@ std::string FileHolder::extension() {
 }
 
 void FileHolder::ensure_is_at_least_length(long length) {
+	if(is_mapped_) return;
+
 	std::fseek(file_, 0, SEEK_END);
 	long bytes_to_write = length - ftell(file_);
 	if(bytes_to_write > 0) {
@@ -10,7 +10,9 @@
 #define FileHolder_hpp
 
 #include <sys/stat.h>
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstdio>
 #include <cstdint>
 #include <mutex>
@@ -28,7 +30,9 @@ class FileHolder final {
 		enum class FileMode {
 			ReadWrite,
 			Read,
-			Rewrite
+			Rewrite,
+			MappedRead,
+			MappedCopyOnWrite
 		};
 
 		~FileHolder();
@@ -42,6 +46,14 @@ class FileHolder final {
 				Read		attempts to open this file for reading only.
 				Rewrite		opens the file for rewriting; none of the original content is preserved; whatever
 							the caller outputs will replace the existing file.
+				MappedRead	maps the entire file into memory for reading only; writes are ignored.
+				MappedCopyOnWrite
+							maps the entire file into memory privately; writes modify the in-memory
+							copy only, and can't extend it. get_is_known_read_only will nevertheless
+							indicate whether the file could have been opened for writing.
+
+			Mapped files are read without any stdio overhead, and can supply spans of their contents
+			without copying. Where memory mapping is unavailable, the file is read into memory instead.
 
 			@raises ErrorCantOpen if the file cannot be opened.
 		*/
@@ -153,6 +165,71 @@ class FileHolder final {
 		/*! @returns @c true if the end-of-file indicator is set, @c false otherwise. */
 		bool eof();
 
+		/*!
+			A bounds-checked view of a contiguous run of bytes from the file.
+		*/
+		class Span {
+			public:
+				Span() = default;
+				Span(const uint8_t *data, std::size_t size) : data_(data), size_(size) {}
+
+				const uint8_t *data() const	{	return data_;	}
+				std::size_t size() const	{	return size_;	}
+				bool empty() const			{	return !size_;	}
+
+				const uint8_t *begin() const	{	return data_;			}
+				const uint8_t *end() const		{	return data_ + size_;	}
+
+				uint8_t operator[](std::size_t index) const {
+					assert(index < size_);
+					return data_[index];
+				}
+
+				/// @returns the portion of this span that starts at @c offset and is at most @c length bytes long.
+				Span subspan(std::size_t offset, std::size_t length) const {
+					offset = std::min(offset, size_);
+					return Span(data_ + offset, std::min(length, size_ - offset));
+				}
+
+			private:
+				const uint8_t *data_ = nullptr;
+				std::size_t size_ = 0;
+		};
+
+		/*!
+			Reads up to @c size bytes, fewer only if the end of the file is reached, and returns a span describing them.
+
+			If this file is mapped then the span refers directly to the mapping and remains valid for the
+			lifetime of this FileHolder. Otherwise it refers to an internal buffer and remains valid only
+			until the next call to @c span.
+		*/
+		Span span(std::size_t size);
+
+		/*!
+			Reads up to @c count values of type @c T, each stored in little-endian form; fewer are
+			returned only if the end of the file is reached.
+		*/
+		template <typename T> std::vector<T> read_le(std::size_t count) {
+			return read_values<T, false>(count);
+		}
+
+		/*!
+			Reads up to @c count values of type @c T, each stored in big-endian form; fewer are
+			returned only if the end of the file is reached.
+		*/
+		template <typename T> std::vector<T> read_be(std::size_t count) {
+			return read_values<T, true>(count);
+		}
+
+		/*! @returns @c true if this file is held in memory, having been opened in one of the mapped modes; @c false otherwise. */
+		bool is_mapped() const;
+
+		/*!
+			Hints that @c length bytes from @c offset are likely to be read soon. This has an effect
+			only on memory-mapped files, which will begin paging the range in.
+		*/
+		void prefetch(long offset, std::size_t length);
+
 		class BitStream {
 			public:
 				uint8_t get_bits(int q) {
@@ -164,14 +241,14 @@ class FileHolder final {
 				}
 
 			private:
-				BitStream(FILE *file, bool lsb_first) :
+				BitStream(FileHolder &file, bool lsb_first) :
 					file_(file),
 					lsb_first_(lsb_first),
 					next_value_(0),
 					bits_remaining_(0) {}
 				friend FileHolder;
 
-				FILE *file_;
+				FileHolder &file_;
 				bool lsb_first_;
 				uint8_t next_value_;
 				int bits_remaining_;
@@ -179,7 +256,7 @@ class FileHolder final {
 				uint8_t get_bit() {
 					if(!bits_remaining_) {
 						bits_remaining_ = 8;
-						next_value_ = static_cast<uint8_t>(fgetc(file_));
+						next_value_ = file_.get8();
 					}
 
 					uint8_t bit;
@@ -219,7 +296,7 @@ class FileHolder final {
 
 		/*!
 			Ensures the file is at least @c length bytes long, appending 0s until it is
-			if necessary.
+			if necessary. Mapped files cannot be extended.
 		*/
 		void ensure_is_at_least_length(long length);
 
@@ -246,6 +323,44 @@ class FileHolder final {
 		bool is_read_only_ = false;
 
 		std::mutex file_access_mutex_;
+
+		// If this file is mapped then its contents are at mapping_, which is either an actual
+		// memory mapping or else the contents of mapping_buffer_, and file_ is closed. Reads and
+		// writes then proceed from position_, and is_at_eof_ substitutes for the stdio
+		// end-of-file indicator.
+		bool is_mapped_ = false;
+		bool is_memory_mapping_ = false;
+		bool is_mapped_writeable_ = false;
+		uint8_t *mapping_ = nullptr;
+		std::size_t mapping_size_ = 0;
+		std::vector<uint8_t> mapping_buffer_;
+		std::size_t position_ = 0;
+		bool is_at_eof_ = false;
+
+		void map(bool copy_on_write);
+
+		/// @returns the next byte from the file, or EOF if there is none.
+		int next_byte();
+
+		// Provides storage for spans of files that are not mapped.
+		std::vector<uint8_t> span_buffer_;
+
+		template <typename T, bool big_endian> std::vector<T> read_values(std::size_t count) {
+			const Span source = span(count * sizeof(T));
+			std::vector<T> result(source.size() / sizeof(T));
+
+			const uint8_t *input = source.data();
+			for(auto &value: result) {
+				T assembled = 0;
+				for(std::size_t c = 0; c < sizeof(T); ++c) {
+					const std::size_t shift = 8 * (big_endian ? sizeof(T) - 1 - c : c);
+					assembled |= T(T(input[c]) << shift);
+				}
+				value = assembled;
+				input += sizeof(T);
+			}
+			return result;
+		}
 };
 
 }
@@ -10,7 +10,7 @@
 
 using namespace Storage::MassStorage;
 
-HFV::HFV(const std::string &file_name) : file_(file_name) {
+HFV::HFV(const std::string &file_name) : file_(file_name, FileHolder::FileMode::MappedCopyOnWrite), file_name_(file_name) {
 	// Is the file a multiple of 512 bytes in size and larger than a floppy disk?
 	const auto file_size = file_.stats().st_size;
 	if(file_size & 511 || file_size <= 800*1024) throw std::exception();
@@ -18,6 +18,10 @@ HFV::HFV(const std::string &file_name) : file_(file_name) {
 	// TODO: check filing system for MFS, HFS or HFS+.
 }
 
+HFV::~HFV() {
+	flush();
+}
+
 size_t HFV::get_block_size() {
 	return 512;
 }
@@ -26,31 +30,117 @@ size_t HFV::get_number_of_blocks() {
 	return mapper_.get_number_of_blocks();
 }
 
+bool HFV::is_in_file(ssize_t source_address) {
+	return source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size);
+}
+
 std::vector<uint8_t> HFV::get_block(size_t address) {
+	const auto block = read_block(address);
+	return std::vector<uint8_t>(block.begin(), block.end());
+}
+
+HFV::Span HFV::read_block(size_t address) {
 	const auto written = writes_.find(address);
-	if(written != writes_.end()) return written->second;
+	if(written != writes_.end()) return Span(written->second.data(), written->second.size());
 
 	const auto source_address = mapper_.to_source_address(address);
-	if(source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size)) {
-		const long file_offset = long(get_block_size()) * long(source_address);
-		file_.seek(file_offset, SEEK_SET);
-		return mapper_.convert_source_block(source_address, file_.read(get_block_size()));
-	} else {
-		return mapper_.convert_source_block(source_address);
+	if(is_in_file(source_address)) {
+		// The mapper leaves blocks within the partition unmodified, so these can be supplied directly from the file.
+		file_.seek(long(get_block_size()) * long(source_address), SEEK_SET);
+		return file_.span(get_block_size());
 	}
+
+	// Other non-negative addresses lie beyond the end of the file, and have no contents.
+	if(source_address >= 0) return Span{};
+
+	auto synthesised = synthesised_blocks_.find(address);
+	if(synthesised == synthesised_blocks_.end()) {
+		synthesised = synthesised_blocks_.emplace(address, mapper_.convert_source_block(source_address)).first;
+	}
+	return Span(synthesised->second.data(), synthesised->second.size());
 }
 
 void HFV::set_block(size_t address, const std::vector<uint8_t> &contents) {
 	const auto source_address = mapper_.to_source_address(address);
-	if(source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size)) {
-		const long file_offset = long(get_block_size()) * long(source_address);
-		file_.seek(file_offset, SEEK_SET);
+	if(is_in_file(source_address)) {
+		file_.seek(long(get_block_size()) * long(source_address), SEEK_SET);
 		file_.write(contents);
+
+		if(file_.get_is_known_read_only()) {
+			has_unwritable_blocks_ = true;
+		} else {
+			dirty_blocks_.insert(source_address);
+			if(dirty_blocks_.size() >= MaximumDirtyBlocks) flush();
+		}
 	} else {
 		writes_[address] = contents;
- 	}
+	}
+}
+
+bool HFV::flush() {
+	// Blocks set while the image was read-only can never be written back.
+	if(has_unwritable_blocks_) return false;
+	if(dirty_blocks_.empty()) return true;
+
+	// If the file can't be opened for writing then keep the dirty blocks, both so that a later
+	// flush can try again and so that the failure is reported until then.
+	if(!writer_) {
+		try {
+			writer_ = std::make_unique<FileHolder>(file_name_, FileHolder::FileMode::ReadWrite);
+		} catch(...) {
+			return false;
+		}
+
+		if(writer_->get_is_known_read_only()) {
+			writer_ = nullptr;
+			return false;
+		}
+	}
+
+	// Write each run of consecutive dirty blocks as a single write, from the mapping.
+	auto block = dirty_blocks_.begin();
+	while(block != dirty_blocks_.end()) {
+		const auto run = block;
+		const ssize_t first = *block;
+		ssize_t last = first;
+		while(++block != dirty_blocks_.end() && *block == last + 1) {
+			last = *block;
+		}
+
+		const long offset = long(get_block_size()) * long(first);
+		file_.seek(offset, SEEK_SET);
+		const auto contents = file_.span(size_t(last + 1 - first) * get_block_size());
+
+		writer_->seek(offset, SEEK_SET);
+		if(writer_->write(contents.data(), contents.size()) != contents.size()) {
+			// Retain this run and all that follow.
+			dirty_blocks_.erase(dirty_blocks_.begin(), run);
+			writer_->flush();
+			return false;
+		}
+	}
+
+	writer_->flush();
+	dirty_blocks_.clear();
+	return true;
+}
+
+void HFV::prefetch(size_t address, size_t count) {
+	// Blocks within the partition are contiguous in the file, so it's necessary only to find the first and last.
+	ssize_t first = -1, last = -1;
+	for(size_t block = address; block < address + count; ++block) {
+		const auto source_address = mapper_.to_source_address(block);
+		if(!is_in_file(source_address)) continue;
+
+		if(first < 0) first = source_address;
+		last = source_address;
+	}
+	if(first < 0) return;
+
+	file_.prefetch(long(get_block_size()) * long(first), size_t(last + 1 - first) * get_block_size());
 }
 
 void HFV::set_drive_type(Encodings::Macintosh::DriveType drive_type) {
 	mapper_.set_drive_type(drive_type, size_t(file_.stats().st_size) / get_block_size());
+	synthesised_blocks_.clear();
 }
@@ -13,8 +13,10 @@
 #include "../../FileHolder.hpp"
 #include "../Encodings/MacintoshVolume.hpp"
 
-#include <vector>
 #include <map>
+#include <memory>
+#include <set>
+#include <vector>
 
 namespace Storage {
 namespace MassStorage {
@@ -31,9 +33,11 @@ class HFV: public MassStorageDevice, public Encodings::Macintosh::Volume {
 			Macintosh mass storage image.
 		*/
 		HFV(const std::string &file_name);
+		~HFV();
 
 	private:
 		FileHolder file_;
+		const std::string file_name_;
 		Encodings::Macintosh::Mapper mapper_;
 
 		/* MassStorageDevices overrides. */
@@ -41,10 +45,26 @@ class HFV: public MassStorageDevice, public Encodings::Macintosh::Volume {
 		size_t get_number_of_blocks() final;
 		std::vector<uint8_t> get_block(size_t address) final;
 		void set_block(size_t address, const std::vector<uint8_t> &) final;
+		Span read_block(size_t address) final;
+		void prefetch(size_t address, size_t count) final;
+		bool flush() final;
 
 		/* Encodings::Macintosh::Volume overrides. */
 		void set_drive_type(Encodings::Macintosh::DriveType) final;
 
+		// The file is mapped copy-on-write, so blocks that lie within it are read directly from the
+		// mapping and set_block writes to the mapping. Written blocks are then copied back to the file
+		// upon each flush, or once MaximumDirtyBlocks have accumulated, via writer_. If the file is
+		// read-only then written blocks are retained only in the mapping and all flushes will fail.
+		std::unique_ptr<FileHolder> writer_;
+		std::set<ssize_t> dirty_blocks_;
+		bool has_unwritable_blocks_ = false;
+		static constexpr size_t MaximumDirtyBlocks = 128;
+		bool is_in_file(ssize_t source_address);
+
+		// Blocks that lie outside of the file are either synthesised by mapper_ and cached in
+		// synthesised_blocks_, or else have been written and are held in writes_.
+		std::map<size_t, std::vector<uint8_t>> synthesised_blocks_;
 		std::map<size_t, std::vector<uint8_t>> writes_;
 };
 
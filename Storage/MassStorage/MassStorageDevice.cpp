@@ -7,3 +7,10 @@
 //
 
 #include "MassStorageDevice.hpp"
+
+using namespace Storage::MassStorage;
+
+MassStorageDevice::Span MassStorageDevice::read_block(size_t address) {
+	last_block_ = get_block(address);
+	return Span(last_block_.data(), last_block_.size());
+}
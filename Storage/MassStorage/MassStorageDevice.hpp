@@ -9,6 +9,8 @@
 #ifndef MassStorageDevice_hpp
 #define MassStorageDevice_hpp
 
+#include "../FileHolder.hpp"
+
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -53,6 +55,35 @@ class MassStorageDevice {
 			Sets new contents for the block at @c address.
 		*/
 		virtual void set_block(size_t address, const std::vector<uint8_t> &) {}
+
+		/// Describes the contents of a block without taking a copy of them.
+		using Span = FileHolder::Span;
+
+		/*!
+			@returns The current contents of the block at @c address. These remain valid only until the
+			next call to @c read_block or @c set_block.
+
+			The default implementation calls @c get_block and retains the result; devices that hold their
+			contents in memory should override this to avoid the copy.
+		*/
+		virtual Span read_block(size_t address);
+
+		/*!
+			Indicates that @c count blocks from @c address are likely to be read soon, allowing the device
+			to start fetching them. The default implementation does nothing.
+		*/
+		virtual void prefetch(size_t, size_t) {}
+
+		/*!
+			Ensures that all blocks set so far have been written to the underlying medium.
+
+			@returns @c true if they have; @c false if some could not be written, in which case they remain
+			pending. The default implementation does nothing and returns @c true.
+		*/
+		virtual bool flush() { return true; }
+
+	private:
+		std::vector<uint8_t> last_block_;
 };
 
 }
@@ -13,6 +13,7 @@ using namespace SCSI;
 
 void DirectAccessDevice::set_storage(const std::shared_ptr<Storage::MassStorage::MassStorageDevice> &device) {
 	device_ = device;
+	next_sequential_address_ = 0;
 }
 
 bool DirectAccessDevice::read(const Target::CommandState &state, Target::Responder &responder) {
@@ -21,12 +22,20 @@ bool DirectAccessDevice::read(const Target::CommandState &state, Target::Respond
 	const auto specs = state.read_write_specs();
 	LOG("Read: " << specs.number_of_blocks << " from " << specs.address);
 
-	std::vector<uint8_t> output = device_->get_block(specs.address);
-	for(uint32_t offset = 1; offset < specs.number_of_blocks; ++offset) {
-		const auto next_block = device_->get_block(specs.address + offset);
-		std::copy(next_block.begin(), next_block.end(), std::back_inserter(output));
+	std::vector<uint8_t> output;
+	output.reserve(device_->get_block_size() * specs.number_of_blocks);
+	for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
+		const auto next_block = device_->read_block(specs.address + offset);
+		output.insert(output.end(), next_block.begin(), next_block.end());
 	}
 
+	// If this read continued on from the previous then assume the next will too, and ask
+	// the device to read ahead by the same number of blocks.
+	if(specs.address == next_sequential_address_) {
+		device_->prefetch(specs.address + specs.number_of_blocks, specs.number_of_blocks);
+	}
+	next_sequential_address_ = specs.address + specs.number_of_blocks;
+
 	responder.send_data(std::move(output), [] (const Target::CommandState &state, Target::Responder &responder) {
 		responder.terminate_command(Target::Responder::Status::Good);
 	});
@@ -42,12 +51,17 @@ bool DirectAccessDevice::write(const Target::CommandState &state, Target::Respon
 	responder.receive_data(device_->get_block_size() * specs.number_of_blocks, [this, specs] (const Target::CommandState &state, Target::Responder &responder) {
 		const auto received_data = state.received_data();
 		const auto block_size = ssize_t(device_->get_block_size());
+		std::vector<uint8_t> sub_vector;
 		for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
 			// TODO: clean up this gross inefficiency when std::span is standard.
-			std::vector<uint8_t> sub_vector(received_data.begin() + ssize_t(offset)*block_size, received_data.begin() + ssize_t(offset+1)*block_size);
+			sub_vector.assign(received_data.begin() + ssize_t(offset)*block_size, received_data.begin() + ssize_t(offset+1)*block_size);
 			this->device_->set_block(specs.address + offset, sub_vector);
 		}
-		responder.terminate_command(Target::Responder::Status::Good);
+
+		// Report success only once the blocks have reached the underlying medium.
+		responder.terminate_command(
+			this->device_->flush() ? Target::Responder::Status::Good : Target::Responder::Status::CheckCondition
+		);
 	});
 
 	return true;
@@ -33,6 +33,9 @@ class DirectAccessDevice: public Target::Executor {
 
 	private:
 		std::shared_ptr<Storage::MassStorage::MassStorageDevice> device_;
+
+		// The block that would follow the most recent read; used to detect sequential reads.
+		uint32_t next_sequential_address_ = 0;
 };
 
 }
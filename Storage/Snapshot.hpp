@@ -0,0 +1,228 @@
+//
+//  Snapshot.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Storage_Snapshot_hpp
+#define Storage_Snapshot_hpp
+
+#include "../ClockReceiver/ClockReceiver.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Storage {
+namespace Snapshot {
+
+/*
+	A snapshot is a binary record of emulated state, consisting of:
+
+		a four-byte signature, 'CLKS';
+		a two-byte format version; and
+		a sequence of chunks.
+
+	Each chunk consists of a four-character tag, a two-byte version, a four-byte length and then
+	that many bytes of content. Content may itself contain further chunks; components
+	nest their chunks within those of the machines that own them.
+
+	All values are stored in host byte order and layout, so snapshots are suitable for resuming
+	or forking a session on the same build of the emulator but are not an interchange format.
+*/
+constexpr uint16_t FormatVersion = 1;
+
+/*!
+	Accumulates a snapshot. Values written must be trivially copyable or a WrappedInt such as Cycles,
+	and must not be pointers; anything that refers to other state should be recorded as an index
+	or an offset.
+*/
+class Writer {
+	public:
+		Writer() {
+			put_bytes("CLKS", 4);
+			put(FormatVersion);
+		}
+
+		/*!
+			Opens a chunk tagged @c tag, with version @c version; all subsequent writes are
+			part of that chunk until the corresponding call to @c end.
+		*/
+		void begin(const char (&tag)[5], uint16_t version) {
+			put_bytes(tag, 4);
+			put(version);
+			chunk_starts_.push_back(data_.size());
+			put(uint32_t(0));
+		}
+
+		/// Closes the most-recently opened chunk.
+		void end() {
+			const std::size_t start = chunk_starts_.back();
+			chunk_starts_.pop_back();
+
+			const uint32_t length = uint32_t(data_.size() - start - sizeof(uint32_t));
+			memcpy(&data_[start], &length, sizeof(length));
+		}
+
+		/// Appends each of @c values.
+		template <typename... Args> void put(const Args &...values) {
+			(put_value(values), ...);
+		}
+
+		/// Appends @c size bytes from @c data.
+		void put_bytes(const void *data, std::size_t size) {
+			const auto bytes = reinterpret_cast<const uint8_t *>(data);
+			data_.insert(data_.end(), bytes, bytes + size);
+		}
+
+		/// Appends the length of @c vector followed by its contents.
+		template <typename T> void put_vector(const std::vector<T> &vector) {
+			static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value);
+			put(uint32_t(vector.size()));
+			put_bytes(vector.data(), vector.size() * sizeof(T));
+		}
+
+		/// @returns The snapshot so far; all chunks should have been closed.
+		const std::vector<uint8_t> &data() const {
+			return data_;
+		}
+
+		/// @returns The snapshot so far, leaving this writer empty.
+		std::vector<uint8_t> take() {
+			return std::move(data_);
+		}
+
+	private:
+		std::vector<uint8_t> data_;
+		std::vector<std::size_t> chunk_starts_;
+
+		template <typename T> void put_value(const T &value) {
+			if constexpr (std::is_base_of<WrappedInt<T>, T>::value) {
+				put_value(value.as_integral());
+			} else {
+				static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value);
+				put_bytes(&value, sizeof(T));
+			}
+		}
+};
+
+/*!
+	Reads a snapshot produced by a Writer.
+
+	Any failure — a malformed snapshot, an unexpected tag, a version newer than the caller
+	understands or an attempt to read beyond the end of a chunk — is sticky: it causes that
+	call and all subsequent calls to return @c false.
+*/
+class Reader {
+	public:
+		Reader(const uint8_t *data, std::size_t size) : data_(data), size_(size) {
+			char signature[4];
+			uint16_t version;
+			is_valid_ =
+				get_bytes(signature, 4) && !memcmp(signature, "CLKS", 4) &&
+				get(version) && version == FormatVersion;
+		}
+
+		Reader(const std::vector<uint8_t> &data) : Reader(data.data(), data.size()) {}
+
+		/*!
+			Opens the next chunk, which must be tagged @c tag and have a version no greater
+			than @c maximum_version.
+
+			@param version If not @c nullptr, receives the version of the chunk.
+			@returns @c true if the chunk was opened; @c false otherwise.
+		*/
+		bool begin(const char (&tag)[5], uint16_t maximum_version, uint16_t *version = nullptr) {
+			char found_tag[4];
+			uint16_t found_version;
+			uint32_t length;
+			if(
+				!get_bytes(found_tag, 4) ||
+				!get(found_version, length) ||
+				memcmp(found_tag, tag, 4) ||
+				found_version > maximum_version ||
+				length > limit() - position_
+			) {
+				return is_valid_ = false;
+			}
+
+			if(version) *version = found_version;
+			chunk_ends_.push_back(position_ + length);
+			return true;
+		}
+
+		/*!
+			Closes the most-recently opened chunk, skipping any content that was not read.
+			@returns @c true if no error has occurred; @c false otherwise.
+		*/
+		bool end() {
+			if(!is_valid_ || chunk_ends_.empty()) return is_valid_ = false;
+			position_ = chunk_ends_.back();
+			chunk_ends_.pop_back();
+			return true;
+		}
+
+		/// Reads each of @c values. @returns @c true if all were read; @c false otherwise.
+		template <typename... Args> bool get(Args &...values) {
+			return (get_value(values) && ...);
+		}
+
+		/// Reads @c size bytes to @c data. @returns @c true if all were read; @c false otherwise.
+		bool get_bytes(void *data, std::size_t size) {
+			if(!is_valid_ || size > limit() - position_) return is_valid_ = false;
+			memcpy(data, &data_[position_], size);
+			position_ += size;
+			return true;
+		}
+
+		/*!
+			Reads a vector written by Writer::put_vector, which may have at most @c maximum_size elements.
+			@returns @c true if the vector was read; @c false otherwise.
+		*/
+		template <typename T> bool get_vector(std::vector<T> &vector, std::size_t maximum_size = std::numeric_limits<uint32_t>::max()) {
+			static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value);
+			uint32_t size;
+			if(!get(size)) return false;
+			if(size > maximum_size || size_t(size) * sizeof(T) > limit() - position_) return is_valid_ = false;
+			vector.resize(size);
+			return get_bytes(vector.data(), size * sizeof(T));
+		}
+
+		/// @returns @c true if no error has occurred; @c false otherwise.
+		bool is_valid() const {
+			return is_valid_;
+		}
+
+	private:
+		const uint8_t *data_;
+		std::size_t size_;
+		std::size_t position_ = 0;
+		std::vector<std::size_t> chunk_ends_;
+		bool is_valid_ = true;
+
+		std::size_t limit() const {
+			return chunk_ends_.empty() ? size_ : chunk_ends_.back();
+		}
+
+		template <typename T> bool get_value(T &value) {
+			if constexpr (std::is_base_of<WrappedInt<T>, T>::value) {
+				typename T::IntType integral;
+				if(!get_value(integral)) return false;
+				value = T(integral);
+				return true;
+			} else {
+				static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value);
+				return get_bytes(&value, sizeof(T));
+			}
+		}
+};
+
+}
+}
+
+#endif /* Storage_Snapshot_hpp */
@@ -165,3 +165,15 @@ std::size_t Parser::pattern_matching_depth(const std::vector<WaveType> &waves, c
 
 	return depth;
 }
+
+void Parser::save_state(Storage::Snapshot::Writer &writer) const {
+	PulseClassificationParser::save_state(writer);
+	writer.put(detection_mode_, wave_was_high_, cycle_length_);
+}
+
+bool Parser::restore_state(Storage::Snapshot::Reader &reader) {
+	return
+		PulseClassificationParser::restore_state(reader) &&
+		reader.get(detection_mode_, wave_was_high_, cycle_length_) &&
+		detection_mode_ >= FastData && detection_mode_ <= Sync;
+}
@@ -31,6 +31,12 @@ class Parser: public Storage::Tape::PulseClassificationParser<WaveType, SymbolTy
 		int get_next_byte(const std::shared_ptr<Storage::Tape::Tape> &tape, bool use_fast_encoding);
 		bool sync_and_get_encoding_speed(const std::shared_ptr<Storage::Tape::Tape> &tape);
 
+		/// Appends the state of the parser to @c writer.
+		void save_state(Storage::Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader);
+
 	private:
 		void process_pulse(const Storage::Tape::Tape::Pulse &pulse);
 		void inspect_waves(const std::vector<WaveType> &waves);
@@ -41,9 +47,9 @@ class Parser: public Storage::Tape::PulseClassificationParser<WaveType, SymbolTy
 			FastZero,
 			SlowZero,
 			Sync
-		} detection_mode_;
-		bool wave_was_high_;
-		float cycle_length_;
+		} detection_mode_ = Sync;
+		bool wave_was_high_ = false;
+		float cycle_length_ = 0.0f;
 
 		struct Pattern
 		{
@@ -10,6 +10,7 @@
 #define TapeParser_hpp
 
 #include "../Tape.hpp"
+#include "../../Snapshot.hpp"
 
 #include <cassert>
 #include <memory>
@@ -56,6 +57,16 @@ template <typename SymbolType> class Parser {
 			return tape->is_at_end() && !has_next_symbol_;
 		}
 
+		/// Appends the error flag and any lookahead symbol to @c writer.
+		void save_state(Storage::Snapshot::Writer &writer) const {
+			writer.put(error_flag_, next_symbol_, has_next_symbol_);
+		}
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader) {
+			return reader.get(error_flag_, next_symbol_, has_next_symbol_);
+		}
+
 	protected:
 		/*!
 			Should be implemented by subclasses. Consumes @c pulse.
@@ -101,6 +112,17 @@ template <typename WaveType, typename SymbolType> class PulseClassificationParse
 			process_pulse should either call @c push_wave or to take no action.
 		*/
 
+		/// Appends the state of the parser, including all waves not yet formed into symbols, to @c writer.
+		void save_state(Storage::Snapshot::Writer &writer) const {
+			Parser<SymbolType>::save_state(writer);
+			writer.put_vector(wave_queue_);
+		}
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Storage::Snapshot::Reader &reader) {
+			return Parser<SymbolType>::restore_state(reader) && reader.get_vector(wave_queue_);
+		}
+
 	protected:
 		/*!
 			Sets @c symbol as the newly-recognised symbol and removes @c nunber_of_waves waves from the front of the list.
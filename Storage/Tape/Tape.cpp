@@ -112,6 +112,33 @@ void TapePlayer::process_next_event() {
 	get_next_pulse();
 }
 
+void TapePlayer::save_state(Snapshot::Writer &writer) const {
+	writer.begin("TAPE", 1);
+	TimedEventLoop::save_state(writer);
+	writer.put(
+		tape_ ? tape_->get_offset() : uint64_t(0),
+		current_pulse_.type, current_pulse_.length.length, current_pulse_.length.clock_rate
+	);
+	writer.end();
+}
+
+bool TapePlayer::restore_state(Snapshot::Reader &reader) {
+	uint64_t offset;
+	if(
+		!reader.begin("TAPE", 1) ||
+		!TimedEventLoop::restore_state(reader) ||
+		!reader.get(offset, current_pulse_.type, current_pulse_.length.length, current_pulse_.length.clock_rate) ||
+		current_pulse_.type > Tape::Pulse::Zero ||
+		!current_pulse_.length.clock_rate
+	) {
+		return false;
+	}
+
+	if(tape_) tape_->set_offset(offset);
+	update_clocking_observer();
+	return reader.end();
+}
+
 // MARK: - Binary Player
 
 BinaryTapePlayer::BinaryTapePlayer(int input_clock_rate) :
@@ -157,3 +184,16 @@ void BinaryTapePlayer::process_input_pulse(const Storage::Tape::Tape::Pulse &pul
 		if(delegate_) delegate_->tape_did_change_input(this);
 	}
 }
+
+void BinaryTapePlayer::save_state(Snapshot::Writer &writer) const {
+	TapePlayer::save_state(writer);
+	writer.put(input_level_, motor_is_running_);
+}
+
+bool BinaryTapePlayer::restore_state(Snapshot::Reader &reader) {
+	if(!TapePlayer::restore_state(reader) || !reader.get(input_level_, motor_is_running_)) {
+		return false;
+	}
+	update_clocking_observer();
+	return true;
+}
@@ -81,7 +81,7 @@ class Tape {
 		virtual ~Tape() {};
 
 	private:
-		uint64_t offset_;
+		uint64_t offset_ = 0;
 		Tape::Pulse pulse_;
 
 		virtual Pulse virtual_get_next_pulse() = 0;
@@ -109,6 +109,15 @@ class TapePlayer: public TimedEventLoop, public ClockingHint::Source {
 
 		ClockingHint::Preference preferred_clocking() override;
 
+		/*!
+			Appends the position of the tape and the time until the end of the current pulse
+			to @c writer. The tape itself is not captured.
+		*/
+		void save_state(Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Snapshot::Reader &reader);
+
 	protected:
 		virtual void process_next_event() override;
 		virtual void process_input_pulse(const Tape::Pulse &pulse) = 0;
@@ -147,6 +156,12 @@ class BinaryTapePlayer : public TapePlayer {
 
 		ClockingHint::Preference preferred_clocking() final;
 
+		/// Appends the state of the tape player, including its motor and input level, to @c writer.
+		void save_state(Snapshot::Writer &writer) const;
+
+		/// Restores state saved by @c save_state. @returns @c true on success; @c false otherwise.
+		bool restore_state(Snapshot::Reader &reader);
+
 	protected:
 		Delegate *delegate_ = nullptr;
 		void process_input_pulse(const Storage::Tape::Tape::Pulse &pulse) final;
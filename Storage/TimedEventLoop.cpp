@@ -86,3 +86,13 @@ Time TimedEventLoop::get_time_into_next_event() {
 	Time zero;
 	return zero;
 }
+
+void TimedEventLoop::save_state(Snapshot::Writer &writer) const {
+	writer.put(cycles_until_event_, subcycles_until_event_);
+}
+
+bool TimedEventLoop::restore_state(Snapshot::Reader &reader) {
+	return
+		reader.get(cycles_until_event_, subcycles_until_event_) &&
+		cycles_until_event_ >= 0 && subcycles_until_event_ >= 0.0f;
+}
@@ -12,6 +12,7 @@
 #include "Storage.hpp"
 #include "../ClockReceiver/ClockReceiver.hpp"
 #include "../SignalProcessing/Stepper.hpp"
+#include "Snapshot.hpp"
 
 #include <memory>
 
@@ -100,6 +101,15 @@ namespace Storage {
 			*/
 			Time get_time_into_next_event();
 
+			/*!
+				Appends the time until the next event to @c writer; subclasses are responsible for
+				recording the nature of that event.
+			*/
+			void save_state(Snapshot::Writer &writer) const;
+
+			/// Restores the time until the next event from @c reader. @returns @c true on success; @c false otherwise.
+			bool restore_state(Snapshot::Reader &reader);
+
 		private:
 			Cycles::IntType input_clock_rate_ = 0;
 			Cycles::IntType cycles_until_event_ = 0;